@@ -0,0 +1,263 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "cache.h"
+#include "allocate.h"
+
+/** --- **/
+
+/**
+ * @name cache_hash:
+ */
+uint64_t cache_hash(const void *p, size_t length) {
+
+  const uint8_t *q = (const uint8_t *) p;
+  uint64_t rv = 0xcbf29ce484222325ULL;
+
+  for (size_t i = 0; i < length; ++i) {
+    rv = (rv ^ q[i]) * 0x100000001b3ULL;
+  }
+
+  return rv;
+}
+
+/**
+ * @name cache_create:
+ */
+cache_t *cache_create(size_t capacity, cache_release_fn_t release) {
+
+  size_t buckets = 1;
+  cache_t *rv = allocate(sizeof(*rv));
+
+  /* Keep the load factor at or below one half */
+  while (buckets < 2 * capacity) {
+    buckets *= 2;
+  }
+
+  rv->buckets = allocate_array(sizeof(*rv->buckets), buckets, 0);
+  memset(rv->buckets, 0, buckets * sizeof(*rv->buckets));
+
+  rv->bucket_mask = buckets - 1;
+  rv->head = rv->tail = NULL;
+  rv->count = 0;
+  rv->capacity = (capacity > 0 ? capacity : 1);
+  rv->release = release;
+  rv->hits = rv->misses = rv->evictions = 0;
+
+  return rv;
+}
+
+/**
+ * @name cache_release_entry:
+ */
+static void cache_release_entry(cache_t *c, cache_entry_t *e) {
+
+  if (c->release) {
+    c->release(e->value);
+  }
+
+  free(e->key);
+  free(e);
+}
+
+/**
+ * @name cache_destroy:
+ */
+void cache_destroy(cache_t *c) {
+
+  cache_entry_t *e = c->head;
+
+  while (e != NULL) {
+    cache_entry_t *next = e->next;
+    cache_release_entry(c, e);
+    e = next;
+  }
+
+  free(c->buckets);
+  free(c);
+}
+
+/**
+ * @name cache_unlink:
+ *   Remove `e` from the list of entries in order of use.
+ */
+static void cache_unlink(cache_t *c, cache_entry_t *e) {
+
+  if (e->previous) {
+    e->previous->next = e->next;
+  } else {
+    c->head = e->next;
+  }
+
+  if (e->next) {
+    e->next->previous = e->previous;
+  } else {
+    c->tail = e->previous;
+  }
+}
+
+/**
+ * @name cache_push:
+ *   Make `e` the most recently used entry.
+ */
+static void cache_push(cache_t *c, cache_entry_t *e) {
+
+  e->previous = NULL;
+  e->next = c->head;
+
+  if (c->head) {
+    c->head->previous = e;
+  } else {
+    c->tail = e;
+  }
+
+  c->head = e;
+}
+
+/**
+ * @name cache_find:
+ *   Return a pointer to the bucket chain link that refers to the
+ *   entry matching `hash`, `tag`, and `key`. If there is no such
+ *   entry, the link that is returned points to NULL.
+ */
+static cache_entry_t **cache_find(cache_t *c, uint64_t hash,
+                                  unsigned int tag,
+                                  const void *key, size_t length) {
+
+  cache_entry_t **p = &c->buckets[hash & c->bucket_mask];
+
+  for (; *p != NULL; p = &(*p)->chain) {
+
+    cache_entry_t *e = *p;
+
+    if (e->hash == hash && e->tag == tag && e->length == length
+          && memcmp(e->key, key, length) == 0) {
+      break;
+    }
+  }
+
+  return p;
+}
+
+/**
+ * @name cache_lookup:
+ */
+void *cache_lookup(cache_t *c, unsigned int tag,
+                   const void *key, size_t length) {
+
+  uint64_t hash = cache_hash(key, length);
+  cache_entry_t *e = *cache_find(c, hash, tag, key, length);
+
+  if (!e) {
+    c->misses++;
+    return NULL;
+  }
+
+  if (e != c->head) {
+    cache_unlink(c, e);
+    cache_push(c, e);
+  }
+
+  c->hits++;
+  return e->value;
+}
+
+/**
+ * @name cache_insert:
+ */
+void cache_insert(cache_t *c, unsigned int tag,
+                  const void *key, size_t length, void *value) {
+
+  uint64_t hash = cache_hash(key, length);
+  cache_entry_t **p = cache_find(c, hash, tag, key, length);
+
+  /* Replace an existing value */
+  if (*p != NULL) {
+
+    cache_entry_t *e = *p;
+
+    if (c->release) {
+      c->release(e->value);
+    }
+
+    e->value = value;
+
+    if (e != c->head) {
+      cache_unlink(c, e);
+      cache_push(c, e);
+    }
+
+    return;
+  }
+
+  /* Evict the least recently used entry */
+  if (c->count >= c->capacity) {
+
+    cache_entry_t *victim = c->tail;
+    cache_entry_t **q = &c->buckets[victim->hash & c->bucket_mask];
+
+    while (*q != victim) {
+      q = &(*q)->chain;
+    }
+
+    *q = victim->chain;
+    cache_unlink(c, victim);
+    cache_release_entry(c, victim);
+
+    c->count--;
+    c->evictions++;
+  }
+
+  cache_entry_t *e = allocate(sizeof(*e));
+
+  e->hash = hash;
+  e->tag = tag;
+  e->length = length;
+  e->value = value;
+  e->key = allocate_array(sizeof(uint8_t), length, 1);
+  memcpy(e->key, key, length);
+
+  /* New entries go at the head of their bucket's chain */
+  p = &c->buckets[hash & c->bucket_mask];
+  e->chain = *p;
+  *p = e;
+
+  cache_push(c, e);
+  c->count++;
+}
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
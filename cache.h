@@ -0,0 +1,139 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "types.h"
+
+#ifndef __CACHE_H__
+#define __CACHE_H__
+
+/** --- **/
+
+/**
+ * @name cache_release_fn_t:
+ *   A function that frees a cached value, called when an entry is
+ *   evicted, replaced, or destroyed along with its cache.
+ */
+typedef void (*cache_release_fn_t)(void *value);
+
+/**
+ * @name cache_entry_t:
+ *   A single cached value. Entries are kept in a hash table, and in
+ *   a doubly-linked list in order of use; the most recently used
+ *   entry is at the head of the list.
+ */
+typedef struct cache_entry {
+
+  uint64_t hash;
+  unsigned int tag;
+  size_t length;
+  uint8_t *key;
+  void *value;
+
+  struct cache_entry *chain;
+  struct cache_entry *previous;
+  struct cache_entry *next;
+
+} cache_entry_t;
+
+/**
+ * @name cache_t:
+ *   A bounded least-recently-used cache, mapping byte-string keys to
+ *   values that the cache owns. Each key also carries an integer
+ *   `tag`, so that callers can distinguish values derived from the
+ *   same bytes under different settings without copying the bytes.
+ */
+typedef struct cache {
+
+  cache_entry_t **buckets;
+  size_t bucket_mask;
+
+  cache_entry_t *head;
+  cache_entry_t *tail;
+
+  size_t count;
+  size_t capacity;
+  cache_release_fn_t release;
+
+  unsigned long hits;
+  unsigned long misses;
+  unsigned long evictions;
+
+} cache_t;
+
+/**
+ * @name cache_hash:
+ *   Return a 64-bit FNV-1a hash of the `length` bytes at `p`.
+ */
+uint64_t cache_hash(const void *p, size_t length);
+
+/**
+ * @name cache_create:
+ *   Create an empty cache that holds at most `capacity` entries,
+ *   which must be at least one. Values are freed with `release`,
+ *   which may be NULL if values don't need to be freed.
+ */
+cache_t *cache_create(size_t capacity, cache_release_fn_t release);
+
+/**
+ * @name cache_destroy:
+ *   Release every value held by `c`, then free `c` itself.
+ */
+void cache_destroy(cache_t *c);
+
+/**
+ * @name cache_lookup:
+ *   Return the value stored under `tag` and the `length` bytes at
+ *   `key`, or NULL if there isn't one. A successful lookup makes the
+ *   entry the most recently used. Either way, the hit or miss is
+ *   counted. The returned value remains owned by the cache, and is
+ *   valid until the next call to `cache_insert` or `cache_destroy`.
+ */
+void *cache_lookup(cache_t *c, unsigned int tag,
+                   const void *key, size_t length);
+
+/**
+ * @name cache_insert:
+ *   Store `value` under `tag` and the `length` bytes at `key`, which
+ *   are copied. The cache takes ownership of `value`. Any value
+ *   already stored under the same key is released; otherwise, if the
+ *   cache is full, the least recently used entry is evicted.
+ */
+void cache_insert(cache_t *c, unsigned int tag,
+                  const void *key, size_t length, void *value);
+
+/** --- **/
+
+#endif /* __CACHE_H__ */
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
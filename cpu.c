@@ -0,0 +1,127 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <pthread.h>
+
+#include "cpu.h"
+
+/** --- **/
+
+/**
+ * @name cpu_detected_features:
+ */
+static unsigned int cpu_detected_features = CPU_NONE;
+
+/**
+ * @name cpu_detect_once:
+ *   Guards detection, which may first be requested by several
+ *   threads at once (e.g. by the workers of the `plan` command).
+ */
+static pthread_once_t cpu_detect_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @name cpu_enabled_features:
+ */
+static unsigned int cpu_enabled_features = CPU_ALL;
+
+/** --- **/
+
+/**
+ * @name cpu_detect_features:
+ */
+static unsigned int cpu_detect_features(void) {
+
+  unsigned int rv = CPU_NONE;
+
+  #if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("sse2")) {
+      rv |= CPU_SSE2;
+    }
+
+    if (__builtin_cpu_supports("ssse3")) {
+      rv |= CPU_SSSE3;
+    }
+
+    if (__builtin_cpu_supports("sse4.1")) {
+      rv |= CPU_SSE41;
+    }
+
+    if (__builtin_cpu_supports("avx2")) {
+      rv |= CPU_AVX2;
+    }
+
+  #endif
+
+  return rv;
+}
+
+/**
+ * @name _cpu_detect_once:
+ */
+static void _cpu_detect_once(void) {
+
+  cpu_detected_features = cpu_detect_features();
+}
+
+/**
+ * @name cpu_features:
+ *   Return a bitmask of `cpu_feature_t` values, describing the
+ *   vector instruction set extensions that are both supported by
+ *   the processor and enabled via `cpu_features_restrict`. The
+ *   processor is only queried once; later calls are inexpensive.
+ *   This is safe to call from multiple threads.
+ */
+unsigned int cpu_features(void) {
+
+  pthread_once(&cpu_detect_once, _cpu_detect_once);
+
+  return (cpu_detected_features & cpu_enabled_features);
+}
+
+/**
+ * @name cpu_features_restrict:
+ *   Limit all subsequent runtime dispatch to the `cpu_feature_t`
+ *   values present in `mask`. Pass `CPU_NONE` to force the use of
+ *   portable scalar code, or `CPU_ALL` to remove any restriction.
+ *   This is intended for use by tests and benchmarks.
+ */
+void cpu_features_restrict(unsigned int mask) {
+
+  cpu_enabled_features = mask;
+}
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
@@ -0,0 +1,73 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "types.h"
+
+#ifndef __CPU_H__
+#define __CPU_H__
+
+/** --- **/
+
+/**
+ * @name cpu_feature_t:
+ */
+typedef enum {
+  CPU_NONE = 0, CPU_SSE2 = 1, CPU_SSSE3 = 2,
+  CPU_SSE41 = 4, CPU_AVX2 = 8, CPU_ALL = 0xff
+} cpu_feature_t;
+
+/**
+ * @name cpu_features:
+ *   Return a bitmask of `cpu_feature_t` values, describing the
+ *   vector instruction set extensions that are both supported by
+ *   the processor and enabled via `cpu_features_restrict`. The
+ *   processor is only queried once; later calls are inexpensive.
+ *   This is safe to call from multiple threads.
+ */
+unsigned int cpu_features(void);
+
+/**
+ * @name cpu_features_restrict:
+ *   Limit all subsequent runtime dispatch to the `cpu_feature_t`
+ *   values present in `mask`. Pass `CPU_NONE` to force the use of
+ *   portable scalar code, or `CPU_ALL` to remove any restriction.
+ *   This is intended for use by tests and benchmarks.
+ */
+void cpu_features_restrict(unsigned int mask);
+
+/** --- **/
+
+#endif /* __CPU_H__ */
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
@@ -392,6 +392,56 @@ int test_unicode_characters() {
     return 0;
 }
 
+int test_compact() {
+    int i, r;
+    jsmn_parser p;
+    jsmn_compact_t c[10];
+    jsmntok_t t[10];
+    const char *js;
+
+    js = "{\"a\": [1, {\"b\": \"c\"}], \"d\": true}";
+    jsmn_init(&p);
+    r = jsmn_parse(&p, js, t, 10);
+    check(r == JSMN_SUCCESS);
+    jsmn_init(&p);
+    r = jsmn_parse_compact(&p, js, c, 10);
+    check(r == JSMN_SUCCESS && p.toknext == 9);
+
+    for (i = 0; i < 9; i++) {
+        check(jsmn_compact_type(&c[i]) == t[i].type);
+        check((int) jsmn_compact_start(&c[i]) == t[i].start);
+        check((int) c[i].end == t[i].end);
+    }
+
+    check(c[0].skip == 8 && c[2].skip == 4 && c[4].skip == 2);
+    check(c[1].skip == 0 && c[7].skip == 0 && c[8].skip == 0);
+
+    /* Resume after running out of tokens */
+    jsmn_init(&p);
+    r = jsmn_parse_compact(&p, js, c, 3);
+    check(r == JSMN_ERROR_NOMEM);
+    r = jsmn_parse_compact(&p, js, c, 10);
+    check(r == JSMN_SUCCESS && p.toknext == 9);
+    check(c[0].skip == 8 && c[2].skip == 4 && c[4].skip == 2);
+
+    js = "{\"a\": [1, 2}";
+    jsmn_init(&p);
+    r = jsmn_parse_compact(&p, js, c, 10);
+    check(r == JSMN_ERROR_INVAL);
+
+    js = "[1, 2]]";
+    jsmn_init(&p);
+    r = jsmn_parse_compact(&p, js, c, 10);
+    check(r == JSMN_ERROR_INVAL);
+
+    js = "{\"a\": [1, 2]";
+    jsmn_init(&p);
+    r = jsmn_parse_compact(&p, js, c, 10);
+    check(r == JSMN_ERROR_PART);
+
+    return 0;
+}
+
 int main() {
     test(test_empty, "general test for a empty JSON objects/arrays");
     test(test_simple, "general test for a simple JSON string");
@@ -403,6 +453,7 @@ int main() {
     test(test_unquoted_keys, "test unquoted keys (like in JavaScript)");
     test(test_objects_arrays, "test objects and arrays");
     test(test_unicode_characters, "test unicode characters");
+    test(test_compact, "test compact tokens and subtree sizes");
 
     if (test_failed > 0) {
         printf("One or more tests failed (%d of %d)\n\n", test_passed, test_failed);
@@ -73,15 +73,13 @@ static void jsmn_fill_token(jsmntok_t *token, jsmntype_t type,
 }
 
 /**
- * Fills next available token with JSON primitive.
+ * Scans a JSON primitive, starting at parser->pos. On success, leaves
+ * parser->pos at the delimiter that follows the primitive. On failure,
+ * restores parser->pos to the start of the primitive.
  */
-static jsmnerr_t jsmn_parse_primitive(jsmn_parser *parser, const char *js,
-									  jsmntok_t *tokens, size_t num_tokens) {
+static jsmnerr_t jsmn_scan_primitive(jsmn_parser *parser, const char *js) {
 
-	jsmntok_t *token;
-	int start;
-
-	start = parser->pos;
+	int start = parser->pos;
 
 	for (; js[parser->pos] != '\0'; parser->pos++) {
 		switch (js[parser->pos]) {
@@ -92,7 +90,7 @@ static jsmnerr_t jsmn_parse_primitive(jsmn_parser *parser, const char *js,
 			#endif
 			case '\t' : case '\r' : case '\n' : case ' ' :
 			case ','  : case ']'  : case '}' :
-				goto found;
+				return JSMN_SUCCESS;
 		}
 		if (js[parser->pos] < 32 || js[parser->pos] >= 127) {
 			parser->pos = start;
@@ -104,28 +102,47 @@ static jsmnerr_t jsmn_parse_primitive(jsmn_parser *parser, const char *js,
 		    Primitive must be followed by a comma/object/array */
 		parser->pos = start;
 		return JSMN_ERROR_PART;
-	#endif
-
-	found:
-		token = jsmn_alloc_token(parser, tokens, num_tokens);
-		if (token == NULL) {
-			parser->pos = start;
-			return JSMN_ERROR_NOMEM;
-		}
-		jsmn_fill_token(token, JSMN_PRIMITIVE, start, parser->pos);
-		#ifdef JSMN_PARENT_LINKS
-			token->parent = parser->toksuper;
-		#endif
-		parser->pos--;
+	#else
 		return JSMN_SUCCESS;
+	#endif
 }
 
 /**
- * Filsl next token with JSON string.
+ * Fills next available token with JSON primitive.
  */
-static jsmnerr_t jsmn_parse_string(jsmn_parser *parser, const char *js,
-								   jsmntok_t *tokens, size_t num_tokens) {
+static jsmnerr_t jsmn_parse_primitive(jsmn_parser *parser, const char *js,
+									  jsmntok_t *tokens, size_t num_tokens) {
+
 	jsmntok_t *token;
+	jsmnerr_t r;
+	int start;
+
+	start = parser->pos;
+
+	if ((r = jsmn_scan_primitive(parser, js)) < 0) {
+		return r;
+	}
+
+	token = jsmn_alloc_token(parser, tokens, num_tokens);
+	if (token == NULL) {
+		parser->pos = start;
+		return JSMN_ERROR_NOMEM;
+	}
+	jsmn_fill_token(token, JSMN_PRIMITIVE, start, parser->pos);
+	#ifdef JSMN_PARENT_LINKS
+		token->parent = parser->toksuper;
+	#endif
+	parser->pos--;
+	return JSMN_SUCCESS;
+}
+
+/**
+ * Scans a JSON string, starting at the opening quote at parser->pos.
+ * On success, leaves parser->pos at the closing quote. On failure,
+ * restores parser->pos to the opening quote.
+ */
+static jsmnerr_t jsmn_scan_string(jsmn_parser *parser, const char *js) {
+
 	int start = parser->pos;
 
 	parser->pos++;
@@ -136,15 +153,6 @@ static jsmnerr_t jsmn_parse_string(jsmn_parser *parser, const char *js,
 
 		/* Quote: end of string */
 		if (c == '\"') {
-			token = jsmn_alloc_token(parser, tokens, num_tokens);
-			if (token == NULL) {
-				parser->pos = start;
-				return JSMN_ERROR_NOMEM;
-			}
-			jsmn_fill_token(token, JSMN_STRING, start+1, parser->pos);
-			#ifdef JSMN_PARENT_LINKS
-				token->parent = parser->toksuper;
-			#endif
 			return JSMN_SUCCESS;
 		}
 
@@ -183,6 +191,31 @@ static jsmnerr_t jsmn_parse_string(jsmn_parser *parser, const char *js,
 	return JSMN_ERROR_PART;
 }
 
+/**
+ * Filsl next token with JSON string.
+ */
+static jsmnerr_t jsmn_parse_string(jsmn_parser *parser, const char *js,
+								   jsmntok_t *tokens, size_t num_tokens) {
+	jsmntok_t *token;
+	jsmnerr_t r;
+	int start = parser->pos;
+
+	if ((r = jsmn_scan_string(parser, js)) < 0) {
+		return r;
+	}
+
+	token = jsmn_alloc_token(parser, tokens, num_tokens);
+	if (token == NULL) {
+		parser->pos = start;
+		return JSMN_ERROR_NOMEM;
+	}
+	jsmn_fill_token(token, JSMN_STRING, start+1, parser->pos);
+	#ifdef JSMN_PARENT_LINKS
+		token->parent = parser->toksuper;
+	#endif
+	return JSMN_SUCCESS;
+}
+
 /**
  * Parse JSON string and fill tokens.
  */
@@ -309,6 +342,129 @@ jsmnerr_t jsmn_parse(jsmn_parser *parser, const char *js,
 	return JSMN_SUCCESS;
 }
 
+/**
+ * Parse JSON string and fill compact tokens. The grammar is exactly that
+ * of jsmn_parse. While a container is open, its end field holds the index
+ * of its parent plus one, tagged with JSMN_COMPACT_OPEN; it's replaced by
+ * the real end offset, and the subtree size is recorded, when it closes.
+ * This finds the parent of a closing container in constant time, without
+ * storing a parent link in every token. Like jsmn_parse, this may be
+ * called again with a larger token array after JSMN_ERROR_NOMEM, and will
+ * resume where it stopped; the first num_tokens tokens must be unchanged.
+ */
+jsmnerr_t jsmn_parse_compact(jsmn_parser *parser, const char *js,
+							 jsmn_compact_t *tokens, unsigned int num_tokens) {
+	jsmnerr_t r;
+	jsmn_compact_t *token;
+
+	for (; js[parser->pos] != '\0'; parser->pos++) {
+		char c;
+		unsigned int start = parser->pos;
+
+		if (start > JSMN_COMPACT_OFFSET_MASK - 1) {
+			return JSMN_ERROR_INVAL;
+		}
+
+		c = js[parser->pos];
+		switch (c) {
+			case '{': case '[':
+				if ((unsigned int) parser->toknext >= num_tokens) {
+					return JSMN_ERROR_NOMEM;
+				}
+				token = &tokens[parser->toknext];
+				token->start = jsmn_compact_pack(
+					(c == '{' ? JSMN_OBJECT : JSMN_ARRAY), start
+				);
+				token->end = JSMN_COMPACT_OPEN | (parser->toksuper + 1);
+				token->skip = 0;
+				parser->toksuper = parser->toknext++;
+				break;
+			case '}': case ']':
+				if (parser->toksuper == -1) {
+					return JSMN_ERROR_INVAL;
+				}
+				token = &tokens[parser->toksuper];
+				if (jsmn_compact_type(token) !=
+						(c == '}' ? JSMN_OBJECT : JSMN_ARRAY)) {
+					return JSMN_ERROR_INVAL;
+				}
+				token->skip = parser->toknext - parser->toksuper - 1;
+				parser->toksuper =
+					(int) (token->end & ~JSMN_COMPACT_OPEN) - 1;
+				token->end = start + 1;
+				break;
+			case '\"':
+				if ((r = jsmn_scan_string(parser, js)) < 0) {
+					return r;
+				}
+				if ((unsigned int) parser->toknext >= num_tokens) {
+					parser->pos = start;
+					return JSMN_ERROR_NOMEM;
+				}
+				token = &tokens[parser->toknext++];
+				token->start = jsmn_compact_pack(JSMN_STRING, start + 1);
+				token->end = parser->pos;
+				token->skip = 0;
+				break;
+			case '\t' : case '\r' : case '\n' : case ':' : case ',': case ' ': 
+				break;
+			#ifdef JSMN_STRICT
+				/* Strict mode:
+				    Primitives are numbers and booleans */
+				case '-': case '0': case '1' : case '2': case '3' : case '4':
+				case '5': case '6': case '7' : case '8': case '9':
+				case 't': case 'f': case 'n' :
+			#else
+				/* Non-strict mode:
+				    Every unquoted value is a primitive */
+				default:
+			#endif
+					if ((r = jsmn_scan_primitive(parser, js)) < 0) {
+						return r;
+					}
+					if ((unsigned int) parser->toknext >= num_tokens) {
+						parser->pos = start;
+						return JSMN_ERROR_NOMEM;
+					}
+					token = &tokens[parser->toknext++];
+					token->start = jsmn_compact_pack(JSMN_PRIMITIVE, start);
+					token->end = parser->pos;
+					token->skip = 0;
+					parser->pos--;
+					break;
+
+			#ifdef JSMN_STRICT
+				/* Unexpected char in strict mode */
+				default:
+					return JSMN_ERROR_INVAL;
+			#endif
+		}
+	}
+
+	/* Unmatched opened object or array */
+	if (parser->toksuper != -1) {
+		return JSMN_ERROR_PART;
+	}
+
+	return JSMN_SUCCESS;
+}
+
+/**
+ * Translate a compact token in to a null-terminated string, exactly as
+ * jsmn_stringify_token does for a full-sized token.
+ */
+char *jsmn_compact_stringify_token(char *json, jsmn_compact_t *token) {
+
+	jsmntype_t type = jsmn_compact_type(token);
+
+	if (type != JSMN_PRIMITIVE && type != JSMN_STRING) {
+		return NULL;
+	}
+
+	json[token->end] = '\0';
+	return &json[jsmn_compact_start(token)];
+}
+
 /**
  * Creates a new parser based over a given buffer with an array of tokens 
  * available.
@@ -23,6 +23,8 @@
 #ifndef __JSMN_H__
 #define __JSMN_H__
 
+#include <stdint.h>
+
 /* Feature definitions:
  *   We don't include these in $CFLAGS, as anyone including jsmn.h
  *   and linking adainst libjsmn.h would also have to define them
@@ -75,6 +77,35 @@ typedef struct {
 	#endif
 } jsmntok_t;
 
+/**
+ * Compact JSON token description, for large token arrays. This is twelve
+ * bytes, rather than the twenty used by jsmntok_t. Offsets are packed in
+ * to 32 bits; the type occupies the top two bits of start; and instead of
+ * a child count and parent link, each token records the number of tokens
+ * in its subtree, so that a whole value can be skipped at once.
+ * @param		start	type (top two bits) and start position
+ * @param		end		end position in JSON data string
+ * @param		skip	number of tokens nested inside this one
+ */
+typedef struct {
+	uint32_t start;
+	uint32_t end;
+	uint32_t skip;
+} jsmn_compact_t;
+
+#define JSMN_COMPACT_TYPE_SHIFT		(30)
+#define JSMN_COMPACT_OFFSET_MASK	((1u << JSMN_COMPACT_TYPE_SHIFT) - 1)
+#define JSMN_COMPACT_OPEN			(1u << 31)
+
+#define jsmn_compact_pack(type, start) \
+	(((uint32_t) (type) << JSMN_COMPACT_TYPE_SHIFT) | (uint32_t) (start))
+
+#define jsmn_compact_type(t) \
+	((jsmntype_t) ((t)->start >> JSMN_COMPACT_TYPE_SHIFT))
+
+#define jsmn_compact_start(t) \
+	((t)->start & JSMN_COMPACT_OFFSET_MASK)
+
 /**
  * JSON parser. Contains an array of token blocks available. Also stores
  * the string being parsed now and current position in that string
@@ -97,6 +128,21 @@ void jsmn_init(jsmn_parser *parser);
 jsmnerr_t jsmn_parse(jsmn_parser *parser, const char *js, 
 		jsmntok_t *tokens, unsigned int num_tokens);
 
+/**
+ * Run JSON parser, filling compact tokens. The input grammar and error
+ * codes are those of jsmn_parse, except that a closing bracket with no
+ * open container is always rejected with JSMN_ERROR_INVAL. Inputs of
+ * 1 GiB or more are also rejected with JSMN_ERROR_INVAL.
+ */
+jsmnerr_t jsmn_parse_compact(jsmn_parser *parser, const char *js,
+		jsmn_compact_t *tokens, unsigned int num_tokens);
+
+/**
+ * Destructively translate a compact token in to a null-terminated string.
+ * See jsmn_stringify_token in jsmn.c for a full description.
+ */
+char *jsmn_compact_stringify_token(char *json, jsmn_compact_t *token);
+
 /**
  * Mark a token as invalid. This can be used prior to parsing, in
  * order to easily detect tokens that were not filled by jsmn_parse.
@@ -33,8 +33,18 @@
  */
 
 #include <iconv.h>
-#include <gammu.h>
-
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+  #include <immintrin.h>
+  #define ENCODING_X86_SIMD (1)
+#endif
+
+#include "cpu.h"
+#include "gsm.h"
+#include "nfc.h"
 #include "types.h"
 #include "allocate.h"
 #include "encoding.h"
@@ -57,17 +67,155 @@ const uint16_t utf16_surrogate_middle = 0xdc00;
 const uint16_t utf16_surrogate_last = 0xdfff;
 
 /**
- * @name utf16be_string_info:
- *   Calculates the number of bytes, code units, and valid symbols
- *   in the big-endian UTF-16 string `s`. If the string contains at
- *   least one invalid byte sequence, this function will record
- *   an error type and offset for the *first* invalid byte sequence,
- *   along with the total number of invalid-sequence bytes that were
- *   encountered. Returns true if the string contained only valid
- *   big-endian UTF-16 sequences; false otherwise.
+ * @name utf16be_span_scalar:
+ *   Portable implementation of `utf16be_span`.
  */
-boolean_t utf16be_string_info(const char *s, string_info_t *i) {
+static size_t utf16be_span_scalar(const uint8_t *p, const uint8_t *end,
+                                  uint8_t lo, uint8_t hi, uint8_t exclude) {
+  size_t rv = 0;
+
+  while (p + 2 <= end && p[0] == 0
+         && p[1] >= lo && p[1] <= hi && p[1] != exclude) {
+    p += 2; rv++;
+  }
+
+  return rv;
+}
+
+#ifdef ENCODING_X86_SIMD
+
+/**
+ * @name utf16be_span_sse2:
+ *   SSE2 implementation of `utf16be_span`; examines eight code
+ *   units per iteration. Requires that `lo` is at least one, and
+ *   that `hi` is less than 0x7f.
+ */
+__attribute__((target("sse2")))
+static size_t utf16be_span_sse2(const uint8_t *p, const uint8_t *end,
+                                uint8_t lo, uint8_t hi, uint8_t exclude) {
+  size_t rv = 0;
+
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i vlo = _mm_set1_epi8(lo - 1);
+  const __m128i vhi = _mm_set1_epi8(hi + 1);
+  const __m128i vexclude = _mm_set1_epi8(exclude);
+  /* Selects the odd-numbered, least-significant bytes */
+  const __m128i odd = _mm_set1_epi16((short) 0xff00);
+
+  while (p + 16 <= end) {
+
+    __m128i v = _mm_loadu_si128((const __m128i *) p);
+
+    /* Most-significant bytes must be zero */
+    __m128i msb_ok = _mm_andnot_si128(odd, _mm_cmpeq_epi8(v, zero));
+
+    /* Least-significant bytes must be in range, and not excluded */
+    __m128i lsb_ok = _mm_andnot_si128(
+      _mm_cmpeq_epi8(v, vexclude),
+        _mm_and_si128(_mm_cmpgt_epi8(v, vlo), _mm_cmplt_epi8(v, vhi))
+    );
+
+    unsigned int bad = 0xffff & ~_mm_movemask_epi8(
+      _mm_or_si128(msb_ok, _mm_and_si128(lsb_ok, odd))
+    );
+
+    if (bad) {
+      return rv + (__builtin_ctz(bad) >> 1);
+    }
+
+    p += 16; rv += 8;
+  }
+
+  return rv + utf16be_span_scalar(p, end, lo, hi, exclude);
+}
+
+/**
+ * @name utf16be_span_avx2:
+ *   AVX2 implementation of `utf16be_span`; examines sixteen code
+ *   units per iteration. The same restrictions as above apply.
+ */
+__attribute__((target("avx2")))
+static size_t utf16be_span_avx2(const uint8_t *p, const uint8_t *end,
+                                uint8_t lo, uint8_t hi, uint8_t exclude) {
+  size_t rv = 0;
+
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i vlo = _mm256_set1_epi8(lo - 1);
+  const __m256i vhi = _mm256_set1_epi8(hi + 1);
+  const __m256i vexclude = _mm256_set1_epi8(exclude);
+  const __m256i odd = _mm256_set1_epi16((short) 0xff00);
+
+  while (p + 32 <= end) {
+
+    __m256i v = _mm256_loadu_si256((const __m256i *) p);
+
+    /* Most-significant bytes must be zero */
+    __m256i msb_ok = _mm256_andnot_si256(odd, _mm256_cmpeq_epi8(v, zero));
+
+    /* Least-significant bytes must be in range, and not excluded */
+    __m256i lsb_ok = _mm256_andnot_si256(
+      _mm256_cmpeq_epi8(v, vexclude),
+        _mm256_and_si256(
+          _mm256_cmpgt_epi8(v, vlo), _mm256_cmpgt_epi8(vhi, v)
+        )
+    );
+
+    uint32_t bad = ~(uint32_t) _mm256_movemask_epi8(
+      _mm256_or_si256(msb_ok, _mm256_and_si256(lsb_ok, odd))
+    );
+
+    if (bad) {
+      return rv + (__builtin_ctz(bad) >> 1);
+    }
+
+    p += 32; rv += 16;
+  }
+
+  return rv + utf16be_span_sse2(p, end, lo, hi, exclude);
+}
+
+#endif /* ENCODING_X86_SIMD */
+
+/**
+ * @name utf16be_span:
+ *   Return the number of leading code units in the big-endian UTF-16
+ *   string `p` whose values lie between `lo` and `hi` (inclusive) and
+ *   are not equal to `exclude`. The range must lie within 0x01-0x7e,
+ *   so that neither the null terminator nor any surrogate can match.
+ *   No bytes at or beyond `end` are examined; vector loops handle
+ *   whole blocks only, and the tail is finished by scalar code.
+ *   Dispatches to the widest vector implementation that the current
+ *   processor supports, falling back to portable scalar code.
+ */
+static size_t utf16be_span(const char *s, const char *end, uint8_t lo,
+                           uint8_t hi, uint8_t exclude) {
+
+  const uint8_t *p = (const uint8_t *) s;
+  const uint8_t *e = (const uint8_t *) end;
+
+  #ifdef ENCODING_X86_SIMD
+    unsigned int features = cpu_features();
+
+    if (features & CPU_AVX2) {
+      return utf16be_span_avx2(p, e, lo, hi, exclude);
+    }
+
+    if (features & CPU_SSE2) {
+      return utf16be_span_sse2(p, e, lo, hi, exclude);
+    }
+  #endif
 
+  return utf16be_span_scalar(p, e, lo, hi, exclude);
+}
+
+/**
+ * @name utf16be_string_info_range:
+ *   Implementation of `utf16be_string_info` and its slice variant.
+ *   No bytes at or beyond `end` are examined; a null code unit
+ *   before `end` also ends the string.
+ */
+static boolean_t utf16be_string_info_range(const char *s, const char *end,
+                                           string_info_t *i) {
   const char *p = s;
   boolean_t in_surrogate = FALSE;
 
@@ -89,6 +237,20 @@ boolean_t utf16be_string_info(const char *s, string_info_t *i) {
 
   for (;;) {
 
+    /* Fast path:
+     *   Skip over runs of ASCII characters, several at a time. These
+     *   can't be surrogates, and so are always valid symbols. */
+
+    if (!in_surrogate) {
+      size_t n = utf16be_span(p, end, 0x01, 0x7e, 0x00);
+      i->units += n; i->symbols += n;
+      i->bytes += 2 * n; p += 2 * n;
+    }
+
+    if (p + 2 > end) {
+      goto finished;
+    }
+
     /* Reassemble current UTF-16 character */
     uint16_t v = (p[0] << 8) | (uint8_t) p[1];
 
@@ -150,242 +312,2901 @@ boolean_t utf16be_string_info(const char *s, string_info_t *i) {
 };
 
 /**
- * @name utf16be_encode_json_utf8:
- *   Copy and transform the string `s` to a newly-allocated
- *   buffer, making it suitable for output as a single utf-8
- *   JSON string. The caller must free the returned string.
+ * @name utf16be_string_info:
+ *   Calculates the number of bytes, code units, and valid symbols
+ *   in the big-endian UTF-16 string `s`. If the string contains at
+ *   least one invalid byte sequence, this function will record
+ *   an error type and offset for the *first* invalid byte sequence,
+ *   along with the total number of invalid-sequence bytes that were
+ *   encountered. Returns true if the string contained only valid
+ *   big-endian UTF-16 sequences; false otherwise. The string is
+ *   measured first; callers that know its length should use
+ *   `utf16be_string_info_slice` instead.
  */
-char *utf16be_encode_json_utf8(const char *s) {
+boolean_t utf16be_string_info(const char *s, string_info_t *i) {
 
-  unsigned int i, j = 0;
+  return utf16be_string_info_range(s, s + 2 * utf16be_length(s), i);
+}
 
-  string_info_t si;
-  utf16be_string_info(s, &si);
-
-  /* Worst-case UTF-16 string allocation:
-   *  Original length plus null terminator. Four bytes for each
-   *  character assuming the worst case of 100% surrogate pairs;
-   *  every character escaped with a two byte UTF-16 backslash. */
-
-  char *b = allocate_array(6, si.units, 1);
-
-  for (i = 0; i < si.units; ++i) {
-
-    char msb = s[2 * i];
-    char lsb = s[2 * i + 1];
-
-    if (msb == '\0') {
-      char escape = '\0';
-
-      switch (lsb) {
-        case '\r':
-          escape = 'r'; break;
-        case '\n':
-          escape = 'n'; break;
-        case '\f':
-          escape = 'f'; break;
-        case '\b':
-          escape = 'b'; break;
-        case '\t':
-          escape = 't'; break;
-        case '\\': case '"':
-          escape = lsb; break;
-        default:
-          break;
-      };
+/**
+ * @name utf16be_string_info_slice:
+ *   Identical to `utf16be_string_info`, but for the UTF-16 slice `s`.
+ *   A lead surrogate at the end of the slice is unmatched.
+ */
+boolean_t utf16be_string_info_slice(string_slice_t s, string_info_t *i) {
 
-      if (escape != '\0') {
-        b[j++] = '\0';
-        b[j++] = '\\';
-        lsb = escape;
-      }
-    }
+  return utf16be_string_info_range(s.data, s.data + s.length, i);
+}
+
+/**
+ * @name utf16be_length:
+ *   Return the number of 16-bit code units in the big-endian UTF-16
+ *   string `s`, not including the two-byte null terminator.
+ */
+size_t utf16be_length(const char *s) {
 
-    b[j++] = msb;
-    b[j++] = lsb;
+  size_t rv = 0;
+
+  while (s[2 * rv] != '\0' || s[2 * rv + 1] != '\0') {
+    rv++;
   }
 
-  b[j++] = '\0';
-  b[j] = '\0';
+  return rv;
+}
 
-  /* Convert result to UTF-8 */
-  char *rv = convert_utf8_utf16be(b, TRUE);
+/**
+ * @name utf16be_slice:
+ *   Return a slice covering the null-terminated big-endian UTF-16
+ *   string `s`, not including its two-byte null terminator.
+ */
+string_slice_t utf16be_slice(const char *s) {
 
-  free(b);
+  string_slice_t rv = { s, 2 * utf16be_length(s) };
   return rv;
 }
 
 /**
- * @name utf16be_is_gsm_codepoint:
- *   Given the most-significant byte `msb` and the least-significant
- *   byte `lsb` of a UCS-16-BE character, return TRUE if the character
- *   can be represented in the default GSM alphabet (described in GSM
- *   03.38). The GSM-to-Unicode conversion table used here was obtained
- *   from http://www.unicode.org/Public/MAPPINGS/ETSI/GSM0338.TXT.
- *
- *   Copyright (c) 2000 - 2009 Unicode, Inc. All Rights reserved.
- *   Unicode, Inc. hereby grants the right to freely use the information
- *   supplied in this file in the creation of products supporting the
- *   Unicode Standard, and to make copies of this file in any form for
- *   internal or external distribution as long as this notice remains
- *   attached.
- *  
+ * @name utf16be_slice_units:
+ *   Return a slice covering the first `units` code units of the
+ *   big-endian UTF-16 string `s`, which need not be null-terminated.
  */
-boolean_t utf16be_is_gsm_codepoint(uint8_t msb, uint8_t lsb) {
+string_slice_t utf16be_slice_units(const char *s, size_t units) {
+
+  string_slice_t rv = { s, 2 * units };
+  return rv;
+}
+
+/**
+ * @name utf8_slice:
+ *   Return a slice covering the null-terminated UTF-8 string `s`,
+ *   not including its null terminator.
+ */
+string_slice_t utf8_slice(const char *s) {
+
+  string_slice_t rv = { s, strlen(s) };
+  return rv;
+}
+
+/**
+ * @name utf8_write_codepoint:
+ *   Write the UTF-8 encoding of the codepoint `c` to `p`. Returns
+ *   a pointer to the byte immediately following the encoded form.
+ */
+static char *utf8_write_codepoint(char *p, codepoint_t c) {
+
+  if (c < 0x80) {
+    *p++ = c;
+  } else if (c < 0x800) {
+    *p++ = 0xc0 | (c >> 6);
+    *p++ = 0x80 | (c & 0x3f);
+  } else if (c < 0x10000) {
+    *p++ = 0xe0 | (c >> 12);
+    *p++ = 0x80 | ((c >> 6) & 0x3f);
+    *p++ = 0x80 | (c & 0x3f);
+  } else {
+    *p++ = 0xf0 | (c >> 18);
+    *p++ = 0x80 | ((c >> 12) & 0x3f);
+    *p++ = 0x80 | ((c >> 6) & 0x3f);
+    *p++ = 0x80 | (c & 0x3f);
+  }
+
+  return p;
+}
+
+/**
+ * @name utf8_write_json_escape:
+ *   If the codepoint `c` must be escaped inside of a JSON string,
+ *   write its escaped form to `p` and return a pointer to the byte
+ *   immediately following it. Otherwise, return NULL.
+ */
+static char *utf8_write_json_escape(char *p, codepoint_t c) {
+
+  static const char hex[] = "0123456789abcdef";
+  char escape = '\0';
+
+  switch (c) {
+    case '\r':
+      escape = 'r'; break;
+    case '\n':
+      escape = 'n'; break;
+    case '\f':
+      escape = 'f'; break;
+    case '\b':
+      escape = 'b'; break;
+    case '\t':
+      escape = 't'; break;
+    case '\\': case '"':
+      escape = c; break;
+    default:
+      break;
+  };
+
+  if (escape != '\0') {
+    *p++ = '\\';
+    *p++ = escape;
+    return p;
+  }
+
+  if (c < 0x20) {
+    *p++ = '\\'; *p++ = 'u';
+    *p++ = '0'; *p++ = '0';
+    *p++ = hex[c >> 4];
+    *p++ = hex[c & 0x0f];
+    return p;
+  }
+
+  return NULL;
+}
+
+/**
+ * @name utf16be_write_json_utf8:
+ *   Transcode the first `units` code units of the big-endian UTF-16
+ *   string `s` to JSON-escaped UTF-8, writing the result to `out`.
+ *   Unpaired surrogates are replaced with U+FFFD. The caller must
+ *   ensure that `out` has room for at least six bytes per unit, plus
+ *   a null terminator. Returns the number of bytes written, not
+ *   including the null terminator.
+ */
+static size_t utf16be_write_json_utf8(const char *s,
+                                      size_t units, char *out) {
+  char *p = out;
+  const uint8_t *u = (const uint8_t *) s;
+
+  for (size_t i = 0; i < units; ++i) {
+
+    codepoint_t c = (u[2 * i] << 8) | u[2 * i + 1];
+
+    if (c < 0x80) {
+      char *q = utf8_write_json_escape(p, c);
+      p = (q ? q : utf8_write_codepoint(p, c));
+      continue;
+    }
 
-  switch (msb) {
+    if (c >= utf16_surrogate_first && c <= utf16_surrogate_last) {
 
-    case 0x00: {
-      int rv = (
-        (lsb >= 0x20 && lsb <= 0x5f)
-          || (lsb >= 0x61 && lsb <= 0x7e)
-          || (lsb >= 0xa3 && lsb <= 0xa5)
-          || (lsb >= 0xc4 && lsb <= 0xc6)
-          || (lsb >= 0xe4 && lsb <= 0xe9)
+      codepoint_t t = (
+        i + 1 < units ? (u[2 * i + 2] << 8) | u[2 * i + 3] : 0
       );
-      if (rv) {
-        return TRUE;
-      }
-      switch (lsb) {
-        case 0x0a: case 0x0c: case 0x0d:
-        case 0xa0: case 0xa1: case 0xa7:
-        case 0xbf: case 0xc9: case 0xd1:
-        case 0xd6: case 0xd8: case 0xdc:
-        case 0xdf: case 0xe0: case 0xec:
-        case 0xf1: case 0xf2: case 0xf6:
-        case 0xf8: case 0xf9: case 0xfc:
-          return TRUE;
-        default:
-          return FALSE;
+
+      if (c < utf16_surrogate_middle &&
+          t >= utf16_surrogate_middle && t <= utf16_surrogate_last) {
+
+        /* Valid surrogate pair */
+        c = 0x10000 + ((c - utf16_surrogate_first) << 10)
+          + (t - utf16_surrogate_middle);
+        i++;
+
+      } else {
+        /* Unmatched or unexpected surrogate */
+        c = 0xfffd;
       }
     }
-    case 0x03: {
-      switch (lsb) {
-        case 0x93: case 0x94:
-        case 0x98: case 0x9b:
-        case 0x9e: case 0xa0:
-        case 0xa3: case 0xa6:
-        case 0xa8: case 0xa9:
-          return TRUE;
+
+    p = utf8_write_codepoint(p, c);
+  }
+
+  *p = '\0';
+  return (p - out);
+}
+
+/**
+ * @name utf16be_json_utf8_length:
+ *   Return the exact number of bytes that `utf16be_write_json_utf8`
+ *   would write for the first `units` code units of `s`, not
+ *   including the null terminator.
+ */
+static size_t utf16be_json_utf8_length(const char *s, size_t units) {
+
+  size_t rv = 0;
+  const uint8_t *u = (const uint8_t *) s;
+
+  for (size_t i = 0; i < units; ++i) {
+
+    codepoint_t c = (u[2 * i] << 8) | u[2 * i + 1];
+
+    if (c < 0x80) {
+      switch (c) {
+        case '\r': case '\n': case '\f': case '\b': case '\t':
+        case '\\': case '"':
+          rv += 2; break;
         default:
-          return FALSE;
+          rv += (c < 0x20 ? 6 : 1); break;
+      }
+    } else if (c < 0x800) {
+      rv += 2;
+    } else if (c < utf16_surrogate_first || c > utf16_surrogate_last) {
+      rv += 3;
+    } else {
+
+      codepoint_t t = (
+        i + 1 < units ? (u[2 * i + 2] << 8) | u[2 * i + 3] : 0
+      );
+
+      if (c < utf16_surrogate_middle &&
+          t >= utf16_surrogate_middle && t <= utf16_surrogate_last) {
+        rv += 4; i++;
+      } else {
+        /* U+FFFD */
+        rv += 3;
       }
     }
-    case 0x20: {
-      return (lsb == 0xac);
-    }
-    default:
-      break;
   }
 
-  return FALSE;
+  return rv;
 }
 
 /**
- * @name utf16be_is_gsm_string:
- *   Return true if the UCS-16-BE string `s` can be represented in
- *   the GSM default alphabet. The input string should be terminated
- *   by the UTF-16-BE null character (i.e. two null bytes).
+ * @name utf16be_encode_json_utf8:
+ *   Copy and transform the string `s` to a newly-allocated
+ *   buffer, making it suitable for output as a single utf-8
+ *   JSON string. The caller must free the returned string.
  */
-boolean_t utf16be_is_gsm_string(const char *s) {
+char *utf16be_encode_json_utf8(const char *s) {
 
-  string_info_t si;
-  utf16be_string_info(s, &si);
+  return utf16be_encode_json_utf8_slice(utf16be_slice(s));
+}
 
-  for (size_t i = 0; i < si.units; ++i) {
-    if (!utf16be_is_gsm_codepoint(s[2 * i], s[2 * i + 1])) {
-      return FALSE;
-    }
-  }
+/**
+ * @name utf16be_encode_json_utf8_slice:
+ *   Identical to `utf16be_encode_json_utf8`, but transforms only the
+ *   big-endian UTF-16 slice `s`, which need not be null terminated.
+ *   The length of the input is taken from `s` rather than measured.
+ */
+char *utf16be_encode_json_utf8_slice(string_slice_t s) {
 
-  return TRUE;
+  size_t units = s.length / 2;
+
+  /* Exact UTF-8 allocation:
+   *  The worst case is six bytes for each code unit (a control
+   *  character escaped as `\u00XX`), but typical text needs little
+   *  more than one; measure first, so memory tracks the output. */
+
+  char *rv = allocate(utf16be_json_utf8_length(s.data, units) + 1);
+  utf16be_write_json_utf8(s.data, units, rv);
+
+  return rv;
 }
 
 /**
- * @name utf8_string_info:
+ * @name utf16be_encode_json_utf8_into:
+ *   Identical to `utf16be_encode_json_utf8`, but writes the result
+ *   to the caller-supplied buffer `out`, of `size` bytes, instead of
+ *   allocating. Returns the number of bytes required, including the
+ *   null terminator; if this is larger than `size`, nothing is written
+ *   and the caller may retry with a buffer of the returned size.
  */
-boolean_t utf8_string_info(const char *str, string_info_t *i) {
+size_t utf16be_encode_json_utf8_into(const char *s,
+                                     char *out, size_t size) {
 
-  const char *p = str;
+  return utf16be_encode_json_utf8_slice_into(utf16be_slice(s), out, size);
+}
 
-  i->units = 0;
-  i->bytes = 0;
-  i->symbols = 0;
-  i->error_offset = 0;
-  i->invalid_bytes = 0;
-  i->error = D_ERR_NONE;
+/**
+ * @name utf16be_encode_json_utf8_slice_into:
+ *   Identical to `utf16be_encode_json_utf8_into`, but for the
+ *   big-endian UTF-16 slice `s`.
+ */
+size_t utf16be_encode_json_utf8_slice_into(string_slice_t s,
+                                           char *out, size_t size) {
+  size_t units = s.length / 2;
 
-  while (*p++) {
+  /* Only measure if the worst case might not fit */
+  if (6 * units + 1 > size) {
 
-    if ((*p & 0xc0) != 0x80) {
-      i->symbols++;
-      i->units++;
-    }
+    size_t required = utf16be_json_utf8_length(s.data, units) + 1;
 
-    i->bytes++;
+    if (required > size) {
+      return required;
+    }
   }
 
-  return TRUE;
+  return utf16be_write_json_utf8(s.data, units, out) + 1;
 }
 
 /**
- * @name convert_utf8_utf16be:
+ * @name gsm_alphabet:
+ *   X-macro covering every character that can be represented
+ *   using the GSM default alphabet, including those that must be
+ *   escaped to the extension table. See `gsm.h` for details.
  */
-char *convert_utf8_utf16be(char *s, boolean_t reverse) {
+#define gsm_alphabet(X, a) \
+  GSM0338_DEFAULT_ALPHABET(X, a) GSM0338_EXTENSION_TABLE(X, a)
 
-  char *rv = NULL;
-  char *t1 = "UTF-16BE", *t2 = "UTF-8";
+/**
+ * @name gsm_cost_default, gsm_cost_extension:
+ *   X-macro helpers: contribute the two-bit septet cost of
+ *   `codepoint` to 64-bit cost map word number `w`, counting words
+ *   from the start of the BMP. Characters in the default alphabet
+ *   cost one septet; extension table characters cost two, since
+ *   they must be preceded by an escape septet.
+ */
+#define gsm_cost_bits(codepoint, w, cost) \
+  | ((((codepoint) >> 5) == (w)) ? \
+    ((uint64_t) (cost) << (2 * ((codepoint) & 0x1f))) : 0)
 
-  iconv_t iv = iconv_open(
-    (reverse ? t2 : t1), (reverse ? t1 : t2)
-  );
+#define gsm_cost_default(septet, codepoint, w) \
+  gsm_cost_bits(codepoint, w, 1)
 
-  if (iv == (iconv_t) -1) {
-    goto exit;
-  }
+#define gsm_cost_extension(septet, codepoint, w) \
+  gsm_cost_bits(codepoint, w, 2)
 
-  string_info_t si;
+/**
+ * @name gsm_cost_page:
+ *   Expands to an initializer for one 256-codepoint page of the
+ *   cost map, built from both of the GSM 03.38 tables in `gsm.h`.
+ */
+#define gsm_cost_word(page, i) \
+  (0 GSM0338_DEFAULT_ALPHABET(gsm_cost_default, ((page) << 3) + (i)) \
+    GSM0338_EXTENSION_TABLE(gsm_cost_extension, ((page) << 3) + (i)))
+
+#define gsm_cost_page(page) { \
+  gsm_cost_word(page, 0), gsm_cost_word(page, 1), \
+  gsm_cost_word(page, 2), gsm_cost_word(page, 3), \
+  gsm_cost_word(page, 4), gsm_cost_word(page, 5), \
+  gsm_cost_word(page, 6), gsm_cost_word(page, 7) \
+}
 
-  if (reverse) {
-    utf16be_string_info(s, &si);
-  } else {
-    utf8_string_info(s, &si);
-  }
+#define gsm_cost_index_entry(index, page, a) \
+  [(page)] = (index),
 
-  /* Allocate and check overflow:
-   *   Worst case for UTF-8 and UTF-16 is four bytes per character.
-   *   For UTF-16, this is every character being represented by two
-   *   16-bit surrogate pairs; for UTF-8, the worst case is clamped
-   *   at four bytes by RFC 3629 (though it technically could be six). */
+#define gsm_cost_page_entry(index, page, a) \
+  [(index)] = gsm_cost_page(page),
 
-  char *target = allocate_array(4, si.units, 1);
-  size_t target_size = (4 * si.units);
+/**
+ * @name gsm_pages_check:
+ *   Compile-time check: every character in `gsm_alphabet` must lie
+ *   in one of the pages listed in `GSM0338_PAGES`. Otherwise, the
+ *   cost map below would silently omit it.
+ */
+#define gsm_page_matches(index, page, codepoint) \
+  || (((codepoint) >> 8) == (page))
 
-  /* Perform conversion */
-  char *fp = s, *tp = target;
-  size_t in = si.bytes, out = target_size;
-  size_t lost = iconv(iv, &fp, &in, &tp, &out);
+#define gsm_page_unlisted(septet, codepoint, a) \
+  + !(0 GSM0338_PAGES(gsm_page_matches, codepoint))
 
-  if (lost == -1) {
-    free(target);
-    goto cleanup_iconv;
-  }
+typedef char gsm_pages_check[
+  (0 gsm_alphabet(gsm_page_unlisted, 0)) == 0 ? 1 : -1
+];
 
-  /* Null-terminate string */
-  *tp = '\0';
+/**
+ * @name gsm_cost_index:
+ *   First level of the GSM septet cost map: maps the most-significant
+ *   byte of a BMP codepoint to a page in `gsm_cost_map`. Page zero is
+ *   empty, and is shared by every unlisted part of the BMP.
+ */
+static const uint8_t gsm_cost_index[256] = {
+  GSM0338_PAGES(gsm_cost_index_entry, 0)
+};
 
-  if (!reverse) {
-    *++tp = '\0';
-  }
+/**
+ * @name gsm_cost_map:
+ *   Second level of the GSM septet cost map: two bits for each of the
+ *   256 codepoints in a page. A cost of zero means that the codepoint
+ *   cannot be represented in the GSM default alphabet at all.
+ */
+static const uint64_t gsm_cost_map[gsm0338_page_count][8] = {
+  [0] = { 0 },
+  GSM0338_PAGES(gsm_cost_page_entry, 0)
+};
 
-  /* Success */
-  rv = target;
+/**
+ * @name gsm_septet_cost:
+ *   Return the number of septets required to represent the BMP
+ *   codepoint (`msb`, `lsb`) in GSM 7-bit encoding, or zero if
+ *   the codepoint can't be represented at all.
+ */
+static inline unsigned int gsm_septet_cost(uint8_t msb, uint8_t lsb) {
 
-  cleanup_iconv:
-    iconv_close(iv);
+  const uint64_t *page = gsm_cost_map[gsm_cost_index[msb]];
+  return ((page[lsb >> 5] >> (2 * (lsb & 0x1f))) & 3);
+}
 
-  exit:
-    return rv;
+/**
+ * @name gsm_ascii_septet_cost:
+ *   Equivalent to `gsm_septet_cost`, for the ASCII character `b`.
+ */
+static inline unsigned int gsm_ascii_septet_cost(uint8_t b) {
+
+  return gsm_septet_cost(0, b);
+}
+
+/**
+ * @name utf16be_is_gsm_codepoint:
+ *   Given the most-significant byte `msb` and the least-significant
+ *   byte `lsb` of a UCS-16-BE character, return TRUE if the character
+ *   can be represented in the default GSM alphabet (described in GSM
+ *   03.38). This is a two-level table lookup; the table is built at
+ *   compile time from the GSM 03.38 mapping tables in `gsm.h`.
+ */
+boolean_t utf16be_is_gsm_codepoint(uint8_t msb, uint8_t lsb) {
+
+  return (gsm_septet_cost(msb, lsb) != 0);
+}
+
+/**
+ * @name utf16be_find_non_gsm_range:
+ *   Implementation of `utf16be_find_non_gsm` and its slice variant.
+ *   No bytes at or beyond `end` are examined; a null code unit
+ *   before `end` also ends the string.
+ */
+static ssize_t utf16be_find_non_gsm_range(const char *s, const char *end) {
+
+  const char *p = s;
+
+  for (;;) {
+
+    /* Fast path:
+     *   Printable ASCII characters are in the GSM default alphabet,
+     *   with the sole exception of the grave accent (U+0060). */
+
+    p += 2 * utf16be_span(p, end, 0x20, 0x7e, 0x60);
+
+    if (p + 2 > end || (p[0] == '\0' && p[1] == '\0')) {
+      return -1;
+    }
+
+    if (!gsm_septet_cost(p[0], p[1])) {
+      return (p - s);
+    }
+
+    p += 2;
+  }
+}
+
+/**
+ * @name utf16be_find_non_gsm:
+ *   Return the byte offset of the first code unit in the big-endian
+ *   UTF-16 string `s` that cannot be represented in the GSM default
+ *   alphabet, or -1 if the entire string can be represented. The
+ *   input string should be terminated by two null bytes.
+ */
+ssize_t utf16be_find_non_gsm(const char *s) {
+
+  return utf16be_find_non_gsm_range(s, s + 2 * utf16be_length(s));
+}
+
+/**
+ * @name utf16be_find_non_gsm_slice:
+ *   Identical to `utf16be_find_non_gsm`, but for the UTF-16 slice `s`.
+ */
+ssize_t utf16be_find_non_gsm_slice(string_slice_t s) {
+
+  return utf16be_find_non_gsm_range(s.data, s.data + s.length);
+}
+
+/**
+ * @name utf16be_is_gsm_string:
+ *   Return true if the UCS-16-BE string `s` can be represented in
+ *   the GSM default alphabet. The input string should be terminated
+ *   by the UTF-16-BE null character (i.e. two null bytes).
+ */
+boolean_t utf16be_is_gsm_string(const char *s) {
+
+  return (utf16be_find_non_gsm(s) < 0);
+}
+
+/**
+ * @name segment_counter_add:
+ *   Account for one character of `cost` septets or code units in a
+ *   multipart message where each part holds at most `capacity`; `used`
+ *   tracks the current part. Characters never span two parts.
+ */
+static inline void segment_counter_add(size_t *used, unsigned int *parts,
+                                       size_t capacity, unsigned int cost) {
+  if (*used + cost > capacity) {
+    (*parts)++;
+    *used = 0;
+  }
+
+  *used += cost;
+}
+
+/**
+ * @name segment_counter_add_run:
+ *   Account for `count` consecutive characters of one septet or code
+ *   unit each; this is equivalent to calling `segment_counter_add`
+ *   `count` times with a `cost` of one, but takes constant time.
+ */
+static inline void segment_counter_add_run(size_t *used, unsigned int *parts,
+                                           size_t capacity, size_t count) {
+  if (*used + count <= capacity) {
+    *used += count;
+    return;
+  }
+
+  count -= (capacity - *used);
+  *parts += (count + capacity - 1) / capacity;
+  *used = ((count - 1) % capacity) + 1;
+}
+
+/**
+ * @name utf16be_segment_info:
+ *   Calculate the exact length of the big-endian UTF-16 string `s`
+ *   when encoded using the GSM 7-bit default alphabet (in septets,
+ *   counting extension table characters twice) and when encoded as
+ *   UCS-2/UTF-16 (in code units), along with the number of message
+ *   parts required for each. If `s` can't be represented in the GSM
+ *   alphabet, `septets` and `gsm_parts` are zero, and the byte offset
+ *   of the first problematic character is stored in `non_gsm_offset`.
+ *   Returns true if the string can be sent using the GSM alphabet.
+ */
+boolean_t utf16be_segment_info(const char *s, sms_segment_info_t *i) {
+
+  const uint8_t *p = (const uint8_t *) s;
+
+  size_t gsm_used = 0, ucs2_used = 0;
+  unsigned int gsm_parts = 1, ucs2_parts = 1;
+
+  i->units = 0;
+  i->septets = 0;
+  i->non_gsm_offset = -1;
+
+  for (;;) {
+
+    uint8_t msb = p[0], lsb = p[1];
+    unsigned int units = 1;
+
+    if (msb == 0 && lsb == 0) {
+      break;
+    }
+
+    /* Keep surrogate pairs together */
+    if (msb >= 0xd8 && msb <= 0xdb && p[2] >= 0xdc && p[2] <= 0xdf) {
+      units = 2;
+    }
+
+    if (i->non_gsm_offset < 0) {
+
+      unsigned int cost = gsm_septet_cost(msb, lsb);
+
+      if (cost) {
+        i->septets += cost;
+        segment_counter_add(
+          &gsm_used, &gsm_parts, sms_gsm_multipart_septets, cost
+        );
+      } else {
+        i->non_gsm_offset = ((const char *) p - s);
+      }
+    }
+
+    i->units += units;
+
+    segment_counter_add(
+      &ucs2_used, &ucs2_parts, sms_ucs2_multipart_units, units
+    );
+
+    p += 2 * units;
+  }
+
+  i->ucs2_parts = (
+    i->units <= sms_ucs2_single_units ? 1 : ucs2_parts
+  );
+
+  if (i->non_gsm_offset >= 0) {
+    i->septets = 0;
+    i->gsm_parts = 0;
+    return FALSE;
+  }
+
+  i->gsm_parts = (
+    i->septets <= sms_gsm_single_septets ? 1 : gsm_parts
+  );
+
+  return TRUE;
+}
+
+/** --- **/
+
+/**
+ * @name gsm_language_table_t:
+ *   One entry of `GSM0338_LANGUAGES`, expanded in to arrays indexed
+ *   by septet. A zero codepoint marks a septet with no character.
+ */
+typedef struct gsm_language_table {
+
+  uint8_t identifier;
+  const char *name;
+
+  boolean_t has_locking;
+  uint16_t locking[128];
+  uint16_t single[128];
+
+} gsm_language_table_t;
+
+#define gsm_table_entry(septet, codepoint, a) \
+  [(septet)] = (codepoint),
+
+#define gsm_table_count(septet, codepoint, a) \
+  + 1
+
+#define gsm_language_entry(index, identifier, name, locking, single, a) \
+  [(index)] = { \
+    (identifier), #name, (0 locking(gsm_table_count, 0)) > 0, \
+    { locking(gsm_table_entry, 0) }, { single(gsm_table_entry, 0) } \
+  },
+
+/**
+ * @name gsm_languages:
+ *   Every table set in `GSM0338_LANGUAGES`, built at compile time.
+ */
+static const gsm_language_table_t gsm_languages[] = {
+  GSM0338_LANGUAGES(gsm_language_entry, 0)
+};
+
+typedef char gsm_language_count_check[
+  (sizeof(gsm_languages) / sizeof(*gsm_languages)
+    == gsm0338_language_count) ? 1 : -1
+];
+
+/**
+ * @name gsm_national_entry_t:
+ *   Reverse mapping for a single codepoint: the septet that encodes
+ *   it in each language's locking and single shift tables, or 0xff
+ *   if the codepoint is absent from that table.
+ */
+typedef struct gsm_national_entry {
+
+  uint16_t codepoint;
+  uint8_t locking[gsm0338_language_count];
+  uint8_t single[gsm0338_language_count];
+
+} gsm_national_entry_t;
+
+/**
+ * @name gsm_national_index_maximum:
+ *   An upper bound on the number of distinct codepoints in all
+ *   of the tables in `GSM0338_LANGUAGES`.
+ */
+#define gsm_national_index_maximum  (gsm0338_language_count * 256)
+
+static gsm_national_entry_t gsm_national_index[gsm_national_index_maximum];
+static size_t gsm_national_index_size = 0;
+static pthread_once_t gsm_national_index_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @name gsm_national_ascii:
+ *   The entry in `gsm_national_index` for each ASCII codepoint, or
+ *   NULL if there is none. This lets the most common characters skip
+ *   the binary search in `gsm_national_lookup`.
+ */
+static const gsm_national_entry_t *gsm_national_ascii[0x80];
+
+/**
+ * @name gsm_national_entry_compare:
+ */
+static int gsm_national_entry_compare(const void *x, const void *y) {
+
+  const gsm_national_entry_t *a = (const gsm_national_entry_t *) x;
+  const gsm_national_entry_t *b = (const gsm_national_entry_t *) y;
+
+  return ((int) a->codepoint - (int) b->codepoint);
+}
+
+/**
+ * @name gsm_national_index_add:
+ *   Record that `codepoint` is encoded as `septet` in the locking
+ *   (or, if `is_single` is true, single shift) table of `language`.
+ *   Used only while building the index, before it is sorted.
+ */
+static void gsm_national_index_add(uint16_t codepoint, unsigned int language,
+                                   uint8_t septet, boolean_t is_single) {
+  gsm_national_entry_t *e = NULL;
+
+  for (size_t i = 0; i < gsm_national_index_size; ++i) {
+    if (gsm_national_index[i].codepoint == codepoint) {
+      e = &gsm_national_index[i];
+      break;
+    }
+  }
+
+  if (!e) {
+    e = &gsm_national_index[gsm_national_index_size++];
+    e->codepoint = codepoint;
+    memset(e->locking, 0xff, sizeof(e->locking));
+    memset(e->single, 0xff, sizeof(e->single));
+  }
+
+  /* Some tables list a character twice; the first septet wins */
+  uint8_t *p = (is_single ? &e->single[language] : &e->locking[language]);
+
+  if (*p == 0xff) {
+    *p = septet;
+  }
+}
+
+/**
+ * @name gsm_national_index_build:
+ *   Build the sorted reverse mapping in `gsm_national_index` from
+ *   `gsm_languages`. This runs once, via `pthread_once`.
+ */
+static void gsm_national_index_build(void) {
+
+  for (unsigned int l = 0; l < gsm0338_language_count; ++l) {
+
+    const gsm_language_table_t *t = &gsm_languages[l];
+
+    for (unsigned int i = 0; i < 128; ++i) {
+
+      /* Septet 0x1b is always the escape */
+      if (i == 0x1b) {
+        continue;
+      }
+
+      if (t->locking[i]) {
+        gsm_national_index_add(t->locking[i], l, i, FALSE);
+      }
+
+      if (t->single[i]) {
+        gsm_national_index_add(t->single[i], l, i, TRUE);
+      }
+    }
+  }
+
+  qsort(
+    gsm_national_index, gsm_national_index_size,
+      sizeof(*gsm_national_index), gsm_national_entry_compare
+  );
+
+  for (size_t i = 0; i < gsm_national_index_size; ++i) {
+    if (gsm_national_index[i].codepoint < 0x80) {
+      gsm_national_ascii[gsm_national_index[i].codepoint] =
+        &gsm_national_index[i];
+    }
+  }
+}
+
+/**
+ * @name gsm_national_lookup:
+ *   Return the reverse mapping for the BMP codepoint `c`, or
+ *   NULL if no table in `GSM0338_LANGUAGES` contains it.
+ */
+static const gsm_national_entry_t *gsm_national_lookup(codepoint_t c) {
+
+  gsm_national_entry_t key;
+
+  if (c > 0xffff) {
+    return NULL;
+  }
+
+  key.codepoint = (uint16_t) c;
+
+  return (const gsm_national_entry_t *) bsearch(
+    &key, gsm_national_index, gsm_national_index_size,
+      sizeof(*gsm_national_index), gsm_national_entry_compare
+  );
+}
+
+/**
+ * @name sms_gsm_septet_capacity:
+ *   Return the number of septets available in each part of a GSM
+ *   7-bit message whose user data header carries `shift_elements`
+ *   national language shift information elements, along with a
+ *   concatenation information element if `is_multipart` is true.
+ */
+size_t sms_gsm_septet_capacity(unsigned int shift_elements,
+                               boolean_t is_multipart) {
+
+  size_t udh = (
+    shift_elements * sms_udh_shift_octets
+      + (is_multipart ? sms_udh_concat_octets : 0)
+  );
+
+  /* One more octet for the header length, if there's a header */
+  if (udh > 0) {
+    udh++;
+  }
+
+  return ((sms_user_data_octets - udh) * 8) / 7;
+}
+
+/**
+ * @name gsm_national_shift_elements:
+ */
+unsigned int gsm_national_shift_elements(const gsm_national_info_t *i) {
+
+  return (i->locking != 0) + (i->single != 0);
+}
+
+/**
+ * @name gsm_language_name:
+ */
+const char *gsm_language_name(unsigned int language) {
+
+  if (language >= gsm0338_language_count) {
+    return NULL;
+  }
+
+  return gsm_languages[language].name;
+}
+
+/**
+ * @name gsm_language_identifier:
+ */
+uint8_t gsm_language_identifier(unsigned int language) {
+
+  return gsm_languages[language % gsm0338_language_count].identifier;
+}
+
+/**
+ * @name gsm_default_codepoint:
+ */
+codepoint_t gsm_default_codepoint(uint8_t septet) {
+
+  return gsm_languages[0].locking[septet & 0x7f];
+}
+
+/**
+ * @name gsm_language_index:
+ */
+int gsm_language_index(uint8_t identifier) {
+
+  for (unsigned int l = 0; l < gsm0338_language_count; ++l) {
+    if (gsm_languages[l].identifier == identifier) {
+      return (int) l;
+    }
+  }
+
+  return -1;
+}
+
+/**
+ * @name gsm_decode_utf16be:
+ */
+size_t gsm_decode_utf16be(const uint8_t *septets, size_t count,
+                          unsigned int locking, unsigned int single,
+                          char *out) {
+  size_t rv = 0;
+  uint8_t *q = (uint8_t *) out;
+
+  const gsm_language_table_t *l =
+    &gsm_languages[locking % gsm0338_language_count];
+
+  const gsm_language_table_t *s =
+    &gsm_languages[single % gsm0338_language_count];
+
+  /* Languages without a locking shift table use the default alphabet */
+  if (!l->has_locking) {
+    l = &gsm_languages[0];
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+
+    uint8_t septet = septets[i] & 0x7f;
+    codepoint_t c = l->locking[septet];
+
+    if (septet == 0x1b && i + 1 < count) {
+
+      /* Escape: an unassigned single shift character is
+          displayed using the locking shift table instead. */
+
+      septet = septets[++i] & 0x7f;
+      c = (s->single[septet] ? s->single[septet] : l->locking[septet]);
+
+    } else if (septet == 0x1b) {
+
+      /* Trailing escape, with nothing to escape */
+      c = 0x20;
+    }
+
+    q[2 * rv] = (uint8_t) (c >> 8);
+    q[2 * rv + 1] = (uint8_t) (c & 0xff);
+    rv++;
+  }
+
+  q[2 * rv] = q[2 * rv + 1] = 0;
+  return rv;
+}
+
+/**
+ * @name gsm_stand_in_utf16be:
+ */
+size_t gsm_stand_in_utf16be(const uint8_t *septets, size_t count,
+                            char *out) {
+
+  uint8_t *q = (uint8_t *) out;
+
+  for (size_t i = 0; i < count; ++i) {
+
+    codepoint_t c = gsm_default_codepoint(septets[i]);
+
+    q[2 * i] = (uint8_t) (c >> 8);
+    q[2 * i + 1] = (uint8_t) (c & 0xff);
+  }
+
+  q[2 * count] = q[2 * count + 1] = 0;
+  return count;
+}
+
+/**
+ * @name gsm_national_candidate_t:
+ *   Running totals for one combination of locking and single
+ *   shift tables, used by `utf16be_national_info`.
+ */
+typedef struct gsm_national_candidate {
+
+  boolean_t is_possible;
+
+  size_t used;
+  size_t septets;
+  size_t capacity;
+  unsigned int parts;
+
+} gsm_national_candidate_t;
+
+/**
+ * @name gsm_national_info_is_better:
+ *   Return true if the table combination `a` should be preferred
+ *   to `b`: it needs fewer parts or, failing that, fewer shift
+ *   information elements. Failing that, a single shift is preferred
+ *   to a locking shift, since a handset that ignores the single shift
+ *   element misreads only the characters that were escaped. Finally,
+ *   the combination with fewer septets is preferred.
+ */
+static boolean_t gsm_national_info_is_better(const gsm_national_info_t *a,
+                                             const gsm_national_info_t *b) {
+  unsigned int ea = gsm_national_shift_elements(a);
+  unsigned int eb = gsm_national_shift_elements(b);
+
+  if (a->parts != b->parts) {
+    return (a->parts < b->parts);
+  }
+
+  if (ea != eb) {
+    return (ea < eb);
+  }
+
+  if ((a->locking == 0) != (b->locking == 0)) {
+    return (a->locking == 0);
+  }
+
+  return (a->septets < b->septets);
+}
+
+/**
+ * @name utf16be_national_info:
+ *   Find the combination of national language locking and single
+ *   shift tables that represents the big-endian UTF-16 string `s` in
+ *   the fewest message parts, counting the space taken by the user
+ *   data header. Ties go to the combination with the fewest shift
+ *   information elements, then to a single shift over a locking shift,
+ *   then to the fewest septets. Returns false if no combination can
+ *   represent every character of `s`.
+ */
+boolean_t utf16be_national_info(const char *s, gsm_national_info_t *i) {
+
+  gsm_national_candidate_t
+    candidates[gsm0338_language_count][gsm0338_language_count];
+
+  const uint8_t *p = (const uint8_t *) s;
+  unsigned int remaining = 0;
+
+  pthread_once(&gsm_national_index_once, gsm_national_index_build);
+
+  for (unsigned int l = 0; l < gsm0338_language_count; ++l) {
+    for (unsigned int m = 0; m < gsm0338_language_count; ++m) {
+
+      gsm_national_candidate_t *c = &candidates[l][m];
+      gsm_national_info_t tables = { l, m, 0, 0 };
+
+      c->is_possible = gsm_languages[l].has_locking;
+      c->capacity = sms_gsm_septet_capacity(
+        gsm_national_shift_elements(&tables), TRUE
+      );
+
+      c->used = c->septets = 0;
+      c->parts = 1;
+
+      remaining += c->is_possible;
+    }
+  }
+
+  /* For each character... */
+  while (remaining > 0 && (p[0] || p[1])) {
+
+    size_t units;
+    codepoint_t cp = utf16be_decode_codepoint((const char *) p, &units);
+    const gsm_national_entry_t *e = gsm_national_lookup(cp);
+
+    p += 2 * units;
+
+    for (unsigned int l = 0; l < gsm0338_language_count; ++l) {
+      for (unsigned int m = 0; m < gsm0338_language_count; ++m) {
+
+        unsigned int cost = 0;
+        gsm_national_candidate_t *c = &candidates[l][m];
+
+        if (!c->is_possible) {
+          continue;
+        }
+
+        if (e && e->locking[l] != 0xff) {
+          cost = 1;
+        } else if (e && e->single[m] != 0xff) {
+          cost = 2;
+        } else {
+          c->is_possible = FALSE;
+          remaining--;
+          continue;
+        }
+
+        c->septets += cost;
+        segment_counter_add(&c->used, &c->parts, c->capacity, cost);
+      }
+    }
+  }
+
+  /* Choose the best remaining combination */
+  boolean_t rv = FALSE;
+
+  for (unsigned int l = 0; l < gsm0338_language_count; ++l) {
+    for (unsigned int m = 0; m < gsm0338_language_count; ++m) {
+
+      gsm_national_candidate_t *c = &candidates[l][m];
+      gsm_national_info_t n = { l, m, c->septets, c->parts };
+
+      if (!c->is_possible) {
+        continue;
+      }
+
+      size_t single_capacity = sms_gsm_septet_capacity(
+        gsm_national_shift_elements(&n), FALSE
+      );
+
+      if (n.septets <= single_capacity) {
+        n.parts = 1;
+      }
+
+      if (rv && !gsm_national_info_is_better(&n, i)) {
+        continue;
+      }
+
+      *i = n;
+      rv = TRUE;
+    }
+  }
+
+  return rv;
+}
+
+/**
+ * @name utf16be_encode_gsm_part:
+ *   Encode characters from the big-endian UTF-16 string `*s` as
+ *   unpacked septets in to `septets`, using the tables selected in
+ *   `i`, until the string ends or the next character would exceed
+ *   `capacity` septets. Characters from a single shift table are
+ *   written as an escape septet followed by the character's septet,
+ *   and are never split. Advances `*s` past the characters encoded,
+ *   and returns the number of septets written. Every character of
+ *   `*s` must be representable using the tables in `i`.
+ */
+size_t utf16be_encode_gsm_part(const char **s, const gsm_national_info_t *i,
+                               size_t capacity, uint8_t *septets) {
+  size_t rv = 0;
+  const char *p = *s;
+
+  pthread_once(&gsm_national_index_once, gsm_national_index_build);
+
+  while (p[0] || p[1]) {
+
+    size_t units;
+    codepoint_t cp = utf16be_decode_codepoint(p, &units);
+
+    const gsm_national_entry_t *e = (
+      cp < 0x80 ? gsm_national_ascii[cp] : gsm_national_lookup(cp)
+    );
+
+    if (e && e->locking[i->locking] != 0xff) {
+
+      if (rv + 1 > capacity) {
+        break;
+      }
+
+      septets[rv++] = e->locking[i->locking];
+
+    } else if (e && e->single[i->single] != 0xff) {
+
+      if (rv + 2 > capacity) {
+        break;
+      }
+
+      septets[rv++] = 0x1b;
+      septets[rv++] = e->single[i->single];
+
+    } else {
+
+      /* Not representable; caller error */
+      break;
+    }
+
+    p += 2 * units;
+  }
+
+  *s = p;
+  return rv;
+}
+
+/** --- **/
+
+/**
+ * @name unicode_composition_t:
+ */
+typedef struct unicode_composition {
+
+  uint16_t first;
+  uint16_t second;
+  uint16_t composite;
+
+} unicode_composition_t;
+
+/**
+ * @name unicode_combining_class_t:
+ */
+typedef struct unicode_combining_class {
+
+  uint16_t first;
+  uint16_t last;
+  uint8_t combining_class;
+
+} unicode_combining_class_t;
+
+#define unicode_composition_entry(first, second, composite, a) \
+  { (first), (second), (composite) },
+
+#define unicode_combining_class_entry(first, last, class, a) \
+  { (first), (last), (class) },
+
+/**
+ * @name unicode_compositions:
+ *   Every canonical composition pair in `nfc.h`, sorted.
+ */
+static const unicode_composition_t unicode_compositions[] = {
+  UNICODE_COMPOSITIONS(unicode_composition_entry, 0)
+};
+
+/**
+ * @name unicode_combining_classes:
+ *   Every range of non-zero canonical combining class in `nfc.h`.
+ */
+static const unicode_combining_class_t unicode_combining_classes[] = {
+  UNICODE_COMBINING_CLASSES(unicode_combining_class_entry, 0)
+};
+
+/**
+ * @name hangul_*:
+ *   Constants for the algorithmic composition of Hangul syllables.
+ */
+#define hangul_s_base   (0xac00)
+#define hangul_l_base   (0x1100)
+#define hangul_v_base   (0x1161)
+#define hangul_t_base   (0x11a7)
+#define hangul_l_count  (19)
+#define hangul_v_count  (21)
+#define hangul_t_count  (28)
+#define hangul_s_count  (hangul_l_count * hangul_v_count * hangul_t_count)
+
+/**
+ * @name unicode_combining_class:
+ *   Return the canonical combining class of the codepoint `c`.
+ *   Characters outside of the BMP are treated as starters, which
+ *   can only prevent a composition, never cause an incorrect one.
+ */
+static uint8_t unicode_combining_class(codepoint_t c) {
+
+  size_t lo = 0;
+  size_t hi = unicode_combining_class_count;
+
+  while (lo < hi) {
+
+    size_t mid = lo + (hi - lo) / 2;
+    const unicode_combining_class_t *r = &unicode_combining_classes[mid];
+
+    if (c < r->first) {
+      hi = mid;
+    } else if (c > r->last) {
+      lo = mid + 1;
+    } else {
+      return r->combining_class;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * @name unicode_compose_pair:
+ *   Return the primary composite of the codepoints `first` and
+ *   `second`, or zero if the two characters don't compose.
+ */
+static codepoint_t unicode_compose_pair(codepoint_t first,
+                                        codepoint_t second) {
+
+  /* Hangul leading consonant plus vowel */
+  if (first >= hangul_l_base && first < hangul_l_base + hangul_l_count &&
+      second >= hangul_v_base && second < hangul_v_base + hangul_v_count) {
+
+    return hangul_s_base + hangul_t_count * (
+      (first - hangul_l_base) * hangul_v_count + (second - hangul_v_base)
+    );
+  }
+
+  /* Hangul syllable plus trailing consonant */
+  if (first >= hangul_s_base && first < hangul_s_base + hangul_s_count &&
+      (first - hangul_s_base) % hangul_t_count == 0 &&
+      second > hangul_t_base && second < hangul_t_base + hangul_t_count) {
+
+    return first + (second - hangul_t_base);
+  }
+
+  size_t lo = 0;
+  size_t hi = unicode_composition_count;
+
+  while (lo < hi) {
+
+    size_t mid = lo + (hi - lo) / 2;
+    const unicode_composition_t *e = &unicode_compositions[mid];
+
+    if (first < e->first || (first == e->first && second < e->second)) {
+      hi = mid;
+    } else if (first > e->first || second > e->second) {
+      lo = mid + 1;
+    } else {
+      return e->composite;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * @name utf16be_write_unit:
+ */
+static inline void utf16be_write_unit(uint8_t *p, codepoint_t c) {
+
+  p[0] = (c >> 8);
+  p[1] = (c & 0xff);
+}
+
+/**
+ * @name utf16be_compose:
+ *   Apply Unicode canonical composition to the big-endian UTF-16
+ *   string `s`, in place, replacing each unblocked starter and
+ *   combining character pair with its primary composite (e.g. `e`
+ *   followed by U+0301 becomes U+00E9). The result is canonically
+ *   equivalent to the input, and is never longer. This doesn't
+ *   decompose or reorder the input first, so the result is identical
+ *   to Normalization Form C for decomposed or partially composed
+ *   text, but not for every possible input. Returns the number of
+ *   compositions performed.
+ */
+size_t utf16be_compose(char *s) {
+
+  size_t rv = 0;
+  uint8_t *in = (uint8_t *) s, *out = (uint8_t *) s;
+
+  uint8_t *starter = NULL;
+  codepoint_t starter_codepoint = 0;
+  unsigned int last_class = 256;
+
+  while (in[0] || in[1]) {
+
+    size_t units;
+    codepoint_t c = utf16be_decode_codepoint((const char *) in, &units);
+    unsigned int class = unicode_combining_class(c);
+
+    in += 2 * units;
+
+    /* Compose with the most recent starter, if not blocked */
+    if (starter && (last_class < class || last_class == 0)) {
+
+      codepoint_t composite = unicode_compose_pair(starter_codepoint, c);
+
+      if (composite) {
+        starter_codepoint = composite;
+        utf16be_write_unit(starter, composite);
+        rv++;
+        continue;
+      }
+    }
+
+    if (class == 0) {
+      starter = out;
+      starter_codepoint = c;
+    }
+
+    last_class = class;
+
+    /* Copy; never overtakes the input */
+    if (units == 2) {
+      memmove(out, in - 4, 4);
+      out += 4;
+
+      /* Supplementary starters never compose */
+      starter = NULL;
+    } else {
+      utf16be_write_unit(out, c);
+      out += 2;
+    }
+  }
+
+  out[0] = out[1] = '\0';
+  return rv;
+}
+
+/** --- **/
+
+/**
+ * @name transliteration_table_add_default:
+ */
+#define transliteration_table_add_default(codepoint, replacement, t) \
+  transliteration_table_add((t), (codepoint), (replacement));
+
+/**
+ * @name create_transliteration_table:
+ *   Create a new, empty transliteration table. If `with_defaults` is
+ *   true, the table is populated from `GSM0338_TRANSLITERATIONS`.
+ *   The caller must release the table using
+ *   `release_transliteration_table`.
+ */
+transliteration_table_t *create_transliteration_table(boolean_t with_defaults) {
+
+  transliteration_table_t *rv = allocate(sizeof(*rv));
+
+  rv->count = 0;
+  rv->size = transliteration_table_size_start;
+  rv->entries = allocate_array(sizeof(transliteration_t), rv->size, 0);
+
+  if (with_defaults) {
+    GSM0338_TRANSLITERATIONS(transliteration_table_add_default, rv)
+  }
+
+  return rv;
+}
+
+/**
+ * @name transliteration_table_add:
+ *   Add a mapping from the codepoint `c` to the UTF-8 string
+ *   `replacement` to the table `t`, replacing any existing mapping
+ *   for `c`. Entries are kept sorted by codepoint. Returns false if
+ *   `replacement` is not valid UTF-8, or if `c` is not a valid
+ *   Unicode scalar value.
+ */
+boolean_t transliteration_table_add(transliteration_table_t *t,
+                                    codepoint_t c, const char *replacement) {
+  if (c == 0 || c > 0x10ffff ||
+      (c >= utf16_surrogate_first && c <= utf16_surrogate_last)) {
+    return FALSE;
+  }
+
+  char *r = convert_utf8_utf16be((char *) replacement, FALSE);
+
+  if (!r) {
+    return FALSE;
+  }
+
+  /* Find insertion point */
+  size_t i = 0;
+
+  while (i < t->count && t->entries[i].codepoint < c) {
+    i++;
+  }
+
+  if (i < t->count && t->entries[i].codepoint == c) {
+    free(t->entries[i].replacement);
+  } else {
+
+    if (t->count >= t->size) {
+
+      transliteration_t *e = (transliteration_t *) reallocate_array(
+        t->entries, sizeof(transliteration_t), t->size * 2, 0
+      );
+
+      if (!e) {
+        free(r);
+        return FALSE;
+      }
+
+      t->size *= 2;
+      t->entries = e;
+    }
+
+    memmove(
+      &t->entries[i + 1], &t->entries[i],
+        (t->count - i) * sizeof(transliteration_t)
+    );
+
+    t->count++;
+    t->entries[i].codepoint = c;
+  }
+
+  t->entries[i].replacement = r;
+  t->entries[i].units = utf16be_length(r);
+
+  return TRUE;
+}
+
+/**
+ * @name transliteration_table_lookup:
+ */
+static const transliteration_t *transliteration_table_lookup(
+  const transliteration_table_t *t, codepoint_t c) {
+
+  size_t lo = 0, hi = t->count;
+
+  while (lo < hi) {
+
+    size_t mid = lo + (hi - lo) / 2;
+
+    if (c < t->entries[mid].codepoint) {
+      hi = mid;
+    } else if (c > t->entries[mid].codepoint) {
+      lo = mid + 1;
+    } else {
+      return &t->entries[mid];
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @name release_transliteration_table:
+ */
+void release_transliteration_table(transliteration_table_t *t) {
+
+  for (size_t i = 0; i < t->count; ++i) {
+    free(t->entries[i].replacement);
+  }
+
+  free(t->entries);
+  free(t);
+}
+
+/**
+ * @name utf16be_transliterate:
+ *   Return a newly-allocated copy of the big-endian UTF-16 string
+ *   `s`, with every character that appears in the table `t` replaced
+ *   by its replacement. The number of characters replaced is stored
+ *   in `substitutions`. The caller must free the returned string.
+ */
+char *utf16be_transliterate(const char *s, const transliteration_table_t *t,
+                            size_t *substitutions) {
+  size_t units = 0;
+  const char *p = s;
+
+  *substitutions = 0;
+
+  /* Measure */
+  while (p[0] || p[1]) {
+
+    size_t n;
+    codepoint_t c = utf16be_decode_codepoint(p, &n);
+    const transliteration_t *e = transliteration_table_lookup(t, c);
+
+    units += (e ? e->units : n);
+    p += 2 * n;
+  }
+
+  char *rv = allocate_array(2, units, 1);
+  char *q = rv;
+
+  /* Copy and replace */
+  for (p = s; p[0] || p[1];) {
+
+    size_t n;
+    codepoint_t c = utf16be_decode_codepoint(p, &n);
+    const transliteration_t *e = transliteration_table_lookup(t, c);
+
+    if (e) {
+      memcpy(q, e->replacement, 2 * e->units);
+      q += 2 * e->units;
+      (*substitutions)++;
+    } else {
+      memcpy(q, p, 2 * n);
+      q += 2 * n;
+    }
+
+    p += 2 * n;
+  }
+
+  q[0] = q[1] = '\0';
+  return rv;
+}
+
+/**
+ * @name utf16be_decode_codepoint:
+ *   Decode the character at the start of the big-endian UTF-16
+ *   string `s`. If `units` is non-null, it receives the number of
+ *   code units consumed: two for a valid surrogate pair, otherwise
+ *   one. Unpaired surrogates are returned as-is.
+ */
+codepoint_t utf16be_decode_codepoint(const char *s, size_t *units) {
+
+  const uint8_t *u = (const uint8_t *) s;
+  codepoint_t c = (u[0] << 8) | u[1];
+
+  if (units) {
+    *units = 1;
+  }
+
+  if (c >= utf16_surrogate_first && c < utf16_surrogate_middle) {
+
+    codepoint_t t = (u[2] << 8) | u[3];
+
+    if (t >= utf16_surrogate_middle && t <= utf16_surrogate_last) {
+
+      if (units) {
+        *units = 2;
+      }
+
+      return 0x10000 + ((c - utf16_surrogate_first) << 10)
+        + (t - utf16_surrogate_middle);
+    }
+  }
+
+  return c;
+}
+
+/**
+ * @name utf8_ascii_span_scalar:
+ *   Portable implementation of `utf8_ascii_span`.
+ */
+static size_t utf8_ascii_span_scalar(const uint8_t *p, const uint8_t *end) {
+
+  const uint8_t *q = p;
+
+  while (q < end && *q && *q < 0x80) {
+    q++;
+  }
+
+  return (q - p);
+}
+
+#ifdef ENCODING_X86_SIMD
+
+/**
+ * @name utf8_ascii_span_sse2:
+ *   SSE2 implementation of `utf8_ascii_span`; examines sixteen
+ *   bytes per iteration.
+ */
+__attribute__((target("sse2")))
+static size_t utf8_ascii_span_sse2(const uint8_t *p, const uint8_t *end) {
+
+  const uint8_t *q = p;
+  const __m128i zero = _mm_setzero_si128();
+
+  while (q + 16 <= end) {
+
+    __m128i v = _mm_loadu_si128((const __m128i *) q);
+
+    /* High bit set, or the null terminator */
+    unsigned int stop = (
+      _mm_movemask_epi8(v) | _mm_movemask_epi8(_mm_cmpeq_epi8(v, zero))
+    );
+
+    if (stop) {
+      return (q - p) + __builtin_ctz(stop);
+    }
+
+    q += 16;
+  }
+
+  return (q - p) + utf8_ascii_span_scalar(q, end);
+}
+
+/**
+ * @name utf8_ascii_span_avx2:
+ *   AVX2 implementation of `utf8_ascii_span`; examines thirty-two
+ *   bytes per iteration.
+ */
+__attribute__((target("avx2")))
+static size_t utf8_ascii_span_avx2(const uint8_t *p, const uint8_t *end) {
+
+  const uint8_t *q = p;
+  const __m256i zero = _mm256_setzero_si256();
+
+  while (q + 32 <= end) {
+
+    __m256i v = _mm256_loadu_si256((const __m256i *) q);
+
+    uint32_t stop = (
+      (uint32_t) _mm256_movemask_epi8(v) |
+        (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero))
+    );
+
+    if (stop) {
+      return (q - p) + __builtin_ctz(stop);
+    }
+
+    q += 32;
+  }
+
+  return (q - p) + utf8_ascii_span_sse2(q, end);
+}
+
+#endif /* ENCODING_X86_SIMD */
+
+/**
+ * @name utf8_ascii_span:
+ *   Return the number of leading bytes of the UTF-8 string `p` that
+ *   are non-null ASCII characters. No bytes at or beyond `end` are
+ *   examined; vector loops handle whole blocks only, and the tail is
+ *   finished by scalar code.
+ */
+static size_t utf8_ascii_span(const uint8_t *p, const uint8_t *end) {
+
+  #ifdef ENCODING_X86_SIMD
+    unsigned int features = cpu_features();
+
+    if (features & CPU_AVX2) {
+      return utf8_ascii_span_avx2(p, end);
+    }
+
+    if (features & CPU_SSE2) {
+      return utf8_ascii_span_sse2(p, end);
+    }
+  #endif
+
+  return utf8_ascii_span_scalar(p, end);
+}
+
+/**
+ * @name utf8_inline_ascii_maximum:
+ *   The length of a run of ASCII bytes, in bytes, beyond which the
+ *   UTF-8 routines below switch from inline scalar code to the
+ *   vectorized `utf8_ascii_span`.
+ */
+#define utf8_inline_ascii_maximum (16)
+
+/**
+ * @name utf8_is_continuation:
+ */
+#define utf8_is_continuation(b) (((b) & 0xc0) == 0x80)
+
+/**
+ * @name utf8_decode_sequence:
+ *   Decode and validate the multibyte UTF-8 sequence at `p`, whose
+ *   lead byte is not ASCII, following Table 3-7 of the Unicode
+ *   Standard. On success, stores the decoded codepoint in `c` and
+ *   the sequence length in `length`, and returns D_ERR_NONE. On
+ *   failure, stores the length of the maximal invalid subpart (at
+ *   least one byte) in `length`, and returns the type of error.
+ *   Never reads past a null byte, or at or beyond `end` if non-null.
+ */
+static inline string_decode_error_t utf8_decode_sequence(const uint8_t *p,
+                                                         const uint8_t *end,
+                                                         codepoint_t *c,
+                                                         size_t *length) {
+  uint8_t b = p[0];
+  uint8_t lo = 0x80, hi = 0xbf;
+  string_decode_error_t below = D_ERR_TRUNCATED, above = D_ERR_TRUNCATED;
+
+  size_t n;
+  *length = 1;
+
+  if (b < 0xc0) {
+    /* Unexpected continuation byte */
+    return D_ERR_INVALID_BYTE;
+  } else if (b < 0xc2) {
+    /* Two-byte encodings of ASCII */
+    return D_ERR_OVERLONG;
+  } else if (b < 0xe0) {
+    n = 2; *c = (b & 0x1f);
+  } else if (b < 0xf0) {
+    n = 3; *c = (b & 0x0f);
+    if (b == 0xe0) {
+      lo = 0xa0; below = D_ERR_OVERLONG;
+    } else if (b == 0xed) {
+      hi = 0x9f; above = D_ERR_ENCODED_SURROGATE;
+    }
+  } else if (b < 0xf5) {
+    n = 4; *c = (b & 0x07);
+    if (b == 0xf0) {
+      lo = 0x90; below = D_ERR_OVERLONG;
+    } else if (b == 0xf4) {
+      hi = 0x8f; above = D_ERR_OUT_OF_RANGE;
+    }
+  } else if (b < 0xf8) {
+    return D_ERR_OUT_OF_RANGE;
+  } else {
+    return D_ERR_INVALID_BYTE;
+  }
+
+  /* Second byte: range depends upon the lead byte */
+  if ((end && p + 1 >= end) || !utf8_is_continuation(p[1])) {
+    return D_ERR_TRUNCATED;
+  }
+
+  if (p[1] < lo) {
+    return below;
+  }
+
+  if (p[1] > hi) {
+    return above;
+  }
+
+  *c = (*c << 6) | (p[1] & 0x3f);
+
+  /* Remaining bytes: any continuation byte */
+  for (size_t i = 2; i < n; ++i) {
+
+    if ((end && p + i >= end) || !utf8_is_continuation(p[i])) {
+      *length = i;
+      return D_ERR_TRUNCATED;
+    }
+
+    *c = (*c << 6) | (p[i] & 0x3f);
+  }
+
+  *length = n;
+  return D_ERR_NONE;
+}
+
+/**
+ * @name utf8_string_info_range:
+ *   Implementation of `utf8_string_info` and `utf8_string_info_slice`.
+ *   No bytes at or beyond `end` are examined; a null byte before
+ *   `end` also ends the string.
+ */
+static boolean_t utf8_string_info_range(const char *str, const char *end,
+                                        string_info_t *i) {
+
+  const uint8_t *p = (const uint8_t *) str;
+  const uint8_t *e = (const uint8_t *) end;
+
+  /* Local counters:
+      Stores through `i` could alias `p`, which would force
+      the compiler to reload the input after every update. */
+
+  size_t units = 0, symbols = 0;
+  size_t error_offset = 0, invalid_bytes = 0;
+  string_decode_error_t error = D_ERR_NONE;
+
+  for (;;) {
+
+    /* Runs of ASCII:
+        Short runs, which are typical of mixed-script text, are
+        handled inline; long runs are handed to the vectorized span. */
+
+    const uint8_t *run = p;
+
+    while (p < e && *p && *p < 0x80
+           && p - run < utf8_inline_ascii_maximum) {
+      p++;
+    }
+
+    if (p - run == utf8_inline_ascii_maximum) {
+      p += utf8_ascii_span(p, e);
+    }
+
+    size_t n = p - run;
+
+    units += n;
+    symbols += n;
+
+    if (p >= e || *p == '\0') {
+      break;
+    }
+
+    codepoint_t c;
+    string_decode_error_t err = utf8_decode_sequence(p, e, &c, &n);
+
+    if (err != D_ERR_NONE) {
+
+      if (!error) {
+        error = err;
+        error_offset = ((const char *) p - str);
+      }
+
+      invalid_bytes += n;
+
+    } else {
+      symbols++;
+      units += (c >= 0x10000 ? 2 : 1);
+    }
+
+    p += n;
+  }
+
+  i->units = units;
+  i->symbols = symbols;
+  i->bytes = ((const char *) p - str);
+
+  i->error = error;
+  i->error_offset = error_offset;
+  i->invalid_bytes = invalid_bytes;
+
+  return (error == D_ERR_NONE);
+}
+
+/**
+ * @name utf8_string_info:
+ *   Validate the null-terminated UTF-8 string `str`, and calculate
+ *   the number of bytes, UTF-16 code units, and symbols it contains.
+ *   Overlong encodings, encoded surrogates, codepoints above U+10FFFF,
+ *   and truncated sequences are all rejected. If the string contains
+ *   at least one invalid sequence, this function records the error
+ *   type and byte offset of the *first* invalid sequence, along with
+ *   the total number of invalid bytes; counts include valid symbols
+ *   only. Returns true if the string is entirely valid UTF-8.
+ */
+boolean_t utf8_string_info(const char *str, string_info_t *i) {
+
+  return utf8_string_info_range(str, str + strlen(str), i);
+}
+
+/**
+ * @name utf8_string_info_slice:
+ *   Identical to `utf8_string_info`, but for the UTF-8 slice `s`.
+ *   A sequence cut short by the end of the slice is truncated.
+ */
+boolean_t utf8_string_info_slice(string_slice_t s, string_info_t *i) {
+
+  return utf8_string_info_range(s.data, s.data + s.length, i);
+}
+
+/**
+ * @name ascii_widen_utf16be:
+ *   Write the `n` ASCII characters at `p` to `q` as big-endian UTF-16
+ *   code units. If `is_sse2` is true, sixteen characters are widened
+ *   per iteration. No null terminator is written.
+ */
+static inline void ascii_widen_utf16be(const uint8_t *p, size_t n,
+                                       uint8_t *q, boolean_t is_sse2) {
+  const uint8_t *end = p + n;
+
+  #ifdef ENCODING_X86_SIMD
+    if (is_sse2) {
+
+      const __m128i zero = _mm_setzero_si128();
+
+      while (p + 16 <= end) {
+
+        /* Interleaving zeroes before each byte yields UTF-16BE */
+        __m128i v = _mm_loadu_si128((const __m128i *) p);
+        _mm_storeu_si128((__m128i *) q, _mm_unpacklo_epi8(zero, v));
+        _mm_storeu_si128((__m128i *) (q + 16), _mm_unpackhi_epi8(zero, v));
+
+        p += 16; q += 32;
+      }
+    }
+  #endif
+
+  while (p < end) {
+    q[0] = 0; q[1] = *p++;
+    q += 2;
+  }
+}
+
+/**
+ * @name utf8_write_utf16be:
+ *   Transcode the first `bytes` bytes of the valid UTF-8 string `s`
+ *   to big-endian UTF-16, writing the result to `out`, which must
+ *   have room for the number of code units reported by
+ *   `utf8_string_info`. Returns the number of code units written.
+ *   No null terminator is written.
+ */
+static size_t utf8_write_utf16be(const char *s, size_t bytes, char *out) {
+
+  const uint8_t *p = (const uint8_t *) s;
+  const uint8_t *end = p + bytes;
+  uint8_t *q = (uint8_t *) out;
+
+  boolean_t is_sse2 = !!(cpu_features() & CPU_SSE2);
+
+  while (p < end) {
+
+    /* Runs of ASCII:
+        Short runs are found inline; long runs are found using
+        the vectorized span. Both are then widened in bulk. */
+
+    const uint8_t *run = p;
+
+    while (p < end && *p < 0x80 && p - run < utf8_inline_ascii_maximum) {
+      p++;
+    }
+
+    if (p - run == utf8_inline_ascii_maximum) {
+      p += utf8_ascii_span(p, end);
+    }
+
+    ascii_widen_utf16be(run, p - run, q, is_sse2);
+    q += 2 * (p - run);
+
+    if (p >= end) {
+      break;
+    }
+
+    /* Already validated:
+        The lead byte alone determines the sequence length. */
+
+    codepoint_t c;
+
+    if (*p < 0xe0) {
+      c = ((p[0] & 0x1f) << 6) | (p[1] & 0x3f);
+      p += 2;
+    } else if (*p < 0xf0) {
+      c = ((p[0] & 0x0f) << 12) | ((p[1] & 0x3f) << 6) | (p[2] & 0x3f);
+      p += 3;
+    } else {
+      c = ((codepoint_t) (p[0] & 0x07) << 18) | ((p[1] & 0x3f) << 12)
+        | ((p[2] & 0x3f) << 6) | (p[3] & 0x3f);
+      p += 4;
+    }
+
+    if (c >= 0x10000) {
+      c -= 0x10000;
+      utf16be_write_unit(q, utf16_surrogate_first + (c >> 10));
+      utf16be_write_unit(q + 2, utf16_surrogate_middle + (c & 0x3ff));
+      q += 4;
+    } else {
+      utf16be_write_unit(q, c);
+      q += 2;
+    }
+  }
+
+  return (q - (uint8_t *) out) / 2;
+}
+
+/**
+ * @name utf8_encode_utf16be:
+ *   Validate the null-terminated UTF-8 string `s` and, if it is
+ *   valid, transcode it to a newly-allocated, null-terminated
+ *   big-endian UTF-16 string of exactly the required size. In either
+ *   case, `i` receives the results of `utf8_string_info`, including
+ *   the type and offset of the first error. Returns NULL if `s` is
+ *   invalid; otherwise, the caller must free the returned string.
+ */
+char *utf8_encode_utf16be(const char *s, string_info_t *i) {
+
+  if (!utf8_string_info(s, i)) {
+    return NULL;
+  }
+
+  char *rv = allocate_array(2, i->units, 1);
+  size_t units = utf8_write_utf16be(s, i->bytes, rv);
+
+  rv[2 * units] = rv[2 * units + 1] = '\0';
+  return rv;
+}
+
+/**
+ * @name utf8_encode_utf16be_slice:
+ *   Identical to `utf8_encode_utf16be`, but for the UTF-8 slice `s`.
+ */
+char *utf8_encode_utf16be_slice(string_slice_t s, string_info_t *i) {
+
+  if (!utf8_string_info_slice(s, i)) {
+    return NULL;
+  }
+
+  char *rv = allocate_array(2, i->units, 1);
+  size_t units = utf8_write_utf16be(s.data, i->bytes, rv);
+
+  rv[2 * units] = rv[2 * units + 1] = '\0';
+  return rv;
+}
+
+/**
+ * @name utf8_preflight:
+ *   Validate the null-terminated UTF-8 string `s`, transcode it to a
+ *   newly-allocated, null-terminated big-endian UTF-16 string, count
+ *   its code units and symbols, and calculate the same GSM and UCS-2
+ *   segment information as `utf16be_segment_info` -- all in a single
+ *   pass over the input. If `s` is invalid, `i` receives the results
+ *   of `utf8_string_info`, and NULL is returned. Otherwise, the caller
+ *   must free the returned string; `i` and `seg` are both filled in,
+ *   and `seg->non_gsm_offset` is negative if and only if the string
+ *   can be sent using the GSM alphabet.
+ */
+char *utf8_preflight(const char *s, string_info_t *i,
+                     sms_segment_info_t *seg) {
+
+  return utf8_preflight_slice(utf8_slice(s), i, seg);
+}
+
+/**
+ * @name utf8_preflight_slice:
+ *   Identical to `utf8_preflight`, but for the UTF-8 slice `str`,
+ *   whose length is already known; the input is read exactly once.
+ */
+char *utf8_preflight_slice(string_slice_t str, string_info_t *i,
+                           sms_segment_info_t *seg) {
+
+  const char *s = str.data;
+  const uint8_t *p = (const uint8_t *) s;
+  const uint8_t *end = p + str.length;
+
+  /* Allocate:
+      Each byte of input yields at most one code unit. */
+
+  char *rv = allocate_array(2, str.length, 1);
+  uint8_t *q = (uint8_t *) rv;
+
+  size_t symbols = 0, septets = 0;
+  size_t gsm_used = 0, ucs2_used = 0;
+  unsigned int gsm_parts = 1, ucs2_parts = 1;
+  ssize_t non_gsm_offset = -1;
+
+  boolean_t is_sse2 = !!(cpu_features() & CPU_SSE2);
+
+  for (;;) {
+
+    /* Runs of ASCII:
+        These are converted and counted in bulk; only characters
+        from the extension table need to be accounted for singly. */
+
+    const uint8_t *run = p;
+
+    while (p < end && *p && *p < 0x80
+           && p - run < utf8_inline_ascii_maximum) {
+      p++;
+    }
+
+    if (p - run == utf8_inline_ascii_maximum) {
+      p += utf8_ascii_span(p, end);
+    }
+
+    if (p > run) {
+
+      size_t length = p - run;
+
+      ascii_widen_utf16be(run, length, q, is_sse2);
+
+      for (const uint8_t *r = run; non_gsm_offset < 0 && r < p; ) {
+
+        const uint8_t *start = r;
+
+        while (r < p && gsm_ascii_septet_cost(*r) == 1) {
+          r++;
+        }
+
+        if (r > start) {
+          septets += (r - start);
+          segment_counter_add_run(
+            &gsm_used, &gsm_parts, sms_gsm_multipart_septets, r - start
+          );
+        }
+
+        if (r < p) {
+
+          unsigned int cost = gsm_ascii_septet_cost(*r);
+
+          if (cost) {
+            septets += cost;
+            segment_counter_add(
+              &gsm_used, &gsm_parts, sms_gsm_multipart_septets, cost
+            );
+          } else {
+            non_gsm_offset = (q - (uint8_t *) rv) + 2 * (r - run);
+          }
+
+          r++;
+        }
+      }
+
+      segment_counter_add_run(
+        &ucs2_used, &ucs2_parts, sms_ucs2_multipart_units, length
+      );
+
+      symbols += length;
+      q += 2 * length;
+    }
+
+    if (p >= end || *p == '\0') {
+      break;
+    }
+
+    size_t n;
+    codepoint_t c;
+
+    if (utf8_decode_sequence(p, end, &c, &n) != D_ERR_NONE) {
+
+      /* Invalid input:
+          This is rare, so rescan to collect complete error information. */
+
+      free(rv);
+      utf8_string_info_slice(str, i);
+      return NULL;
+    }
+
+    unsigned int units = 1;
+
+    /* Classify: stop counting septets at the first non-GSM symbol */
+    if (non_gsm_offset < 0) {
+
+      unsigned int cost = (
+        c < 0x10000 ? gsm_septet_cost(c >> 8, c & 0xff) : 0
+      );
+
+      if (cost) {
+        septets += cost;
+        segment_counter_add(
+          &gsm_used, &gsm_parts, sms_gsm_multipart_septets, cost
+        );
+      } else {
+        non_gsm_offset = (q - (uint8_t *) rv);
+      }
+    }
+
+    /* Convert */
+    if (c >= 0x10000) {
+      c -= 0x10000;
+      utf16be_write_unit(q, utf16_surrogate_first + (c >> 10));
+      utf16be_write_unit(q + 2, utf16_surrogate_middle + (c & 0x3ff));
+      units = 2;
+    } else {
+      utf16be_write_unit(q, c);
+    }
+
+    segment_counter_add(
+      &ucs2_used, &ucs2_parts, sms_ucs2_multipart_units, units
+    );
+
+    symbols++;
+    q += 2 * units;
+    p += n;
+  }
+
+  q[0] = q[1] = '\0';
+
+  i->bytes = ((const char *) p - s);
+  i->units = (q - (uint8_t *) rv) / 2;
+
+  /* Exact size:
+      Multibyte input yields fewer units than bytes; give the excess
+      back, so that memory held by the caller tracks the output. */
+
+  if (i->units < str.length) {
+
+    char *shrunk = reallocate_array(rv, 2, i->units, 1);
+
+    if (shrunk) {
+      rv = shrunk;
+    }
+  }
+  i->symbols = symbols;
+  i->error = D_ERR_NONE;
+  i->error_offset = 0;
+  i->invalid_bytes = 0;
+
+  seg->units = i->units;
+  seg->non_gsm_offset = non_gsm_offset;
+
+  seg->ucs2_parts = (
+    seg->units <= sms_ucs2_single_units ? 1 : ucs2_parts
+  );
+
+  if (non_gsm_offset >= 0) {
+    seg->septets = 0;
+    seg->gsm_parts = 0;
+  } else {
+    seg->septets = septets;
+    seg->gsm_parts = (
+      septets <= sms_gsm_single_septets ? 1 : gsm_parts
+    );
+  }
+
+  return rv;
+}
+
+/**
+ * @name string_decode_errors:
+ */
+static const char *const string_decode_errors[] = {
+  /* 0 */  "Success; no error",
+  /* 1 */  "Unmatched UTF-16 surrogate",
+  /* 2 */  "Unexpected UTF-16 surrogate",
+  /* 3 */  "Unknown decoding error",
+  /* 4 */  "Invalid UTF-8 byte",
+  /* 5 */  "Truncated UTF-8 sequence",
+  /* 6 */  "Overlong UTF-8 sequence",
+  /* 7 */  "UTF-8 encoded surrogate",
+  /* 8 */  "Codepoint out of range"
+};
+
+/**
+ * @name string_decode_error_text:
+ *   Return a human-readable description of the decoding error `err`.
+ */
+const char *string_decode_error_text(string_decode_error_t err) {
+
+  return (
+    err < D_ERR_BARRIER ?
+      string_decode_errors[err] : string_decode_errors[D_ERR_UNKNOWN]
+  );
+}
+
+/**
+ * @name conversion_descriptors:
+ *   Long-lived iconv descriptors for `convert_utf8_utf16be`. Index
+ *   zero converts UTF-8 to UTF-16BE; index one converts UTF-16BE to
+ *   UTF-8. Each is opened lazily, on first use. iconv descriptors
+ *   carry conversion state, so every thread has its own pair.
+ */
+static __thread iconv_t conversion_descriptors[] = {
+  (iconv_t) -1, (iconv_t) -1
+};
+
+/**
+ * @name conversion_descriptor:
+ *   Return a cached iconv descriptor for the conversion direction
+ *   specified by `reverse`, opening it if necessary. The descriptor
+ *   is returned to its initial shift state before being handed out,
+ *   so that a previous failed conversion can't affect the next one.
+ *   Returns `(iconv_t) -1` if the descriptor could not be opened.
+ */
+static iconv_t conversion_descriptor(boolean_t reverse) {
+
+  char *t1 = "UTF-16BE", *t2 = "UTF-8";
+  iconv_t *iv = &conversion_descriptors[reverse ? 1 : 0];
+
+  if (*iv == (iconv_t) -1) {
+    *iv = iconv_open(
+      (reverse ? t2 : t1), (reverse ? t1 : t2)
+    );
+  } else {
+    iconv(*iv, NULL, NULL, NULL, NULL);
+  }
+
+  return *iv;
+}
+
+/**
+ * @name release_conversion_descriptors:
+ *   Close any iconv descriptors that were opened and cached by
+ *   `convert_utf8_utf16be` on the calling thread. This should be
+ *   called once at exit, and by any other thread before it exits.
+ */
+void release_conversion_descriptors(void) {
+
+  for (unsigned int i = 0; i < 2; ++i) {
+    if (conversion_descriptors[i] != (iconv_t) -1) {
+      iconv_close(conversion_descriptors[i]);
+      conversion_descriptors[i] = (iconv_t) -1;
+    }
+  }
+}
+
+/**
+ * @name utf16be_utf8_length:
+ *   Return the exact number of bytes needed to represent the first
+ *   `units` code units of the valid big-endian UTF-16 string `s` in
+ *   UTF-8, not including a null terminator.
+ */
+static size_t utf16be_utf8_length(const char *s, size_t units) {
+
+  size_t rv = 0;
+  const uint8_t *u = (const uint8_t *) s;
+
+  for (size_t i = 0; i < units; ++i) {
+
+    codepoint_t c = (u[2 * i] << 8) | u[2 * i + 1];
+
+    if (c < 0x80) {
+      rv += 1;
+    } else if (c < 0x800) {
+      rv += 2;
+    } else if (c >= utf16_surrogate_first && c < utf16_surrogate_middle) {
+      rv += 4; i++;
+    } else {
+      rv += 3;
+    }
+  }
+
+  return rv;
+}
+
+/**
+ * @name convert_utf8_utf16be:
+ */
+char *convert_utf8_utf16be(char *s, boolean_t reverse) {
+
+  string_info_t si;
+
+  /* UTF-8 to UTF-16:
+   *   This direction is handled natively; see `utf8_encode_utf16be`. */
+
+  if (!reverse) {
+    return utf8_encode_utf16be(s, &si);
+  }
+
+  return convert_utf8_utf16be_slice(utf16be_slice(s), reverse);
+}
+
+/**
+ * @name convert_utf8_utf16be_slice:
+ *   Identical to `convert_utf8_utf16be`, but for the slice `s`, which
+ *   is UTF-8 if `reverse` is false, or big-endian UTF-16 otherwise.
+ *   The length of the input is taken from `s` rather than measured.
+ */
+char *convert_utf8_utf16be_slice(string_slice_t s, boolean_t reverse) {
+
+  char *rv = NULL;
+  string_info_t si;
+
+  if (!reverse) {
+    return utf8_encode_utf16be_slice(s, &si);
+  }
+
+  iconv_t iv = conversion_descriptor(reverse);
+
+  if (iv == (iconv_t) -1) {
+    goto exit;
+  }
+
+  size_t units = s.length / 2;
+
+  /* Exact allocation:
+   *   One to three bytes per code unit, or four per surrogate pair;
+   *   see `utf16be_utf8_length`. */
+
+  size_t target_size = utf16be_utf8_length(s.data, units);
+  char *target = allocate(target_size + 1);
+
+  /* Perform conversion */
+  char *fp = (char *) s.data, *tp = target;
+  size_t in = 2 * units, out = target_size;
+  size_t lost = iconv(iv, &fp, &in, &tp, &out);
+
+  if (lost == -1) {
+    free(target);
+    goto exit;
+  }
+
+  /* Null-terminate string */
+  *tp = '\0';
+
+  /* Success */
+  rv = target;
+
+  exit:
+    return rv;
+}
+
+/**
+ * @name convert_utf8_utf16be_into:
+ *   Identical to `convert_utf8_utf16be`, but writes the result to the
+ *   caller-supplied buffer `out`, of `size` bytes, instead of
+ *   allocating. Returns the number of bytes required, including the
+ *   null terminator (two bytes for UTF-16BE); if this is larger than
+ *   `size`, nothing is written and the caller may retry with a buffer
+ *   of the returned size. Returns zero if `s` is invalid.
+ */
+size_t convert_utf8_utf16be_into(const char *s, boolean_t reverse,
+                                 char *out, size_t size) {
+
+  string_slice_t slice = (reverse ? utf16be_slice(s) : utf8_slice(s));
+  return convert_utf8_utf16be_slice_into(slice, reverse, out, size);
+}
+
+/**
+ * @name convert_utf8_utf16be_slice_into:
+ *   Identical to `convert_utf8_utf16be_into`, but for the slice `s`,
+ *   which is UTF-8 if `reverse` is false, or big-endian UTF-16
+ *   otherwise. The length of the input is taken from `s`.
+ */
+size_t convert_utf8_utf16be_slice_into(string_slice_t s, boolean_t reverse,
+                                       char *out, size_t size) {
+  string_info_t si;
+
+  if (!reverse) {
+
+    if (!utf8_string_info_slice(s, &si)) {
+      return 0;
+    }
+
+    size_t required = 2 * si.units + 2;
+
+    if (required > size) {
+      return required;
+    }
+
+    size_t units = utf8_write_utf16be(s.data, si.bytes, out);
+    out[2 * units] = out[2 * units + 1] = '\0';
+
+    return required;
+  }
+
+  if (!utf16be_string_info_slice(s, &si)) {
+    return 0;
+  }
+
+  size_t required = utf16be_utf8_length(s.data, si.units) + 1;
+
+  if (required > size) {
+    return required;
+  }
+
+  iconv_t iv = conversion_descriptor(reverse);
+
+  if (iv == (iconv_t) -1) {
+    return 0;
+  }
+
+  /* Perform conversion */
+  char *fp = (char *) s.data, *tp = out;
+  size_t in = 2 * si.units, remaining = size - 1;
+
+  if (iconv(iv, &fp, &in, &tp, &remaining) == (size_t) -1) {
+    return 0;
+  }
+
+  /* Null-terminate string */
+  *tp = '\0';
+  return required;
+}
+
+/** --- **/
+
+/**
+ * @name hex_digits:
+ */
+static const char hex_digits[] = "0123456789ABCDEF";
+
+/**
+ * @name octets_encode_hex_scalar:
+ *   Portable implementation of `octets_encode_hex`. Writes digits
+ *   only; the caller is responsible for the null terminator.
+ */
+static void octets_encode_hex_scalar(const uint8_t *p,
+                                     size_t length, char *out) {
+
+  for (size_t i = 0; i < length; ++i) {
+    out[2 * i] = hex_digits[p[i] >> 4];
+    out[2 * i + 1] = hex_digits[p[i] & 0x0f];
+  }
+}
+
+#ifdef ENCODING_X86_SIMD
+
+/**
+ * @name octets_encode_hex_ssse3:
+ *   SSSE3 implementation of `octets_encode_hex`; converts sixteen
+ *   octets per iteration, looking up both digits of each octet at
+ *   once with `pshufb`.
+ */
+__attribute__((target("ssse3")))
+static void octets_encode_hex_ssse3(const uint8_t *p,
+                                    size_t length, char *out) {
+  size_t i = 0;
+
+  const __m128i mask = _mm_set1_epi8(0x0f);
+  const __m128i digits = _mm_loadu_si128((const __m128i *) hex_digits);
+
+  for (; i + 16 <= length; i += 16) {
+
+    __m128i v = _mm_loadu_si128((const __m128i *) (p + i));
+
+    __m128i hi = _mm_shuffle_epi8(
+      digits, _mm_and_si128(_mm_srli_epi16(v, 4), mask)
+    );
+
+    __m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(v, mask));
+
+    _mm_storeu_si128((__m128i *) (out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+    _mm_storeu_si128((__m128i *) (out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+  }
+
+  octets_encode_hex_scalar(p + i, length - i, out + 2 * i);
+}
+
+/**
+ * @name octets_encode_hex_avx2:
+ *   AVX2 implementation of `octets_encode_hex`; converts thirty-two
+ *   octets per iteration. The input's quadwords are reordered first,
+ *   so that the in-lane unpack instructions produce output in order.
+ */
+__attribute__((target("avx2")))
+static void octets_encode_hex_avx2(const uint8_t *p,
+                                   size_t length, char *out) {
+  size_t i = 0;
+
+  const __m256i mask = _mm256_set1_epi8(0x0f);
+
+  const __m256i digits = _mm256_broadcastsi128_si256(
+    _mm_loadu_si128((const __m128i *) hex_digits)
+  );
+
+  for (; i + 32 <= length; i += 32) {
+
+    __m256i v = _mm256_permute4x64_epi64(
+      _mm256_loadu_si256((const __m256i *) (p + i)), 0xd8
+    );
+
+    __m256i hi = _mm256_shuffle_epi8(
+      digits, _mm256_and_si256(_mm256_srli_epi16(v, 4), mask)
+    );
+
+    __m256i lo = _mm256_shuffle_epi8(digits, _mm256_and_si256(v, mask));
+
+    _mm256_storeu_si256(
+      (__m256i *) (out + 2 * i), _mm256_unpacklo_epi8(hi, lo)
+    );
+
+    _mm256_storeu_si256(
+      (__m256i *) (out + 2 * i + 32), _mm256_unpackhi_epi8(hi, lo)
+    );
+  }
+
+  /* Remaining octets go to scalar code, not to the SSSE3 kernel:
+      mixing legacy SSE and VEX instructions is costly. */
+
+  octets_encode_hex_scalar(p + i, length - i, out + 2 * i);
+}
+
+#endif /* ENCODING_X86_SIMD */
+
+/**
+ * @name octets_encode_hex:
+ */
+size_t octets_encode_hex(const uint8_t *p, size_t length, char *out) {
+
+  #ifdef ENCODING_X86_SIMD
+    unsigned int features = cpu_features();
+
+    if (features & CPU_AVX2) {
+      octets_encode_hex_avx2(p, length, out);
+    } else if (features & CPU_SSSE3) {
+      octets_encode_hex_ssse3(p, length, out);
+    } else {
+      octets_encode_hex_scalar(p, length, out);
+    }
+  #else
+    octets_encode_hex_scalar(p, length, out);
+  #endif
+
+  out[2 * length] = '\0';
+  return 2 * length;
+}
+
+/**
+ * @name hex_digit_value:
+ *   Return the value of the hexadecimal digit `c`, in either
+ *   case, or -1 if `c` isn't a hexadecimal digit.
+ */
+static int hex_digit_value(char c) {
+
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+
+  return -1;
+}
+
+/**
+ * @name hex_decode_octets:
+ */
+ssize_t hex_decode_octets(string_slice_t s, uint8_t *out, size_t size) {
+
+  if (s.length % 2 != 0 || s.length / 2 > size) {
+    return -1;
+  }
+
+  for (size_t i = 0; i < s.length / 2; ++i) {
+
+    int hi = hex_digit_value(s.data[2 * i]);
+    int lo = hex_digit_value(s.data[2 * i + 1]);
+
+    if (hi < 0 || lo < 0) {
+      return -1;
+    }
+
+    out[i] = (uint8_t) ((hi << 4) | lo);
+  }
+
+  return (ssize_t) (s.length / 2);
+}
+
+/**
+ * @name base64_digits:
+ */
+static const char base64_digits[] =
+  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/**
+ * @name octets_encode_base64_scalar:
+ *   Portable implementation of `octets_encode_base64`. Writes digits
+ *   and padding only; the caller is responsible for the null
+ *   terminator.
+ */
+static void octets_encode_base64_scalar(const uint8_t *p,
+                                        size_t length, char *out) {
+  size_t i = 0;
+
+  for (; i + 3 <= length; i += 3, out += 4) {
+
+    uint32_t v = (
+      ((uint32_t) p[i] << 16) | ((uint32_t) p[i + 1] << 8) | p[i + 2]
+    );
+
+    out[0] = base64_digits[v >> 18];
+    out[1] = base64_digits[(v >> 12) & 0x3f];
+    out[2] = base64_digits[(v >> 6) & 0x3f];
+    out[3] = base64_digits[v & 0x3f];
+  }
+
+  if (i < length) {
+
+    uint32_t v = (uint32_t) p[i] << 16;
+
+    if (i + 1 < length) {
+      v |= (uint32_t) p[i + 1] << 8;
+    }
+
+    out[0] = base64_digits[v >> 18];
+    out[1] = base64_digits[(v >> 12) & 0x3f];
+    out[2] = (i + 1 < length ? base64_digits[(v >> 6) & 0x3f] : '=');
+    out[3] = '=';
+  }
+}
+
+#ifdef ENCODING_X86_SIMD
+
+/**
+ * @name base64_digits_ssse3:
+ *   Map each byte of `v`, a six-bit index, to its base64 digit. The
+ *   index is reduced to one of sixteen ranges, and `pshufb` looks up
+ *   the offset that converts each range to ASCII.
+ */
+__attribute__((target("ssse3")))
+static inline __m128i base64_digits_ssse3(__m128i v) {
+
+  const __m128i offsets = _mm_setr_epi8(
+    'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+    '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+    '/' - 63, 'A', 0, 0
+  );
+
+  /* 0..25 map to 13, 26..51 to 0, and 52..63 to 1..12 */
+  __m128i r = _mm_subs_epu8(v, _mm_set1_epi8(51));
+  __m128i is_upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), v);
+
+  r = _mm_or_si128(r, _mm_and_si128(is_upper, _mm_set1_epi8(13)));
+  return _mm_add_epi8(v, _mm_shuffle_epi8(offsets, r));
+}
+
+/**
+ * @name base64_indices_ssse3:
+ *   Split the first twelve octets of `v` in to sixteen six-bit
+ *   indices, one per byte, in output order.
+ */
+__attribute__((target("ssse3")))
+static inline __m128i base64_indices_ssse3(__m128i v) {
+
+  v = _mm_shuffle_epi8(v, _mm_setr_epi8(
+    1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10
+  ));
+
+  __m128i a = _mm_mulhi_epu16(
+    _mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00)),
+      _mm_set1_epi32(0x04000040)
+  );
+
+  __m128i b = _mm_mullo_epi16(
+    _mm_and_si128(v, _mm_set1_epi32(0x003f03f0)),
+      _mm_set1_epi32(0x01000010)
+  );
+
+  return _mm_or_si128(a, b);
+}
+
+/**
+ * @name octets_encode_base64_ssse3:
+ *   SSSE3 implementation of `octets_encode_base64`; converts twelve
+ *   octets to sixteen digits per iteration. Each iteration loads
+ *   sixteen octets, so the loop stops while four remain unread.
+ */
+__attribute__((target("ssse3")))
+static void octets_encode_base64_ssse3(const uint8_t *p,
+                                       size_t length, char *out) {
+  size_t i = 0;
+
+  for (; i + 16 <= length; i += 12, out += 16) {
+
+    __m128i v = _mm_loadu_si128((const __m128i *) (p + i));
+
+    _mm_storeu_si128(
+      (__m128i *) out, base64_digits_ssse3(base64_indices_ssse3(v))
+    );
+  }
+
+  octets_encode_base64_scalar(p + i, length - i, out);
+}
+
+/**
+ * @name base64_digits_avx2:
+ *   AVX2 version of `base64_digits_ssse3`.
+ */
+__attribute__((target("avx2")))
+static inline __m256i base64_digits_avx2(__m256i v) {
+
+  const __m256i offsets = _mm256_setr_epi8(
+    'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+    '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+    '/' - 63, 'A', 0, 0,
+    'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+    '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+    '/' - 63, 'A', 0, 0
+  );
+
+  __m256i r = _mm256_subs_epu8(v, _mm256_set1_epi8(51));
+  __m256i is_upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), v);
+
+  r = _mm256_or_si256(r, _mm256_and_si256(is_upper, _mm256_set1_epi8(13)));
+  return _mm256_add_epi8(v, _mm256_shuffle_epi8(offsets, r));
+}
+
+/**
+ * @name octets_encode_base64_avx2:
+ *   AVX2 implementation of `octets_encode_base64`; converts
+ *   twenty-four octets to thirty-two digits per iteration. Each
+ *   128-bit lane is loaded separately, twelve octets apart, and is
+ *   then handled exactly as in `octets_encode_base64_ssse3`.
+ */
+__attribute__((target("avx2")))
+static void octets_encode_base64_avx2(const uint8_t *p,
+                                      size_t length, char *out) {
+  size_t i = 0;
+
+  const __m256i order = _mm256_setr_epi8(
+    1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+    1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10
+  );
+
+  for (; i + 28 <= length; i += 24, out += 32) {
+
+    __m256i v = _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) (p + i))),
+        _mm_loadu_si128((const __m128i *) (p + i + 12)), 1
+    );
+
+    v = _mm256_shuffle_epi8(v, order);
+
+    __m256i a = _mm256_mulhi_epu16(
+      _mm256_and_si256(v, _mm256_set1_epi32(0x0fc0fc00)),
+        _mm256_set1_epi32(0x04000040)
+    );
+
+    __m256i b = _mm256_mullo_epi16(
+      _mm256_and_si256(v, _mm256_set1_epi32(0x003f03f0)),
+        _mm256_set1_epi32(0x01000010)
+    );
+
+    _mm256_storeu_si256(
+      (__m256i *) out, base64_digits_avx2(_mm256_or_si256(a, b))
+    );
+  }
+
+  /* As for hexadecimal, the remainder goes to scalar code */
+  octets_encode_base64_scalar(p + i, length - i, out);
+}
+
+#endif /* ENCODING_X86_SIMD */
+
+/**
+ * @name octets_encode_base64:
+ */
+size_t octets_encode_base64(const uint8_t *p, size_t length, char *out) {
+
+  size_t rv = base64_encoded_length(length);
+
+  #ifdef ENCODING_X86_SIMD
+    unsigned int features = cpu_features();
+
+    if (features & CPU_AVX2) {
+      octets_encode_base64_avx2(p, length, out);
+    } else if (features & CPU_SSSE3) {
+      octets_encode_base64_ssse3(p, length, out);
+    } else {
+      octets_encode_base64_scalar(p, length, out);
+    }
+  #else
+    octets_encode_base64_scalar(p, length, out);
+  #endif
+
+  out[rv] = '\0';
+  return rv;
+}
+
+/**
+ * @name base64_digit_value:
+ *   Return the value of the base64 digit `c`, from the standard
+ *   alphabet of RFC 4648, or -1 if `c` isn't a base64 digit.
+ */
+static int base64_digit_value(char c) {
+
+  if (c >= 'A' && c <= 'Z') {
+    return c - 'A';
+  }
+
+  if (c >= 'a' && c <= 'z') {
+    return c - 'a' + 26;
+  }
+
+  if (c >= '0' && c <= '9') {
+    return c - '0' + 52;
+  }
+
+  switch (c) {
+    case '+':
+      return 62;
+    case '/':
+      return 63;
+  }
+
+  return -1;
+}
+
+/**
+ * @name base64_decode_octets:
+ */
+ssize_t base64_decode_octets(string_slice_t s, uint8_t *out, size_t size) {
+
+  size_t length = s.length, rv = 0;
+
+  /* Padding is optional, but must be complete if present */
+  if (length % 4 == 0 && length > 0 && s.data[length - 1] == '=') {
+    length -= (s.data[length - 2] == '=' ? 2 : 1);
+  }
+
+  if (length % 4 == 1 || (length / 4) * 3 + (length % 4) * 3 / 4 > size) {
+    return -1;
+  }
+
+  uint32_t acc = 0;
+  unsigned int bits = 0;
+
+  for (size_t i = 0; i < length; ++i) {
+
+    int v = base64_digit_value(s.data[i]);
+
+    if (v < 0) {
+      return -1;
+    }
+
+    acc = (acc << 6) | (uint32_t) v;
+    bits += 6;
+
+    if (bits >= 8) {
+      bits -= 8;
+      out[rv++] = (uint8_t) (acc >> bits);
+    }
+  }
+
+  /* Leftover bits must be zero, so that every input is canonical */
+  if (acc & ((1u << bits) - 1)) {
+    return -1;
+  }
+
+  return (ssize_t) rv;
 }
 
 /* vim: set ts=4 sts=2 sw=2 expandtab: */
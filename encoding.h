@@ -54,9 +54,29 @@ typedef enum {
   D_ERR_NONE = 0,
   D_ERR_UNMATCHED_SURROGATE = 1,
   D_ERR_UNEXPECTED_SURROGATE = 2,
-  D_ERR_UNKNOWN = 3
+  D_ERR_UNKNOWN = 3,
+  D_ERR_INVALID_BYTE = 4,
+  D_ERR_TRUNCATED = 5,
+  D_ERR_OVERLONG = 6,
+  D_ERR_ENCODED_SURROGATE = 7,
+  D_ERR_OUT_OF_RANGE = 8,
+  D_ERR_BARRIER = 9
 } string_decode_error_t;
 
+/**
+ * @name string_slice_t:
+ *   A string of `length` bytes beginning at `data`, which need not be
+ *   null-terminated. Functions that accept a slice never read beyond
+ *   its end, and never need to measure it; a null character within a
+ *   slice still ends the string early.
+ */
+typedef struct string_slice {
+
+  const char *data;
+  size_t length;
+
+} string_slice_t;
+
 /**
  * @name string_info_t:
  */
@@ -73,33 +93,347 @@ typedef struct string_info {
 
 } string_info_t;
 
+/**
+ * @name sms_gsm_single_septets, sms_gsm_multipart_septets:
+ *   The number of GSM 7-bit septets available in a single-part
+ *   message, and in each part of a concatenated message (after
+ *   allowing for a six-octet concatenation user data header).
+ */
+#define sms_gsm_single_septets      (160)
+#define sms_gsm_multipart_septets   (153)
+
+/**
+ * @name sms_ucs2_single_units, sms_ucs2_multipart_units:
+ *   The number of UCS-2/UTF-16 code units available in a single-part
+ *   message, and in each part of a concatenated message.
+ */
+#define sms_ucs2_single_units       (70)
+#define sms_ucs2_multipart_units    (67)
+
+/**
+ * @name sms_user_data_octets, sms_udh_concat_octets, sms_udh_shift_octets:
+ *   The size of the user data field of a single message, and the sizes
+ *   of the user data header's concatenation and national language shift
+ *   information elements (including their identifier and length octets).
+ */
+#define sms_user_data_octets        (140)
+#define sms_udh_concat_octets       (5)
+#define sms_udh_shift_octets        (3)
+
+/**
+ * @name sms_segment_info_t:
+ */
+typedef struct sms_segment_info {
+
+  size_t septets;
+  size_t units;
+
+  unsigned int gsm_parts;
+  unsigned int ucs2_parts;
+
+  ssize_t non_gsm_offset;
+
+} sms_segment_info_t;
+
+/**
+ * @name gsm_national_info_t:
+ *   A combination of 3GPP TS 23.038 locking and single shift tables,
+ *   as indices in to `GSM0338_LANGUAGES` (zero is the default alphabet
+ *   and extension table), along with the length of a particular string
+ *   in septets, and the number of parts needed, using those tables.
+ */
+typedef struct gsm_national_info {
+
+  unsigned int locking;
+  unsigned int single;
+
+  size_t septets;
+  unsigned int parts;
+
+} gsm_national_info_t;
+
+/**
+ * @name transliteration_t:
+ *   A single look-alike replacement: the character `codepoint` is
+ *   replaced by the `units`-long big-endian UTF-16 `replacement`.
+ */
+typedef struct transliteration {
+
+  codepoint_t codepoint;
+  size_t units;
+  char *replacement;
+
+} transliteration_t;
+
+/**
+ * @name transliteration_table_t:
+ *   A set of replacements, sorted by codepoint.
+ */
+typedef struct transliteration_table {
+
+  size_t size;
+  size_t count;
+  transliteration_t *entries;
+
+} transliteration_table_t;
+
+#define transliteration_table_size_start  (64)
+
 /**
  * @name convert_utf8_utf16be:
  */
 char *convert_utf8_utf16be(char *utf8, boolean_t reverse);
 
+/**
+ * @name convert_utf8_utf16be_slice:
+ *   Identical to `convert_utf8_utf16be`, but for the slice `s`, which
+ *   is UTF-8 if `reverse` is false, or big-endian UTF-16 otherwise.
+ *   The length of the input is taken from `s` rather than measured.
+ */
+char *convert_utf8_utf16be_slice(string_slice_t s, boolean_t reverse);
+
+/**
+ * @name convert_utf8_utf16be_into:
+ *   Identical to `convert_utf8_utf16be`, but writes the result to the
+ *   caller-supplied buffer `out`, of `size` bytes, instead of
+ *   allocating. Returns the number of bytes required, including the
+ *   null terminator (two bytes for UTF-16BE); if this is larger than
+ *   `size`, nothing is written and the caller may retry with a buffer
+ *   of the returned size. Returns zero if `s` is invalid.
+ */
+size_t convert_utf8_utf16be_into(const char *s, boolean_t reverse,
+                                 char *out, size_t size);
+
+/**
+ * @name convert_utf8_utf16be_slice_into:
+ *   Identical to `convert_utf8_utf16be_into`, but for the slice `s`,
+ *   which is UTF-8 if `reverse` is false, or big-endian UTF-16
+ *   otherwise. The length of the input is taken from `s`.
+ */
+size_t convert_utf8_utf16be_slice_into(string_slice_t s, boolean_t reverse,
+                                       char *out, size_t size);
+
+/**
+ * @name release_conversion_descriptors:
+ *   Close any iconv descriptors that were opened and cached by
+ *   `convert_utf8_utf16be` on the calling thread. This should be
+ *   called once at exit, and by any other thread before it exits.
+ */
+void release_conversion_descriptors(void);
+
 /**
  * @name utf16be_string_info:
  */
 boolean_t utf16be_string_info(const char *s, string_info_t *i);
 
+/**
+ * @name utf16be_string_info_slice:
+ *   Identical to `utf16be_string_info`, but for the UTF-16 slice `s`.
+ *   A lead surrogate at the end of the slice is unmatched.
+ */
+boolean_t utf16be_string_info_slice(string_slice_t s, string_info_t *i);
+
+/**
+ * @name utf16be_length:
+ *   Return the number of 16-bit code units in the big-endian UTF-16
+ *   string `s`, not including the two-byte null terminator.
+ */
+size_t utf16be_length(const char *s);
+
 /**
  * @name utf16be_is_gsm_codepoint:
  *   Given the most-significant byte `msb` and the least-significant
  *   byte `lsb` of a UCS-16-BE character, return TRUE if the character
  *   can be represented in the default GSM alphabet (described in GSM
- *   03.38). The GSM-to-Unicode conversion table used here was obtained
- *   from http://www.unicode.org/Public/MAPPINGS/ETSI/GSM0338.TXT.
- *
- *   Copyright (c) 2000 - 2009 Unicode, Inc. All Rights reserved.
- *   Unicode, Inc. hereby grants the right to freely use the information
- *   supplied in this file in the creation of products supporting the
- *   Unicode Standard, and to make copies of this file in any form for
- *   internal or external distribution as long as this notice remains
- *   attached.
+ *   03.38). This is a two-level bitmap lookup; the bitmap is built at
+ *   compile time from the GSM 03.38 mapping tables in `gsm.h`.
  */
 boolean_t utf16be_is_gsm_codepoint(uint8_t msb, uint8_t lsb);
 
+/**
+ * @name utf16be_find_non_gsm:
+ *   Return the byte offset of the first code unit in the big-endian
+ *   UTF-16 string `s` that cannot be represented in the GSM default
+ *   alphabet, or -1 if the entire string can be represented. The
+ *   input string should be terminated by two null bytes.
+ */
+ssize_t utf16be_find_non_gsm(const char *s);
+
+/**
+ * @name utf16be_find_non_gsm_slice:
+ *   Identical to `utf16be_find_non_gsm`, but for the UTF-16 slice `s`.
+ */
+ssize_t utf16be_find_non_gsm_slice(string_slice_t s);
+
+/**
+ * @name utf16be_segment_info:
+ *   Calculate the exact length of the big-endian UTF-16 string `s`
+ *   when encoded using the GSM 7-bit default alphabet (in septets,
+ *   counting extension table characters twice) and when encoded as
+ *   UCS-2/UTF-16 (in code units), along with the number of message
+ *   parts required for each. If `s` can't be represented in the GSM
+ *   alphabet, `septets` and `gsm_parts` are zero, and the byte offset
+ *   of the first problematic character is stored in `non_gsm_offset`.
+ *   Returns true if the string can be sent using the GSM alphabet.
+ */
+boolean_t utf16be_segment_info(const char *s, sms_segment_info_t *i);
+
+/**
+ * @name sms_gsm_septet_capacity:
+ *   Return the number of septets available in each part of a GSM
+ *   7-bit message whose user data header carries `shift_elements`
+ *   national language shift information elements, along with a
+ *   concatenation information element if `is_multipart` is true.
+ */
+size_t sms_gsm_septet_capacity(unsigned int shift_elements,
+                               boolean_t is_multipart);
+
+/**
+ * @name gsm_national_shift_elements:
+ *   Return the number of shift information elements that must be
+ *   included in the user data header to select the tables in `i`.
+ */
+unsigned int gsm_national_shift_elements(const gsm_national_info_t *i);
+
+/**
+ * @name gsm_language_name:
+ *   Return the name of the table set at `language` in
+ *   `GSM0338_LANGUAGES`, or NULL if the index is out of range.
+ */
+const char *gsm_language_name(unsigned int language);
+
+/**
+ * @name gsm_language_identifier:
+ *   Return the 3GPP TS 23.038 language identifier for the table
+ *   set at `language` in `GSM0338_LANGUAGES`.
+ */
+uint8_t gsm_language_identifier(unsigned int language);
+
+/**
+ * @name gsm_default_codepoint:
+ *   Return the Unicode codepoint for `septet` in the GSM 03.38
+ *   default alphabet. Only the low seven bits of `septet` are used.
+ */
+codepoint_t gsm_default_codepoint(uint8_t septet);
+
+/**
+ * @name gsm_language_index:
+ *   Return the index in `GSM0338_LANGUAGES` of the table set with
+ *   the 3GPP TS 23.038 language `identifier`, or -1 if there is no
+ *   such table set.
+ */
+int gsm_language_index(uint8_t identifier);
+
+/**
+ * @name gsm_decode_utf16be:
+ *   Decode `count` unpacked septets, using the locking and single
+ *   shift tables at `locking` and `single` in `GSM0338_LANGUAGES`,
+ *   and write the result to `out` as null-terminated big-endian
+ *   UTF-16. The buffer `out` must have room for `2 * (count + 1)`
+ *   bytes. Returns the number of code units written, excluding the
+ *   terminator.
+ */
+size_t gsm_decode_utf16be(const uint8_t *septets, size_t count,
+                          unsigned int locking, unsigned int single,
+                          char *out);
+
+/**
+ * @name gsm_stand_in_utf16be:
+ *   Write each of `count` unpacked septets to `out` as the default
+ *   alphabet character for that septet, as null-terminated big-endian
+ *   UTF-16; escapes are written as U+00A0, and are not combined with
+ *   the septet that follows. This is the text that libgammu's default
+ *   alphabet encoder should turn back in to exactly the same septets.
+ *   The buffer `out` must have room for `2 * (count + 1)` bytes.
+ *   Returns the number of code units written.
+ */
+size_t gsm_stand_in_utf16be(const uint8_t *septets, size_t count,
+                            char *out);
+
+/**
+ * @name utf16be_national_info:
+ *   Find the combination of national language locking and single
+ *   shift tables that represents the big-endian UTF-16 string `s` in
+ *   the fewest message parts, counting the space taken by the user
+ *   data header. Ties go to the combination with the fewest shift
+ *   information elements, then to a single shift over a locking shift,
+ *   then to the fewest septets. Returns false if no combination can
+ *   represent every character of `s`.
+ */
+boolean_t utf16be_national_info(const char *s, gsm_national_info_t *i);
+
+/**
+ * @name utf16be_encode_gsm_part:
+ *   Encode characters from the big-endian UTF-16 string `*s` as
+ *   unpacked septets in to `septets`, using the tables selected in
+ *   `i`, until the string ends or the next character would exceed
+ *   `capacity` septets. Characters from a single shift table are
+ *   written as an escape septet followed by the character's septet,
+ *   and are never split. Advances `*s` past the characters encoded,
+ *   and returns the number of septets written. Every character of
+ *   `*s` must be representable using the tables in `i`.
+ */
+size_t utf16be_encode_gsm_part(const char **s, const gsm_national_info_t *i,
+                               size_t capacity, uint8_t *septets);
+
+/**
+ * @name utf16be_compose:
+ *   Apply Unicode canonical composition to the big-endian UTF-16
+ *   string `s`, in place, replacing each unblocked starter and
+ *   combining character pair with its primary composite (e.g. `e`
+ *   followed by U+0301 becomes U+00E9). The result is canonically
+ *   equivalent to the input, and is never longer. This doesn't
+ *   decompose or reorder the input first, so the result is identical
+ *   to Normalization Form C for decomposed or partially composed
+ *   text, but not for every possible input. Returns the number of
+ *   compositions performed.
+ */
+size_t utf16be_compose(char *s);
+
+/**
+ * @name create_transliteration_table:
+ *   Create a new, empty transliteration table. If `with_defaults` is
+ *   true, the table is populated from `GSM0338_TRANSLITERATIONS`.
+ *   The caller must release the table using
+ *   `release_transliteration_table`.
+ */
+transliteration_table_t *create_transliteration_table(boolean_t with_defaults);
+
+/**
+ * @name transliteration_table_add:
+ *   Add a mapping from the codepoint `c` to the UTF-8 string
+ *   `replacement` to the table `t`, replacing any existing mapping
+ *   for `c`. Entries are kept sorted by codepoint. Returns false if
+ *   `replacement` is not valid UTF-8, or if `c` is not a valid
+ *   Unicode scalar value.
+ */
+boolean_t transliteration_table_add(transliteration_table_t *t,
+                                    codepoint_t c, const char *replacement);
+
+/**
+ * @name release_transliteration_table:
+ */
+void release_transliteration_table(transliteration_table_t *t);
+
+/**
+ * @name utf16be_transliterate:
+ *   Return a newly-allocated copy of the big-endian UTF-16 string
+ *   `s`, with every character that appears in the table `t` replaced
+ *   by its replacement. The number of characters replaced is stored
+ *   in `substitutions`. The caller must free the returned string.
+ */
+char *utf16be_transliterate(const char *s, const transliteration_table_t *t,
+                            size_t *substitutions);
+
+/**
+ * @name utf16be_decode_codepoint:
+ *   Decode the character at the start of the big-endian UTF-16
+ *   string `s`. If `units` is non-null, it receives the number of
+ *   code units consumed: two for a valid surrogate pair, otherwise
+ *   one. Unpaired surrogates are returned as-is.
+ */
+codepoint_t utf16be_decode_codepoint(const char *s, size_t *units);
+
 /**
  * @name utf16be_is_gsm_string:
  *   Return true if the UCS-16-BE string `s` can be represented in
@@ -110,17 +444,176 @@ boolean_t utf16be_is_gsm_string(const char *s);
 
 /**
  * @name utf8_string_info:
+ *   Validate the null-terminated UTF-8 string `str`, and calculate
+ *   the number of bytes, UTF-16 code units, and symbols it contains.
+ *   Overlong encodings, encoded surrogates, codepoints above U+10FFFF,
+ *   and truncated sequences are all rejected. If the string contains
+ *   at least one invalid sequence, this function records the error
+ *   type and byte offset of the *first* invalid sequence, along with
+ *   the total number of invalid bytes; counts include valid symbols
+ *   only. Returns true if the string is entirely valid UTF-8.
  */
 boolean_t utf8_string_info(const char *str, string_info_t *i);
 
+/**
+ * @name utf8_string_info_slice:
+ *   Identical to `utf8_string_info`, but for the UTF-8 slice `s`.
+ *   A sequence cut short by the end of the slice is truncated.
+ */
+boolean_t utf8_string_info_slice(string_slice_t s, string_info_t *i);
+
+/**
+ * @name utf8_encode_utf16be:
+ *   Validate the null-terminated UTF-8 string `s` and, if it is
+ *   valid, transcode it to a newly-allocated, null-terminated
+ *   big-endian UTF-16 string of exactly the required size. In either
+ *   case, `i` receives the results of `utf8_string_info`, including
+ *   the type and offset of the first error. Returns NULL if `s` is
+ *   invalid; otherwise, the caller must free the returned string.
+ */
+char *utf8_encode_utf16be(const char *s, string_info_t *i);
+
+/**
+ * @name utf8_encode_utf16be_slice:
+ *   Identical to `utf8_encode_utf16be`, but for the UTF-8 slice `s`.
+ */
+char *utf8_encode_utf16be_slice(string_slice_t s, string_info_t *i);
+
+/**
+ * @name utf8_preflight:
+ *   Validate the null-terminated UTF-8 string `s`, transcode it to a
+ *   newly-allocated, null-terminated big-endian UTF-16 string, count
+ *   its code units and symbols, and calculate the same GSM and UCS-2
+ *   segment information as `utf16be_segment_info` -- all in a single
+ *   pass over the input. If `s` is invalid, `i` receives the results
+ *   of `utf8_string_info`, and NULL is returned. Otherwise, the caller
+ *   must free the returned string; `i` and `seg` are both filled in,
+ *   and `seg->non_gsm_offset` is negative if and only if the string
+ *   can be sent using the GSM alphabet.
+ */
+char *utf8_preflight(const char *s, string_info_t *i,
+                     sms_segment_info_t *seg);
+
+/**
+ * @name utf8_preflight_slice:
+ *   Identical to `utf8_preflight`, but for the UTF-8 slice `str`,
+ *   whose length is already known; the input is read exactly once.
+ */
+char *utf8_preflight_slice(string_slice_t str, string_info_t *i,
+                           sms_segment_info_t *seg);
+
+/**
+ * @name string_decode_error_text:
+ *   Return a human-readable description of the decoding error `err`.
+ */
+const char *string_decode_error_text(string_decode_error_t err);
+
 /**
  * @name utf16be_encode_json_utf8:
  *   Copy and transform the string `s` to a newly-allocated
  *   buffer, making it suitable for output as a single utf-8
  *   JSON string. The caller must free the returned string.
+ *   This is a single native pass over `s`: quotes, backslashes,
+ *   and control characters are escaped, and unpaired surrogates
+ *   are replaced with U+FFFD.
  */
 char *utf16be_encode_json_utf8(const char *s);
 
+/**
+ * @name utf16be_encode_json_utf8_slice:
+ *   Identical to `utf16be_encode_json_utf8`, but transforms only the
+ *   big-endian UTF-16 slice `s`, which need not be null terminated.
+ *   The length of the input is taken from `s` rather than measured.
+ */
+char *utf16be_encode_json_utf8_slice(string_slice_t s);
+
+/**
+ * @name utf16be_encode_json_utf8_into:
+ *   Identical to `utf16be_encode_json_utf8`, but writes the result
+ *   to the caller-supplied buffer `out`, of `size` bytes, instead of
+ *   allocating. Returns the number of bytes required, including the
+ *   null terminator; if this is larger than `size`, nothing is written
+ *   and the caller may retry with a buffer of the returned size.
+ */
+size_t utf16be_encode_json_utf8_into(const char *s,
+                                     char *out, size_t size);
+
+/**
+ * @name utf16be_encode_json_utf8_slice_into:
+ *   Identical to `utf16be_encode_json_utf8_into`, but for the
+ *   big-endian UTF-16 slice `s`.
+ */
+size_t utf16be_encode_json_utf8_slice_into(string_slice_t s,
+                                           char *out, size_t size);
+
+/**
+ * @name utf16be_slice:
+ *   Return a slice covering the null-terminated big-endian UTF-16
+ *   string `s`, not including its two-byte null terminator.
+ */
+string_slice_t utf16be_slice(const char *s);
+
+/**
+ * @name utf16be_slice_units:
+ *   Return a slice covering the first `units` code units of the
+ *   big-endian UTF-16 string `s`, which need not be null-terminated.
+ */
+string_slice_t utf16be_slice_units(const char *s, size_t units);
+
+/**
+ * @name utf8_slice:
+ *   Return a slice covering the null-terminated UTF-8 string `s`,
+ *   not including its null terminator.
+ */
+string_slice_t utf8_slice(const char *s);
+
+/** --- **/
+
+/**
+ * @name octets_encode_hex:
+ *   Write the `length` octets at `p` to `out` as upper-case
+ *   hexadecimal digits, followed by a null terminator. The buffer
+ *   `out` must have room for `2 * length + 1` bytes. Returns the
+ *   number of digits written.
+ */
+size_t octets_encode_hex(const uint8_t *p, size_t length, char *out);
+
+/**
+ * @name base64_encoded_length:
+ *   The number of base64 digits, including padding, needed to
+ *   encode `n` octets. This doesn't include a null terminator.
+ */
+#define base64_encoded_length(n) ((((n) + 2) / 3) * 4)
+
+/**
+ * @name octets_encode_base64:
+ *   Write the `length` octets at `p` to `out` as base64 digits,
+ *   using the standard alphabet of RFC 4648 with padding, followed
+ *   by a null terminator. The buffer `out` must have room for
+ *   `base64_encoded_length(length) + 1` bytes. Returns the number
+ *   of digits written.
+ */
+size_t octets_encode_base64(const uint8_t *p, size_t length, char *out);
+
+/**
+ * @name hex_decode_octets:
+ *   Decode the hexadecimal digits in `s`, in either case, to at
+ *   most `size` octets in `out`. Returns the number of octets
+ *   written, or -1 if `s` has an odd length, contains anything other
+ *   than hexadecimal digits, or would decode to more than `size`
+ *   octets.
+ */
+ssize_t hex_decode_octets(string_slice_t s, uint8_t *out, size_t size);
+
+/**
+ * @name base64_decode_octets:
+ *   Decode the base64 digits in `s`, using the standard alphabet of
+ *   RFC 4648, to at most `size` octets in `out`. Trailing padding is
+ *   optional. Returns the number of octets written, or -1 if `s` isn't
+ *   valid base64 or would decode to more than `size` octets.
+ */
+ssize_t base64_decode_octets(string_slice_t s, uint8_t *out, size_t size);
+
 /** --- **/
 
 #endif /* __ENCODING_H__ */
@@ -39,7 +39,9 @@
 #include <unistd.h>
 #include <string.h>
 #include <limits.h>
+#include <time.h>
 #include <ctype.h>
+#include <pthread.h>
 #include <inttypes.h>
 
 #include <iconv.h>
@@ -47,16 +49,26 @@
 #include <jsmn.h>
 
 #include "json.h"
+#include "json_stream.h"
 #include "allocate.h"
 #include "bitfield.h"
+#include "cache.h"
 #include "encoding.h"
+#include "pdu.h"
 #include "gammu-json.h"
 
 /** --- **/
 
 #define timestamp_max_width     (64)
+#define json_field_max_width    (6 * (GSM_MAX_SMS_LENGTH + 1) + 1)
 #define read_line_size_start    (1024)
 #define read_line_size_maximum  (4194304)
+#define repl_shrink_interval    (64)
+#define stream_chunk_size       (65536)
+
+#define plan_block_size         (64)
+#define plan_messages_per_thread  (256)
+#define plan_threads_maximum    (16)
 
 /** --- **/
 
@@ -72,6 +84,25 @@ const static char *usage_text = (
   "\n"
   "  -h, --help                Print this helpful message.\n"
   "\n"
+  "  -n, --normalize           Compose decomposed Unicode characters (e.g.\n"
+  "                            `e' followed by a combining acute accent)\n"
+  "                            before choosing a message encoding, so that\n"
+  "                            more messages fit in the GSM alphabet.\n"
+  "\n"
+  "  -t, --transliterate       Replace look-alike characters (e.g. curly\n"
+  "                            quotes, dashes, and ellipses) with their\n"
+  "                            closest GSM alphabet equivalents, whenever\n"
+  "                            doing so reduces the number of message\n"
+  "                            parts. The `send', `plan', and `broadcast'\n"
+  "                            commands also accept this as their first\n"
+  "                            argument.\n"
+  "\n"
+  "  -T, --transliteration-table <file>\n"
+  "                            Add to or override the default replacements\n"
+  "                            used by --transliterate. Each line of <file>\n"
+  "                            holds a hexadecimal codepoint (e.g. U+2019),\n"
+  "                            a single space, and its UTF-8 replacement.\n"
+  "\n"
   "  -r, --repl                Run in `read, evaluate, print' loop mode.\n"
   "                            Read a single-line JSON-encoded command\n"
   "                            from stdin, execute the command, then\n"
@@ -81,13 +112,24 @@ const static char *usage_text = (
   "                            via command-line arguments, execute it before\n"
   "                            attempting to read more commands from stdin.\n"
   "\n"
+  "  -s, --stream              Like --repl, but read JSON-encoded commands\n"
+  "                            from stdin as a continuous stream: commands\n"
+  "                            may span lines or share them, and have no\n"
+  "                            size limit. The arguments to `send' are\n"
+  "                            sent, in pairs, as soon as they're read.\n"
+  "\n"
   "  -v, --verbose             Ask Gammu to print debugging information\n"
   "                            to stderr while performing operations.\n"
   "\n"
   "Commands:\n"
   "\n"
-  "  retrieve                  Retrieve all messages from a device, as a\n"
+  "  retrieve [ --hex | --base64 ] [ --udh ]\n"
+  "                            Retrieve all messages from a device, as a\n"
   "                            JSON-encoded array of objects, on stdout.\n"
+  "                            The content of 8-bit messages is printed in\n"
+  "                            hexadecimal (the default) or base64; with\n"
+  "                            `--udh', so is each part's raw user data\n"
+  "                            header.\n"
   "\n"
   "  delete { all | N... }     Delete one or more messages from a device,\n"
   "                            using location numbers to identify them.\n"
@@ -99,6 +141,36 @@ const static char *usage_text = (
   "                            sent to exactly one phone number. Prints\n"
   "                            JSON-encoded information about the sent\n"
   "                            messages on stdout.\n"
+  "\n"
+  "  send-binary [ --hex | --base64 ] { phone payload }...\n"
+  "                            Send one or more binary payloads, given in\n"
+  "                            hexadecimal (the default) or base64, as\n"
+  "                            8-bit data messages. Payloads longer than\n"
+  "                            140 octets are split in to concatenated\n"
+  "                            parts. Prints results as `send' does.\n"
+  "\n"
+  "  broadcast [ --transliterate ] text { phone... | --file path }\n"
+  "                            Send the same message to every phone number\n"
+  "                            provided, or to every number listed (one per\n"
+  "                            line) in the file at `path'. The message is\n"
+  "                            encoded once, and only the destination is\n"
+  "                            changed for each recipient. Prints results\n"
+  "                            for each recipient as `send' does.\n"
+  "\n"
+  "  plan { phone text }...    Encode one or more messages exactly as `send'\n"
+  "                            would, without using a device. Prints the\n"
+  "                            encoding and number of parts for each\n"
+  "                            message, along with totals, on stdout.\n"
+  "\n"
+  "  encode { phone text }...  Encode one or more messages exactly as `send'\n"
+  "                            would, without using a device, and print\n"
+  "                            each part as a hexadecimal SMS-SUBMIT PDU\n"
+  "                            (with an empty SMSC address) on stdout.\n"
+  "\n"
+  "  stats                     Print counters for this process, such as\n"
+  "                            message cache hits and misses, as a JSON\n"
+  "                            object on stdout. Useful with `--repl'.\n"
+  "\n"
   "About:\n"
   "\n"
   "  Copyright (c) 2013-2014 David Brown <hello at scri.pt>.\n"
@@ -121,7 +193,8 @@ static const char *const operation_errors[] = {
   /* 4 */  "one or more SMS locations are invalid",
   /* 5 */  "failed to create in-memory message index",
   /* 6 */  "failed to delete one or more messages",
-  /* 7 */  "parse error while processing JSON input"
+  /* 7 */  "parse error while processing JSON input",
+  /* 8 */  "failed to open recipient list"
 };
 
 /**
@@ -137,38 +210,71 @@ static const char *const usage_errors[] = {
   /* 6 */  "no command specified",
   /* 7 */  "location(s) must be specified",
   /* 8 */  "no valid location(s) specified",
-  /* 9 */  "integer argument would overflow"
+  /* 9 */  "integer argument would overflow",
+  /* 10 */ "no transliteration table file name provided",
+  /* 11 */ "transliteration table could not be loaded"
 };
 
 /** --- **/
 
 static app_options_t app; /* global */
 
+/**
+ * @name app_transliterations:
+ *   The replacement table used by `--transliterate`, created on
+ *   first use by `transliteration_table`.
+ */
+static transliteration_table_t *app_transliterations = NULL;
+
+/**
+ * @name app_message_cache:
+ *   The cache of encoded message bodies used by `send`, created on
+ *   first use by `message_cache`.
+ */
+static cache_t *app_message_cache = NULL;
+
 /** --- **/
 
 /**
- * @name read_line:
+ * @name read_line_into:
  *   Read a line portably, relying only upon the C library's
  *   `getc` standard I/O function. This should work on any
  *   platform that has a standard I/O (stdio) implementation.
+ *   The line is stored in `*buffer`, which holds `*size` bytes
+ *   (plus one, for the null terminator) and is enlarged as needed;
+ *   if `*buffer` is NULL, a new buffer is allocated. Both `*buffer`
+ *   and `*size` are updated, and the buffer belongs to the caller,
+ *   even on failure. Returns `*buffer`, or NULL if the line is too
+ *   long or memory couldn't be allocated.
  */
-char *read_line(FILE *stream, boolean_t *eof) {
-
+char *read_line_into(FILE *stream, char **buffer,
+                     size_t *size, boolean_t *eof) {
   int c;
-  unsigned int i = 0;
-  size_t size = read_line_size_start;
+  size_t i = 0;
 
-  char *rv = allocate_array(sizeof(char), size, 1);
+  if (!*buffer) {
+    *size = read_line_size_start;
+    *buffer = allocate_array(sizeof(char), *size, 1);
+  }
+
+  char *rv = *buffer;
 
   for (;;) {
 
-    if (!size || i >= size) {
-      if ((size *= 8) >= read_line_size_maximum) {
-        goto allocation_error;
+    if (i >= *size) {
+
+      size_t new_size = *size * 8;
+
+      if (new_size >= read_line_size_maximum) {
+        return NULL;
       }
-      if (!(rv = reallocate_array(rv, sizeof(char), size, 1))) {
-        goto allocation_error;
+
+      if (!(rv = reallocate_array(rv, sizeof(char), new_size, 1))) {
+        return NULL;
       }
+
+      *buffer = rv;
+      *size = new_size;
     }
 
     c = getc(stream);
@@ -185,14 +291,24 @@ char *read_line(FILE *stream, boolean_t *eof) {
 
   rv[i] = '\0';
   return rv;
+}
 
-  allocation_error:
+/**
+ * @name read_line:
+ *   Read a line, as described for `read_line_into`, in to a newly
+ *   allocated buffer. The caller must free the returned string.
+ */
+char *read_line(FILE *stream, boolean_t *eof) {
 
-    if (rv) {
-      free(rv);
-    }
+  size_t size = 0;
+  char *rv = NULL;
 
+  if (!read_line_into(stream, &rv, &size, eof)) {
+    free(rv);
     return NULL;
+  }
+
+  return rv;
 }
 
 /* --- */
@@ -269,6 +385,12 @@ transmit_status_t *initialize_transmit_status(transmit_status_t *t) {
   t->message_index = 0;
   t->message_part_index = 0;
 
+  t->encoded.text = NULL;
+  t->encoded.number = NULL;
+  t->encoded.part_offsets = NULL;
+  t->encoded.decode_error = D_ERR_NONE;
+  t->encoded.is_binary = FALSE;
+
   for (unsigned int i = 0; i < GSM_MAX_MULTI_SMS; i++) {
     t->parts[i].err = NULL;
     t->parts[i].status = 0;
@@ -303,10 +425,14 @@ app_options_t *initialize_application_options(app_options_t *o) {
 
   o->help = FALSE;
   o->repl = FALSE;
+  o->stream = FALSE;
   o->invalid = FALSE;
   o->verbose = FALSE;
+  o->normalize = FALSE;
+  o->transliterate = FALSE;
   o->application_name = NULL;
   o->gammu_configuration_path = NULL;
+  o->transliteration_table_path = NULL;
 
   return o;
 }
@@ -340,22 +466,35 @@ boolean_t find_maximum_integer_argument(unsigned long *rv, char *argv[]) {
 
 
 /**
- * @name encode_timestamp_utf8:
+ * @name encode_timestamp_utf8_into:
+ *   Identical to `encode_timestamp_utf8`, but writes the result to
+ *   the caller-supplied buffer `out`, of `size` bytes. Returns the
+ *   number of bytes required, including the null terminator; if this
+ *   is larger than `size`, the output has been truncated.
  */
-char *encode_timestamp_utf8(message_timestamp_t *t) {
-
-  char *rv = allocate(timestamp_max_width);
-
+size_t encode_timestamp_utf8_into(message_timestamp_t *t,
+                                  char *out, size_t size) {
   #ifdef _WIN32
     #pragma warning(disable: 4996)
   #endif
 
-  snprintf(
-    rv, timestamp_max_width, "%.4d-%.2d-%.2d %.2d:%.2d:%.2d",
+  int rv = snprintf(
+    out, size, "%.4d-%.2d-%.2d %.2d:%.2d:%.2d",
       t->Year, t->Month, t->Day, t->Hour, t->Minute, t->Second
   );
 
-  return (char *) rv;
+  return (rv < 0 ? 0 : (size_t) rv + 1);
+}
+
+/**
+ * @name encode_timestamp_utf8:
+ */
+char *encode_timestamp_utf8(message_timestamp_t *t) {
+
+  char *rv = allocate(timestamp_max_width);
+  encode_timestamp_utf8_into(t, rv, timestamp_max_width);
+
+  return rv;
 }
 
 
@@ -380,6 +519,8 @@ gammu_state_t *gammu_create(const char *config_path) {
   gammu_state_t *s = allocate(sizeof(*s));
 
   INI_Section *ini;
+  s->messages = NULL;
+
   GSM_InitLocales(NULL);
 
   if ((s->err = GSM_FindGammuRC(&ini, config_path)) != ERR_NONE) {
@@ -452,6 +593,7 @@ void gammu_destroy(gammu_state_t *s) {
   GSM_TerminateConnection(s->sm);
   GSM_FreeStateMachine(s->sm);
 
+  free(s->messages);
   free(s);
 }
 
@@ -465,7 +607,12 @@ boolean_t for_each_message(gammu_state_t *s,
   boolean_t rv = FALSE;
   boolean_t start = TRUE;
 
-  multimessage_t *sms = allocate(sizeof(*sms));
+  /* Allocated once, then reused for the lifetime of `s` */
+  if (!s->messages) {
+    s->messages = allocate(sizeof(*s->messages));
+  }
+
+  multimessage_t *sms = s->messages;
 
   for (;;) {
 
@@ -489,16 +636,82 @@ boolean_t for_each_message(gammu_state_t *s,
     start = FALSE;
   }
 
-  free(sms);
   return rv;
 }
 
+/**
+ * @name print_json_utf16be_property:
+ *   Print a JSON property named `name`, whose value is the big-endian
+ *   UTF-16 slice `s` encoded as a JSON string, followed by a comma.
+ *   The value is encoded in to a buffer on the stack, which is large
+ *   enough for any single message part; the heap is used only if `s`
+ *   is longer than that.
+ */
+void print_json_utf16be_property(const char *name, string_slice_t s) {
+
+  char buffer[json_field_max_width];
+  char *b = buffer;
+
+  size_t required =
+    utf16be_encode_json_utf8_slice_into(s, buffer, sizeof(buffer));
+
+  if (required > sizeof(buffer)) {
+    b = allocate(required);
+    utf16be_encode_json_utf8_slice_into(s, b, required);
+  }
+
+  printf("\"%s\": \"%s\", ", name, b);
+
+  if (b != buffer) {
+    free(b);
+  }
+}
+
+/**
+ * @name print_json_octets_property:
+ *   Print a JSON property named `name`, whose value is the `length`
+ *   octets at `p`, encoded as a string of hexadecimal or base64
+ *   digits according to `format`, followed by a comma. No more than
+ *   `size` octets are printed.
+ */
+void print_json_octets_property(const char *name, const uint8_t *p,
+                                size_t length, size_t size,
+                                binary_format_t format) {
+
+  /* Large enough for any part, in either format */
+  char buffer[2 * sizeof(((message_t *) 0)->Text) + 1];
+
+  if (length > size) {
+    length = size;
+  }
+
+  if (format == BINARY_FORMAT_BASE64) {
+    octets_encode_base64(p, length, buffer);
+  } else {
+    octets_encode_hex(p, length, buffer);
+  }
+
+  printf("\"%s\": \"%s\", ", name, buffer);
+}
+
 /**
  * @name print_message_json_utf8:
+ *   Print the multi-part message `sms` as JSON. If `x` is non-null,
+ *   it points to a `retrieve_options_t` structure, which determines
+ *   how the content of 8-bit messages is printed, and whether the
+ *   raw user data header of each part is included.
  */
 boolean_t print_message_json_utf8(gammu_state_t *s,
                                   multimessage_t *sms,
                                   boolean_t is_start, void *x) {
+  char timestamp[timestamp_max_width];
+
+  retrieve_options_t defaults = { BINARY_FORMAT_HEX, FALSE };
+  retrieve_options_t *o = (x ? (retrieve_options_t *) x : &defaults);
+
+  const char *format_name =
+    (o->format == BINARY_FORMAT_BASE64 ? "base64" : "hex");
+
   if (!is_start) {
     printf(", ");
   }
@@ -512,39 +725,35 @@ boolean_t print_message_json_utf8(gammu_state_t *s,
     printf("\"location\": %d, ", sms->SMS[i].Location);
 
     /* Originating phone number */
-    char *from =
-      utf16be_encode_json_utf8((char *) sms->SMS[i].Number);
-
-    printf("\"from\": \"%s\", ", from);
-    free(from);
+    print_json_utf16be_property(
+      "from", utf16be_slice((char *) sms->SMS[i].Number)
+    );
 
     /* SMS service center phone number */
-    char *smsc =
-      utf16be_encode_json_utf8((char *) sms->SMS[i].SMSC.Number);
-
-    printf("\"smsc\": \"%s\", ", smsc);
-    free(smsc);
+    print_json_utf16be_property(
+      "smsc", utf16be_slice((char *) sms->SMS[i].SMSC.Number)
+    );
 
     /* Receive timestamp */
     if (is_empty_timestamp(&sms->SMS[i].DateTime)) {
       printf("\"timestamp\": false, ");
     } else {
-      char *timestamp =
-        encode_timestamp_utf8(&sms->SMS[i].DateTime);
+      encode_timestamp_utf8_into(
+        &sms->SMS[i].DateTime, timestamp, sizeof(timestamp)
+      );
 
       printf("\"timestamp\": \"%s\", ", timestamp);
-      free(timestamp);
     }
 
     /* SMSC receive timestamp */
     if (is_empty_timestamp(&sms->SMS[i].SMSCTime)) {
       printf("\"smsc_timestamp\": false, ");
     } else {
-      char *smsc_timestamp =
-        encode_timestamp_utf8(&sms->SMS[i].SMSCTime);
+      encode_timestamp_utf8_into(
+        &sms->SMS[i].SMSCTime, timestamp, sizeof(timestamp)
+      );
 
-      printf("\"smsc_timestamp\": \"%s\", ", smsc_timestamp);
-      free(smsc_timestamp);
+      printf("\"smsc_timestamp\": \"%s\", ", timestamp);
     }
 
     /* Multi-part message metadata */
@@ -567,21 +776,35 @@ boolean_t print_message_json_utf8(gammu_state_t *s,
       }
     }
 
+    /* Raw user data header, if requested */
+    if (o->include_udh && sms->SMS[i].UDH.Length > 0) {
+      print_json_octets_property(
+        "udh_data", sms->SMS[i].UDH.Text, sms->SMS[i].UDH.Length,
+          sizeof(sms->SMS[i].UDH.Text), o->format
+      );
+    }
+
     /* Text and text encoding */
     switch (sms->SMS[i].Coding) {
       case SMS_Coding_8bit: {
+
         printf("\"encoding\": \"binary\", ");
+        printf("\"payload_format\": \"%s\", ", format_name);
+
+        print_json_octets_property(
+          "payload", sms->SMS[i].Text, sms->SMS[i].Length,
+            sizeof(sms->SMS[i].Text), o->format
+        );
         break;
       }
       case SMS_Coding_Default_No_Compression:
       case SMS_Coding_Unicode_No_Compression: {
 
-        char *text =
-          utf16be_encode_json_utf8((char *) sms->SMS[i].Text);
-
         printf("\"encoding\": \"utf-8\", ");
-        printf("\"content\": \"%s\", ", text);
-        free(text);
+
+        print_json_utf16be_property(
+          "content", utf16be_slice((char *) sms->SMS[i].Text)
+        );
         break;
       }
       case SMS_Coding_Unicode_Compression:
@@ -606,12 +829,12 @@ boolean_t print_message_json_utf8(gammu_state_t *s,
 /**
  * @name print_messages_json_utf8:
  */
-int print_messages_json_utf8(gammu_state_t *s) {
+int print_messages_json_utf8(gammu_state_t *s, retrieve_options_t *o) {
 
   printf("[");
 
   boolean_t rv = for_each_message(
-    s, (message_iterate_fn_t) print_message_json_utf8, NULL
+    s, (message_iterate_fn_t) print_message_json_utf8, o
   );
 
   printf("]\n");
@@ -625,7 +848,22 @@ int action_retrieve_messages(gammu_state_t **sp,
                              int argc, char *argv[]) {
 
   int rv = 0;
-  
+  retrieve_options_t o = { BINARY_FORMAT_HEX, FALSE };
+
+  /* Options:
+      Unrecognized arguments are ignored, as they always have been. */
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "-x") == 0 || strcmp(argv[i], "--hex") == 0) {
+      o.format = BINARY_FORMAT_HEX;
+    } else if (strcmp(argv[i], "-b") == 0
+               || strcmp(argv[i], "--base64") == 0) {
+      o.format = BINARY_FORMAT_BASE64;
+    } else if (strcmp(argv[i], "-u") == 0 || strcmp(argv[i], "--udh") == 0) {
+      o.include_udh = TRUE;
+    }
+  }
+
   /* Lazy initialization of libgammu */
   gammu_state_t *s = gammu_create_if_necessary(sp);
 
@@ -634,7 +872,7 @@ int action_retrieve_messages(gammu_state_t **sp,
     rv = 1; goto cleanup;
   }
 
-  if (!print_messages_json_utf8(s)) {
+  if (!print_messages_json_utf8(s, &o)) {
     print_operation_error(OP_ERR_RETRIEVE);
     rv = 2; goto cleanup;
   }
@@ -934,6 +1172,109 @@ void print_json_validation_error(json_validation_error_t err) {
   }
 }
 
+/**
+ * @name print_json_decode_error:
+ *   If `e` could not be decoded, print the type of decoding
+ *   error and the byte offset at which it was found. The output
+ *   is preceded by a comma, and should follow an "error" property.
+ */
+void print_json_decode_error(encoded_message_t *e) {
+
+  if (e->decode_error == D_ERR_NONE) {
+    return;
+  }
+
+  printf(", \"decode_error\": \"%s\"",
+         string_decode_error_text(e->decode_error)); /* const */
+
+  printf(", \"decode_error_offset\": %zu", e->decode_error_offset);
+}
+
+/**
+ * @name print_json_encoding_info:
+ *   Print the encoding chosen for the message `e`, its length, and
+ *   the number of parts predicted. For UTF-16 messages, also print
+ *   the offset (in UTF-16 code units) and codepoint of the first
+ *   character that couldn't be represented in the GSM alphabet. For
+ *   messages sent using national language shift tables, print the
+ *   tables chosen, and the number of parts saved relative to UTF-16.
+ *   If characters were composed by `--normalize`, print their count;
+ *   if characters were replaced by `--transliterate`, print the number
+ *   of replacements and the number of parts that they saved. For
+ *   binary messages, print only the number of octets.
+ */
+void print_json_encoding_info(encoded_message_t *e) {
+
+  if (e->is_binary) {
+    printf("\"parts_predicted\": %u, ", e->octet_parts);
+    printf("\"encoding\": \"binary\", ");
+    printf("\"octets\": %zu, ", e->octets);
+    return;
+  }
+
+  if (e->is_gsm) {
+    printf("\"parts_predicted\": %u, ", e->segments.gsm_parts);
+    printf("\"encoding\": \"gsm\", ");
+    printf("\"septets\": %zu, ", e->segments.septets);
+  } else if (e->is_national) {
+    printf("\"parts_predicted\": %u, ", e->national.parts);
+    printf("\"encoding\": \"gsm\", ");
+    printf("\"septets\": %zu, ", e->national.septets);
+    printf("\"national_language\": { ");
+    printf("\"locking_shift\": \"%s\", ",
+      gsm_language_name(e->national.locking)); /* const */
+    printf("\"single_shift\": \"%s\" }, ",
+      gsm_language_name(e->national.single)); /* const */
+    printf("\"parts_saved\": %u, ",
+      e->segments.ucs2_parts - e->national.parts);
+  } else {
+    printf("\"parts_predicted\": %u, ", e->segments.ucs2_parts);
+    printf("\"encoding\": \"utf-16\", ");
+    printf("\"non_gsm_offset\": %zd, ", e->segments.non_gsm_offset / 2);
+    printf("\"non_gsm_codepoint\": %" PRIu32 ", ", e->non_gsm_codepoint);
+  }
+
+  printf("\"units\": %zu, ", e->segments.units);
+
+  if (e->compositions > 0) {
+    printf("\"compositions\": %zu, ", e->compositions);
+  }
+
+  if (e->substitutions > 0) {
+    printf("\"transliterated\": { ");
+    printf("\"substitutions\": %zu, ", e->substitutions);
+    printf("\"parts_saved\": %u }, ", e->substitution_parts_saved);
+  }
+}
+
+/**
+ * @name print_json_part_content:
+ *   Print the content of part `i` of the message `e`, which has been
+ *   encoded in to `m`, as a JSON property. For messages encoded using
+ *   national language shift tables, part text is taken from the
+ *   original message, since `m` holds only stand-in characters. For
+ *   binary messages, only the part's length in octets is printed.
+ */
+void print_json_part_content(encoded_message_t *e,
+                             multimessage_t *m, unsigned int i) {
+  if (e->is_binary) {
+    printf("\"octets\": %d, ", m->SMS[i].Length);
+    return;
+  }
+
+  if (e->part_offsets) {
+    print_json_utf16be_property("content", utf16be_slice_units(
+      e->text + e->part_offsets[i],
+        (e->part_offsets[i + 1] - e->part_offsets[i]) / 2
+    ));
+    return;
+  }
+
+  print_json_utf16be_property(
+    "content", utf16be_slice((char *) m->SMS[i].Text)
+  );
+}
+
 /**
  * @name print_json_transmit_status:
  */
@@ -951,6 +1292,7 @@ void print_json_transmit_status(gammu_state_t *s, multimessage_t *m,
 
     printf("\"result\": \"error\", ");
     printf("\"error\": \"%s\"", t->err); /* const */
+    print_json_decode_error(&t->encoded);
 
   } else {
 
@@ -967,6 +1309,9 @@ void print_json_transmit_status(gammu_state_t *s, multimessage_t *m,
     printf("\"parts_sent\": %d, ", t->parts_sent);
     printf("\"parts_total\": %d, ", t->parts_total);
 
+    /* Encoding information */
+    print_json_encoding_info(&t->encoded);
+
     /* Per-part status codes */
     printf("\"parts\": [");
 
@@ -983,12 +1328,8 @@ void print_json_transmit_status(gammu_state_t *s, multimessage_t *m,
         printf("\"result\": \"error\", ");
         printf("\"error\": \"%s\", ", t->parts[i].err); /* const */
       } else {
-        char *text =
-          utf16be_encode_json_utf8((char *) m->SMS[i].Text);
-
         printf("\"result\": \"success\", ");
-        printf("\"content\": \"%s\", ", text);
-        free(text);
+        print_json_part_content(&t->encoded, m, i);
       }
 
       printf("\"index\": %d, ", i + 1);
@@ -1024,211 +1365,1875 @@ static void _message_transmit_callback(GSM_StateMachine *sm,
 }
 
 /**
- * @name action_send_messages:
+ * @name libgammu_encoder_lock:
+ *   Serializes the calls we make in to libgammu while encoding
+ *   messages. libgammu doesn't document its encoder as reentrant,
+ *   and it reads the global debug state; our own conversion and
+ *   analysis, which is most of the work, still runs in parallel.
  */
-int action_send_messages(gammu_state_t **sp,
-                         int argc, char *argv[]) {
+static pthread_mutex_t libgammu_encoder_lock = PTHREAD_MUTEX_INITIALIZER;
 
-  int rv = 0;
-  char **argp = &argv[1];
+/**
+ * @name national_stand_in_once:
+ */
+static pthread_once_t national_stand_in_once = PTHREAD_ONCE_INIT;
 
-  if (argc <= 2) {
-    print_usage_error(U_ERR_ARGS_MISSING);
-    return 1;
-  }
+/**
+ * @name national_stand_in_exact:
+ */
+static boolean_t national_stand_in_exact = FALSE;
 
-  if (argc % 2 != 1) {
-    print_usage_error(U_ERR_ARGS_ODD);
-    return 2;
+/**
+ * @name _check_national_stand_in:
+ *   Encode the stand-in character for every septet with libgammu's
+ *   default alphabet encoder, exactly as it encodes the text of each
+ *   default-coded message it sends, and confirm that every septet
+ *   comes back unchanged. If not, warn that national language tables
+ *   are disabled.
+ */
+static void _check_national_stand_in(void) {
+
+  uint8_t septet;
+  char text[2 * (1 + 1)];
+  unsigned char encoded[4];
+
+  national_stand_in_exact = TRUE;
+  pthread_mutex_lock(&libgammu_encoder_lock);
+
+  for (unsigned int i = 0; i <= 0x7f; ++i) {
+
+    size_t length = 1;
+
+    septet = (uint8_t) i;
+    gsm_stand_in_utf16be(&septet, 1, text);
+
+    EncodeDefault(encoded, (unsigned char *) text, &length, TRUE, NULL);
+
+    if (length != 1 || encoded[0] != septet) {
+      national_stand_in_exact = FALSE;
+      break;
+    }
   }
 
-  /* Lazy initialization of libgammu */
-  gammu_state_t *s = gammu_create_if_necessary(sp);
+  pthread_mutex_unlock(&libgammu_encoder_lock);
 
-  if (!s) {
-    print_operation_error(OP_ERR_INIT);
-    rv = 3; goto cleanup;
+  if (!national_stand_in_exact) {
+    warn("libgammu doesn't encode septet 0x%02x as expected; %s",
+      septet, "national language shift tables are disabled");
   }
+}
 
-  /* Allocate */
-  smsc_t *smsc = allocate(sizeof(*smsc));
-  multimessage_t *sms = allocate(sizeof(*sms));
-  multimessage_info_t *info = allocate(sizeof(*info));
+/**
+ * @name national_stand_in_is_exact:
+ *   Return true if libgammu encodes the stand-in text produced by
+ *   `gsm_stand_in_utf16be` back in to exactly the same septets, so
+ *   that `encode_national_multimessage` can be used. The check is
+ *   only made once. This is safe to call from multiple threads.
+ */
+static boolean_t national_stand_in_is_exact(void) {
 
-  /* Find SMSC number */
-  smsc->Location = 1;
+  pthread_once(&national_stand_in_once, _check_national_stand_in);
+  return national_stand_in_exact;
+}
 
-  if ((s->err = GSM_GetSMSC(s->sm, smsc)) != ERR_NONE) {
-    print_operation_error(OP_ERR_SMSC);
-    rv = 4; goto cleanup_sms;
-  }
+/**
+ * @name concatenation_reference:
+ *   A counter used to generate the 8-bit reference numbers placed in
+ *   the concatenation headers of messages that we encode ourselves.
+ */
+static unsigned int concatenation_reference = 0;
 
-  transmit_status_t status;
-  initialize_transmit_status(&status);
+/**
+ * @name next_concatenation_reference:
+ *   Return a new 8-bit reference number for the concatenation header
+ *   of a message that we encode ourselves. This is safe to call from
+ *   multiple threads.
+ */
+static uint8_t next_concatenation_reference(void) {
 
-  GSM_SetSendSMSStatusCallback(
-    s->sm, _message_transmit_callback, &status
+  return (uint8_t) (
+    time(NULL) + __sync_fetch_and_add(&concatenation_reference, 1)
   );
+}
 
-  boolean_t is_start = TRUE;
-  unsigned int message_index = 0;
+/**
+ * @name encode_national_multimessage:
+ *   Split and encode the message `e` in to `sms`, using the national
+ *   language shift tables selected in `e->national`. libgammu doesn't
+ *   support these tables, so we build each part's user data header
+ *   ourselves. Each part's text is handed to libgammu as the default
+ *   alphabet characters that it will encode to exactly the septets
+ *   we've chosen; U+00A0 stands in for the escape septet. Callers
+ *   must first check `national_stand_in_is_exact`. The byte offset
+ *   of each part within `e->text` is stored in `part_offsets`.
+ *   Returns NULL on success, or a constant error string on failure.
+ */
+const char *encode_national_multimessage(encoded_message_t *e,
+                                         multimessage_t *sms) {
 
-  printf("[");
+  gsm_national_info_t *n = &e->national;
 
-  /* For each message... */
-  while (*argp != NULL) {
+  if (n->parts > GSM_MAX_MULTI_SMS) {
+    return "Message is too long";
+  }
+
+  uint8_t septets[sms_gsm_single_septets];
+  boolean_t is_multipart = (n->parts > 1);
+
+  size_t capacity = sms_gsm_septet_capacity(
+    gsm_national_shift_elements(n), is_multipart
+  );
 
-    GSM_ClearMultiPartSMSInfo(info);
-    GSM_Debug_Info *debug = GSM_GetGlobalDebug();
+  uint8_t reference = next_concatenation_reference();
 
-    /* Copy/convert destination phone number */
-    char *sms_destination_number = convert_utf8_utf16be(*argp++, FALSE);
+  const char *p = e->text;
+  e->part_offsets = allocate_array(sizeof(size_t), n->parts + 1, 0);
 
-    string_info_t nsi;
-    utf16be_string_info(sms_destination_number, &nsi);
+  sms->Number = 0;
 
-    /* Check size of phone number:
-        We'll be decoding this in to a fixed-sized buffer. */
+  /* For each part... */
+  while (p[0] || p[1]) {
 
-    if (nsi.units >= GSM_MAX_NUMBER_LENGTH) {
-      status.err = "Phone number is too long";
-      goto cleanup_transmit_status;
+    unsigned int i = sms->Number;
+
+    if (i >= n->parts) {
+      return "Failed to encode message";
     }
 
-    /* Missing message text:
-        This shouldn't happen since we check `argc` above,
-        but I'm leaving this here in case we refactor later. */
+    e->part_offsets[i] = (p - e->text);
+    size_t length = utf16be_encode_gsm_part(&p, n, capacity, septets);
 
-    if (*argp == NULL) {
-      status.err = "No message body provided";
-      goto cleanup_transmit_status;
+    if (length == 0) {
+      return "Failed to encode message";
     }
 
-    /* UTF-8 message content */
-    char *sms_message = *argp++;
+    message_t *m = &sms->SMS[i];
 
-    /* Convert message from UTF-8 to UTF-16-BE:
-        Every symbol is two bytes long; the string is then
-        terminated by a single 2-byte UTF-16 null character. */
+    pthread_mutex_lock(&libgammu_encoder_lock);
+    GSM_SetDefaultSMSData(m);
+    pthread_mutex_unlock(&libgammu_encoder_lock);
 
-    char *sms_message_utf16be = convert_utf8_utf16be(sms_message, FALSE);
+    m->Class = 1;
+    m->Coding = SMS_Coding_Default_No_Compression;
 
-    if (!sms_message_utf16be) {
-      status.err = "Invalid UTF-8 sequence";
-      goto cleanup_transmit_status;
-    }
+    /* User data header:
+        The first octet is the length of the header that follows. */
 
-    /* Prepare message info structure:
-        This information is used to encode the possibly-multipart SMS. */
+    unsigned int h = 1;
+    unsigned char *udh = m->UDH.Text;
 
-    info->Class = 1;
-    info->EntriesNum = 1;
-    info->Entries[0].ID = SMS_ConcatenatedTextLong;
-    info->Entries[0].Buffer = (uint8_t *) sms_message_utf16be;
-    info->UnicodeCoding = !utf16be_is_gsm_string(sms_message_utf16be);
+    if (is_multipart) {
+      udh[h++] = 0x00; /* Concatenation, 8-bit reference */
+      udh[h++] = 3;
+      udh[h++] = reference;
+      udh[h++] = n->parts;
+      udh[h++] = i + 1;
+    }
 
-    if ((s->err = GSM_EncodeMultiPartSMS(debug, info, sms)) != ERR_NONE) {
-      status.err = "Failed to encode message";
-      goto cleanup_sms_text;
+    if (n->locking) {
+      udh[h++] = 0x25; /* National language locking shift */
+      udh[h++] = 1;
+      udh[h++] = gsm_language_identifier(n->locking);
     }
 
-    status.parts_sent = 0;
-    status.parts_total = sms->Number;
+    if (n->single) {
+      udh[h++] = 0x24; /* National language single shift */
+      udh[h++] = 1;
+      udh[h++] = gsm_language_identifier(n->single);
+    }
 
-    /* For each SMS part... */
-    for (unsigned int i = 0; i < sms->Number; i++) {
+    udh[0] = h - 1;
 
-      status.finished = FALSE;
-      status.message_part_index = i;
+    m->UDH.Type = (h > 1 ? UDH_UserUDH : UDH_NoUDH);
+    m->UDH.Length = (h > 1 ? h : 0);
+    m->UDH.ID8bit = (is_multipart ? reference : -1);
+    m->UDH.ID16bit = -1;
+    m->UDH.PartNumber = (is_multipart ? i + 1 : -1);
+    m->UDH.AllParts = (is_multipart ? n->parts : -1);
 
-      sms->SMS[i].PDU = SMS_Submit;
+    /* Stand-in text for libgammu */
+    m->Length = gsm_stand_in_utf16be(septets, length, (char *) m->Text);
 
-      /* Copy destination phone number:
-           This is a fixed-size buffer; size was already checked above. */
+    sms->Number++;
+  }
 
-      CopyUnicodeString(sms->SMS[i].SMSC.Number, smsc->Number);
-      CopyUnicodeString(sms->SMS[i].Number, sms_destination_number);
+  e->part_offsets[sms->Number] = (p - e->text);
+  return NULL;
+}
 
-      /* Transmit a single message part */
-      if ((s->err = GSM_SendSMS(s->sm, &sms->SMS[i])) != ERR_NONE) {
-        status.parts[i].err = "Message transmission failed";
-        continue;
-      }
+/**
+ * @name choose_message_encoding:
+ *   Choose an encoding for the UTF-16BE text of the message `e`: the
+ *   GSM default alphabet if possible, otherwise a combination of
+ *   national language shift tables if it needs fewer parts than
+ *   UTF-16, otherwise UTF-16. The segment information in `e` must
+ *   already describe its text; see `utf8_preflight` and
+ *   `utf16be_segment_info`. Fills in the remaining encoding
+ *   information in `e`, and returns the number of parts predicted.
+ */
+static unsigned int choose_message_encoding(encoded_message_t *e) {
 
-      for (;;) {
-        /* Wait for reply */
-        GSM_ReadDevice(s->sm, TRUE);
+  e->is_national = FALSE;
+  e->non_gsm_codepoint = 0;
 
-        if (status.finished) {
-          break;
-        }
-      }
+  /* The segment information identifies the first character, if
+      any, that can't be represented in the GSM default alphabet,
+      along with the number of parts required by each encoding. */
 
-      if (!status.parts[i].transmitted) {
-        status.parts[i].err = "Message delivery failed";
-        continue;
-      }
+  if ((e->is_gsm = (e->segments.non_gsm_offset < 0))) {
+    return e->segments.gsm_parts;
+  }
 
-      status.parts_sent++;
-    }
+  e->non_gsm_codepoint = utf16be_decode_codepoint(
+    e->text + e->segments.non_gsm_offset, NULL
+  );
 
-    cleanup_sms_text:
-      status.message_index = ++message_index;
-      free(sms_message_utf16be);
+  /* National language shift tables:
+      If some combination of 3GPP TS 23.038 locking and single shift
+      tables needs fewer parts than UTF-16, use it instead. When the
+      number of parts is equal, UTF-16 is more widely supported. */
 
-    cleanup_transmit_status:
-      print_json_transmit_status(s, sms, &status, is_start);
-      free(sms_destination_number);
-      is_start = FALSE;
+  if (utf16be_national_info(e->text, &e->national)
+      && e->national.parts < e->segments.ucs2_parts) {
+
+    e->is_national = TRUE;
+    return e->national.parts;
   }
 
-  cleanup_sms:
+  return e->segments.ucs2_parts;
+}
 
-    free(sms);
-    free(smsc);
-    free(info);
-    printf("]\n");
-  
-  cleanup:
+/**
+ * @name argument_slice:
+ *   Return a slice covering the null-terminated command-line argument
+ *   `s`. If `s` is null, the slice has a null `data` pointer.
+ */
+static string_slice_t argument_slice(const char *s) {
 
+  if (s == NULL) {
+    string_slice_t rv = { NULL, 0 };
     return rv;
+  }
+
+  return utf8_slice(s);
 }
 
-/** --- **/
+/**
+ * @name initialize_encoded_message:
+ */
+encoded_message_t *initialize_encoded_message(encoded_message_t *e) {
+
+  e->text = NULL;
+  e->number = NULL;
+  e->units = 0;
+  e->number_units = 0;
+  e->decode_error = D_ERR_NONE;
+  e->decode_error_offset = 0;
+  e->is_gsm = FALSE;
+  e->is_national = FALSE;
+  e->part_offsets = NULL;
+  e->non_gsm_codepoint = 0;
+  e->compositions = 0;
+  e->substitutions = 0;
+  e->substitution_parts_saved = 0;
+  e->is_binary = FALSE;
+  e->octets = 0;
+  e->octet_parts = 0;
+  e->is_shared = FALSE;
+
+  return e;
+}
 
 /**
- * @name parse_global_arguments:
+ * @name convert_number:
+ *   Convert the UTF-8 destination phone number `number` to UTF-16BE
+ *   and store it in `e`, along with its length. Nothing else in `e`
+ *   is changed. Returns NULL on success, or a constant error string
+ *   on failure.
  */
-int parse_global_arguments(int argc, char *argv[], app_options_t *o) {
+static const char *convert_number(string_slice_t number,
+                                  encoded_message_t *e) {
 
-  int rv = 0;
-  char **argp = argv;
+  /* Copy/convert destination phone number:
+      The validator also yields the length in UTF-16 units. */
 
-  while (*argp != NULL) {
+  string_info_t nsi;
 
-    if (strcmp(*argp, "-h") == 0 || strcmp(*argp, "--help") == 0) {
-      o->help = TRUE;
-      break;
-    }
+  if (!(e->number = utf8_encode_utf16be_slice(number, &nsi))) {
+    e->decode_error = nsi.error;
+    e->decode_error_offset = nsi.error_offset;
+    return "Invalid UTF-8 sequence in phone number";
+  }
 
-    if (strcmp(*argp, "-c") == 0 || strcmp(*argp, "--config") == 0) {
+  /* Check size of phone number:
+      We'll be decoding this in to a fixed-sized buffer. */
 
-      if (*++argp == NULL) {
-        print_usage_error(U_ERR_CONFIG_MISSING);
-        o->invalid = TRUE;
-        break;
-      }
+  if ((e->number_units = nsi.units) >= GSM_MAX_NUMBER_LENGTH) {
+    return "Phone number is too long";
+  }
 
-      o->gammu_configuration_path = *argp++;
-      rv += 2;
+  return NULL;
+}
 
-      continue;
-    }
+/**
+ * @name prepare_number:
+ *   Initialize `e`, then convert the destination phone number
+ *   `number` in to it, as described for `convert_number`.
+ */
+static const char *prepare_number(string_slice_t number,
+                                  encoded_message_t *e) {
 
-    if (strcmp(*argp, "-v") == 0 || strcmp(*argp, "--verbose") == 0) {
-      o->verbose = TRUE;
-      ++argp; ++rv;
-      continue;
+  initialize_encoded_message(e);
+  return convert_number(number, e);
+}
+
+/**
+ * @name prepare_multimessage:
+ *   Convert the UTF-8 destination phone number `number` and message
+ *   body `text` to UTF-16BE, and choose an encoding for the message.
+ *   If `transliterations` is non-null, look-alike characters are
+ *   replaced using that table when doing so saves parts. This does
+ *   not require a device or libgammu, and is safe to call from
+ *   multiple threads as long as each thread provides its own `e`.
+ *   Returns NULL on success, or a constant error string on failure.
+ *   In either case, the caller must call `release_encoded_message`
+ *   on `e`. Both inputs are slices, so neither is measured again;
+ *   the unit counts of the results are stored in `e` for later use.
+ */
+const char *prepare_multimessage(string_slice_t number, string_slice_t text,
+                                 const transliteration_table_t *transliterations,
+                                 encoded_message_t *e) {
+  const char *err;
+
+  if ((err = prepare_number(number, e))) {
+    return err;
+  }
+
+  /* Missing message text:
+      This shouldn't happen since callers check `argc`,
+      but I'm leaving this here in case we refactor later. */
+
+  if (text.data == NULL) {
+    return "No message body provided";
+  }
+
+  /* Convert message from UTF-8 to UTF-16-BE:
+      Every symbol is two bytes long; the string is then
+      terminated by a single 2-byte UTF-16 null character.
+      The same pass validates, classifies, and sizes the text. */
+
+  string_info_t tsi;
+
+  if (!(e->text = utf8_preflight_slice(text, &tsi, &e->segments))) {
+    e->decode_error = tsi.error;
+    e->decode_error_offset = tsi.error_offset;
+    return "Invalid UTF-8 sequence";
+  }
+
+  e->units = tsi.units;
+
+  /* Choose encoding */
+  unsigned int parts = choose_message_encoding(e);
+
+  /* Optional canonical composition:
+      Combining characters are never in the GSM alphabet, so this
+      can only help messages that would otherwise be sent as UTF-16.
+      Composition is lossless, and never lengthens the message. */
+
+  if (!e->is_gsm && app.normalize) {
+    if ((e->compositions = utf16be_compose(e->text)) > 0) {
+      utf16be_segment_info(e->text, &e->segments);
+      e->units = e->segments.units;
+      parts = choose_message_encoding(e);
+    }
+  }
+
+  /* Optional transliteration:
+      Replacing look-alike characters is lossy, so the replacements
+      are kept only if they reduce the number of parts required. */
+
+  if (!e->is_gsm && transliterations) {
+
+    size_t n;
+    char *t = utf16be_transliterate(e->text, transliterations, &n);
+
+    if (n > 0) {
+
+      encoded_message_t candidate = *e;
+
+      candidate.text = t;
+      utf16be_segment_info(t, &candidate.segments);
+      candidate.units = candidate.segments.units;
+
+      unsigned int candidate_parts = choose_message_encoding(&candidate);
+
+      if (candidate_parts < parts) {
+        free(e->text);
+        *e = candidate;
+        e->substitutions = n;
+        e->substitution_parts_saved = parts - candidate_parts;
+        parts = candidate_parts;
+        t = NULL;
+      }
+    }
+
+    free(t);
+  }
+
+  return NULL;
+}
+
+/**
+ * @name resolve_national_encoding:
+ *   If `e` was to be sent using national language shift tables, but
+ *   libgammu wouldn't reproduce our septets exactly, send it as UTF-16
+ *   instead of sending corrupted text. See `national_stand_in_is_exact`.
+ */
+static void resolve_national_encoding(encoded_message_t *e) {
+
+  if (e->is_national && !national_stand_in_is_exact()) {
+    e->is_national = FALSE;
+  }
+}
+
+/**
+ * @name encoded_message_parts:
+ *   Return the number of parts in which the prepared message `e`
+ *   will be sent, using the encoding chosen for it. The segment
+ *   counts are exact, so this is the number of parts that
+ *   `encode_multimessage` produces.
+ */
+static unsigned int encoded_message_parts(const encoded_message_t *e) {
+
+  if (e->is_gsm) {
+    return e->segments.gsm_parts;
+  }
+
+  if (e->is_national) {
+    return e->national.parts;
+  }
+
+  return e->segments.ucs2_parts;
+}
+
+/**
+ * @name plan_multimessage:
+ *   Prepare the message exactly as `encode_multimessage` would, and
+ *   store the number of parts it would be sent as in `parts`, without
+ *   calling in to libgammu. This is safe to call from multiple threads
+ *   as long as each thread provides its own `e`. Returns NULL on
+ *   success, or the error `encode_multimessage` would return. In
+ *   either case, the caller must call `release_encoded_message` on `e`.
+ */
+static const char *plan_multimessage(string_slice_t number,
+                                     string_slice_t text,
+                                     const transliteration_table_t *t,
+                                     encoded_message_t *e,
+                                     unsigned int *parts) {
+  const char *err;
+  *parts = 0;
+
+  if ((err = prepare_multimessage(number, text, t, e))) {
+    return err;
+  }
+
+  resolve_national_encoding(e);
+
+  if (encoded_message_parts(e) > GSM_MAX_MULTI_SMS) {
+    return (e->is_national ?
+      "Message is too long" : "Failed to encode message");
+  }
+
+  *parts = encoded_message_parts(e);
+  return NULL;
+}
+
+/**
+ * @name encode_multimessage:
+ *   Prepare the message as described for `prepare_multimessage`,
+ *   then encode the possibly-multipart message in to `sms`. This
+ *   does not require a device, and is safe to call from multiple
+ *   threads as long as each thread provides its own `info`, `sms`,
+ *   and `e`; calls in to libgammu are serialized, so the `plan`
+ *   command uses `plan_multimessage` instead. Returns NULL on
+ *   success, or a constant error string on failure. In either case,
+ *   the caller must call `release_encoded_message` on `e`.
+ */
+const char *encode_multimessage(string_slice_t number, string_slice_t text,
+                                const transliteration_table_t *transliterations,
+                                multimessage_info_t *info,
+                                multimessage_t *sms, encoded_message_t *e) {
+  const char *err;
+  GSM_Error gammu_err;
+
+  if ((err = prepare_multimessage(number, text, transliterations, e))) {
+    return err;
+  }
+
+  resolve_national_encoding(e);
+
+  if (e->is_national) {
+    return encode_national_multimessage(e, sms);
+  }
+
+  pthread_mutex_lock(&libgammu_encoder_lock);
+
+  /* Prepare message info structure:
+      This information is used to encode the possibly-multipart SMS. */
+
+  GSM_ClearMultiPartSMSInfo(info);
+
+  info->Class = 1;
+  info->EntriesNum = 1;
+  info->Entries[0].ID = SMS_ConcatenatedTextLong;
+  info->Entries[0].Buffer = (uint8_t *) e->text;
+  info->UnicodeCoding = !e->is_gsm;
+
+  gammu_err = GSM_EncodeMultiPartSMS(GSM_GetGlobalDebug(), info, sms);
+  pthread_mutex_unlock(&libgammu_encoder_lock);
+
+  if (gammu_err != ERR_NONE) {
+    return "Failed to encode message";
+  }
+
+  return NULL;
+}
+
+/**
+ * @name encode_binary_multimessage:
+ *   Convert the UTF-8 destination phone number `number`, decode the
+ *   hexadecimal or base64 `payload` (as selected by `format`), and
+ *   split the payload in to 8-bit data messages in `sms`. A payload
+ *   of up to `sms_user_data_octets` octets is sent as a single part;
+ *   longer payloads are split in to parts that each carry an 8-bit
+ *   concatenation header and as many octets as fit after it. The
+ *   decoded payload is kept in `e`. Returns NULL on success, or a
+ *   constant error string on failure. In either case, the caller
+ *   must call `release_encoded_message` on `e`.
+ */
+const char *encode_binary_multimessage(string_slice_t number,
+                                       string_slice_t payload,
+                                       binary_format_t format,
+                                       multimessage_t *sms,
+                                       encoded_message_t *e) {
+  ssize_t octets;
+  const char *err;
+
+  if ((err = prepare_number(number, e))) {
+    return err;
+  }
+
+  e->is_binary = TRUE;
+
+  if (payload.data == NULL) {
+    return "No message body provided";
+  }
+
+  /* Decode payload:
+      Both formats decode to fewer octets than there are digits. */
+
+  uint8_t *p = allocate(payload.length + 1);
+  e->text = (char *) p;
+
+  if (format == BINARY_FORMAT_BASE64) {
+    octets = base64_decode_octets(payload, p, payload.length);
+  } else {
+    octets = hex_decode_octets(payload, p, payload.length);
+  }
+
+  if (octets < 0) {
+    return (format == BINARY_FORMAT_BASE64 ?
+      "Invalid base64 payload" : "Invalid hexadecimal payload");
+  }
+
+  if (octets == 0) {
+    return "No message body provided";
+  }
+
+  /* Split in to parts */
+  boolean_t is_multipart = (octets > sms_user_data_octets);
+
+  size_t capacity = (
+    is_multipart ?
+      sms_user_data_octets - (sms_udh_concat_octets + 1)
+        : sms_user_data_octets
+  );
+
+  e->octets = (size_t) octets;
+  e->octet_parts = (e->octets + capacity - 1) / capacity;
+
+  if (e->octet_parts > GSM_MAX_MULTI_SMS) {
+    return "Message is too long";
+  }
+
+  uint8_t reference = next_concatenation_reference();
+  sms->Number = 0;
+
+  /* For each part... */
+  for (unsigned int i = 0; i < e->octet_parts; ++i) {
+
+    message_t *m = &sms->SMS[i];
+    size_t offset = i * capacity;
+    size_t length = e->octets - offset;
+
+    if (length > capacity) {
+      length = capacity;
+    }
+
+    GSM_SetDefaultSMSData(m);
+
+    m->Class = 1;
+    m->Coding = SMS_Coding_8bit;
+
+    if (is_multipart) {
+
+      unsigned char *udh = m->UDH.Text;
+
+      udh[0] = sms_udh_concat_octets;
+      udh[1] = 0x00; /* Concatenation, 8-bit reference */
+      udh[2] = 3;
+      udh[3] = reference;
+      udh[4] = e->octet_parts;
+      udh[5] = i + 1;
+
+      m->UDH.Type = UDH_UserUDH;
+      m->UDH.Length = sms_udh_concat_octets + 1;
+      m->UDH.ID8bit = reference;
+      m->UDH.ID16bit = -1;
+      m->UDH.PartNumber = i + 1;
+      m->UDH.AllParts = e->octet_parts;
+
+    } else {
+
+      m->UDH.Type = UDH_NoUDH;
+      m->UDH.Length = 0;
+    }
+
+    memcpy(m->Text, p + offset, length);
+    m->Length = length;
+
+    sms->Number++;
+  }
+
+  return NULL;
+}
+
+/**
+ * @name release_encoded_message:
+ */
+void release_encoded_message(encoded_message_t *e) {
+
+  free(e->number);
+  e->number = NULL;
+
+  if (e->is_shared) {
+    return;
+  }
+
+  free(e->text);
+  free(e->part_offsets);
+
+  e->text = NULL;
+  e->part_offsets = NULL;
+}
+
+/**
+ * @name release_cached_multimessage:
+ *   Free an entry of the message cache. This is the cache's
+ *   `cache_release_fn_t`.
+ */
+static void release_cached_multimessage(void *x) {
+
+  cached_multimessage_t *m = (cached_multimessage_t *) x;
+
+  m->encoded.is_shared = FALSE;
+  release_encoded_message(&m->encoded);
+
+  free(m);
+}
+
+/**
+ * @name message_cache:
+ *   Return the process-wide cache of encoded message bodies,
+ *   creating it if it doesn't yet exist.
+ */
+cache_t *message_cache(void) {
+
+  if (!app_message_cache) {
+    app_message_cache = cache_create(
+      message_cache_capacity, release_cached_multimessage
+    );
+  }
+
+  return app_message_cache;
+}
+
+/**
+ * @name set_concatenation_reference:
+ *   Replace the reference number in the concatenation header of
+ *   every part of `sms` with `reference`. Both 8-bit and 16-bit
+ *   concatenation headers are supported; the 16-bit form gets a
+ *   reference with a zero high byte. Parts without a concatenation
+ *   header are left unchanged.
+ */
+static void set_concatenation_reference(multimessage_t *sms,
+                                        uint8_t reference) {
+
+  for (unsigned int i = 0; i < sms->Number; i++) {
+
+    message_t *m = &sms->SMS[i];
+    unsigned char *udh = m->UDH.Text;
+
+    /* Walk the information elements */
+    for (int j = 1; j + 1 < m->UDH.Length; j += 2 + udh[j + 1]) {
+
+      if (udh[j] == 0x00 && udh[j + 1] == 3) {
+        udh[j + 2] = reference;
+        m->UDH.ID8bit = reference;
+      } else if (udh[j] == 0x08 && udh[j + 1] == 4) {
+        udh[j + 2] = 0;
+        udh[j + 3] = reference;
+        m->UDH.ID16bit = reference;
+      }
+    }
+  }
+}
+
+/**
+ * @name encode_cached_multimessage:
+ *   Encode a message exactly as `encode_multimessage` does, but
+ *   consult the message cache first. The cache is keyed by the UTF-8
+ *   message body and the settings that affect its encoding; a hit
+ *   skips conversion and encoding entirely, and only the destination
+ *   number is converted. Multipart messages from the cache are given
+ *   a new concatenation reference, so that a recipient can tell two
+ *   copies of the same message apart. On success, the text held by
+ *   `e` is owned by the cache, and is valid until the next call.
+ *   Returns NULL on success, or a constant error string on failure.
+ *   In either case, the caller must call `release_encoded_message`
+ *   on `e`.
+ */
+const char *encode_cached_multimessage(string_slice_t number,
+                                       string_slice_t text,
+                                       const transliteration_table_t *transliterations,
+                                       multimessage_info_t *info,
+                                       multimessage_t *sms,
+                                       encoded_message_t *e) {
+  const char *err;
+
+  if (text.data == NULL) {
+    return encode_multimessage(
+      number, text, transliterations, info, sms, e
+    );
+  }
+
+  cache_t *c = message_cache();
+
+  unsigned int tag = (
+    (transliterations ? 1 : 0) | (app.normalize ? 2 : 0)
+  );
+
+  cached_multimessage_t *m =
+    cache_lookup(c, tag, text.data, text.length);
+
+  /* Hit: copy the parts, then convert only the number */
+  if (m) {
+
+    *e = m->encoded;
+    e->number = NULL;
+    e->is_shared = TRUE;
+
+    if ((err = convert_number(number, e))) {
+      return err;
+    }
+
+    sms->Number = m->parts;
+    memcpy(sms->SMS, m->sms, m->parts * sizeof(*m->sms));
+
+    if (m->parts > 1) {
+      set_concatenation_reference(sms, next_concatenation_reference());
+    }
+
+    return NULL;
+  }
+
+  /* Miss: encode, then hand the encoded text to the cache */
+  if ((err = encode_multimessage(
+        number, text, transliterations, info, sms, e))) {
+    return err;
+  }
+
+  m = allocate(sizeof(*m) + sms->Number * sizeof(*m->sms));
+
+  m->encoded = *e;
+  m->encoded.number = NULL;
+  m->encoded.number_units = 0;
+  m->parts = sms->Number;
+  memcpy(m->sms, sms->SMS, sms->Number * sizeof(*m->sms));
+
+  cache_insert(c, tag, text.data, text.length, m);
+  e->is_shared = TRUE;
+
+  return NULL;
+}
+
+/**
+ * @name action_print_statistics:
+ *   Print counters describing the work done by this process so
+ *   far, as a JSON object. This does not require a device.
+ */
+int action_print_statistics(gammu_state_t **sp,
+                            int argc, char *argv[]) {
+
+  cache_t *c = message_cache();
+
+  printf("{ \"message_cache\": { ");
+  printf("\"entries\": %zu, ", c->count);
+  printf("\"capacity\": %zu, ", c->capacity);
+  printf("\"hits\": %lu, ", c->hits);
+  printf("\"misses\": %lu, ", c->misses);
+  printf("\"evictions\": %lu", c->evictions);
+  printf(" } }\n");
+
+  fflush(stdout);
+  return 0;
+}
+
+/**
+ * @name transliteration_table:
+ *   Return the process-wide transliteration table, creating it
+ *   (with the default replacements) if it doesn't yet exist.
+ */
+transliteration_table_t *transliteration_table(void) {
+
+  if (!app_transliterations) {
+    app_transliterations = create_transliteration_table(TRUE);
+  }
+
+  return app_transliterations;
+}
+
+/**
+ * @name parse_transliteration_line:
+ *   Parse one line of a transliteration table file, and add its
+ *   replacement to `t`. Blank lines and lines starting with `#` are
+ *   ignored. Returns false if the line is malformed.
+ */
+static boolean_t parse_transliteration_line(transliteration_table_t *t,
+                                            char *line) {
+  char *end, *p = line;
+  size_t length = strlen(line);
+
+  /* Tolerate CRLF line endings */
+  if (length > 0 && line[length - 1] == '\r') {
+    line[--length] = '\0';
+  }
+
+  if (line[0] == '\0' || line[0] == '#') {
+    return TRUE;
+  }
+
+  if ((p[0] == 'U' || p[0] == 'u') && p[1] == '+') {
+    p += 2;
+  }
+
+  if (!isxdigit(*p)) {
+    return FALSE;
+  }
+
+  errno = 0;
+  unsigned long c = strtoul(p, &end, 16);
+
+  if (errno != 0 || c > 0x10ffff) {
+    return FALSE;
+  }
+
+  /* No replacement: remove the character */
+  if (*end == '\0') {
+    return transliteration_table_add(t, c, "");
+  }
+
+  if (*end != ' ' && *end != '\t') {
+    return FALSE;
+  }
+
+  return transliteration_table_add(t, c, end + 1);
+}
+
+/**
+ * @name load_transliteration_table:
+ *   Read additional replacements from the file at `path` in to the
+ *   table `t`, overriding any existing replacement for the same
+ *   character. Returns false if the file couldn't be read, or if
+ *   any line in it is malformed.
+ */
+boolean_t load_transliteration_table(transliteration_table_t *t,
+                                     const char *path) {
+  boolean_t rv = TRUE;
+  FILE *stream = fopen(path, "r");
+
+  if (!stream) {
+    return FALSE;
+  }
+
+  for (;;) {
+
+    boolean_t is_eof = FALSE;
+    char *line = read_line(stream, &is_eof);
+
+    if (!line) {
+      rv = FALSE;
+      break;
+    }
+
+    rv = parse_transliteration_line(t, line);
+    free(line);
+
+    if (!rv || is_eof) {
+      break;
+    }
+  }
+
+  fclose(stream);
+  return rv;
+}
+
+/**
+ * @name parse_transliterate_flag:
+ *   If the first argument of the command in `*argv` is `-t` or
+ *   `--transliterate`, remove it by shifting the command name over
+ *   it, and return the transliteration table. Otherwise, return the
+ *   table only if `--transliterate` was given as a global option.
+ */
+static const transliteration_table_t *parse_transliterate_flag(
+  int *argc, char **argv[]) {
+
+  char **v = *argv;
+
+  if (*argc > 1 && (strcmp(v[1], "-t") == 0 ||
+      strcmp(v[1], "--transliterate") == 0)) {
+
+    v[1] = v[0];
+    *argv = &v[1];
+    (*argc)--;
+
+    return transliteration_table();
+  }
+
+  return (app.transliterate ? transliteration_table() : NULL);
+}
+
+/**
+ * @name transmit_multimessage:
+ *   Send each part of the encoded multimessage `sms` to the phone
+ *   number in `status->encoded`, via the message centre `smsc`, and
+ *   wait for each part's result. Per-part results and the number of
+ *   parts sent are recorded in `status`. The status callback must
+ *   already have been registered with `status` as its argument.
+ */
+void transmit_multimessage(gammu_state_t *s, smsc_t *smsc,
+                           multimessage_t *sms, transmit_status_t *status) {
+
+  status->parts_sent = 0;
+  status->parts_total = sms->Number;
+
+  /* For each SMS part... */
+  for (unsigned int i = 0; i < sms->Number; i++) {
+
+    status->finished = FALSE;
+    status->message_part_index = i;
+
+    sms->SMS[i].PDU = SMS_Submit;
+
+    /* Copy destination phone number:
+         This is a fixed-size buffer; size was already checked above.
+         The length is known, so the terminator is copied directly. */
+
+    CopyUnicodeString(sms->SMS[i].SMSC.Number, smsc->Number);
+
+    memcpy(
+      sms->SMS[i].Number, status->encoded.number,
+        2 * (status->encoded.number_units + 1)
+    );
+
+    /* Transmit a single message part */
+    if ((s->err = GSM_SendSMS(s->sm, &sms->SMS[i])) != ERR_NONE) {
+      status->parts[i].err = "Message transmission failed";
+      continue;
+    }
+
+    for (;;) {
+      /* Wait for reply */
+      GSM_ReadDevice(s->sm, TRUE);
+
+      if (status->finished) {
+        break;
+      }
+    }
+
+    if (!status->parts[i].transmitted) {
+      status->parts[i].err = "Message delivery failed";
+      continue;
+    }
+
+    status->parts_sent++;
+  }
+}
+
+/**
+ * @name parse_binary_format_flag:
+ *   If the first argument after the command name is `--hex` or
+ *   `--base64` (or `-x` or `-b`), remove it by shifting the command
+ *   name over it, and return the payload format that it selects.
+ *   Otherwise, return the default format, hexadecimal.
+ */
+static binary_format_t parse_binary_format_flag(int *argc, char **argv[]) {
+
+  char **v = *argv;
+  binary_format_t rv = BINARY_FORMAT_HEX;
+
+  if (*argc <= 1) {
+    return rv;
+  }
+
+  if (strcmp(v[1], "-b") == 0 || strcmp(v[1], "--base64") == 0) {
+    rv = BINARY_FORMAT_BASE64;
+  } else if (strcmp(v[1], "-x") != 0 && strcmp(v[1], "--hex") != 0) {
+    return rv;
+  }
+
+  v[1] = v[0];
+  *argv = &v[1];
+  (*argc)--;
+
+  return rv;
+}
+
+/**
+ * @name send_session_start:
+ *   Prepare `x` to send messages: initialize libgammu if necessary,
+ *   find the SMSC number, and begin printing a JSON array of results.
+ *   If `is_binary` is true, payloads are decoded from `format` and
+ *   sent as 8-bit data; otherwise, they are UTF-8 text, and are
+ *   encoded as described for `encode_multimessage` using
+ *   `transliterations`. Returns zero on success; otherwise, the error
+ *   has been printed, `x` needn't be finished, and the result is the
+ *   command's exit status.
+ */
+static int send_session_start(send_session_t *x, gammu_state_t **sp,
+                              const transliteration_table_t *transliterations,
+                              boolean_t is_binary, binary_format_t format) {
+
+  /* Lazy initialization of libgammu */
+  gammu_state_t *s = gammu_create_if_necessary(sp);
+
+  if (!s) {
+    print_operation_error(OP_ERR_INIT);
+    return 3;
+  }
+
+  /* Allocate */
+  x->s = s;
+  x->smsc = allocate(sizeof(*x->smsc));
+  x->sms = allocate(sizeof(*x->sms));
+  x->info = allocate(sizeof(*x->info));
+
+  x->transliterations = transliterations;
+  x->is_binary = is_binary;
+  x->format = format;
+  x->is_start = TRUE;
+  x->message_index = 0;
+
+  /* Find SMSC number */
+  x->smsc->Location = 1;
+
+  if ((s->err = GSM_GetSMSC(s->sm, x->smsc)) != ERR_NONE) {
+    print_operation_error(OP_ERR_SMSC);
+    free(x->sms);
+    free(x->smsc);
+    free(x->info);
+    return 4;
+  }
+
+  initialize_transmit_status(&x->status);
+
+  GSM_SetSendSMSStatusCallback(
+    s->sm, _message_transmit_callback, &x->status
+  );
+
+  printf("[");
+  return 0;
+}
+
+/**
+ * @name send_session_message:
+ *   Send `text` (or a binary payload) to `number`, and print the
+ *   result as the next element of the session's array.
+ */
+static void send_session_message(send_session_t *x,
+                                 const char *number, const char *text) {
+
+  initialize_transmit_status(&x->status);
+  x->status.message_index = ++x->message_index;
+
+  /* Convert, classify, and encode */
+  if (x->is_binary) {
+    x->status.err = encode_binary_multimessage(
+      argument_slice(number), argument_slice(text),
+        x->format, x->sms, &x->status.encoded
+    );
+  } else {
+    x->status.err = encode_cached_multimessage(
+      argument_slice(number), argument_slice(text),
+        x->transliterations, x->info, x->sms, &x->status.encoded
+    );
+  }
+
+  if (!x->status.err) {
+    transmit_multimessage(x->s, x->smsc, x->sms, &x->status);
+  }
+
+  print_json_transmit_status(x->s, x->sms, &x->status, x->is_start);
+  release_encoded_message(&x->status.encoded);
+  x->is_start = FALSE;
+
+  /* Results are useful as they arrive */
+  fflush(stdout);
+}
+
+/**
+ * @name send_session_finish:
+ *   Finish printing the session's array of results, and free `x`.
+ */
+static void send_session_finish(send_session_t *x) {
+
+  free(x->sms);
+  free(x->smsc);
+  free(x->info);
+
+  printf("]\n");
+  fflush(stdout);
+}
+
+/**
+ * @name send_messages:
+ *   Send each phone number and payload pair in `argv`, printing the
+ *   result of each as it completes. See `send_session_start` for the
+ *   meaning of the remaining arguments.
+ */
+static int send_messages(gammu_state_t **sp, int argc, char *argv[],
+                         const transliteration_table_t *transliterations,
+                         boolean_t is_binary, binary_format_t format) {
+  int rv = 0;
+  char **argp = &argv[1];
+  send_session_t x;
+
+  if (argc <= 2) {
+    print_usage_error(U_ERR_ARGS_MISSING);
+    return 1;
+  }
+
+  if (argc % 2 != 1) {
+    print_usage_error(U_ERR_ARGS_ODD);
+    return 2;
+  }
+
+  rv = send_session_start(&x, sp, transliterations, is_binary, format);
+
+  if (rv != 0) {
+    return rv;
+  }
+
+  /* For each message... */
+  while (*argp != NULL) {
+
+    char *number = *argp++;
+    char *text = (*argp != NULL ? *argp++ : NULL);
+
+    send_session_message(&x, number, text);
+  }
+
+  send_session_finish(&x);
+  return rv;
+}
+
+/**
+ * @name action_send_messages:
+ */
+int action_send_messages(gammu_state_t **sp,
+                         int argc, char *argv[]) {
+
+  const transliteration_table_t *transliterations =
+    parse_transliterate_flag(&argc, &argv);
+
+  return send_messages(
+    sp, argc, argv, transliterations, FALSE, BINARY_FORMAT_HEX
+  );
+}
+
+/**
+ * @name action_send_binary_messages:
+ */
+int action_send_binary_messages(gammu_state_t **sp,
+                                int argc, char *argv[]) {
+
+  binary_format_t format = parse_binary_format_flag(&argc, &argv);
+  return send_messages(sp, argc, argv, NULL, TRUE, format);
+}
+
+/** --- **/
+
+/**
+ * @name broadcast_recipients_t:
+ *   A source of phone numbers for `broadcast`: either the remaining
+ *   command-line arguments, or a file containing one number per line.
+ */
+typedef struct broadcast_recipients {
+
+  char **argp;
+  FILE *stream;
+  boolean_t eof;
+  char *line;
+
+} broadcast_recipients_t;
+
+/**
+ * @name next_broadcast_recipient:
+ *   Return the next phone number from `r`, or NULL if there are
+ *   no more. Blank lines in a recipient file are skipped, as are
+ *   carriage returns at the end of a line. The returned string is
+ *   valid until the next call.
+ */
+static char *next_broadcast_recipient(broadcast_recipients_t *r) {
+
+  if (!r->stream) {
+    return (*r->argp != NULL ? *r->argp++ : NULL);
+  }
+
+  for (;;) {
+
+    free(r->line);
+    r->line = NULL;
+
+    if (r->eof || !(r->line = read_line(r->stream, &r->eof))) {
+      return NULL;
+    }
+
+    size_t length = strlen(r->line);
+
+    if (length > 0 && r->line[length - 1] == '\r') {
+      r->line[--length] = '\0';
+    }
+
+    if (length > 0) {
+      return r->line;
+    }
+  }
+}
+
+/**
+ * @name clone_multimessage:
+ *   Copy the encoded parts of `from` in to `to`. Only the parts that
+ *   are in use are copied; each is later given its own destination
+ *   number by `transmit_multimessage`.
+ */
+static void clone_multimessage(multimessage_t *to,
+                               const multimessage_t *from) {
+
+  to->Number = from->Number;
+  memcpy(to->SMS, from->SMS, from->Number * sizeof(*from->SMS));
+}
+
+/**
+ * @name action_broadcast_message:
+ *   Send one message to many recipients. The text is converted,
+ *   classified, and encoded exactly once; each recipient then gets a
+ *   copy of the encoded parts, with only the destination number
+ *   changed. Results are printed for each recipient as they complete,
+ *   in the same format used by `send`.
+ */
+int action_broadcast_message(gammu_state_t **sp,
+                             int argc, char *argv[]) {
+  int rv = 0;
+
+  const transliteration_table_t *transliterations =
+    parse_transliterate_flag(&argc, &argv);
+
+  broadcast_recipients_t r = { &argv[2], NULL, FALSE, NULL };
+
+  if (argc <= 2) {
+    print_usage_error(U_ERR_ARGS_MISSING);
+    return 1;
+  }
+
+  char *text = argv[1];
+
+  /* Recipients from a file */
+  if (strcmp(argv[2], "-f") == 0 || strcmp(argv[2], "--file") == 0) {
+
+    if (argc != 4) {
+      print_usage_error(argc < 4 ? U_ERR_ARGS_MISSING : U_ERR_ARGS_INVAL);
+      return 1;
+    }
+
+    if (!(r.stream = fopen(argv[3], "r"))) {
+      print_operation_error(OP_ERR_RECIPIENTS);
+      return 2;
+    }
+  }
+
+  /* Lazy initialization of libgammu */
+  gammu_state_t *s = gammu_create_if_necessary(sp);
+
+  if (!s) {
+    print_operation_error(OP_ERR_INIT);
+    rv = 3; goto cleanup;
+  }
+
+  /* Allocate */
+  smsc_t *smsc = allocate(sizeof(*smsc));
+  multimessage_t *sms = allocate(sizeof(*sms));
+  multimessage_t *clone = allocate(sizeof(*clone));
+  multimessage_info_t *info = allocate(sizeof(*info));
+
+  /* Find SMSC number */
+  smsc->Location = 1;
+
+  if ((s->err = GSM_GetSMSC(s->sm, smsc)) != ERR_NONE) {
+    print_operation_error(OP_ERR_SMSC);
+    rv = 4; goto cleanup_sms;
+  }
+
+  /* Convert, classify, and encode, once:
+      The destination number is supplied per recipient, below. */
+
+  encoded_message_t e;
+
+  const char *err = encode_multimessage(
+    utf8_slice(""), argument_slice(text), transliterations, info, sms, &e
+  );
+
+  transmit_status_t status;
+  initialize_transmit_status(&status);
+
+  GSM_SetSendSMSStatusCallback(
+    s->sm, _message_transmit_callback, &status
+  );
+
+  char *number;
+  boolean_t is_start = TRUE;
+  unsigned int message_index = 0;
+
+  printf("[");
+
+  /* For each recipient... */
+  while ((number = next_broadcast_recipient(&r)) != NULL) {
+
+    initialize_transmit_status(&status);
+    status.message_index = ++message_index;
+
+    /* Share the encoded text; convert only the number */
+    status.encoded = e;
+    status.encoded.number = NULL;
+    status.encoded.is_shared = TRUE;
+
+    if (!(status.err = err)) {
+      status.err = convert_number(argument_slice(number), &status.encoded);
+    }
+
+    if (!status.err) {
+      clone_multimessage(clone, sms);
+      transmit_multimessage(s, smsc, clone, &status);
+    }
+
+    print_json_transmit_status(s, clone, &status, is_start);
+    release_encoded_message(&status.encoded);
+    is_start = FALSE;
+  }
+
+  printf("]\n");
+  release_encoded_message(&e);
+
+  cleanup_sms:
+
+    free(sms);
+    free(smsc);
+    free(clone);
+    free(info);
+
+  cleanup:
+
+    if (r.stream) {
+      fclose(r.stream);
+    }
+
+    free(r.line);
+    return rv;
+}
+
+/** --- **/
+
+/**
+ * @name _plan_worker:
+ *   Thread entry point for the `plan` command. Repeatedly claims
+ *   a block of messages from the shared state `x`, and plans each
+ *   message in the block, until no unclaimed messages remain. This
+ *   never calls in to libgammu, so workers never wait on each other.
+ */
+static void *_plan_worker(void *x) {
+
+  plan_state_t *p = (plan_state_t *) x;
+
+  for (;;) {
+
+    unsigned int start =
+      __sync_fetch_and_add(&p->next, plan_block_size);
+
+    if (start >= p->count) {
+      break;
+    }
+
+    unsigned int end = start + plan_block_size;
+
+    if (end > p->count) {
+      end = p->count;
+    }
+
+    for (unsigned int i = start; i < end; ++i) {
+
+      plan_result_t *r = &p->results[i];
+
+      r->err = plan_multimessage(
+        argument_slice(p->argv[2 * i]), argument_slice(p->argv[2 * i + 1]),
+          p->transliterations, &r->encoded, &r->parts
+      );
+
+      release_encoded_message(&r->encoded);
+    }
+  }
+
+  /* Descriptors are per-thread */
+  release_conversion_descriptors();
+  return NULL;
+}
+
+/**
+ * @name plan_thread_count:
+ *   Choose the number of threads to use when planning `count`
+ *   messages: one per online processor, but never so many that
+ *   a thread has fewer than `plan_messages_per_thread` messages.
+ */
+static unsigned int plan_thread_count(unsigned int count) {
+
+  long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  unsigned int rv = count / plan_messages_per_thread;
+
+  if (cpus > 0 && rv > cpus) {
+    rv = cpus;
+  }
+
+  if (rv > plan_threads_maximum) {
+    rv = plan_threads_maximum;
+  }
+
+  return (rv > 0 ? rv : 1);
+}
+
+/**
+ * @name print_json_plan_results:
+ */
+void print_json_plan_results(plan_state_t *p) {
+
+  unsigned int errors = 0, gsm = 0, national = 0, utf16 = 0;
+  unsigned long parts = 0, saved = 0, septets = 0, units = 0;
+  unsigned long substitutions = 0, substitution_saved = 0;
+
+  printf("{ \"detail\": [");
+
+  for (unsigned int i = 0; i < p->count; ++i) {
+
+    plan_result_t *r = &p->results[i];
+
+    if (i != 0) {
+      printf(", ");
+    }
+
+    printf("{ ");
+    printf("\"index\": %u, ", i + 1);
+
+    if (r->err) {
+      printf("\"result\": \"error\", ");
+      printf("\"error\": \"%s\"", r->err); /* const */
+      print_json_decode_error(&r->encoded);
+      printf(" }");
+      errors++;
+      continue;
+    }
+
+    printf("\"result\": \"success\", ");
+    print_json_encoding_info(&r->encoded);
+    printf("\"parts\": %u", r->parts);
+    printf(" }");
+
+    if (r->encoded.is_gsm) {
+      gsm++;
+      septets += r->encoded.segments.septets;
+    } else if (r->encoded.is_national) {
+      gsm++;
+      national++;
+      septets += r->encoded.national.septets;
+      saved += r->encoded.segments.ucs2_parts - r->encoded.national.parts;
+    } else {
+      utf16++;
+    }
+
+    parts += r->parts;
+    units += r->encoded.segments.units;
+    substitutions += r->encoded.substitutions;
+    substitution_saved += r->encoded.substitution_parts_saved;
+  }
+
+  printf("], ");
+
+  printf("\"totals\": { ");
+  printf("\"messages\": %u, ", p->count);
+  printf("\"errors\": %u, ", errors);
+  printf("\"gsm\": %u, ", gsm);
+  printf("\"national_language\": %u, ", national);
+  printf("\"utf-16\": %u, ", utf16);
+  printf("\"septets\": %lu, ", septets);
+  printf("\"units\": %lu, ", units);
+  printf("\"parts\": %lu, ", parts);
+  printf("\"parts_saved\": %lu, ", saved);
+  printf("\"substitutions\": %lu, ", substitutions);
+  printf("\"substitution_parts_saved\": %lu", substitution_saved);
+  printf(" }, ");
+
+  if (errors == 0) {
+    printf("\"result\": \"success\"");
+  } else if (errors < p->count) {
+    printf("\"result\": \"partial\"");
+  } else {
+    printf("\"result\": \"error\"");
+  }
+
+  printf(" }\n");
+  fflush(stdout);
+}
+
+/**
+ * @name action_plan_messages:
+ *   Convert, classify, and encode messages exactly as `send` would,
+ *   without initializing libgammu or using a device. Large batches
+ *   are spread across a pool of worker threads; results are always
+ *   printed in the same order as the messages were provided.
+ */
+int action_plan_messages(gammu_state_t **sp,
+                         int argc, char *argv[]) {
+
+  int rv = 0;
+
+  const transliteration_table_t *transliterations =
+    parse_transliterate_flag(&argc, &argv);
+
+  if (argc <= 2) {
+    print_usage_error(U_ERR_ARGS_MISSING);
+    return 1;
+  }
+
+  if (argc % 2 != 1) {
+    print_usage_error(U_ERR_ARGS_ODD);
+    return 2;
+  }
+
+  plan_state_t p;
+
+  p.next = 0;
+  p.argv = &argv[1];
+  p.transliterations = transliterations;
+  p.count = (argc - 1) / 2;
+  p.results = allocate_array(sizeof(plan_result_t), p.count, 0);
+
+  unsigned int threads = plan_thread_count(p.count);
+  pthread_t *pool = allocate_array(sizeof(pthread_t), threads, 0);
+
+  unsigned int started = 0;
+
+  /* Start worker threads:
+      The calling thread does its share of the work too. */
+
+  for (unsigned int i = 1; i < threads; ++i) {
+    if (pthread_create(&pool[started], NULL, _plan_worker, &p) != 0) {
+      break;
+    }
+    started++;
+  }
+
+  _plan_worker(&p);
+
+  for (unsigned int i = 0; i < started; ++i) {
+    pthread_join(pool[i], NULL);
+  }
+
+  print_json_plan_results(&p);
+
+  free(pool);
+  free(p.results);
+
+  return rv;
+}
+
+/** --- **/
+
+/**
+ * @name encode_pdu_multimessage:
+ *   Split the message `e`, already prepared by `prepare_multimessage`,
+ *   in to one SMS-SUBMIT PDU per part, addressed to the UTF-8 phone
+ *   number `number`. As with `send`, every part is a class 1 message.
+ *   Parts are written to `parts`, which must have room for
+ *   `GSM_MAX_MULTI_SMS` messages, and their number to `count`. This
+ *   doesn't use libgammu. Returns NULL on success, or a constant
+ *   error string on failure.
+ */
+const char *encode_pdu_multimessage(string_slice_t number,
+                                    encoded_message_t *e,
+                                    pdu_message_t *parts,
+                                    unsigned int *count) {
+  pdu_message_t base;
+  gsm_national_info_t tables;
+  const gsm_national_info_t *n = NULL;
+
+  pdu_initialize(&base, PDU_SUBMIT);
+  base.message_class = 1;
+
+  if (!pdu_set_address(&base, number)) {
+    return "Phone number cannot be encoded in a PDU";
+  }
+
+  /* Default alphabet and extension table */
+  if (e->is_gsm) {
+    memset(&tables, 0, sizeof(tables));
+    n = &tables;
+  }
+
+  if (e->is_national) {
+    n = &e->national;
+  }
+
+  *count = pdu_split_utf16be(
+    &base, e->text, n, next_concatenation_reference(),
+      parts, GSM_MAX_MULTI_SMS
+  );
+
+  if (*count == 0) {
+    return "Message is too long";
+  }
+
+  return NULL;
+}
+
+/**
+ * @name print_json_encode_result:
+ *   Print the result of encoding message number `index`: either the
+ *   error `err`, or the encoding information for `e` followed by the
+ *   content, hexadecimal PDU, and TPDU length of each of the `count`
+ *   parts in `parts`. The TPDU length is the value that AT+CMGS
+ *   expects; it excludes the leading service centre address.
+ */
+void print_json_encode_result(unsigned int index, const char *err,
+                              encoded_message_t *e, pdu_message_t *parts,
+                              unsigned int count, boolean_t is_start) {
+  if (!is_start) {
+    printf(", ");
+  }
+
+  printf("{ ");
+  printf("\"index\": %u, ", index);
+
+  if (err) {
+    printf("\"result\": \"error\", ");
+    printf("\"error\": \"%s\"", err); /* const */
+    print_json_decode_error(e);
+    printf(" }");
+    return;
+  }
+
+  printf("\"result\": \"success\", ");
+  print_json_encoding_info(e);
+
+  printf("\"parts_total\": %u, ", count);
+  printf("\"parts\": [");
+
+  for (unsigned int i = 0; i < count; ++i) {
+
+    size_t tpdu_length;
+    uint8_t pdu[pdu_octets_maximum];
+    char hex[2 * pdu_octets_maximum + 1];
+    char text[2 * (sms_gsm_single_septets + 1)];
+
+    if (i != 0) {
+      printf(", ");
+    }
+
+    printf("{ ");
+
+    size_t length = pdu_encode(&parts[i], pdu, &tpdu_length);
+
+    if (length == 0) {
+      printf("\"result\": \"error\", ");
+      printf("\"error\": \"Failed to encode message part\", ");
+    } else {
+      printf("\"result\": \"success\", ");
+      size_t units = pdu_text_utf16be(&parts[i], text);
+      print_json_utf16be_property(
+        "content", utf16be_slice_units(text, units)
+      );
+      octets_encode_hex(pdu, length, hex);
+      printf("\"pdu\": \"%s\", ", hex);
+      printf("\"tpdu_length\": %zu, ", tpdu_length);
+    }
+
+    printf("\"index\": %u", i + 1);
+    printf(" }");
+  }
+
+  printf("] }");
+  fflush(stdout);
+}
+
+/**
+ * @name action_encode_messages:
+ *   Convert, classify, and split messages as `send` would, then
+ *   encode each part as a hexadecimal SMS-SUBMIT PDU using our own
+ *   encoder, without initializing libgammu or using a device.
+ */
+int action_encode_messages(gammu_state_t **sp,
+                           int argc, char *argv[]) {
+
+  const transliteration_table_t *transliterations =
+    parse_transliterate_flag(&argc, &argv);
+
+  char **argp = &argv[1];
+
+  if (argc <= 2) {
+    print_usage_error(U_ERR_ARGS_MISSING);
+    return 1;
+  }
+
+  if (argc % 2 != 1) {
+    print_usage_error(U_ERR_ARGS_ODD);
+    return 2;
+  }
+
+  pdu_message_t *parts =
+    allocate_array(sizeof(pdu_message_t), GSM_MAX_MULTI_SMS, 0);
+
+  boolean_t is_start = TRUE;
+  unsigned int message_index = 0;
+
+  printf("[");
+
+  /* For each message... */
+  while (*argp != NULL) {
+
+    encoded_message_t e;
+    unsigned int count = 0;
+
+    string_slice_t number = argument_slice(*argp++);
+    string_slice_t text = argument_slice(*argp++);
+
+    const char *err = prepare_multimessage(
+      number, text, transliterations, &e
+    );
+
+    if (!err) {
+      err = encode_pdu_multimessage(number, &e, parts, &count);
+    }
+
+    print_json_encode_result(
+      ++message_index, err, &e, parts, count, is_start
+    );
+
+    release_encoded_message(&e);
+    is_start = FALSE;
+  }
+
+  printf("]\n");
+  free(parts);
+
+  return 0;
+}
+
+/**
+ * @name parse_global_arguments:
+ */
+int parse_global_arguments(int argc, char *argv[], app_options_t *o) {
+
+  int rv = 0;
+  char **argp = argv;
+
+  while (*argp != NULL) {
+
+    if (strcmp(*argp, "-h") == 0 || strcmp(*argp, "--help") == 0) {
+      o->help = TRUE;
+      break;
+    }
+
+    if (strcmp(*argp, "-c") == 0 || strcmp(*argp, "--config") == 0) {
+
+      if (*++argp == NULL) {
+        print_usage_error(U_ERR_CONFIG_MISSING);
+        o->invalid = TRUE;
+        break;
+      }
+
+      o->gammu_configuration_path = *argp++;
+      rv += 2;
+
+      continue;
+    }
+
+    if (strcmp(*argp, "-v") == 0 || strcmp(*argp, "--verbose") == 0) {
+      o->verbose = TRUE;
+      ++argp; ++rv;
+      continue;
+    }
+
+    if (strcmp(*argp, "-t") == 0 ||
+        strcmp(*argp, "--transliterate") == 0) {
+      o->transliterate = TRUE;
+      ++argp; ++rv;
+      continue;
+    }
+
+    if (strcmp(*argp, "-T") == 0 ||
+        strcmp(*argp, "--transliteration-table") == 0) {
+
+      if (*++argp == NULL) {
+        print_usage_error(U_ERR_TABLE_MISSING);
+        o->invalid = TRUE;
+        break;
+      }
+
+      o->transliteration_table_path = *argp++;
+      rv += 2;
+
+      continue;
+    }
+
+    if (strcmp(*argp, "-n") == 0 || strcmp(*argp, "--normalize") == 0) {
+      o->normalize = TRUE;
+      ++argp; ++rv;
+      continue;
+    }
+
+    if (strcmp(*argp, "-s") == 0 || strcmp(*argp, "--stream") == 0) {
+
+      /* Errors are reported as they are in REPL mode */
+      o->repl = o->stream = TRUE;
+      ++argp; ++rv;
+
+      continue;
     }
 
     if (strcmp(*argp, "-r") == 0 || strcmp(*argp, "--repl") == 0) {
@@ -1252,7 +3257,8 @@ int parse_global_arguments(int argc, char *argv[], app_options_t *o) {
  * @name process_command:
  *   Execute a command, based upon the arguments provided.
  *   The `argv[0]` argument should contain a single command
- *   (currently either `send`, `retrieve`, or `delete`); the
+ *   (currently `send`, `send-binary`, `broadcast`, `plan`, `encode`,
+ *   `stats`, `retrieve`, or `delete`); the
  *   remaining items in `argv` are parameters to be provided to
  *   the specified command. Return `true` if a command was
  *   executed (whether successfully or resulting in an error),
@@ -1287,39 +3293,85 @@ boolean_t process_command(gammu_state_t **s,
     return TRUE;
   }
 
+  /* Option #4:
+   *   Encode one or more messages without sending them. */
+
+  if (argc > 0 && strcmp(argv[0], "plan") == 0) {
+    *rv = action_plan_messages(s, argc, argv);
+    return TRUE;
+  }
+
+  /* Option #5:
+   *   Send one or more binary payloads as 8-bit data messages. */
+
+  if (argc > 0 && strcmp(argv[0], "send-binary") == 0) {
+    *rv = action_send_binary_messages(s, argc, argv);
+    return TRUE;
+  }
+
+  /* Option #6:
+   *   Send one message to many recipients, encoding it only once. */
+
+  if (argc > 0 && strcmp(argv[0], "broadcast") == 0) {
+    *rv = action_broadcast_message(s, argc, argv);
+    return TRUE;
+  }
+
+  /* Option #7:
+   *   Encode one or more messages as PDUs, without a device. */
+
+  if (argc > 0 && strcmp(argv[0], "encode") == 0) {
+    *rv = action_encode_messages(s, argc, argv);
+    return TRUE;
+  }
+
+  /* Option #8:
+   *   Print statistics for this process, without a device. */
+
+  if (argc > 0 && strcmp(argv[0], "stats") == 0) {
+    *rv = action_print_statistics(s, argc, argv);
+    return TRUE;
+  }
+
   return FALSE;
 }
 
 /**
  * @name process_repl_commands:
+ *   Read, execute, and print the result of each line of JSON from
+ *   `stream`, until end-of-file. A single parser context is used for
+ *   the whole session, so the line buffer, token array, and argument
+ *   vector are reused from one command to the next.
  */
 void process_repl_commands(gammu_state_t **s, FILE *stream) {
 
+  json_context_t *c = json_context_create(repl_shrink_interval);
+
   for (;;) {
 
     boolean_t is_eof = FALSE;
-    char *line = read_line(stream, &is_eof);
+
+    char *line =
+      read_line_into(stream, &c->line, &c->line_size, &is_eof);
 
     if (!line) {
       break;
     }
 
     if (is_eof && line[0] == '\0') {
-      goto cleanup;
+      break;
     }
 
-    parsed_json_t *p = parse_json(line);
-
-    if (p) {
+    if (json_context_parse(c, line)) {
 
       char **argv = NULL;
       int argc = 0, err = 0;
 
-      boolean_t rv = parsed_json_to_arguments(p, &argc, &argv, &err);
+      boolean_t rv = json_context_arguments(c, &argc, &argv, &err);
 
       if (!rv) {
         print_json_validation_error(err);
-        goto cleanup_json;
+        goto cleanup;
       }
 
       int result = 0;
@@ -1329,27 +3381,264 @@ void process_repl_commands(gammu_state_t **s, FILE *stream) {
         if (!result) {
           print_usage_error(U_ERR_CMD_INVAL);
         }
-        goto cleanup_json;
+        goto cleanup;
       }
 
     } else {
       print_json_validation_error(V_ERR_PARSE);
     }
 
-    cleanup_json:
-
-      if (p) {
-        release_parsed_json(p);
-      }
-
     cleanup:
 
-      free(line);
+      json_context_finish(c);
 
       if (is_eof) {
         break;
       }
   }
+
+  json_context_destroy(c);
+}
+
+/**
+ * @name stream_copy:
+ */
+static char *stream_copy(const char *s, size_t length) {
+
+  char *rv = allocate_array(sizeof(char), length, 1);
+
+  memcpy(rv, s, length);
+  rv[length] = '\0';
+
+  return rv;
+}
+
+/**
+ * @name stream_command_reset:
+ *   Free everything held for the current command, except for the
+ *   argument vector itself, which is reused.
+ */
+static void stream_command_reset(stream_command_t *c) {
+
+  for (unsigned int i = 1; i <= c->argc; ++i) {
+    free(c->argv[i]);
+  }
+
+  free(c->command);
+  free(c->number);
+
+  c->command = c->number = NULL;
+  c->is_send = c->is_started = c->transliterate = FALSE;
+  c->start_result = c->err = 0;
+  c->seen = c->argc = 0;
+}
+
+/**
+ * @name stream_command_reserve:
+ *   Ensure that the argument vector of `c` has room for the command,
+ *   one more argument, and a null terminator.
+ */
+static boolean_t stream_command_reserve(stream_command_t *c) {
+
+  if (c->argc + 3 <= c->argv_size) {
+    return TRUE;
+  }
+
+  unsigned int n = (c->argv_size ? c->argv_size * 2 : 16);
+  char **v = reallocate_array(c->argv, sizeof(char *), n, 0);
+
+  if (!v) {
+    return FALSE;
+  }
+
+  c->argv = v;
+  c->argv_size = n;
+
+  return TRUE;
+}
+
+/**
+ * @name _stream_command:
+ *   Handles the `command` property. A `send` command whose arguments
+ *   haven't started yet is streamed; once messages have been sent,
+ *   a later `command` property can't change it, and is ignored.
+ */
+static void _stream_command(void *x, const char *s, size_t length) {
+
+  stream_command_t *c = (stream_command_t *) x;
+
+  if (c->is_send && c->seen > 0) {
+    return;
+  }
+
+  free(c->command);
+  c->command = stream_copy(s, length);
+  c->is_send = (c->argc == 0 && strcmp(s, "send") == 0);
+}
+
+/**
+ * @name _stream_argument:
+ *   Handles each element of the `arguments` array.
+ */
+static void _stream_argument(void *x, const char *s, size_t length) {
+
+  stream_command_t *c = (stream_command_t *) x;
+
+  /* Any other command: keep the argument until the end */
+  if (!c->is_send) {
+
+    if (!stream_command_reserve(c)) {
+      c->err = V_ERR_MEM_ALLOC;
+      return;
+    }
+
+    c->argv[++c->argc] = stream_copy(s, length);
+    return;
+  }
+
+  /* Already reported */
+  if (c->start_result != 0) {
+    return;
+  }
+
+  /* Leading flag, as accepted by `parse_transliterate_flag` */
+  if (++c->seen == 1 &&
+      (strcmp(s, "-t") == 0 || strcmp(s, "--transliterate") == 0)) {
+    c->transliterate = TRUE;
+    return;
+  }
+
+  if (!c->number) {
+    c->number = stream_copy(s, length);
+    return;
+  }
+
+  /* The first complete pair starts the session */
+  if (!c->is_started) {
+
+    const transliteration_table_t *t = (
+      c->transliterate || app.transliterate ?
+        transliteration_table() : NULL
+    );
+
+    c->start_result = send_session_start(
+      &c->session, c->sp, t, FALSE, BINARY_FORMAT_HEX
+    );
+
+    if (c->start_result != 0) {
+      return;
+    }
+
+    c->is_started = TRUE;
+  }
+
+  send_session_message(&c->session, c->number, s);
+
+  free(c->number);
+  c->number = NULL;
+}
+
+/**
+ * @name _stream_end:
+ *   Handles the end of each command. A streamed `send` closes its
+ *   array of results; any error is then printed on its own line.
+ *   Any other command is run as it would be in REPL mode.
+ */
+static void _stream_end(void *x, json_validation_error_t err) {
+
+  stream_command_t *c = (stream_command_t *) x;
+
+  if (c->is_send) {
+
+    if (c->is_started) {
+      send_session_finish(&c->session);
+    }
+
+    if (err != V_ERR_NONE) {
+      print_json_validation_error(err);
+    } else if (c->start_result != 0) {
+      /* Already reported */
+    } else if (!c->is_started) {
+      print_usage_error(U_ERR_ARGS_MISSING);
+    } else if (c->number) {
+      print_usage_error(U_ERR_ARGS_ODD);
+    }
+
+  } else if (err != V_ERR_NONE || c->err != 0) {
+
+    print_json_validation_error(err != V_ERR_NONE ? err : c->err);
+
+  } else if (stream_command_reserve(c)) {
+
+    int result = 0;
+
+    /* Commands may rearrange their argument vector:
+     *   Pass a copy, so that every argument can still be freed. */
+
+    char **argv = allocate_array(sizeof(char *), c->argc + 2, 0);
+
+    memcpy(argv + 1, c->argv + 1, c->argc * sizeof(char *));
+    argv[0] = c->command;
+    argv[c->argc + 1] = NULL;
+
+    if (!process_command(c->sp, c->argc + 1, argv, &result)) {
+      if (!result) {
+        print_usage_error(U_ERR_CMD_INVAL);
+      }
+    }
+
+    free(argv);
+
+  } else {
+    print_json_validation_error(V_ERR_MEM_ALLOC);
+  }
+
+  stream_command_reset(c);
+}
+
+/**
+ * @name process_stream_commands:
+ *   Read JSON commands from the file descriptor `fd` until end-of-
+ *   file, and execute each one while it's being read. Input is
+ *   consumed in chunks of whatever size is available, so commands
+ *   needn't be separated by newlines, and no command is limited in
+ *   size; see `json_stream_t` and `stream_command_t`.
+ */
+void process_stream_commands(gammu_state_t **s, int fd) {
+
+  char chunk[stream_chunk_size];
+
+  stream_command_t c;
+
+  memset(&c, 0, sizeof(c));
+  c.sp = s;
+
+  json_stream_handler_t h = {
+    _stream_command, _stream_argument, _stream_end, &c
+  };
+
+  json_stream_t *j = json_stream_create(&h);
+
+  for (;;) {
+
+    ssize_t n = read(fd, chunk, sizeof(chunk));
+
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+
+    if (n <= 0) {
+      break;
+    }
+
+    json_stream_feed(j, chunk, n);
+  }
+
+  json_stream_finish(j);
+  json_stream_destroy(j);
+
+  stream_command_reset(&c);
+  free(c.argv);
 }
 
 /**
@@ -1381,6 +3670,15 @@ int main(int argc, char *argv[]) {
   argc -= n;
   argp += n;
 
+  /* Additional transliterations */
+  if (app.transliteration_table_path) {
+    if (!load_transliteration_table(transliteration_table(),
+                                    app.transliteration_table_path)) {
+      print_usage_error(U_ERR_TABLE_INVAL);
+      goto cleanup;
+    }
+  }
+
   /* Execute command:
    *   This runs the operation provided via command-line arguments. */
 
@@ -1398,7 +3696,9 @@ int main(int argc, char *argv[]) {
    *  them in to command/arguments tuples, dispatch these tuples
    *  to `process_command`, and repeat until reaching end-of-file. */
 
-  if (app.repl) {
+  if (app.stream) {
+    process_stream_commands(&s, fileno(stdin));
+  } else if (app.repl) {
     process_repl_commands(&s, stdin);
   }
 
@@ -1408,6 +3708,15 @@ int main(int argc, char *argv[]) {
       gammu_destroy(s);
     }
 
+    if (app_transliterations) {
+      release_transliteration_table(app_transliterations);
+    }
+
+    if (app_message_cache) {
+      cache_destroy(app_message_cache);
+    }
+
+    release_conversion_descriptors();
     return rv;
 }
 
@@ -43,10 +43,14 @@ typedef struct app_options {
 
   boolean_t help;
   boolean_t repl;
+  boolean_t stream;
   boolean_t invalid;
   boolean_t verbose;
+  boolean_t normalize;
+  boolean_t transliterate;
   char *application_name;
   char *gammu_configuration_path;
+  char *transliteration_table_path;
 
 } app_options_t;
 
@@ -58,6 +62,9 @@ typedef struct gammu_state {
   int err;
   GSM_StateMachine *sm;
 
+  /* Reused by `for_each_message` */
+  GSM_MultiSMSMessage *messages;
+
 } gammu_state_t;
 
 /**
@@ -93,6 +100,90 @@ typedef boolean_t (*message_iterate_fn_t)(
 );
 
 
+/**
+ * @name encoded_message_t:
+ */
+typedef struct encoded_message {
+
+  char *number;
+  char *text;
+
+  size_t number_units;
+  size_t units;
+
+  string_decode_error_t decode_error;
+  size_t decode_error_offset;
+
+  boolean_t is_gsm;
+  sms_segment_info_t segments;
+  codepoint_t non_gsm_codepoint;
+  size_t compositions;
+
+  size_t substitutions;
+  unsigned int substitution_parts_saved;
+
+  boolean_t is_national;
+  gsm_national_info_t national;
+  size_t *part_offsets;
+
+  /* Binary messages:
+      When `is_binary` is set, `text` holds `octets` octets of
+      user data, rather than UTF-16BE text. */
+
+  boolean_t is_binary;
+  size_t octets;
+  unsigned int octet_parts;
+
+  /* Shared encoding:
+      When `is_shared` is set, `text` and `part_offsets` belong to
+      someone else (e.g. the message cache), and only `number` is
+      freed by `release_encoded_message`. */
+
+  boolean_t is_shared;
+
+} encoded_message_t;
+
+/**
+ * @name cached_multimessage_t:
+ *   An entry in the message cache: the result of encoding a single
+ *   message body, without a destination number. Only the parts that
+ *   are in use are stored.
+ */
+typedef struct cached_multimessage {
+
+  encoded_message_t encoded;
+  unsigned int parts;
+  message_t sms[];
+
+} cached_multimessage_t;
+
+/**
+ * @name message_cache_capacity:
+ *   The maximum number of encoded message bodies kept by the
+ *   message cache used by `send`.
+ */
+#define message_cache_capacity  (64)
+
+/**
+ * @name binary_format_t:
+ *   The textual representation of binary data: payloads provided to
+ *   `send-binary`, and 8-bit message content printed by `retrieve`.
+ */
+typedef enum {
+  BINARY_FORMAT_HEX = 0, BINARY_FORMAT_BASE64
+} binary_format_t;
+
+/**
+ * @name retrieve_options_t:
+ *   Options for `retrieve`, passed to `print_message_json_utf8`.
+ */
+typedef struct retrieve_options {
+
+  binary_format_t format;
+  boolean_t include_udh;
+
+} retrieve_options_t;
+
 /**
  * @name part_transmit_status_t:
  */
@@ -119,8 +210,37 @@ typedef struct transmit_status {
   int message_part_index;
   part_transmit_status_t parts[GSM_MAX_MULTI_SMS];
 
+  encoded_message_t encoded;
+
 } transmit_status_t;
 
+/**
+ * @name plan_result_t:
+ */
+typedef struct plan_result {
+
+  const char *err;
+  unsigned int parts;
+  encoded_message_t encoded;
+
+} plan_result_t;
+
+/**
+ * @name plan_state_t:
+ *   Work shared between the threads of a `plan` command. Each
+ *   thread claims blocks of messages by atomically advancing `next`.
+ */
+typedef struct plan_state {
+
+  char **argv;
+  plan_result_t *results;
+  const transliteration_table_t *transliterations;
+
+  unsigned int count;
+  unsigned int next;
+
+} plan_state_t;
+
 /**
  * @name delete_status_t:
  */
@@ -160,13 +280,66 @@ typedef void (*delete_callback_fn_t)(
   gammu_state_t *, message_t *, delete_stage_t, void *
 );
 
+/**
+ * @name send_session_t:
+ *   The state needed to send a series of messages and print their
+ *   results as a single JSON array, one message at a time. See
+ *   `send_session_start`.
+ */
+typedef struct send_session {
+
+  gammu_state_t *s;
+  smsc_t *smsc;
+  multimessage_t *sms;
+  multimessage_info_t *info;
+  transmit_status_t status;
+
+  const transliteration_table_t *transliterations;
+  boolean_t is_binary;
+  binary_format_t format;
+
+  boolean_t is_start;
+  unsigned int message_index;
+
+} send_session_t;
+
+/**
+ * @name stream_command_t:
+ *   The command being read in streaming mode. Arguments to `send`
+ *   are sent in pairs as soon as they're read, and only a pending
+ *   phone number is kept; any other command's arguments are kept
+ *   until the command is complete, then run as in REPL mode.
+ */
+typedef struct stream_command {
+
+  gammu_state_t **sp;
+
+  char *command;
+  boolean_t is_send;
+
+  /* Streaming `send` */
+  boolean_t is_started;
+  boolean_t transliterate;
+  int start_result;
+  char *number;
+  unsigned int seen;
+  send_session_t session;
+
+  /* Any other command */
+  char **argv;
+  unsigned int argc;
+  unsigned int argv_size;
+  int err;
+
+} stream_command_t;
+
 /**
  * @name operation_error_t:
  */
 typedef enum {
   OP_ERR_NONE = 0, OP_ERR_INIT, OP_ERR_SMSC,
   OP_ERR_RETRIEVE, OP_ERR_LOCATION, OP_ERR_INDEX,
-  OP_ERR_DELETE, OP_ERR_JSON, OP_ERR_BARRIER,
+  OP_ERR_DELETE, OP_ERR_JSON, OP_ERR_RECIPIENTS, OP_ERR_BARRIER,
   OP_ERR_UNKNOWN = 255
 } operation_error_t;
 
@@ -177,7 +350,8 @@ typedef enum {
   U_ERR_NONE = 0, U_ERR_ARGS_MISSING, U_ERR_ARGS_ODD,
   U_ERR_CONFIG_MISSING, U_ERR_ARGS_INVAL, U_ERR_CMD_INVAL,
   U_ERR_CMD_MISSING, U_ERR_LOC_MISSING, U_ERR_LOC_INVAL,
-  U_ERR_OVERFLOW, U_ERR_BARRIER, U_ERR_UNKNOWN = 255
+  U_ERR_OVERFLOW, U_ERR_TABLE_MISSING, U_ERR_TABLE_INVAL,
+  U_ERR_BARRIER, U_ERR_UNKNOWN = 255
 } usage_error_t;
 
 /**
@@ -0,0 +1,911 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __GSM_H__
+#define __GSM_H__
+
+/** --- **/
+
+/**
+ * @name GSM0338_DEFAULT_ALPHABET:
+ *   X-macro listing every character of the GSM 03.38 default
+ *   alphabet, as `X(septet, codepoint, a)`, where `a` is passed
+ *   through unchanged. The GSM-to-Unicode conversion table used
+ *   here was obtained from
+ *   http://www.unicode.org/Public/MAPPINGS/ETSI/GSM0338.TXT.
+ *
+ *   Copyright (c) 2000 - 2009 Unicode, Inc. All Rights reserved.
+ *   Unicode, Inc. hereby grants the right to freely use the information
+ *   supplied in this file in the creation of products supporting the
+ *   Unicode Standard, and to make copies of this file in any form for
+ *   internal or external distribution as long as this notice remains
+ *   attached.
+ *
+ *   Septet 0x1b is the escape to the extension table; like the
+ *   Unicode mapping, we accept U+00A0 (no-break space) for it.
+ */
+#define GSM0338_DEFAULT_ALPHABET(X, a) \
+  X(0x00, 0x0040, a)  /* COMMERCIAL AT */ \
+  X(0x01, 0x00a3, a)  /* POUND SIGN */ \
+  X(0x02, 0x0024, a)  /* DOLLAR SIGN */ \
+  X(0x03, 0x00a5, a)  /* YEN SIGN */ \
+  X(0x04, 0x00e8, a)  /* LATIN SMALL LETTER E WITH GRAVE */ \
+  X(0x05, 0x00e9, a)  /* LATIN SMALL LETTER E WITH ACUTE */ \
+  X(0x06, 0x00f9, a)  /* LATIN SMALL LETTER U WITH GRAVE */ \
+  X(0x07, 0x00ec, a)  /* LATIN SMALL LETTER I WITH GRAVE */ \
+  X(0x08, 0x00f2, a)  /* LATIN SMALL LETTER O WITH GRAVE */ \
+  X(0x09, 0x00e7, a)  /* LATIN SMALL LETTER C WITH CEDILLA */ \
+  X(0x0a, 0x000a, a)  /* LINE FEED */ \
+  X(0x0b, 0x00d8, a)  /* LATIN CAPITAL LETTER O WITH STROKE */ \
+  X(0x0c, 0x00f8, a)  /* LATIN SMALL LETTER O WITH STROKE */ \
+  X(0x0d, 0x000d, a)  /* CARRIAGE RETURN */ \
+  X(0x0e, 0x00c5, a)  /* LATIN CAPITAL LETTER A WITH RING ABOVE */ \
+  X(0x0f, 0x00e5, a)  /* LATIN SMALL LETTER A WITH RING ABOVE */ \
+  X(0x10, 0x0394, a)  /* GREEK CAPITAL LETTER DELTA */ \
+  X(0x11, 0x005f, a)  /* LOW LINE */ \
+  X(0x12, 0x03a6, a)  /* GREEK CAPITAL LETTER PHI */ \
+  X(0x13, 0x0393, a)  /* GREEK CAPITAL LETTER GAMMA */ \
+  X(0x14, 0x039b, a)  /* GREEK CAPITAL LETTER LAMDA */ \
+  X(0x15, 0x03a9, a)  /* GREEK CAPITAL LETTER OMEGA */ \
+  X(0x16, 0x03a0, a)  /* GREEK CAPITAL LETTER PI */ \
+  X(0x17, 0x03a8, a)  /* GREEK CAPITAL LETTER PSI */ \
+  X(0x18, 0x03a3, a)  /* GREEK CAPITAL LETTER SIGMA */ \
+  X(0x19, 0x0398, a)  /* GREEK CAPITAL LETTER THETA */ \
+  X(0x1a, 0x039e, a)  /* GREEK CAPITAL LETTER XI */ \
+  X(0x1b, 0x00a0, a)  /* ESCAPE TO EXTENSION TABLE */ \
+  X(0x1c, 0x00c6, a)  /* LATIN CAPITAL LETTER AE */ \
+  X(0x1d, 0x00e6, a)  /* LATIN SMALL LETTER AE */ \
+  X(0x1e, 0x00df, a)  /* LATIN SMALL LETTER SHARP S (German) */ \
+  X(0x1f, 0x00c9, a)  /* LATIN CAPITAL LETTER E WITH ACUTE */ \
+  X(0x20, 0x0020, a)  /* SPACE */ \
+  X(0x21, 0x0021, a)  /* EXCLAMATION MARK */ \
+  X(0x22, 0x0022, a)  /* QUOTATION MARK */ \
+  X(0x23, 0x0023, a)  /* NUMBER SIGN */ \
+  X(0x24, 0x00a4, a)  /* CURRENCY SIGN */ \
+  X(0x25, 0x0025, a)  /* PERCENT SIGN */ \
+  X(0x26, 0x0026, a)  /* AMPERSAND */ \
+  X(0x27, 0x0027, a)  /* APOSTROPHE */ \
+  X(0x28, 0x0028, a)  /* LEFT PARENTHESIS */ \
+  X(0x29, 0x0029, a)  /* RIGHT PARENTHESIS */ \
+  X(0x2a, 0x002a, a)  /* ASTERISK */ \
+  X(0x2b, 0x002b, a)  /* PLUS SIGN */ \
+  X(0x2c, 0x002c, a)  /* COMMA */ \
+  X(0x2d, 0x002d, a)  /* HYPHEN-MINUS */ \
+  X(0x2e, 0x002e, a)  /* FULL STOP */ \
+  X(0x2f, 0x002f, a)  /* SOLIDUS */ \
+  X(0x30, 0x0030, a)  /* DIGIT ZERO */ \
+  X(0x31, 0x0031, a)  /* DIGIT ONE */ \
+  X(0x32, 0x0032, a)  /* DIGIT TWO */ \
+  X(0x33, 0x0033, a)  /* DIGIT THREE */ \
+  X(0x34, 0x0034, a)  /* DIGIT FOUR */ \
+  X(0x35, 0x0035, a)  /* DIGIT FIVE */ \
+  X(0x36, 0x0036, a)  /* DIGIT SIX */ \
+  X(0x37, 0x0037, a)  /* DIGIT SEVEN */ \
+  X(0x38, 0x0038, a)  /* DIGIT EIGHT */ \
+  X(0x39, 0x0039, a)  /* DIGIT NINE */ \
+  X(0x3a, 0x003a, a)  /* COLON */ \
+  X(0x3b, 0x003b, a)  /* SEMICOLON */ \
+  X(0x3c, 0x003c, a)  /* LESS-THAN SIGN */ \
+  X(0x3d, 0x003d, a)  /* EQUALS SIGN */ \
+  X(0x3e, 0x003e, a)  /* GREATER-THAN SIGN */ \
+  X(0x3f, 0x003f, a)  /* QUESTION MARK */ \
+  X(0x40, 0x00a1, a)  /* INVERTED EXCLAMATION MARK */ \
+  X(0x41, 0x0041, a)  /* LATIN CAPITAL LETTER A */ \
+  X(0x42, 0x0042, a)  /* LATIN CAPITAL LETTER B */ \
+  X(0x43, 0x0043, a)  /* LATIN CAPITAL LETTER C */ \
+  X(0x44, 0x0044, a)  /* LATIN CAPITAL LETTER D */ \
+  X(0x45, 0x0045, a)  /* LATIN CAPITAL LETTER E */ \
+  X(0x46, 0x0046, a)  /* LATIN CAPITAL LETTER F */ \
+  X(0x47, 0x0047, a)  /* LATIN CAPITAL LETTER G */ \
+  X(0x48, 0x0048, a)  /* LATIN CAPITAL LETTER H */ \
+  X(0x49, 0x0049, a)  /* LATIN CAPITAL LETTER I */ \
+  X(0x4a, 0x004a, a)  /* LATIN CAPITAL LETTER J */ \
+  X(0x4b, 0x004b, a)  /* LATIN CAPITAL LETTER K */ \
+  X(0x4c, 0x004c, a)  /* LATIN CAPITAL LETTER L */ \
+  X(0x4d, 0x004d, a)  /* LATIN CAPITAL LETTER M */ \
+  X(0x4e, 0x004e, a)  /* LATIN CAPITAL LETTER N */ \
+  X(0x4f, 0x004f, a)  /* LATIN CAPITAL LETTER O */ \
+  X(0x50, 0x0050, a)  /* LATIN CAPITAL LETTER P */ \
+  X(0x51, 0x0051, a)  /* LATIN CAPITAL LETTER Q */ \
+  X(0x52, 0x0052, a)  /* LATIN CAPITAL LETTER R */ \
+  X(0x53, 0x0053, a)  /* LATIN CAPITAL LETTER S */ \
+  X(0x54, 0x0054, a)  /* LATIN CAPITAL LETTER T */ \
+  X(0x55, 0x0055, a)  /* LATIN CAPITAL LETTER U */ \
+  X(0x56, 0x0056, a)  /* LATIN CAPITAL LETTER V */ \
+  X(0x57, 0x0057, a)  /* LATIN CAPITAL LETTER W */ \
+  X(0x58, 0x0058, a)  /* LATIN CAPITAL LETTER X */ \
+  X(0x59, 0x0059, a)  /* LATIN CAPITAL LETTER Y */ \
+  X(0x5a, 0x005a, a)  /* LATIN CAPITAL LETTER Z */ \
+  X(0x5b, 0x00c4, a)  /* LATIN CAPITAL LETTER A WITH DIAERESIS */ \
+  X(0x5c, 0x00d6, a)  /* LATIN CAPITAL LETTER O WITH DIAERESIS */ \
+  X(0x5d, 0x00d1, a)  /* LATIN CAPITAL LETTER N WITH TILDE */ \
+  X(0x5e, 0x00dc, a)  /* LATIN CAPITAL LETTER U WITH DIAERESIS */ \
+  X(0x5f, 0x00a7, a)  /* SECTION SIGN */ \
+  X(0x60, 0x00bf, a)  /* INVERTED QUESTION MARK */ \
+  X(0x61, 0x0061, a)  /* LATIN SMALL LETTER A */ \
+  X(0x62, 0x0062, a)  /* LATIN SMALL LETTER B */ \
+  X(0x63, 0x0063, a)  /* LATIN SMALL LETTER C */ \
+  X(0x64, 0x0064, a)  /* LATIN SMALL LETTER D */ \
+  X(0x65, 0x0065, a)  /* LATIN SMALL LETTER E */ \
+  X(0x66, 0x0066, a)  /* LATIN SMALL LETTER F */ \
+  X(0x67, 0x0067, a)  /* LATIN SMALL LETTER G */ \
+  X(0x68, 0x0068, a)  /* LATIN SMALL LETTER H */ \
+  X(0x69, 0x0069, a)  /* LATIN SMALL LETTER I */ \
+  X(0x6a, 0x006a, a)  /* LATIN SMALL LETTER J */ \
+  X(0x6b, 0x006b, a)  /* LATIN SMALL LETTER K */ \
+  X(0x6c, 0x006c, a)  /* LATIN SMALL LETTER L */ \
+  X(0x6d, 0x006d, a)  /* LATIN SMALL LETTER M */ \
+  X(0x6e, 0x006e, a)  /* LATIN SMALL LETTER N */ \
+  X(0x6f, 0x006f, a)  /* LATIN SMALL LETTER O */ \
+  X(0x70, 0x0070, a)  /* LATIN SMALL LETTER P */ \
+  X(0x71, 0x0071, a)  /* LATIN SMALL LETTER Q */ \
+  X(0x72, 0x0072, a)  /* LATIN SMALL LETTER R */ \
+  X(0x73, 0x0073, a)  /* LATIN SMALL LETTER S */ \
+  X(0x74, 0x0074, a)  /* LATIN SMALL LETTER T */ \
+  X(0x75, 0x0075, a)  /* LATIN SMALL LETTER U */ \
+  X(0x76, 0x0076, a)  /* LATIN SMALL LETTER V */ \
+  X(0x77, 0x0077, a)  /* LATIN SMALL LETTER W */ \
+  X(0x78, 0x0078, a)  /* LATIN SMALL LETTER X */ \
+  X(0x79, 0x0079, a)  /* LATIN SMALL LETTER Y */ \
+  X(0x7a, 0x007a, a)  /* LATIN SMALL LETTER Z */ \
+  X(0x7b, 0x00e4, a)  /* LATIN SMALL LETTER A WITH DIAERESIS */ \
+  X(0x7c, 0x00f6, a)  /* LATIN SMALL LETTER O WITH DIAERESIS */ \
+  X(0x7d, 0x00f1, a)  /* LATIN SMALL LETTER N WITH TILDE */ \
+  X(0x7e, 0x00fc, a)  /* LATIN SMALL LETTER U WITH DIAERESIS */ \
+  X(0x7f, 0x00e0, a)  /* LATIN SMALL LETTER A WITH GRAVE */
+
+/**
+ * @name GSM0338_EXTENSION_TABLE:
+ *   X-macro listing every character of the GSM 03.38 extension
+ *   table, as `X(septet, codepoint, a)`. Each of these characters
+ *   is transmitted as an escape septet (0x1b), followed by `septet`.
+ *   Source and copyright notice are as described above.
+ */
+#define GSM0338_EXTENSION_TABLE(X, a) \
+  X(0x0a, 0x000c, a)  /* FORM FEED */ \
+  X(0x14, 0x005e, a)  /* CIRCUMFLEX ACCENT */ \
+  X(0x28, 0x007b, a)  /* LEFT CURLY BRACKET */ \
+  X(0x29, 0x007d, a)  /* RIGHT CURLY BRACKET */ \
+  X(0x2f, 0x005c, a)  /* REVERSE SOLIDUS */ \
+  X(0x3c, 0x005b, a)  /* LEFT SQUARE BRACKET */ \
+  X(0x3d, 0x007e, a)  /* TILDE */ \
+  X(0x3e, 0x005d, a)  /* RIGHT SQUARE BRACKET */ \
+  X(0x40, 0x007c, a)  /* VERTICAL LINE */ \
+  X(0x65, 0x20ac, a)  /* EURO SIGN */
+
+/**
+ * @name GSM0338_PAGES:
+ *   X-macro listing each 256-codepoint page of the BMP that contains
+ *   at least one character from the tables above, as `X(index, page, a)`.
+ *   Lookup tables derived from this list are checked at compile time:
+ *   adding a character in an unlisted page will fail the build.
+ */
+#define GSM0338_PAGES(X, a) \
+  X(1, 0x00, a) \
+  X(2, 0x03, a) \
+  X(3, 0x20, a)
+
+/**
+ * @name gsm0338_page_count:
+ *   The number of pages in `GSM0338_PAGES`, plus one for the
+ *   shared all-zero page used for every other part of the BMP.
+ */
+#define gsm0338_page_count  (4)
+
+/** --- **/
+
+/**
+ * National language shift tables:
+ *   3GPP TS 23.038 defines additional tables that replace the default
+ *   alphabet (a "locking shift") and/or the extension table (a "single
+ *   shift") for a single message. The tables in use are announced in
+ *   the user data header; see `GSM0338_LANGUAGES`. Septet 0x1b is the
+ *   escape to the single shift table, and is omitted from each table.
+ */
+
+/**
+ * @name GSM0338_TURKISH_LOCKING_SHIFT:
+ *   X-macro listing the 3GPP TS 23.038 Turkish national language
+ *   locking shift table (A.3.1).
+ */
+#define GSM0338_TURKISH_LOCKING_SHIFT(X, a) \
+  X(0x00, 0x0040, a)  /* COMMERCIAL AT */ \
+  X(0x01, 0x00a3, a)  /* POUND SIGN */ \
+  X(0x02, 0x0024, a)  /* DOLLAR SIGN */ \
+  X(0x03, 0x00a5, a)  /* YEN SIGN */ \
+  X(0x04, 0x20ac, a)  /* EURO SIGN */ \
+  X(0x05, 0x00e9, a)  /* LATIN SMALL LETTER E WITH ACUTE */ \
+  X(0x06, 0x00f9, a)  /* LATIN SMALL LETTER U WITH GRAVE */ \
+  X(0x07, 0x0131, a)  /* LATIN SMALL LETTER DOTLESS I */ \
+  X(0x08, 0x00f2, a)  /* LATIN SMALL LETTER O WITH GRAVE */ \
+  X(0x09, 0x00c7, a)  /* LATIN CAPITAL LETTER C WITH CEDILLA */ \
+  X(0x0a, 0x000a, a)  /* LINE FEED */ \
+  X(0x0b, 0x011e, a)  /* LATIN CAPITAL LETTER G WITH BREVE */ \
+  X(0x0c, 0x011f, a)  /* LATIN SMALL LETTER G WITH BREVE */ \
+  X(0x0d, 0x000d, a)  /* CARRIAGE RETURN */ \
+  X(0x0e, 0x00c5, a)  /* LATIN CAPITAL LETTER A WITH RING ABOVE */ \
+  X(0x0f, 0x00e5, a)  /* LATIN SMALL LETTER A WITH RING ABOVE */ \
+  X(0x10, 0x0394, a)  /* GREEK CAPITAL LETTER DELTA */ \
+  X(0x11, 0x005f, a)  /* LOW LINE */ \
+  X(0x12, 0x03a6, a)  /* GREEK CAPITAL LETTER PHI */ \
+  X(0x13, 0x0393, a)  /* GREEK CAPITAL LETTER GAMMA */ \
+  X(0x14, 0x039b, a)  /* GREEK CAPITAL LETTER LAMDA */ \
+  X(0x15, 0x03a9, a)  /* GREEK CAPITAL LETTER OMEGA */ \
+  X(0x16, 0x03a0, a)  /* GREEK CAPITAL LETTER PI */ \
+  X(0x17, 0x03a8, a)  /* GREEK CAPITAL LETTER PSI */ \
+  X(0x18, 0x03a3, a)  /* GREEK CAPITAL LETTER SIGMA */ \
+  X(0x19, 0x0398, a)  /* GREEK CAPITAL LETTER THETA */ \
+  X(0x1a, 0x039e, a)  /* GREEK CAPITAL LETTER XI */ \
+  X(0x1c, 0x015e, a)  /* LATIN CAPITAL LETTER S WITH CEDILLA */ \
+  X(0x1d, 0x015f, a)  /* LATIN SMALL LETTER S WITH CEDILLA */ \
+  X(0x1e, 0x00df, a)  /* LATIN SMALL LETTER SHARP S */ \
+  X(0x1f, 0x00c9, a)  /* LATIN CAPITAL LETTER E WITH ACUTE */ \
+  X(0x20, 0x0020, a)  /* SPACE */ \
+  X(0x21, 0x0021, a)  /* EXCLAMATION MARK */ \
+  X(0x22, 0x0022, a)  /* QUOTATION MARK */ \
+  X(0x23, 0x0023, a)  /* NUMBER SIGN */ \
+  X(0x24, 0x00a4, a)  /* CURRENCY SIGN */ \
+  X(0x25, 0x0025, a)  /* PERCENT SIGN */ \
+  X(0x26, 0x0026, a)  /* AMPERSAND */ \
+  X(0x27, 0x0027, a)  /* APOSTROPHE */ \
+  X(0x28, 0x0028, a)  /* LEFT PARENTHESIS */ \
+  X(0x29, 0x0029, a)  /* RIGHT PARENTHESIS */ \
+  X(0x2a, 0x002a, a)  /* ASTERISK */ \
+  X(0x2b, 0x002b, a)  /* PLUS SIGN */ \
+  X(0x2c, 0x002c, a)  /* COMMA */ \
+  X(0x2d, 0x002d, a)  /* HYPHEN-MINUS */ \
+  X(0x2e, 0x002e, a)  /* FULL STOP */ \
+  X(0x2f, 0x002f, a)  /* SOLIDUS */ \
+  X(0x30, 0x0030, a)  /* DIGIT ZERO */ \
+  X(0x31, 0x0031, a)  /* DIGIT ONE */ \
+  X(0x32, 0x0032, a)  /* DIGIT TWO */ \
+  X(0x33, 0x0033, a)  /* DIGIT THREE */ \
+  X(0x34, 0x0034, a)  /* DIGIT FOUR */ \
+  X(0x35, 0x0035, a)  /* DIGIT FIVE */ \
+  X(0x36, 0x0036, a)  /* DIGIT SIX */ \
+  X(0x37, 0x0037, a)  /* DIGIT SEVEN */ \
+  X(0x38, 0x0038, a)  /* DIGIT EIGHT */ \
+  X(0x39, 0x0039, a)  /* DIGIT NINE */ \
+  X(0x3a, 0x003a, a)  /* COLON */ \
+  X(0x3b, 0x003b, a)  /* SEMICOLON */ \
+  X(0x3c, 0x003c, a)  /* LESS-THAN SIGN */ \
+  X(0x3d, 0x003d, a)  /* EQUALS SIGN */ \
+  X(0x3e, 0x003e, a)  /* GREATER-THAN SIGN */ \
+  X(0x3f, 0x003f, a)  /* QUESTION MARK */ \
+  X(0x40, 0x0130, a)  /* LATIN CAPITAL LETTER I WITH DOT ABOVE */ \
+  X(0x41, 0x0041, a)  /* LATIN CAPITAL LETTER A */ \
+  X(0x42, 0x0042, a)  /* LATIN CAPITAL LETTER B */ \
+  X(0x43, 0x0043, a)  /* LATIN CAPITAL LETTER C */ \
+  X(0x44, 0x0044, a)  /* LATIN CAPITAL LETTER D */ \
+  X(0x45, 0x0045, a)  /* LATIN CAPITAL LETTER E */ \
+  X(0x46, 0x0046, a)  /* LATIN CAPITAL LETTER F */ \
+  X(0x47, 0x0047, a)  /* LATIN CAPITAL LETTER G */ \
+  X(0x48, 0x0048, a)  /* LATIN CAPITAL LETTER H */ \
+  X(0x49, 0x0049, a)  /* LATIN CAPITAL LETTER I */ \
+  X(0x4a, 0x004a, a)  /* LATIN CAPITAL LETTER J */ \
+  X(0x4b, 0x004b, a)  /* LATIN CAPITAL LETTER K */ \
+  X(0x4c, 0x004c, a)  /* LATIN CAPITAL LETTER L */ \
+  X(0x4d, 0x004d, a)  /* LATIN CAPITAL LETTER M */ \
+  X(0x4e, 0x004e, a)  /* LATIN CAPITAL LETTER N */ \
+  X(0x4f, 0x004f, a)  /* LATIN CAPITAL LETTER O */ \
+  X(0x50, 0x0050, a)  /* LATIN CAPITAL LETTER P */ \
+  X(0x51, 0x0051, a)  /* LATIN CAPITAL LETTER Q */ \
+  X(0x52, 0x0052, a)  /* LATIN CAPITAL LETTER R */ \
+  X(0x53, 0x0053, a)  /* LATIN CAPITAL LETTER S */ \
+  X(0x54, 0x0054, a)  /* LATIN CAPITAL LETTER T */ \
+  X(0x55, 0x0055, a)  /* LATIN CAPITAL LETTER U */ \
+  X(0x56, 0x0056, a)  /* LATIN CAPITAL LETTER V */ \
+  X(0x57, 0x0057, a)  /* LATIN CAPITAL LETTER W */ \
+  X(0x58, 0x0058, a)  /* LATIN CAPITAL LETTER X */ \
+  X(0x59, 0x0059, a)  /* LATIN CAPITAL LETTER Y */ \
+  X(0x5a, 0x005a, a)  /* LATIN CAPITAL LETTER Z */ \
+  X(0x5b, 0x00c4, a)  /* LATIN CAPITAL LETTER A WITH DIAERESIS */ \
+  X(0x5c, 0x00d6, a)  /* LATIN CAPITAL LETTER O WITH DIAERESIS */ \
+  X(0x5d, 0x00d1, a)  /* LATIN CAPITAL LETTER N WITH TILDE */ \
+  X(0x5e, 0x00dc, a)  /* LATIN CAPITAL LETTER U WITH DIAERESIS */ \
+  X(0x5f, 0x00a7, a)  /* SECTION SIGN */ \
+  X(0x60, 0x00e7, a)  /* LATIN SMALL LETTER C WITH CEDILLA */ \
+  X(0x61, 0x0061, a)  /* LATIN SMALL LETTER A */ \
+  X(0x62, 0x0062, a)  /* LATIN SMALL LETTER B */ \
+  X(0x63, 0x0063, a)  /* LATIN SMALL LETTER C */ \
+  X(0x64, 0x0064, a)  /* LATIN SMALL LETTER D */ \
+  X(0x65, 0x0065, a)  /* LATIN SMALL LETTER E */ \
+  X(0x66, 0x0066, a)  /* LATIN SMALL LETTER F */ \
+  X(0x67, 0x0067, a)  /* LATIN SMALL LETTER G */ \
+  X(0x68, 0x0068, a)  /* LATIN SMALL LETTER H */ \
+  X(0x69, 0x0069, a)  /* LATIN SMALL LETTER I */ \
+  X(0x6a, 0x006a, a)  /* LATIN SMALL LETTER J */ \
+  X(0x6b, 0x006b, a)  /* LATIN SMALL LETTER K */ \
+  X(0x6c, 0x006c, a)  /* LATIN SMALL LETTER L */ \
+  X(0x6d, 0x006d, a)  /* LATIN SMALL LETTER M */ \
+  X(0x6e, 0x006e, a)  /* LATIN SMALL LETTER N */ \
+  X(0x6f, 0x006f, a)  /* LATIN SMALL LETTER O */ \
+  X(0x70, 0x0070, a)  /* LATIN SMALL LETTER P */ \
+  X(0x71, 0x0071, a)  /* LATIN SMALL LETTER Q */ \
+  X(0x72, 0x0072, a)  /* LATIN SMALL LETTER R */ \
+  X(0x73, 0x0073, a)  /* LATIN SMALL LETTER S */ \
+  X(0x74, 0x0074, a)  /* LATIN SMALL LETTER T */ \
+  X(0x75, 0x0075, a)  /* LATIN SMALL LETTER U */ \
+  X(0x76, 0x0076, a)  /* LATIN SMALL LETTER V */ \
+  X(0x77, 0x0077, a)  /* LATIN SMALL LETTER W */ \
+  X(0x78, 0x0078, a)  /* LATIN SMALL LETTER X */ \
+  X(0x79, 0x0079, a)  /* LATIN SMALL LETTER Y */ \
+  X(0x7a, 0x007a, a)  /* LATIN SMALL LETTER Z */ \
+  X(0x7b, 0x00e4, a)  /* LATIN SMALL LETTER A WITH DIAERESIS */ \
+  X(0x7c, 0x00f6, a)  /* LATIN SMALL LETTER O WITH DIAERESIS */ \
+  X(0x7d, 0x00f1, a)  /* LATIN SMALL LETTER N WITH TILDE */ \
+  X(0x7e, 0x00fc, a)  /* LATIN SMALL LETTER U WITH DIAERESIS */ \
+  X(0x7f, 0x00e0, a)  /* LATIN SMALL LETTER A WITH GRAVE */
+
+/**
+ * @name GSM0338_TURKISH_SINGLE_SHIFT:
+ *   X-macro listing the 3GPP TS 23.038 Turkish national language
+ *   single shift table (A.2.1).
+ */
+#define GSM0338_TURKISH_SINGLE_SHIFT(X, a) \
+  X(0x0a, 0x000c, a)  /* FORM FEED */ \
+  X(0x14, 0x005e, a)  /* CIRCUMFLEX ACCENT */ \
+  X(0x28, 0x007b, a)  /* LEFT CURLY BRACKET */ \
+  X(0x29, 0x007d, a)  /* RIGHT CURLY BRACKET */ \
+  X(0x2f, 0x005c, a)  /* REVERSE SOLIDUS */ \
+  X(0x3c, 0x005b, a)  /* LEFT SQUARE BRACKET */ \
+  X(0x3d, 0x007e, a)  /* TILDE */ \
+  X(0x3e, 0x005d, a)  /* RIGHT SQUARE BRACKET */ \
+  X(0x40, 0x007c, a)  /* VERTICAL LINE */ \
+  X(0x47, 0x011e, a)  /* LATIN CAPITAL LETTER G WITH BREVE */ \
+  X(0x49, 0x0130, a)  /* LATIN CAPITAL LETTER I WITH DOT ABOVE */ \
+  X(0x53, 0x015e, a)  /* LATIN CAPITAL LETTER S WITH CEDILLA */ \
+  X(0x63, 0x00e7, a)  /* LATIN SMALL LETTER C WITH CEDILLA */ \
+  X(0x65, 0x20ac, a)  /* EURO SIGN */ \
+  X(0x67, 0x011f, a)  /* LATIN SMALL LETTER G WITH BREVE */ \
+  X(0x69, 0x0131, a)  /* LATIN SMALL LETTER DOTLESS I */ \
+  X(0x73, 0x015f, a)  /* LATIN SMALL LETTER S WITH CEDILLA */
+
+/**
+ * @name GSM0338_SPANISH_SINGLE_SHIFT:
+ *   X-macro listing the 3GPP TS 23.038 Spanish national language
+ *   single shift table (A.2.2).
+ */
+#define GSM0338_SPANISH_SINGLE_SHIFT(X, a) \
+  X(0x09, 0x00e7, a)  /* LATIN SMALL LETTER C WITH CEDILLA */ \
+  X(0x0a, 0x000c, a)  /* FORM FEED */ \
+  X(0x14, 0x005e, a)  /* CIRCUMFLEX ACCENT */ \
+  X(0x28, 0x007b, a)  /* LEFT CURLY BRACKET */ \
+  X(0x29, 0x007d, a)  /* RIGHT CURLY BRACKET */ \
+  X(0x2f, 0x005c, a)  /* REVERSE SOLIDUS */ \
+  X(0x3c, 0x005b, a)  /* LEFT SQUARE BRACKET */ \
+  X(0x3d, 0x007e, a)  /* TILDE */ \
+  X(0x3e, 0x005d, a)  /* RIGHT SQUARE BRACKET */ \
+  X(0x40, 0x007c, a)  /* VERTICAL LINE */ \
+  X(0x41, 0x00c1, a)  /* LATIN CAPITAL LETTER A WITH ACUTE */ \
+  X(0x49, 0x00cd, a)  /* LATIN CAPITAL LETTER I WITH ACUTE */ \
+  X(0x4f, 0x00d3, a)  /* LATIN CAPITAL LETTER O WITH ACUTE */ \
+  X(0x55, 0x00da, a)  /* LATIN CAPITAL LETTER U WITH ACUTE */ \
+  X(0x61, 0x00e1, a)  /* LATIN SMALL LETTER A WITH ACUTE */ \
+  X(0x65, 0x20ac, a)  /* EURO SIGN */ \
+  X(0x69, 0x00ed, a)  /* LATIN SMALL LETTER I WITH ACUTE */ \
+  X(0x6f, 0x00f3, a)  /* LATIN SMALL LETTER O WITH ACUTE */ \
+  X(0x75, 0x00fa, a)  /* LATIN SMALL LETTER U WITH ACUTE */
+
+/**
+ * @name GSM0338_PORTUGUESE_LOCKING_SHIFT:
+ *   X-macro listing the 3GPP TS 23.038 Portuguese national language
+ *   locking shift table (A.3.3).
+ */
+#define GSM0338_PORTUGUESE_LOCKING_SHIFT(X, a) \
+  X(0x00, 0x0040, a)  /* COMMERCIAL AT */ \
+  X(0x01, 0x00a3, a)  /* POUND SIGN */ \
+  X(0x02, 0x0024, a)  /* DOLLAR SIGN */ \
+  X(0x03, 0x00a5, a)  /* YEN SIGN */ \
+  X(0x04, 0x00ea, a)  /* LATIN SMALL LETTER E WITH CIRCUMFLEX */ \
+  X(0x05, 0x00e9, a)  /* LATIN SMALL LETTER E WITH ACUTE */ \
+  X(0x06, 0x00fa, a)  /* LATIN SMALL LETTER U WITH ACUTE */ \
+  X(0x07, 0x00ed, a)  /* LATIN SMALL LETTER I WITH ACUTE */ \
+  X(0x08, 0x00f3, a)  /* LATIN SMALL LETTER O WITH ACUTE */ \
+  X(0x09, 0x00e7, a)  /* LATIN SMALL LETTER C WITH CEDILLA */ \
+  X(0x0a, 0x000a, a)  /* LINE FEED */ \
+  X(0x0b, 0x00d4, a)  /* LATIN CAPITAL LETTER O WITH CIRCUMFLEX */ \
+  X(0x0c, 0x00f4, a)  /* LATIN SMALL LETTER O WITH CIRCUMFLEX */ \
+  X(0x0d, 0x000d, a)  /* CARRIAGE RETURN */ \
+  X(0x0e, 0x00c1, a)  /* LATIN CAPITAL LETTER A WITH ACUTE */ \
+  X(0x0f, 0x00e1, a)  /* LATIN SMALL LETTER A WITH ACUTE */ \
+  X(0x10, 0x0394, a)  /* GREEK CAPITAL LETTER DELTA */ \
+  X(0x11, 0x005f, a)  /* LOW LINE */ \
+  X(0x12, 0x00aa, a)  /* FEMININE ORDINAL INDICATOR */ \
+  X(0x13, 0x00c7, a)  /* LATIN CAPITAL LETTER C WITH CEDILLA */ \
+  X(0x14, 0x00c0, a)  /* LATIN CAPITAL LETTER A WITH GRAVE */ \
+  X(0x15, 0x221e, a)  /* INFINITY */ \
+  X(0x16, 0x005e, a)  /* CIRCUMFLEX ACCENT */ \
+  X(0x17, 0x005c, a)  /* REVERSE SOLIDUS */ \
+  X(0x18, 0x20ac, a)  /* EURO SIGN */ \
+  X(0x19, 0x00d3, a)  /* LATIN CAPITAL LETTER O WITH ACUTE */ \
+  X(0x1a, 0x007c, a)  /* VERTICAL LINE */ \
+  X(0x1c, 0x00c2, a)  /* LATIN CAPITAL LETTER A WITH CIRCUMFLEX */ \
+  X(0x1d, 0x00e2, a)  /* LATIN SMALL LETTER A WITH CIRCUMFLEX */ \
+  X(0x1e, 0x00ca, a)  /* LATIN CAPITAL LETTER E WITH CIRCUMFLEX */ \
+  X(0x1f, 0x00c9, a)  /* LATIN CAPITAL LETTER E WITH ACUTE */ \
+  X(0x20, 0x0020, a)  /* SPACE */ \
+  X(0x21, 0x0021, a)  /* EXCLAMATION MARK */ \
+  X(0x22, 0x0022, a)  /* QUOTATION MARK */ \
+  X(0x23, 0x0023, a)  /* NUMBER SIGN */ \
+  X(0x24, 0x00ba, a)  /* MASCULINE ORDINAL INDICATOR */ \
+  X(0x25, 0x0025, a)  /* PERCENT SIGN */ \
+  X(0x26, 0x0026, a)  /* AMPERSAND */ \
+  X(0x27, 0x0027, a)  /* APOSTROPHE */ \
+  X(0x28, 0x0028, a)  /* LEFT PARENTHESIS */ \
+  X(0x29, 0x0029, a)  /* RIGHT PARENTHESIS */ \
+  X(0x2a, 0x002a, a)  /* ASTERISK */ \
+  X(0x2b, 0x002b, a)  /* PLUS SIGN */ \
+  X(0x2c, 0x002c, a)  /* COMMA */ \
+  X(0x2d, 0x002d, a)  /* HYPHEN-MINUS */ \
+  X(0x2e, 0x002e, a)  /* FULL STOP */ \
+  X(0x2f, 0x002f, a)  /* SOLIDUS */ \
+  X(0x30, 0x0030, a)  /* DIGIT ZERO */ \
+  X(0x31, 0x0031, a)  /* DIGIT ONE */ \
+  X(0x32, 0x0032, a)  /* DIGIT TWO */ \
+  X(0x33, 0x0033, a)  /* DIGIT THREE */ \
+  X(0x34, 0x0034, a)  /* DIGIT FOUR */ \
+  X(0x35, 0x0035, a)  /* DIGIT FIVE */ \
+  X(0x36, 0x0036, a)  /* DIGIT SIX */ \
+  X(0x37, 0x0037, a)  /* DIGIT SEVEN */ \
+  X(0x38, 0x0038, a)  /* DIGIT EIGHT */ \
+  X(0x39, 0x0039, a)  /* DIGIT NINE */ \
+  X(0x3a, 0x003a, a)  /* COLON */ \
+  X(0x3b, 0x003b, a)  /* SEMICOLON */ \
+  X(0x3c, 0x003c, a)  /* LESS-THAN SIGN */ \
+  X(0x3d, 0x003d, a)  /* EQUALS SIGN */ \
+  X(0x3e, 0x003e, a)  /* GREATER-THAN SIGN */ \
+  X(0x3f, 0x003f, a)  /* QUESTION MARK */ \
+  X(0x40, 0x00cd, a)  /* LATIN CAPITAL LETTER I WITH ACUTE */ \
+  X(0x41, 0x0041, a)  /* LATIN CAPITAL LETTER A */ \
+  X(0x42, 0x0042, a)  /* LATIN CAPITAL LETTER B */ \
+  X(0x43, 0x0043, a)  /* LATIN CAPITAL LETTER C */ \
+  X(0x44, 0x0044, a)  /* LATIN CAPITAL LETTER D */ \
+  X(0x45, 0x0045, a)  /* LATIN CAPITAL LETTER E */ \
+  X(0x46, 0x0046, a)  /* LATIN CAPITAL LETTER F */ \
+  X(0x47, 0x0047, a)  /* LATIN CAPITAL LETTER G */ \
+  X(0x48, 0x0048, a)  /* LATIN CAPITAL LETTER H */ \
+  X(0x49, 0x0049, a)  /* LATIN CAPITAL LETTER I */ \
+  X(0x4a, 0x004a, a)  /* LATIN CAPITAL LETTER J */ \
+  X(0x4b, 0x004b, a)  /* LATIN CAPITAL LETTER K */ \
+  X(0x4c, 0x004c, a)  /* LATIN CAPITAL LETTER L */ \
+  X(0x4d, 0x004d, a)  /* LATIN CAPITAL LETTER M */ \
+  X(0x4e, 0x004e, a)  /* LATIN CAPITAL LETTER N */ \
+  X(0x4f, 0x004f, a)  /* LATIN CAPITAL LETTER O */ \
+  X(0x50, 0x0050, a)  /* LATIN CAPITAL LETTER P */ \
+  X(0x51, 0x0051, a)  /* LATIN CAPITAL LETTER Q */ \
+  X(0x52, 0x0052, a)  /* LATIN CAPITAL LETTER R */ \
+  X(0x53, 0x0053, a)  /* LATIN CAPITAL LETTER S */ \
+  X(0x54, 0x0054, a)  /* LATIN CAPITAL LETTER T */ \
+  X(0x55, 0x0055, a)  /* LATIN CAPITAL LETTER U */ \
+  X(0x56, 0x0056, a)  /* LATIN CAPITAL LETTER V */ \
+  X(0x57, 0x0057, a)  /* LATIN CAPITAL LETTER W */ \
+  X(0x58, 0x0058, a)  /* LATIN CAPITAL LETTER X */ \
+  X(0x59, 0x0059, a)  /* LATIN CAPITAL LETTER Y */ \
+  X(0x5a, 0x005a, a)  /* LATIN CAPITAL LETTER Z */ \
+  X(0x5b, 0x00c3, a)  /* LATIN CAPITAL LETTER A WITH TILDE */ \
+  X(0x5c, 0x00d5, a)  /* LATIN CAPITAL LETTER O WITH TILDE */ \
+  X(0x5d, 0x00da, a)  /* LATIN CAPITAL LETTER U WITH ACUTE */ \
+  X(0x5e, 0x00dc, a)  /* LATIN CAPITAL LETTER U WITH DIAERESIS */ \
+  X(0x5f, 0x00a7, a)  /* SECTION SIGN */ \
+  X(0x60, 0x007e, a)  /* TILDE */ \
+  X(0x61, 0x0061, a)  /* LATIN SMALL LETTER A */ \
+  X(0x62, 0x0062, a)  /* LATIN SMALL LETTER B */ \
+  X(0x63, 0x0063, a)  /* LATIN SMALL LETTER C */ \
+  X(0x64, 0x0064, a)  /* LATIN SMALL LETTER D */ \
+  X(0x65, 0x0065, a)  /* LATIN SMALL LETTER E */ \
+  X(0x66, 0x0066, a)  /* LATIN SMALL LETTER F */ \
+  X(0x67, 0x0067, a)  /* LATIN SMALL LETTER G */ \
+  X(0x68, 0x0068, a)  /* LATIN SMALL LETTER H */ \
+  X(0x69, 0x0069, a)  /* LATIN SMALL LETTER I */ \
+  X(0x6a, 0x006a, a)  /* LATIN SMALL LETTER J */ \
+  X(0x6b, 0x006b, a)  /* LATIN SMALL LETTER K */ \
+  X(0x6c, 0x006c, a)  /* LATIN SMALL LETTER L */ \
+  X(0x6d, 0x006d, a)  /* LATIN SMALL LETTER M */ \
+  X(0x6e, 0x006e, a)  /* LATIN SMALL LETTER N */ \
+  X(0x6f, 0x006f, a)  /* LATIN SMALL LETTER O */ \
+  X(0x70, 0x0070, a)  /* LATIN SMALL LETTER P */ \
+  X(0x71, 0x0071, a)  /* LATIN SMALL LETTER Q */ \
+  X(0x72, 0x0072, a)  /* LATIN SMALL LETTER R */ \
+  X(0x73, 0x0073, a)  /* LATIN SMALL LETTER S */ \
+  X(0x74, 0x0074, a)  /* LATIN SMALL LETTER T */ \
+  X(0x75, 0x0075, a)  /* LATIN SMALL LETTER U */ \
+  X(0x76, 0x0076, a)  /* LATIN SMALL LETTER V */ \
+  X(0x77, 0x0077, a)  /* LATIN SMALL LETTER W */ \
+  X(0x78, 0x0078, a)  /* LATIN SMALL LETTER X */ \
+  X(0x79, 0x0079, a)  /* LATIN SMALL LETTER Y */ \
+  X(0x7a, 0x007a, a)  /* LATIN SMALL LETTER Z */ \
+  X(0x7b, 0x00e3, a)  /* LATIN SMALL LETTER A WITH TILDE */ \
+  X(0x7c, 0x00f5, a)  /* LATIN SMALL LETTER O WITH TILDE */ \
+  X(0x7d, 0x0060, a)  /* GRAVE ACCENT */ \
+  X(0x7e, 0x00fc, a)  /* LATIN SMALL LETTER U WITH DIAERESIS */ \
+  X(0x7f, 0x00e0, a)  /* LATIN SMALL LETTER A WITH GRAVE */
+
+/**
+ * @name GSM0338_PORTUGUESE_SINGLE_SHIFT:
+ *   X-macro listing the 3GPP TS 23.038 Portuguese national language
+ *   single shift table (A.2.3).
+ */
+#define GSM0338_PORTUGUESE_SINGLE_SHIFT(X, a) \
+  X(0x05, 0x00ea, a)  /* LATIN SMALL LETTER E WITH CIRCUMFLEX */ \
+  X(0x09, 0x00e7, a)  /* LATIN SMALL LETTER C WITH CEDILLA */ \
+  X(0x0a, 0x000c, a)  /* FORM FEED */ \
+  X(0x0b, 0x00d4, a)  /* LATIN CAPITAL LETTER O WITH CIRCUMFLEX */ \
+  X(0x0c, 0x00f4, a)  /* LATIN SMALL LETTER O WITH CIRCUMFLEX */ \
+  X(0x0e, 0x00c1, a)  /* LATIN CAPITAL LETTER A WITH ACUTE */ \
+  X(0x0f, 0x00e1, a)  /* LATIN SMALL LETTER A WITH ACUTE */ \
+  X(0x12, 0x03a6, a)  /* GREEK CAPITAL LETTER PHI */ \
+  X(0x13, 0x0393, a)  /* GREEK CAPITAL LETTER GAMMA */ \
+  X(0x14, 0x005e, a)  /* CIRCUMFLEX ACCENT */ \
+  X(0x15, 0x03a9, a)  /* GREEK CAPITAL LETTER OMEGA */ \
+  X(0x16, 0x03a0, a)  /* GREEK CAPITAL LETTER PI */ \
+  X(0x17, 0x03a8, a)  /* GREEK CAPITAL LETTER PSI */ \
+  X(0x18, 0x03a3, a)  /* GREEK CAPITAL LETTER SIGMA */ \
+  X(0x19, 0x0398, a)  /* GREEK CAPITAL LETTER THETA */ \
+  X(0x1f, 0x00ca, a)  /* LATIN CAPITAL LETTER E WITH CIRCUMFLEX */ \
+  X(0x28, 0x007b, a)  /* LEFT CURLY BRACKET */ \
+  X(0x29, 0x007d, a)  /* RIGHT CURLY BRACKET */ \
+  X(0x2f, 0x005c, a)  /* REVERSE SOLIDUS */ \
+  X(0x3c, 0x005b, a)  /* LEFT SQUARE BRACKET */ \
+  X(0x3d, 0x007e, a)  /* TILDE */ \
+  X(0x3e, 0x005d, a)  /* RIGHT SQUARE BRACKET */ \
+  X(0x40, 0x007c, a)  /* VERTICAL LINE */ \
+  X(0x41, 0x00c0, a)  /* LATIN CAPITAL LETTER A WITH GRAVE */ \
+  X(0x49, 0x00cd, a)  /* LATIN CAPITAL LETTER I WITH ACUTE */ \
+  X(0x4f, 0x00d3, a)  /* LATIN CAPITAL LETTER O WITH ACUTE */ \
+  X(0x55, 0x00da, a)  /* LATIN CAPITAL LETTER U WITH ACUTE */ \
+  X(0x5b, 0x00c3, a)  /* LATIN CAPITAL LETTER A WITH TILDE */ \
+  X(0x5c, 0x00d5, a)  /* LATIN CAPITAL LETTER O WITH TILDE */ \
+  X(0x61, 0x00c2, a)  /* LATIN CAPITAL LETTER A WITH CIRCUMFLEX */ \
+  X(0x65, 0x20ac, a)  /* EURO SIGN */ \
+  X(0x69, 0x00ed, a)  /* LATIN SMALL LETTER I WITH ACUTE */ \
+  X(0x6f, 0x00f3, a)  /* LATIN SMALL LETTER O WITH ACUTE */ \
+  X(0x75, 0x00fa, a)  /* LATIN SMALL LETTER U WITH ACUTE */ \
+  X(0x7b, 0x00e3, a)  /* LATIN SMALL LETTER A WITH TILDE */ \
+  X(0x7c, 0x00f5, a)  /* LATIN SMALL LETTER O WITH TILDE */ \
+  X(0x7f, 0x00e2, a)  /* LATIN SMALL LETTER A WITH CIRCUMFLEX */
+
+/**
+ * @name GSM0338_HINDI_LOCKING_SHIFT:
+ *   X-macro listing the 3GPP TS 23.038 Hindi national language
+ *   locking shift table (A.3.6).
+ */
+#define GSM0338_HINDI_LOCKING_SHIFT(X, a) \
+  X(0x00, 0x0901, a)  /* DEVANAGARI SIGN CANDRABINDU */ \
+  X(0x01, 0x0902, a)  /* DEVANAGARI SIGN ANUSVARA */ \
+  X(0x02, 0x0903, a)  /* DEVANAGARI SIGN VISARGA */ \
+  X(0x03, 0x0905, a)  /* DEVANAGARI LETTER A */ \
+  X(0x04, 0x0906, a)  /* DEVANAGARI LETTER AA */ \
+  X(0x05, 0x0907, a)  /* DEVANAGARI LETTER I */ \
+  X(0x06, 0x0908, a)  /* DEVANAGARI LETTER II */ \
+  X(0x07, 0x0909, a)  /* DEVANAGARI LETTER U */ \
+  X(0x08, 0x090a, a)  /* DEVANAGARI LETTER UU */ \
+  X(0x09, 0x090b, a)  /* DEVANAGARI LETTER VOCALIC R */ \
+  X(0x0a, 0x000a, a)  /* LINE FEED */ \
+  X(0x0b, 0x090c, a)  /* DEVANAGARI LETTER VOCALIC L */ \
+  X(0x0c, 0x090d, a)  /* DEVANAGARI LETTER CANDRA E */ \
+  X(0x0d, 0x000d, a)  /* CARRIAGE RETURN */ \
+  X(0x0e, 0x090e, a)  /* DEVANAGARI LETTER SHORT E */ \
+  X(0x0f, 0x090f, a)  /* DEVANAGARI LETTER E */ \
+  X(0x10, 0x0910, a)  /* DEVANAGARI LETTER AI */ \
+  X(0x11, 0x0911, a)  /* DEVANAGARI LETTER CANDRA O */ \
+  X(0x12, 0x0912, a)  /* DEVANAGARI LETTER SHORT O */ \
+  X(0x13, 0x0913, a)  /* DEVANAGARI LETTER O */ \
+  X(0x14, 0x0914, a)  /* DEVANAGARI LETTER AU */ \
+  X(0x15, 0x0915, a)  /* DEVANAGARI LETTER KA */ \
+  X(0x16, 0x0916, a)  /* DEVANAGARI LETTER KHA */ \
+  X(0x17, 0x0917, a)  /* DEVANAGARI LETTER GA */ \
+  X(0x18, 0x0918, a)  /* DEVANAGARI LETTER GHA */ \
+  X(0x19, 0x0919, a)  /* DEVANAGARI LETTER NGA */ \
+  X(0x1a, 0x091a, a)  /* DEVANAGARI LETTER CA */ \
+  X(0x1c, 0x091b, a)  /* DEVANAGARI LETTER CHA */ \
+  X(0x1d, 0x091c, a)  /* DEVANAGARI LETTER JA */ \
+  X(0x1e, 0x091d, a)  /* DEVANAGARI LETTER JHA */ \
+  X(0x1f, 0x091e, a)  /* DEVANAGARI LETTER NYA */ \
+  X(0x20, 0x0020, a)  /* SPACE */ \
+  X(0x21, 0x0021, a)  /* EXCLAMATION MARK */ \
+  X(0x22, 0x091f, a)  /* DEVANAGARI LETTER TTA */ \
+  X(0x23, 0x0920, a)  /* DEVANAGARI LETTER TTHA */ \
+  X(0x24, 0x0921, a)  /* DEVANAGARI LETTER DDA */ \
+  X(0x25, 0x0922, a)  /* DEVANAGARI LETTER DDHA */ \
+  X(0x26, 0x0923, a)  /* DEVANAGARI LETTER NNA */ \
+  X(0x27, 0x0924, a)  /* DEVANAGARI LETTER TA */ \
+  X(0x28, 0x0029, a)  /* RIGHT PARENTHESIS */ \
+  X(0x29, 0x0028, a)  /* LEFT PARENTHESIS */ \
+  X(0x2a, 0x0925, a)  /* DEVANAGARI LETTER THA */ \
+  X(0x2b, 0x0926, a)  /* DEVANAGARI LETTER DA */ \
+  X(0x2c, 0x002c, a)  /* COMMA */ \
+  X(0x2d, 0x0927, a)  /* DEVANAGARI LETTER DHA */ \
+  X(0x2e, 0x002e, a)  /* FULL STOP */ \
+  X(0x2f, 0x0928, a)  /* DEVANAGARI LETTER NA */ \
+  X(0x30, 0x0030, a)  /* DIGIT ZERO */ \
+  X(0x31, 0x0031, a)  /* DIGIT ONE */ \
+  X(0x32, 0x0032, a)  /* DIGIT TWO */ \
+  X(0x33, 0x0033, a)  /* DIGIT THREE */ \
+  X(0x34, 0x0034, a)  /* DIGIT FOUR */ \
+  X(0x35, 0x0035, a)  /* DIGIT FIVE */ \
+  X(0x36, 0x0036, a)  /* DIGIT SIX */ \
+  X(0x37, 0x0037, a)  /* DIGIT SEVEN */ \
+  X(0x38, 0x0038, a)  /* DIGIT EIGHT */ \
+  X(0x39, 0x0039, a)  /* DIGIT NINE */ \
+  X(0x3a, 0x003a, a)  /* COLON */ \
+  X(0x3b, 0x003b, a)  /* SEMICOLON */ \
+  X(0x3c, 0x0929, a)  /* DEVANAGARI LETTER NNNA */ \
+  X(0x3d, 0x092a, a)  /* DEVANAGARI LETTER PA */ \
+  X(0x3e, 0x092b, a)  /* DEVANAGARI LETTER PHA */ \
+  X(0x3f, 0x003f, a)  /* QUESTION MARK */ \
+  X(0x40, 0x092c, a)  /* DEVANAGARI LETTER BA */ \
+  X(0x41, 0x092d, a)  /* DEVANAGARI LETTER BHA */ \
+  X(0x42, 0x092e, a)  /* DEVANAGARI LETTER MA */ \
+  X(0x43, 0x092f, a)  /* DEVANAGARI LETTER YA */ \
+  X(0x44, 0x0930, a)  /* DEVANAGARI LETTER RA */ \
+  X(0x45, 0x0931, a)  /* DEVANAGARI LETTER RRA */ \
+  X(0x46, 0x0932, a)  /* DEVANAGARI LETTER LA */ \
+  X(0x47, 0x0933, a)  /* DEVANAGARI LETTER LLA */ \
+  X(0x48, 0x0934, a)  /* DEVANAGARI LETTER LLLA */ \
+  X(0x49, 0x0935, a)  /* DEVANAGARI LETTER VA */ \
+  X(0x4a, 0x0936, a)  /* DEVANAGARI LETTER SHA */ \
+  X(0x4b, 0x0937, a)  /* DEVANAGARI LETTER SSA */ \
+  X(0x4c, 0x0938, a)  /* DEVANAGARI LETTER SA */ \
+  X(0x4d, 0x0939, a)  /* DEVANAGARI LETTER HA */ \
+  X(0x4e, 0x093c, a)  /* DEVANAGARI SIGN NUKTA */ \
+  X(0x4f, 0x093d, a)  /* DEVANAGARI SIGN AVAGRAHA */ \
+  X(0x50, 0x093e, a)  /* DEVANAGARI VOWEL SIGN AA */ \
+  X(0x51, 0x093f, a)  /* DEVANAGARI VOWEL SIGN I */ \
+  X(0x52, 0x0940, a)  /* DEVANAGARI VOWEL SIGN II */ \
+  X(0x53, 0x0941, a)  /* DEVANAGARI VOWEL SIGN U */ \
+  X(0x54, 0x0942, a)  /* DEVANAGARI VOWEL SIGN UU */ \
+  X(0x55, 0x0943, a)  /* DEVANAGARI VOWEL SIGN VOCALIC R */ \
+  X(0x56, 0x0944, a)  /* DEVANAGARI VOWEL SIGN VOCALIC RR */ \
+  X(0x57, 0x0945, a)  /* DEVANAGARI VOWEL SIGN CANDRA E */ \
+  X(0x58, 0x0946, a)  /* DEVANAGARI VOWEL SIGN SHORT E */ \
+  X(0x59, 0x0947, a)  /* DEVANAGARI VOWEL SIGN E */ \
+  X(0x5a, 0x0948, a)  /* DEVANAGARI VOWEL SIGN AI */ \
+  X(0x5b, 0x0949, a)  /* DEVANAGARI VOWEL SIGN CANDRA O */ \
+  X(0x5c, 0x094a, a)  /* DEVANAGARI VOWEL SIGN SHORT O */ \
+  X(0x5d, 0x094b, a)  /* DEVANAGARI VOWEL SIGN O */ \
+  X(0x5e, 0x094c, a)  /* DEVANAGARI VOWEL SIGN AU */ \
+  X(0x5f, 0x094d, a)  /* DEVANAGARI SIGN VIRAMA */ \
+  X(0x60, 0x0950, a)  /* DEVANAGARI OM */ \
+  X(0x61, 0x0061, a)  /* LATIN SMALL LETTER A */ \
+  X(0x62, 0x0062, a)  /* LATIN SMALL LETTER B */ \
+  X(0x63, 0x0063, a)  /* LATIN SMALL LETTER C */ \
+  X(0x64, 0x0064, a)  /* LATIN SMALL LETTER D */ \
+  X(0x65, 0x0065, a)  /* LATIN SMALL LETTER E */ \
+  X(0x66, 0x0066, a)  /* LATIN SMALL LETTER F */ \
+  X(0x67, 0x0067, a)  /* LATIN SMALL LETTER G */ \
+  X(0x68, 0x0068, a)  /* LATIN SMALL LETTER H */ \
+  X(0x69, 0x0069, a)  /* LATIN SMALL LETTER I */ \
+  X(0x6a, 0x006a, a)  /* LATIN SMALL LETTER J */ \
+  X(0x6b, 0x006b, a)  /* LATIN SMALL LETTER K */ \
+  X(0x6c, 0x006c, a)  /* LATIN SMALL LETTER L */ \
+  X(0x6d, 0x006d, a)  /* LATIN SMALL LETTER M */ \
+  X(0x6e, 0x006e, a)  /* LATIN SMALL LETTER N */ \
+  X(0x6f, 0x006f, a)  /* LATIN SMALL LETTER O */ \
+  X(0x70, 0x0070, a)  /* LATIN SMALL LETTER P */ \
+  X(0x71, 0x0071, a)  /* LATIN SMALL LETTER Q */ \
+  X(0x72, 0x0072, a)  /* LATIN SMALL LETTER R */ \
+  X(0x73, 0x0073, a)  /* LATIN SMALL LETTER S */ \
+  X(0x74, 0x0074, a)  /* LATIN SMALL LETTER T */ \
+  X(0x75, 0x0075, a)  /* LATIN SMALL LETTER U */ \
+  X(0x76, 0x0076, a)  /* LATIN SMALL LETTER V */ \
+  X(0x77, 0x0077, a)  /* LATIN SMALL LETTER W */ \
+  X(0x78, 0x0078, a)  /* LATIN SMALL LETTER X */ \
+  X(0x79, 0x0079, a)  /* LATIN SMALL LETTER Y */ \
+  X(0x7a, 0x007a, a)  /* LATIN SMALL LETTER Z */ \
+  X(0x7b, 0x0972, a)  /* DEVANAGARI LETTER CANDRA A */ \
+  X(0x7c, 0x097b, a)  /* DEVANAGARI LETTER GGA */ \
+  X(0x7d, 0x097c, a)  /* DEVANAGARI LETTER JJA */ \
+  X(0x7e, 0x097e, a)  /* DEVANAGARI LETTER DDDA */ \
+  X(0x7f, 0x097f, a)  /* DEVANAGARI LETTER BBA */
+
+/**
+ * @name GSM0338_HINDI_SINGLE_SHIFT:
+ *   X-macro listing the 3GPP TS 23.038 Hindi national language
+ *   single shift table (A.2.6).
+ */
+#define GSM0338_HINDI_SINGLE_SHIFT(X, a) \
+  X(0x00, 0x0040, a)  /* COMMERCIAL AT */ \
+  X(0x01, 0x00a3, a)  /* POUND SIGN */ \
+  X(0x02, 0x0024, a)  /* DOLLAR SIGN */ \
+  X(0x03, 0x00a5, a)  /* YEN SIGN */ \
+  X(0x04, 0x00bf, a)  /* INVERTED QUESTION MARK */ \
+  X(0x05, 0x0022, a)  /* QUOTATION MARK */ \
+  X(0x06, 0x00a4, a)  /* CURRENCY SIGN */ \
+  X(0x07, 0x0025, a)  /* PERCENT SIGN */ \
+  X(0x08, 0x0026, a)  /* AMPERSAND */ \
+  X(0x09, 0x0027, a)  /* APOSTROPHE */ \
+  X(0x0a, 0x000c, a)  /* FORM FEED */ \
+  X(0x0b, 0x002a, a)  /* ASTERISK */ \
+  X(0x0c, 0x002b, a)  /* PLUS SIGN */ \
+  X(0x0e, 0x002d, a)  /* HYPHEN-MINUS */ \
+  X(0x0f, 0x002f, a)  /* SOLIDUS */ \
+  X(0x10, 0x003c, a)  /* LESS-THAN SIGN */ \
+  X(0x11, 0x003d, a)  /* EQUALS SIGN */ \
+  X(0x12, 0x003e, a)  /* GREATER-THAN SIGN */ \
+  X(0x13, 0x00a1, a)  /* INVERTED EXCLAMATION MARK */ \
+  X(0x14, 0x005e, a)  /* CIRCUMFLEX ACCENT */ \
+  X(0x16, 0x005f, a)  /* LOW LINE */ \
+  X(0x17, 0x0023, a)  /* NUMBER SIGN */ \
+  X(0x19, 0x0964, a)  /* DEVANAGARI DANDA */ \
+  X(0x1a, 0x0965, a)  /* DEVANAGARI DOUBLE DANDA */ \
+  X(0x1c, 0x0966, a)  /* DEVANAGARI DIGIT ZERO */ \
+  X(0x1d, 0x0967, a)  /* DEVANAGARI DIGIT ONE */ \
+  X(0x1e, 0x0968, a)  /* DEVANAGARI DIGIT TWO */ \
+  X(0x1f, 0x0969, a)  /* DEVANAGARI DIGIT THREE */ \
+  X(0x20, 0x096a, a)  /* DEVANAGARI DIGIT FOUR */ \
+  X(0x21, 0x096b, a)  /* DEVANAGARI DIGIT FIVE */ \
+  X(0x22, 0x096c, a)  /* DEVANAGARI DIGIT SIX */ \
+  X(0x23, 0x096d, a)  /* DEVANAGARI DIGIT SEVEN */ \
+  X(0x24, 0x096e, a)  /* DEVANAGARI DIGIT EIGHT */ \
+  X(0x25, 0x096f, a)  /* DEVANAGARI DIGIT NINE */ \
+  X(0x26, 0x0951, a)  /* DEVANAGARI STRESS SIGN UDATTA */ \
+  X(0x27, 0x0952, a)  /* DEVANAGARI STRESS SIGN ANUDATTA */ \
+  X(0x28, 0x007b, a)  /* LEFT CURLY BRACKET */ \
+  X(0x29, 0x007d, a)  /* RIGHT CURLY BRACKET */ \
+  X(0x2a, 0x0953, a)  /* DEVANAGARI GRAVE ACCENT */ \
+  X(0x2b, 0x0954, a)  /* DEVANAGARI ACUTE ACCENT */ \
+  X(0x2c, 0x0958, a)  /* DEVANAGARI LETTER QA */ \
+  X(0x2d, 0x0959, a)  /* DEVANAGARI LETTER KHHA */ \
+  X(0x2e, 0x095a, a)  /* DEVANAGARI LETTER GHHA */ \
+  X(0x2f, 0x005c, a)  /* REVERSE SOLIDUS */ \
+  X(0x30, 0x095b, a)  /* DEVANAGARI LETTER ZA */ \
+  X(0x31, 0x095c, a)  /* DEVANAGARI LETTER DDDHA */ \
+  X(0x32, 0x095d, a)  /* DEVANAGARI LETTER RHA */ \
+  X(0x33, 0x095e, a)  /* DEVANAGARI LETTER FA */ \
+  X(0x34, 0x095f, a)  /* DEVANAGARI LETTER YYA */ \
+  X(0x35, 0x0960, a)  /* DEVANAGARI LETTER VOCALIC RR */ \
+  X(0x36, 0x0961, a)  /* DEVANAGARI LETTER VOCALIC LL */ \
+  X(0x37, 0x0962, a)  /* DEVANAGARI VOWEL SIGN VOCALIC L */ \
+  X(0x38, 0x0963, a)  /* DEVANAGARI VOWEL SIGN VOCALIC LL */ \
+  X(0x39, 0x0970, a)  /* DEVANAGARI ABBREVIATION SIGN */ \
+  X(0x3a, 0x0971, a)  /* DEVANAGARI SIGN HIGH SPACING DOT */ \
+  X(0x3c, 0x005b, a)  /* LEFT SQUARE BRACKET */ \
+  X(0x3d, 0x007e, a)  /* TILDE */ \
+  X(0x3e, 0x005d, a)  /* RIGHT SQUARE BRACKET */ \
+  X(0x40, 0x007c, a)  /* VERTICAL LINE */ \
+  X(0x41, 0x0041, a)  /* LATIN CAPITAL LETTER A */ \
+  X(0x42, 0x0042, a)  /* LATIN CAPITAL LETTER B */ \
+  X(0x43, 0x0043, a)  /* LATIN CAPITAL LETTER C */ \
+  X(0x44, 0x0044, a)  /* LATIN CAPITAL LETTER D */ \
+  X(0x45, 0x0045, a)  /* LATIN CAPITAL LETTER E */ \
+  X(0x46, 0x0046, a)  /* LATIN CAPITAL LETTER F */ \
+  X(0x47, 0x0047, a)  /* LATIN CAPITAL LETTER G */ \
+  X(0x48, 0x0048, a)  /* LATIN CAPITAL LETTER H */ \
+  X(0x49, 0x0049, a)  /* LATIN CAPITAL LETTER I */ \
+  X(0x4a, 0x004a, a)  /* LATIN CAPITAL LETTER J */ \
+  X(0x4b, 0x004b, a)  /* LATIN CAPITAL LETTER K */ \
+  X(0x4c, 0x004c, a)  /* LATIN CAPITAL LETTER L */ \
+  X(0x4d, 0x004d, a)  /* LATIN CAPITAL LETTER M */ \
+  X(0x4e, 0x004e, a)  /* LATIN CAPITAL LETTER N */ \
+  X(0x4f, 0x004f, a)  /* LATIN CAPITAL LETTER O */ \
+  X(0x50, 0x0050, a)  /* LATIN CAPITAL LETTER P */ \
+  X(0x51, 0x0051, a)  /* LATIN CAPITAL LETTER Q */ \
+  X(0x52, 0x0052, a)  /* LATIN CAPITAL LETTER R */ \
+  X(0x53, 0x0053, a)  /* LATIN CAPITAL LETTER S */ \
+  X(0x54, 0x0054, a)  /* LATIN CAPITAL LETTER T */ \
+  X(0x55, 0x0055, a)  /* LATIN CAPITAL LETTER U */ \
+  X(0x56, 0x0056, a)  /* LATIN CAPITAL LETTER V */ \
+  X(0x57, 0x0057, a)  /* LATIN CAPITAL LETTER W */ \
+  X(0x58, 0x0058, a)  /* LATIN CAPITAL LETTER X */ \
+  X(0x59, 0x0059, a)  /* LATIN CAPITAL LETTER Y */ \
+  X(0x5a, 0x005a, a)  /* LATIN CAPITAL LETTER Z */ \
+  X(0x65, 0x20ac, a)  /* EURO SIGN */
+
+
+/**
+ * @name GSM0338_NONE:
+ *   An empty X-macro, for languages that lack one of the two tables.
+ */
+#define GSM0338_NONE(X, a)
+
+/**
+ * @name GSM0338_LANGUAGES:
+ *   X-macro listing each supported table set, as `X(index, identifier,
+ *   name, locking, single, a)`. The `identifier` is the 3GPP TS 23.038
+ *   language identifier transmitted in the user data header; `locking`
+ *   and `single` are the X-macros for the two tables. Index zero is the
+ *   default alphabet and extension table, which need no header.
+ */
+#define GSM0338_LANGUAGES(X, a) \
+  X(0, 0x00, default, GSM0338_DEFAULT_ALPHABET, GSM0338_EXTENSION_TABLE, a) \
+  X(1, 0x01, turkish, GSM0338_TURKISH_LOCKING_SHIFT, \
+    GSM0338_TURKISH_SINGLE_SHIFT, a) \
+  X(2, 0x02, spanish, GSM0338_NONE, GSM0338_SPANISH_SINGLE_SHIFT, a) \
+  X(3, 0x03, portuguese, GSM0338_PORTUGUESE_LOCKING_SHIFT, \
+    GSM0338_PORTUGUESE_SINGLE_SHIFT, a) \
+  X(4, 0x06, hindi, GSM0338_HINDI_LOCKING_SHIFT, \
+    GSM0338_HINDI_SINGLE_SHIFT, a)
+
+/**
+ * @name gsm0338_language_count:
+ *   The number of entries in `GSM0338_LANGUAGES`.
+ */
+#define gsm0338_language_count  (5)
+
+/**
+ * @name GSM0338_TRANSLITERATIONS:
+ *   X-macro listing the default look-alike replacements used by the
+ *   `--transliterate` option, as `X(codepoint, replacement, a)`. Each
+ *   replacement is a UTF-8 string made up of characters from the GSM
+ *   default alphabet; an empty replacement removes the character.
+ */
+#define GSM0338_TRANSLITERATIONS(X, a) \
+  X(0x00a0, " ", a)     /* NO-BREAK SPACE */ \
+  X(0x00ab, "\"", a)    /* LEFT-POINTING DOUBLE ANGLE QUOTATION MARK */ \
+  X(0x00ad, "", a)      /* SOFT HYPHEN */ \
+  X(0x00b4, "'", a)     /* ACUTE ACCENT */ \
+  X(0x00bb, "\"", a)    /* RIGHT-POINTING DOUBLE ANGLE QUOTATION MARK */ \
+  X(0x02bc, "'", a)     /* MODIFIER LETTER APOSTROPHE */ \
+  X(0x02c6, "^", a)     /* MODIFIER LETTER CIRCUMFLEX ACCENT */ \
+  X(0x02dc, "~", a)     /* SMALL TILDE */ \
+  X(0x2002, " ", a)     /* EN SPACE */ \
+  X(0x2003, " ", a)     /* EM SPACE */ \
+  X(0x2007, " ", a)     /* FIGURE SPACE */ \
+  X(0x2008, " ", a)     /* PUNCTUATION SPACE */ \
+  X(0x2009, " ", a)     /* THIN SPACE */ \
+  X(0x200a, " ", a)     /* HAIR SPACE */ \
+  X(0x200b, "", a)      /* ZERO WIDTH SPACE */ \
+  X(0x2010, "-", a)     /* HYPHEN */ \
+  X(0x2011, "-", a)     /* NON-BREAKING HYPHEN */ \
+  X(0x2012, "-", a)     /* FIGURE DASH */ \
+  X(0x2013, "-", a)     /* EN DASH */ \
+  X(0x2014, "-", a)     /* EM DASH */ \
+  X(0x2015, "-", a)     /* HORIZONTAL BAR */ \
+  X(0x2018, "'", a)     /* LEFT SINGLE QUOTATION MARK */ \
+  X(0x2019, "'", a)     /* RIGHT SINGLE QUOTATION MARK */ \
+  X(0x201a, "'", a)     /* SINGLE LOW-9 QUOTATION MARK */ \
+  X(0x201b, "'", a)     /* SINGLE HIGH-REVERSED-9 QUOTATION MARK */ \
+  X(0x201c, "\"", a)    /* LEFT DOUBLE QUOTATION MARK */ \
+  X(0x201d, "\"", a)    /* RIGHT DOUBLE QUOTATION MARK */ \
+  X(0x201e, "\"", a)    /* DOUBLE LOW-9 QUOTATION MARK */ \
+  X(0x201f, "\"", a)    /* DOUBLE HIGH-REVERSED-9 QUOTATION MARK */ \
+  X(0x2022, "-", a)     /* BULLET */ \
+  X(0x2026, "...", a)   /* HORIZONTAL ELLIPSIS */ \
+  X(0x202f, " ", a)     /* NARROW NO-BREAK SPACE */ \
+  X(0x2032, "'", a)     /* PRIME */ \
+  X(0x2033, "\"", a)    /* DOUBLE PRIME */ \
+  X(0x2039, "'", a)     /* SINGLE LEFT-POINTING ANGLE QUOTATION MARK */ \
+  X(0x203a, "'", a)     /* SINGLE RIGHT-POINTING ANGLE QUOTATION MARK */ \
+  X(0x2044, "/", a)     /* FRACTION SLASH */ \
+  X(0x205f, " ", a)     /* MEDIUM MATHEMATICAL SPACE */ \
+  X(0x2212, "-", a)     /* MINUS SIGN */ \
+  X(0x3000, " ", a)     /* IDEOGRAPHIC SPACE */ \
+  X(0xfeff, "", a)      /* ZERO WIDTH NO-BREAK SPACE */
+
+/** --- **/
+
+#endif /* __GSM_H__ */
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
@@ -68,173 +68,184 @@ static const char *const json_validation_errors[] = {
 };
 
 /**
- * @name parsed_json_to_arguments:
+ * @name json_arguments_reserve:
+ *   Ensure that the argument buffer at `*buffer`, which holds `*size`
+ *   pointers, has room for `n` arguments and a null terminator. The
+ *   buffer grows by a few orders of magnitude at a time. Returns a
+ *   `json_validation_error_t` value.
  */
-boolean_t parsed_json_to_arguments(parsed_json_t *p,
-                                   int *argc, char **argv[], int *err) {
+static int json_arguments_reserve(char ***buffer,
+                                  unsigned int *size, size_t n) {
 
-  int n = 0;
-  char **rv = NULL;
+  unsigned int new_size = *size;
 
-  unsigned int size = 0;
-  jsmntok_t *tokens = p->tokens;
-  json_validation_state_t state = START;
-  boolean_t matched_keys[] = { FALSE, FALSE };
-  unsigned int object_size = 0, array_size = 0;
+  while (!new_size || n >= new_size) {
 
-  #define return_validation_error(e) \
-    do { *err = (e); goto validation_error; } while (0)
+    /* Increase size, then check against memory limit */
+    new_size = (new_size ? new_size * 8 : json_argument_list_start);
 
-  #define token_lookahead(i, c) \
-    (((i) + (c)) < p->nr_tokens && \
-      !jsmn_token_is_invalid(tokens + (i) + (c)) ? \
-        (tokens + (i) + (c)) : NULL)
+    if (new_size > json_argument_list_maximum) {
+      return V_ERR_MEM_LIMIT;
+    }
+  }
 
-  /* For every token */
-  for (unsigned int i = 0; i < p->nr_tokens; ++i) {
+  if (new_size == *size) {
+    return V_ERR_NONE;
+  }
 
-    jsmntok_t *t = &tokens[i];
+  /* Enlarge array of argument pointers */
+  char **r = (char **) reallocate_array(*buffer, sizeof(char *), new_size, 1);
 
-    if (matched_keys[0] && matched_keys[1]) {
-      state = SUCCESS;
-      break;
-    }
+  if (!r) {
+    return V_ERR_MEM_ALLOC;
+  }
 
-    if (jsmn_token_is_invalid(t)) {
-      break;
-    }
+  *buffer = r;
+  *size = new_size;
 
-    if (!size || n >= size) {
+  return V_ERR_NONE;
+}
 
-      /* Increase size by a few orders of magnitude */
-      size = (size ? size * 8 : json_argument_list_start);
+/**
+ * @name json_children:
+ *   Return the number of values directly inside the container token
+ *   at index `i`. Each child's subtree size leads straight to the
+ *   next child, so nested values are never visited.
+ */
+static unsigned int json_children(jsmn_compact_t *tokens, unsigned int i) {
 
-      /* Increase size, then check against memory limit */
-      if (size > json_argument_list_maximum) {
-        return_validation_error(V_ERR_MEM_LIMIT);
-      }
+  unsigned int rv = 0;
+  unsigned int end = i + tokens[i].skip + 1;
 
-      /* Enlarge array of argument pointers */
-      if (!(rv = (char **) reallocate_array(rv, sizeof(char *), size, 1))) {
-        return_validation_error(V_ERR_MEM_ALLOC);
-      }
-    }
+  for (unsigned int j = i + 1; j < end; j += tokens[j].skip + 1) {
+    rv++;
+  }
 
-    switch (state) {
+  return rv;
+}
 
-      case START: {
+/**
+ * @name json_arguments:
+ *   Convert the parsed command `p` in to an argument vector, stored
+ *   in the buffer at `*buffer`, which holds `*size` pointers (plus
+ *   one). The buffer is enlarged as needed; both `*buffer` and
+ *   `*size` are updated, and the buffer always belongs to the
+ *   caller, even if validation fails. On failure, `*err` is set to
+ *   a `json_validation_error_t` value. The root object is walked a
+ *   property at a time: each token's subtree size is used to step
+ *   over values that aren't of interest, however deeply nested.
+ */
+static boolean_t json_arguments(parsed_json_t *p,
+                                char ***buffer, unsigned int *size,
+                                int *argc, char **argv[], int *err) {
+  int e;
+  unsigned int n = 0;
+  jsmn_compact_t *tokens = p->tokens;
+  boolean_t matched_keys[] = { FALSE, FALSE };
 
-        if (t->type != JSMN_OBJECT) {
-          return_validation_error(V_ERR_ROOT_TYPE);
-        }
+  #define return_validation_error(x) \
+    do { *err = (x); goto validation_error; } while (0)
 
-        if (t->size % 2 != 0) {
-          return_validation_error(V_ERR_PROPS_ODD);
-        }
+  if (p->nr_tokens == 0) {
+    return_validation_error(V_ERR_PROPS_MISSING);
+  }
 
-        object_size = t->size;
-        state = IN_ROOT_OBJECT;
+  if ((e = json_arguments_reserve(buffer, size, 1)) != V_ERR_NONE) {
+    return_validation_error(e);
+  }
 
-        break;
-      }
+  jsmn_compact_t *root = &tokens[0];
 
-      case IN_ROOT_OBJECT: {
+  if (jsmn_compact_type(root) != JSMN_OBJECT) {
+    return_validation_error(V_ERR_ROOT_TYPE);
+  }
 
-        if (object_size <= 0) {
-          break;
-        }
+  if (json_children(tokens, 0) % 2 != 0) {
+    return_validation_error(V_ERR_PROPS_ODD);
+  }
 
-        if (t->type != JSMN_STRING) {
-          return_validation_error(V_ERR_PROPS_TYPE);
-        }
+  /* For every property of the root object */
+  unsigned int end = root->skip + 1;
 
-        char *s = jsmn_stringify_token(p->json, t);
+  for (unsigned int i = 1; i < end; ) {
 
-        if (!(t = token_lookahead(i, 1))) {
-          return_validation_error(V_ERR_PROPS_ODD);
-        }
+    jsmn_compact_t *k = &tokens[i], *v = &tokens[i + 1];
 
-        if (strcmp(s, "command") == 0) {
+    if (jsmn_compact_type(k) != JSMN_STRING) {
+      return_validation_error(V_ERR_PROPS_TYPE);
+    }
 
-          if (t->type != JSMN_STRING) {
-            return_validation_error(V_ERR_CMD_TYPE);
-          }
+    char *s = jsmn_compact_stringify_token(p->json, k);
 
-          rv[0] = jsmn_stringify_token(p->json, t);
-          matched_keys[0] = TRUE;
+    if (strcmp(s, "command") == 0) {
 
-        } else if (strcmp(s, "arguments") == 0) {
+      if (jsmn_compact_type(v) != JSMN_STRING) {
+        return_validation_error(V_ERR_CMD_TYPE);
+      }
 
-          if (t->type != JSMN_ARRAY && t->type != JSMN_OBJECT) {
-            return_validation_error(V_ERR_ARGS_TYPE);
-          }
+      (*buffer)[0] = jsmn_compact_stringify_token(p->json, v);
+      matched_keys[0] = TRUE;
 
-          /* Handle empty arrays */
-          jsmntok_t *tt = token_lookahead(i, 2);
+    } else if (strcmp(s, "arguments") == 0) {
 
-          if (!tt || t->size <= 0) {
-            matched_keys[1] = TRUE;
-          } else {
-            state = IN_ARGUMENTS_ARRAY;
-          }
+      jsmntype_t type = jsmn_compact_type(v);
 
-          /* Enter array */
-          array_size = t->size;
-        }
+      if (type != JSMN_ARRAY && type != JSMN_OBJECT) {
+        return_validation_error(V_ERR_ARGS_TYPE);
+      }
 
-        /* To walk the stair / steps in pairs */
-        object_size -= 2;
-        i++;
+      /* Every element is a scalar, so it has no subtree:
+       *   The container's subtree size is its number of elements,
+       *   unless validation is about to fail anyway. */
 
-        break;
+      e = json_arguments_reserve(buffer, size, n + v->skip + 1);
+
+      if (e != V_ERR_NONE) {
+        return_validation_error(e);
       }
 
-      case IN_ARGUMENTS_ARRAY: {
+      unsigned int array_end = i + 1 + v->skip + 1;
+
+      for (unsigned int j = i + 2; j < array_end; ++j) {
 
-        if (t->type != JSMN_PRIMITIVE && t->type != JSMN_STRING) {
+        jsmn_compact_t *t = &tokens[j];
+        type = jsmn_compact_type(t);
+
+        if (type != JSMN_PRIMITIVE && type != JSMN_STRING) {
           return_validation_error(V_ERR_ARG_TYPE);
         }
 
-        char *s = jsmn_stringify_token(p->json, t);
+        char *a = jsmn_compact_stringify_token(p->json, t);
 
         /* Require that primitives are numeric */
-        if (t->type == JSMN_PRIMITIVE && (!s || !isdigit(s[0]))) {
+        if (type == JSMN_PRIMITIVE && !isdigit(a[0])) {
           return_validation_error(V_ERR_ARGS_NUMERIC);
         }
 
-        rv[++n] = s;
-
-        if (--array_size <= 0) {
-          matched_keys[1] = TRUE;
-          state = IN_ROOT_OBJECT;
-        }
-
-        break;
+        (*buffer)[++n] = a;
       }
 
-      case SUCCESS: {
-        goto successful;
-      }
+      matched_keys[1] = TRUE;
+    }
 
-      default: {
-        return_validation_error(V_ERR_UNKNOWN);
-        break;
-      }
+    if (matched_keys[0] && matched_keys[1]) {
+      goto successful;
     }
-  }
 
-  if (state != SUCCESS) {
-    return_validation_error(V_ERR_PROPS_MISSING);
+    /* Step over the key, then over the value's whole subtree */
+    i += v->skip + 2;
   }
 
+  return_validation_error(V_ERR_PROPS_MISSING);
+
   /* Victory */
   successful:
 
     /* Null-terminate */
-    rv[n + 1] = NULL;
+    (*buffer)[n + 1] = NULL;
 
     /* Return values */
-    *argv = rv;
+    *argv = *buffer;
     *argc = n + 1;
 
     /* Success */
@@ -243,11 +254,25 @@ boolean_t parsed_json_to_arguments(parsed_json_t *p,
   /* Non-victory */
   validation_error:
 
-    if (rv) {
-      free(rv);
-    }
+    return FALSE;
+
+  #undef return_validation_error
+}
 
+/**
+ * @name parsed_json_to_arguments:
+ */
+boolean_t parsed_json_to_arguments(parsed_json_t *p,
+                                   int *argc, char **argv[], int *err) {
+  char **rv = NULL;
+  unsigned int size = 0;
+
+  if (!json_arguments(p, &rv, &size, argc, argv, err)) {
+    free(rv);
     return FALSE;
+  }
+
+  return TRUE;
 }
 
 /**
@@ -259,16 +284,10 @@ void print_parsed_json(parsed_json_t *p) {
 
   for (unsigned int i = 0; i < p->nr_tokens; ++i) {
 
-    jsmntok_t *t = &p->tokens[i];
-
-    if (jsmn_token_is_invalid(t)) {
-      debug("end\n");
-      break;
-    }
-    
-    char *s = jsmn_stringify_token(p->json, t);
+    jsmn_compact_t *t = &p->tokens[i];
+    char *s = jsmn_compact_stringify_token(p->json, t);
 
-    switch (t->type) {
+    switch (jsmn_compact_type(t)) {
       case JSMN_STRING:
         debug("string: '%s'\n", s);
         break;
@@ -276,93 +295,192 @@ void print_parsed_json(parsed_json_t *p) {
         debug("primitive: '%s'\n", s);
         break;
       case JSMN_OBJECT:
-        debug("object[%d]\n", t->size);
+        debug("object[%u]\n", json_children(p->tokens, i));
         break;
       case JSMN_ARRAY:
-        debug("array[%d]\n", t->size);
+        debug("array[%u]\n", json_children(p->tokens, i));
         break;
-      default:
-        debug("unknown-%d[%d]: '%s'\n", t->type, t->size, s);
-        continue;
     }
   }
+
+  debug("end\n");
 }
 
 /**
- * @name parse_json:
+ * @name parse_json_token_estimate:
+ *   Estimate the number of tokens needed for the `length`-byte JSON
+ *   string in `p`, assuming that the rest of the string is as dense
+ *   with tokens as the part that has been parsed so far.
  */
-parsed_json_t *parse_json(char *json) {
+static size_t parse_json_token_estimate(parsed_json_t *p, size_t length) {
 
-  parsed_json_t *rv =
-    (parsed_json_t *) allocate(sizeof(parsed_json_t));
+  size_t parsed = p->parser.pos;
+  size_t tokens = p->parser.toknext;
 
-  if (!rv) {
-    return NULL;
+  if (parsed == 0 || tokens == 0) {
+    return 0;
   }
 
-  rv->json = json;
-  rv->tokens = NULL;
-  rv->nr_tokens = 0;
+  /* Round up, and leave a little headroom */
+  return (tokens * length + parsed - 1) / parsed + 16;
+}
 
-  unsigned int n = json_parser_tokens_start;
+/**
+ * @name parse_json_indexed:
+ *   Tokenize the `length`-byte JSON string `json` in to `p` via a
+ *   structural index, as described for `parse_json_tokens`. The
+ *   token array is sized once, from the number of indexed positions,
+ *   which is never less than the number of tokens. Returns one of
+ *   `JSMN_SUCCESS`, `JSMN_ERROR_NOMEM`, or `json_index_fallback`.
+ */
+static int parse_json_indexed(parsed_json_t *p, char *json,
+                              size_t length, unsigned int *size) {
 
-  for (;;) {
+  if (!json_index_build(&p->index, json, length)) {
+    return json_index_fallback;
+  }
+
+  size_t n = p->index.count;
+
+  if (n > json_parser_tokens_maximum) {
+    n = json_parser_tokens_maximum;
+  }
 
-    /* Check against upper limit */
-    if (n > json_parser_tokens_maximum) {
-      goto allocation_error;
+  if (n > *size) {
+
+    jsmn_compact_t *t =
+      reallocate_array(p->tokens, sizeof(jsmn_compact_t), n, 0);
+
+    if (!t) {
+      return JSMN_ERROR_NOMEM;
     }
 
-    jsmn_init(&rv->parser);
+    p->tokens = t;
+    *size = n;
+  }
 
-    rv->tokens =
-      reallocate_array(rv->tokens, sizeof(jsmntok_t), n, 0);
+  return json_index_tokenize(&p->index, &p->parser, json, p->tokens, n);
+}
 
-    if (!rv->tokens) {
-      goto allocation_error;
+/**
+ * @name parse_json_tokens:
+ *   Tokenize the `length`-byte JSON string `json` in to `p`, whose
+ *   token array holds `*size` tokens and may be NULL if `*size` is
+ *   zero. The string is tokenized exactly once: if the token array
+ *   fills up, it's enlarged in place and jsmn resumes from the
+ *   position at which it stopped, rather than starting over. The
+ *   new size is projected from the density of tokens seen so far,
+ *   so even very long lines need few reallocations. Both `p->tokens`
+ *   and `*size` are updated, and the array belongs to the caller,
+ *   even on failure. Tokens beyond `p->nr_tokens` are unspecified.
+ */
+static boolean_t parse_json_tokens(parsed_json_t *p, char *json,
+                                   size_t length, unsigned int *size) {
+  p->json = json;
+  p->nr_tokens = 0;
+  p->index.count = 0;
+
+  /* Long strings: index them first
+   *   The index produces exactly the tokens that jsmn would, and
+   *   defers to jsmn for anything it can't reproduce, including
+   *   every kind of malformed input. */
+
+  if (length >= json_index_threshold && json_index_is_accelerated()) {
+
+    switch (parse_json_indexed(p, json, length, size)) {
+      case JSMN_SUCCESS:
+        p->nr_tokens = p->parser.toknext;
+        return TRUE;
+      case json_index_fallback:
+        break;
+      default:
+        return FALSE;
     }
+  }
+
+  jsmn_init(&p->parser);
 
-    /* Set all tokens to invalid */
-    for (unsigned int i = 0; i < n; ++i) {
-      jsmn_mark_token_invalid(&rv->tokens[i]);
+  unsigned int n = (*size ? *size : json_parser_tokens_start);
+
+  for (;;) {
+
+    /* Enlarge the token array, if necessary */
+    if (n > *size) {
+
+      jsmn_compact_t *t =
+        reallocate_array(p->tokens, sizeof(jsmn_compact_t), n, 0);
+
+      if (!t) {
+        return FALSE;
+      }
+
+      p->tokens = t;
+      *size = n;
     }
 
-    /* Parse */
+    /* Parse, or resume parsing */
     jsmnerr_t result =
-      jsmn_parse(&rv->parser, json, rv->tokens, n);
+      jsmn_parse_compact(&p->parser, json, p->tokens, n);
 
     /* Not enough room to parse the full string?
-     *   Increase the available token space by a couple (base two)
-     *   orders of magnitude, then go around, reallocate, and retry. */
+     *   jsmn has stopped at the start of the token that didn't fit,
+     *   and kept every token before it. Make room for at least twice
+     *   as many tokens (or for the projected total, if larger), then
+     *   go around and resume. */
 
     if (result == JSMN_ERROR_NOMEM) {
-      n *= 4;
+
+      if (n >= json_parser_tokens_maximum) {
+        return FALSE;
+      }
+
+      size_t estimate = parse_json_token_estimate(p, length);
+      n = (estimate > 2 * n ? estimate : 2 * n);
+
+      if (n > json_parser_tokens_maximum) {
+        n = json_parser_tokens_maximum;
+      }
+
       continue;
     }
 
     if (result < 0) {
-      goto allocation_error;
+      return FALSE;
     }
 
-    /* Parsed successfully */
-    rv->nr_tokens = n;
-    break;
+    /* Parsed successfully:
+     *   Every token that jsmn allocated has been filled. */
+
+    p->nr_tokens = p->parser.toknext;
+    return TRUE;
   }
+}
 
-  /* Success */
-  return rv;
+/**
+ * @name parse_json:
+ *   Tokenize the null-terminated JSON string `json`, as described
+ *   for `parse_json_tokens`, in to a newly-allocated structure.
+ */
+parsed_json_t *parse_json(char *json) {
 
-  /* Error:
-   *  Clean up the `rv` structure and its members. */
+  parsed_json_t *rv =
+    (parsed_json_t *) allocate(sizeof(parsed_json_t));
 
-  allocation_error:
+  if (!rv) {
+    return NULL;
+  }
 
-    if (rv->tokens) {
-      free(rv->tokens);
-    }
+  unsigned int size = 0;
+  rv->tokens = NULL;
+  rv->index.positions = NULL;
+  rv->index.count = rv->index.size = rv->index.length = 0;
 
-    free(rv);
+  if (!parse_json_tokens(rv, json, strlen(json), &size)) {
+    release_parsed_json(rv);
     return NULL;
+  }
+
+  return rv;
 }
 
 /**
@@ -370,10 +488,195 @@ parsed_json_t *parse_json(char *json) {
  */
 void release_parsed_json(parsed_json_t *p) {
 
+  json_index_release(&p->index);
   free(p->tokens);
   free(p);
 }
 
+/** --- **/
+
+/**
+ * @name json_context_create:
+ */
+json_context_t *json_context_create(unsigned int shrink_interval) {
+
+  json_context_t *rv = allocate(sizeof(*rv));
+
+  rv->parsed.json = NULL;
+  rv->parsed.tokens = NULL;
+  rv->parsed.nr_tokens = 0;
+  rv->tokens_size = 0;
+
+  rv->parsed.index.positions = NULL;
+  rv->parsed.index.count = rv->parsed.index.size = 0;
+  rv->parsed.index.length = 0;
+
+  rv->argv = NULL;
+  rv->argv_size = 0;
+
+  rv->line = NULL;
+  rv->line_size = 0;
+
+  rv->shrink_interval = shrink_interval;
+  rv->commands = 0;
+  rv->line_peak = 0;
+  rv->tokens_peak = 0;
+  rv->argv_peak = 0;
+  rv->index_peak = 0;
+
+  return rv;
+}
+
+/**
+ * @name json_context_destroy:
+ */
+void json_context_destroy(json_context_t *c) {
+
+  free(c->line);
+  json_index_release(&c->parsed.index);
+  free(c->parsed.tokens);
+  free(c->argv);
+  free(c);
+}
+
+/**
+ * @name json_context_parse:
+ */
+parsed_json_t *json_context_parse(json_context_t *c, char *json) {
+
+  size_t length = strlen(json);
+
+  if (length + 1 > c->line_peak) {
+    c->line_peak = length + 1;
+  }
+
+  boolean_t rv =
+    parse_json_tokens(&c->parsed, json, length, &c->tokens_size);
+
+  if (c->parsed.parser.toknext > c->tokens_peak) {
+    c->tokens_peak = c->parsed.parser.toknext;
+  }
+
+  if (c->parsed.index.count > c->index_peak) {
+    c->index_peak = c->parsed.index.count;
+  }
+
+  return (rv ? &c->parsed : NULL);
+}
+
+/**
+ * @name json_context_arguments:
+ */
+boolean_t json_context_arguments(json_context_t *c,
+                                 int *argc, char **argv[], int *err) {
+
+  boolean_t rv = json_arguments(
+    &c->parsed, &c->argv, &c->argv_size, argc, argv, err
+  );
+
+  if (rv && (unsigned int) *argc + 1 > c->argv_peak) {
+    c->argv_peak = *argc + 1;
+  }
+
+  return rv;
+}
+
+/**
+ * @name json_context_shrink_size:
+ *   Return the size to which a buffer that holds `size` items, of
+ *   which at most `peak` were needed recently, should shrink. The
+ *   result is never smaller than `start`, and is `size` itself if
+ *   the buffer shouldn't shrink.
+ */
+static size_t json_context_shrink_size(size_t size,
+                                       size_t peak, size_t start) {
+
+  if (size <= start || peak * json_context_shrink_ratio > size) {
+    return size;
+  }
+
+  size_t rv = 2 * peak;
+  return (rv > start ? rv : start);
+}
+
+/**
+ * @name json_context_finish:
+ */
+void json_context_finish(json_context_t *c) {
+
+  if (!c->shrink_interval || ++c->commands < c->shrink_interval) {
+    return;
+  }
+
+  /* Shrink each buffer that was mostly unused:
+   *   A failed reallocation leaves the larger buffer in place,
+   *   which is harmless; it will be tried again next time. */
+
+  size_t n;
+
+  n = json_context_shrink_size(
+    c->line_size, c->line_peak, json_context_line_start
+  );
+
+  if (n < c->line_size) {
+    char *p = reallocate_array(c->line, sizeof(char), n, 1);
+    if (p) {
+      c->line = p;
+      c->line_size = n;
+    }
+  }
+
+  n = json_context_shrink_size(
+    c->tokens_size, c->tokens_peak, json_parser_tokens_start
+  );
+
+  if (n < c->tokens_size) {
+    jsmn_compact_t *p =
+      reallocate_array(c->parsed.tokens, sizeof(jsmn_compact_t), n, 0);
+    if (p) {
+      c->parsed.tokens = p;
+      c->tokens_size = n;
+    }
+  }
+
+  n = json_context_shrink_size(
+    c->argv_size, c->argv_peak, json_argument_list_start
+  );
+
+  if (n < c->argv_size) {
+    char **p = reallocate_array(c->argv, sizeof(char *), n, 1);
+    if (p) {
+      c->argv = p;
+      c->argv_size = n;
+    }
+  }
+
+  /* The index is only needed for long lines:
+   *   If none were seen recently, it's released entirely. */
+
+  if (!c->index_peak) {
+    json_index_release(&c->parsed.index);
+  } else {
+
+    n = json_context_shrink_size(
+      c->parsed.index.size, c->index_peak, json_index_start
+    );
+
+    if (n < c->parsed.index.size) {
+      uint32_t *p = reallocate_array(
+        c->parsed.index.positions, sizeof(uint32_t), n, 0
+      );
+      if (p) {
+        c->parsed.index.positions = p;
+        c->parsed.index.size = n;
+      }
+    }
+  }
+
+  c->commands = 0;
+  c->line_peak = c->tokens_peak = c->argv_peak = c->index_peak = 0;
+}
+
 /**
  * @name json_validation_error_text:
  */
@@ -36,6 +36,7 @@
 
 #include "types.h"
 #include "allocate.h"
+#include "json_index.h"
 
 #ifndef __JSON_H__
 #define __JSON_H__
@@ -52,16 +53,67 @@
 
 /**
  * @name parsed_json_t:
+ *   A tokenized JSON string. Tokens use jsmn's compact layout: each
+ *   records its subtree size rather than a parent link, so a value
+ *   can be skipped in one step, and large token arrays stay small.
+ *   Long strings are tokenized via a structural index, which is
+ *   kept here so that its buffer can be reused.
  */
 typedef struct parsed_json {
 
   char *json;
   jsmn_parser parser;
-  jsmntok_t *tokens;
+  jsmn_compact_t *tokens;
   unsigned int nr_tokens;
+  json_index_t index;
 
 } parsed_json_t;
 
+/**
+ * @name json_context_t:
+ *   A parser context for a session that handles many commands, such
+ *   as the REPL. The line buffer, token array, and argument vector
+ *   are kept between commands, at the largest size needed so far,
+ *   so that steady-state parsing performs no allocations. If
+ *   `shrink_interval` is non-zero, then after every that many
+ *   commands, any buffer whose recent peak usage was small compared
+ *   to its size is reduced.
+ */
+typedef struct json_context {
+
+  char *line;
+  size_t line_size;
+
+  parsed_json_t parsed;
+  unsigned int tokens_size;
+
+  char **argv;
+  unsigned int argv_size;
+
+  unsigned int shrink_interval;
+  unsigned int commands;
+
+  size_t line_peak;
+  unsigned int tokens_peak;
+  unsigned int argv_peak;
+  size_t index_peak;
+
+} json_context_t;
+
+/**
+ * @name json_context_line_start:
+ *   The smallest size to which `json_context_finish` will shrink the
+ *   line buffer; this matches the initial size used by `read_line`.
+ */
+#define json_context_line_start     (1024)
+
+/**
+ * @name json_context_shrink_ratio:
+ *   A buffer is shrunk only if its size is at least this many times
+ *   its recent peak usage; it is then shrunk to twice that peak.
+ */
+#define json_context_shrink_ratio   (4)
+
 /**
  * @name json_validation_state_t:
  */
@@ -103,6 +155,43 @@ parsed_json_t *parse_json(char *json);
  */
 void release_parsed_json(parsed_json_t *p);
 
+/**
+ * @name json_context_create:
+ *   Create an empty parser context. Buffers are allocated on first
+ *   use. See `json_context_t` for the meaning of `shrink_interval`;
+ *   pass zero to keep every buffer at its high-water mark.
+ */
+json_context_t *json_context_create(unsigned int shrink_interval);
+
+/**
+ * @name json_context_destroy:
+ */
+void json_context_destroy(json_context_t *c);
+
+/**
+ * @name json_context_parse:
+ *   Tokenize `json`, which is usually `c->line`, using the token
+ *   array kept by `c`. Returns a pointer to the context's parse
+ *   result, which is valid until the next call, or NULL on failure.
+ */
+parsed_json_t *json_context_parse(json_context_t *c, char *json);
+
+/**
+ * @name json_context_arguments:
+ *   Convert the most recent parse result of `c` to an argument
+ *   vector, as `parsed_json_to_arguments` does. The vector belongs
+ *   to `c`, and must not be freed; it is valid until the next call.
+ */
+boolean_t json_context_arguments(json_context_t *c,
+                                 int *argc, char **argv[], int *err);
+
+/**
+ * @name json_context_finish:
+ *   Note that a command has been completely handled, and apply the
+ *   shrink policy of `c` if it is due.
+ */
+void json_context_finish(json_context_t *c);
+
 /**
  * @name json_validation_error_text:
  */
@@ -0,0 +1,546 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+  #include <immintrin.h>
+  #define JSON_INDEX_X86_SIMD (1)
+#endif
+
+#include "cpu.h"
+#include "allocate.h"
+#include "json_index.h"
+
+/** --- **/
+
+/**
+ * @name json_index_block_t:
+ *   Bitmasks describing sixty-four consecutive bytes; bit `i` of
+ *   each mask refers to byte `i` of the block.
+ */
+typedef struct json_index_block {
+
+  uint64_t quote;       /* Double quote */
+  uint64_t backslash;   /* Backslash */
+  uint64_t bracket;     /* Braces and square brackets */
+  uint64_t separator;   /* Colon, comma, and whitespace */
+
+} json_index_block_t;
+
+/**
+ * @name json_index_classify_fn_t:
+ *   Classify the sixty-four bytes at `p`, all of which are readable.
+ */
+typedef void (*json_index_classify_fn_t)(const uint8_t *p,
+                                         json_index_block_t *b);
+
+/**
+ * @name json_index_class:
+ *   Character classes for the scalar implementation.
+ */
+enum {
+  C_OTHER = 0, C_QUOTE = 1, C_BACKSLASH = 2,
+    C_BRACKET = 3, C_SEPARATOR = 4
+};
+
+/**
+ * @name json_index_classify_scalar:
+ *   Portable implementation of `json_index_classify_fn_t`.
+ */
+static void json_index_classify_scalar(const uint8_t *p,
+                                       json_index_block_t *b) {
+
+  b->quote = b->backslash = b->bracket = b->separator = 0;
+
+  for (unsigned int i = 0; i < 64; ++i) {
+
+    uint64_t bit = ((uint64_t) 1 << i);
+
+    switch (p[i]) {
+      case '"':
+        b->quote |= bit;
+        break;
+      case '\\':
+        b->backslash |= bit;
+        break;
+      case '{': case '}': case '[': case ']':
+        b->bracket |= bit;
+        break;
+      case ':': case ',': case ' ': case '\t': case '\n': case '\r':
+        b->separator |= bit;
+        break;
+    }
+  }
+}
+
+#ifdef JSON_INDEX_X86_SIMD
+
+/**
+ * @name json_index_classify_sse2:
+ *   SSE2 implementation of `json_index_classify_fn_t`; classifies
+ *   sixteen bytes per step. Setting bit 0x20 maps both kinds of
+ *   opening bracket to '{', and both kinds of closing bracket to
+ *   '}', without matching any other byte.
+ */
+__attribute__((target("sse2")))
+static void json_index_classify_sse2(const uint8_t *p,
+                                     json_index_block_t *b) {
+
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i case_bit = _mm_set1_epi8(0x20);
+  const __m128i open = _mm_set1_epi8('{');
+  const __m128i close = _mm_set1_epi8('}');
+  const __m128i colon = _mm_set1_epi8(':');
+  const __m128i comma = _mm_set1_epi8(',');
+  const __m128i space = _mm_set1_epi8(' ');
+  const __m128i tab = _mm_set1_epi8('\t');
+  const __m128i lf = _mm_set1_epi8('\n');
+  const __m128i cr = _mm_set1_epi8('\r');
+
+  b->quote = b->backslash = b->bracket = b->separator = 0;
+
+  for (unsigned int i = 0; i < 64; i += 16) {
+
+    __m128i v = _mm_loadu_si128((const __m128i *) (p + i));
+    __m128i folded = _mm_or_si128(v, case_bit);
+
+    __m128i brackets = _mm_or_si128(
+      _mm_cmpeq_epi8(folded, open), _mm_cmpeq_epi8(folded, close)
+    );
+
+    __m128i separators = _mm_or_si128(
+      _mm_or_si128(_mm_cmpeq_epi8(v, colon), _mm_cmpeq_epi8(v, comma)),
+      _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab)),
+        _mm_or_si128(_mm_cmpeq_epi8(v, lf), _mm_cmpeq_epi8(v, cr))
+      )
+    );
+
+    b->quote |= (uint64_t) (uint16_t)
+      _mm_movemask_epi8(_mm_cmpeq_epi8(v, quote)) << i;
+    b->backslash |= (uint64_t) (uint16_t)
+      _mm_movemask_epi8(_mm_cmpeq_epi8(v, backslash)) << i;
+    b->bracket |= (uint64_t) (uint16_t)
+      _mm_movemask_epi8(brackets) << i;
+    b->separator |= (uint64_t) (uint16_t)
+      _mm_movemask_epi8(separators) << i;
+  }
+}
+
+/**
+ * @name json_index_classify_avx2:
+ *   AVX2 implementation of `json_index_classify_fn_t`; classifies
+ *   thirty-two bytes per step, as above.
+ */
+__attribute__((target("avx2")))
+static void json_index_classify_avx2(const uint8_t *p,
+                                     json_index_block_t *b) {
+
+  const __m256i quote = _mm256_set1_epi8('"');
+  const __m256i backslash = _mm256_set1_epi8('\\');
+  const __m256i case_bit = _mm256_set1_epi8(0x20);
+  const __m256i open = _mm256_set1_epi8('{');
+  const __m256i close = _mm256_set1_epi8('}');
+  const __m256i colon = _mm256_set1_epi8(':');
+  const __m256i comma = _mm256_set1_epi8(',');
+  const __m256i space = _mm256_set1_epi8(' ');
+  const __m256i tab = _mm256_set1_epi8('\t');
+  const __m256i lf = _mm256_set1_epi8('\n');
+  const __m256i cr = _mm256_set1_epi8('\r');
+
+  b->quote = b->backslash = b->bracket = b->separator = 0;
+
+  for (unsigned int i = 0; i < 64; i += 32) {
+
+    __m256i v = _mm256_loadu_si256((const __m256i *) (p + i));
+    __m256i folded = _mm256_or_si256(v, case_bit);
+
+    __m256i brackets = _mm256_or_si256(
+      _mm256_cmpeq_epi8(folded, open), _mm256_cmpeq_epi8(folded, close)
+    );
+
+    __m256i separators = _mm256_or_si256(
+      _mm256_or_si256(
+        _mm256_cmpeq_epi8(v, colon), _mm256_cmpeq_epi8(v, comma)
+      ),
+      _mm256_or_si256(
+        _mm256_or_si256(
+          _mm256_cmpeq_epi8(v, space), _mm256_cmpeq_epi8(v, tab)
+        ),
+        _mm256_or_si256(
+          _mm256_cmpeq_epi8(v, lf), _mm256_cmpeq_epi8(v, cr)
+        )
+      )
+    );
+
+    b->quote |= (uint64_t) (uint32_t)
+      _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, quote)) << i;
+    b->backslash |= (uint64_t) (uint32_t)
+      _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, backslash)) << i;
+    b->bracket |= (uint64_t) (uint32_t)
+      _mm256_movemask_epi8(brackets) << i;
+    b->separator |= (uint64_t) (uint32_t)
+      _mm256_movemask_epi8(separators) << i;
+  }
+}
+
+#endif /* JSON_INDEX_X86_SIMD */
+
+/**
+ * @name json_index_classifier:
+ *   Return the widest classifier that the current processor supports.
+ */
+static json_index_classify_fn_t json_index_classifier(void) {
+
+  #ifdef JSON_INDEX_X86_SIMD
+    unsigned int features = cpu_features();
+
+    if (features & CPU_AVX2) {
+      return json_index_classify_avx2;
+    }
+
+    if (features & CPU_SSE2) {
+      return json_index_classify_sse2;
+    }
+  #endif
+
+  return json_index_classify_scalar;
+}
+
+/**
+ * @name json_index_is_accelerated:
+ */
+boolean_t json_index_is_accelerated(void) {
+
+  return (json_index_classifier() != json_index_classify_scalar);
+}
+
+/**
+ * @name json_index_prefix_xor:
+ *   Set bit `i` of the result to the parity of bits zero through `i`
+ *   of `x`. Applied to a mask of quotes, this yields a mask of the
+ *   bytes inside of strings, including each opening quote.
+ */
+static inline uint64_t json_index_prefix_xor(uint64_t x) {
+
+  x ^= x << 1; x ^= x << 2; x ^= x << 4;
+  x ^= x << 8; x ^= x << 16; x ^= x << 32;
+
+  return x;
+}
+
+/**
+ * @name json_index_escaped:
+ *   Return a mask of the bytes in a block that are escaped, given a
+ *   mask of its backslashes. A backslash escapes the byte after it,
+ *   unless it's escaped itself. `*carry` is one if the first byte of
+ *   this block is escaped, and is updated for the next block. Runs
+ *   of backslashes are rare outside of strings with escapes, so
+ *   visiting each one in turn is inexpensive.
+ */
+static inline uint64_t json_index_escaped(uint64_t backslash,
+                                          uint64_t *carry) {
+  uint64_t rv = *carry;
+  *carry = 0;
+
+  while (backslash) {
+
+    unsigned int i = __builtin_ctzll(backslash);
+    backslash &= backslash - 1;
+
+    if (rv & ((uint64_t) 1 << i)) {
+      continue;
+    }
+
+    if (i == 63) {
+      *carry = 1;
+    } else {
+      rv |= ((uint64_t) 1 << (i + 1));
+    }
+  }
+
+  return rv;
+}
+
+/**
+ * @name json_index_build:
+ */
+boolean_t json_index_build(json_index_t *x, const char *json, size_t length) {
+
+  uint8_t tail[64];
+  json_index_block_t b;
+  json_index_classify_fn_t classify = json_index_classifier();
+
+  /* State carried between blocks */
+  uint64_t escape_carry = 0, string_carry = 0, scalar_carry = 0;
+
+  x->count = 0;
+  x->length = length;
+
+  if (length >= JSMN_COMPACT_OFFSET_MASK) {
+    return FALSE;
+  }
+
+  for (size_t offset = 0; offset < length; offset += 64) {
+
+    /* Room for every position in this block */
+    if (x->count + 64 > x->size) {
+
+      size_t n = (x->size ? x->size * 2 : json_index_start);
+
+      uint32_t *p =
+        reallocate_array(x->positions, sizeof(uint32_t), n, 0);
+
+      if (!p) {
+        return FALSE;
+      }
+
+      x->positions = p;
+      x->size = n;
+    }
+
+    /* Final partial block:
+     *   Pad with whitespace, which never produces a position. */
+
+    const uint8_t *p = (const uint8_t *) json + offset;
+
+    if (length - offset < 64) {
+      memset(tail, ' ', sizeof(tail));
+      memcpy(tail, p, length - offset);
+      p = tail;
+    }
+
+    classify(p, &b);
+
+    uint64_t quote =
+      b.quote & ~json_index_escaped(b.backslash, &escape_carry);
+
+    uint64_t in_string = json_index_prefix_xor(quote) ^ string_carry;
+    string_carry = (uint64_t) 0 - (in_string >> 63);
+
+    /* Bytes of primitive values; the first byte of each run */
+    uint64_t scalar = ~(quote | b.bracket | b.separator | in_string);
+    uint64_t starts = scalar & ~((scalar << 1) | scalar_carry);
+    scalar_carry = scalar >> 63;
+
+    uint64_t positions = (b.bracket & ~in_string) | quote | starts;
+
+    while (positions) {
+      x->positions[x->count++] =
+        (uint32_t) (offset + __builtin_ctzll(positions));
+      positions &= positions - 1;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+ * @name json_index_primitive_end:
+ *   Return the position just past the primitive value that starts
+ *   at `start`, or zero if jsmn would reject or stop inside of it.
+ */
+static size_t json_index_primitive_end(const char *json, size_t start) {
+
+  for (size_t i = start; json[i] != '\0'; ++i) {
+    switch (json[i]) {
+      case '\t': case '\r': case '\n': case ' ':
+      case ',': case ']': case '}':
+        return i;
+    }
+    if (json[i] < 32 || json[i] >= 127) {
+      return 0;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * @name json_index_string_is_plain:
+ *   Return true if the escape sequences in the string body between
+ *   `start` and `end` are all ones that jsmn accepts, and none of
+ *   them extends past `end`. If so, jsmn's closing quote is the one
+ *   found by the index.
+ */
+static boolean_t json_index_string_is_plain(const char *json,
+                                            size_t start, size_t end) {
+
+  const char *p = json + start, *e = json + end;
+
+  while ((p = memchr(p, '\\', e - p)) != NULL) {
+
+    switch (p[1]) {
+      case '"': case '/': case '\\': case 'b':
+      case 'f': case 'r': case 'n': case 't':
+        p += 2;
+        break;
+      case 'u':
+        if (e - p < 6) {
+          return FALSE;
+        }
+        for (unsigned int i = 2; i < 6; ++i) {
+          char c = p[i];
+          if (!((c >= '0' && c <= '9') ||
+                (c >= 'A' && c <= 'F') || (c >= 'a' && c <= 'f'))) {
+            return FALSE;
+          }
+        }
+        p += 6;
+        break;
+      default:
+        return FALSE;
+    }
+
+    if (p >= e) {
+      return (p == e);
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+ * @name json_index_tokenize:
+ *   Any input for which jsmn reports an error produces a fallback
+ *   here, rather than an error code, so that the error reported is
+ *   always jsmn's own.
+ */
+int json_index_tokenize(json_index_t *x, jsmn_parser *parser,
+                        const char *json, jsmn_compact_t *tokens,
+                        unsigned int num_tokens) {
+  jsmn_compact_t *t;
+  uint32_t *positions = x->positions;
+
+  jsmn_init(parser);
+
+  for (size_t k = 0; k < x->count; ++k) {
+
+    uint32_t start = positions[k], end;
+    char c = json[start];
+
+    switch (c) {
+
+      case '{': case '[':
+        if ((unsigned int) parser->toknext >= num_tokens) {
+          return JSMN_ERROR_NOMEM;
+        }
+        t = &tokens[parser->toknext];
+        t->start = jsmn_compact_pack(
+          (c == '{' ? JSMN_OBJECT : JSMN_ARRAY), start
+        );
+        t->end = JSMN_COMPACT_OPEN | (parser->toksuper + 1);
+        t->skip = 0;
+        parser->toksuper = parser->toknext++;
+        break;
+
+      case '}': case ']':
+        if (parser->toksuper == -1) {
+          return json_index_fallback;
+        }
+        t = &tokens[parser->toksuper];
+        if (jsmn_compact_type(t) != (c == '}' ? JSMN_OBJECT : JSMN_ARRAY)) {
+          return json_index_fallback;
+        }
+        t->skip = parser->toknext - parser->toksuper - 1;
+        parser->toksuper = (int) (t->end & ~JSMN_COMPACT_OPEN) - 1;
+        t->end = start + 1;
+        break;
+
+      case '"':
+        /* The next position is the closing quote */
+        if (k + 1 >= x->count || json[(end = positions[k + 1])] != '"') {
+          return json_index_fallback;
+        }
+        if (!json_index_string_is_plain(json, start + 1, end)) {
+          return json_index_fallback;
+        }
+        if ((unsigned int) parser->toknext >= num_tokens) {
+          return JSMN_ERROR_NOMEM;
+        }
+        t = &tokens[parser->toknext++];
+        t->start = jsmn_compact_pack(JSMN_STRING, start + 1);
+        t->end = end;
+        t->skip = 0;
+        k++;
+        break;
+
+      case '-': case '0': case '1': case '2': case '3': case '4':
+      case '5': case '6': case '7': case '8': case '9':
+      case 't': case 'f': case 'n':
+        /* jsmn ends a primitive at fewer characters than the index
+         *   does; if they disagree, jsmn would have read past the
+         *   next indexed position. */
+        end = json_index_primitive_end(json, start);
+        if (!end || (k + 1 < x->count && positions[k + 1] < end)) {
+          return json_index_fallback;
+        }
+        if ((unsigned int) parser->toknext >= num_tokens) {
+          return JSMN_ERROR_NOMEM;
+        }
+        t = &tokens[parser->toknext++];
+        t->start = jsmn_compact_pack(JSMN_PRIMITIVE, start);
+        t->end = end;
+        t->skip = 0;
+        break;
+
+      default:
+        return json_index_fallback;
+    }
+  }
+
+  /* Unmatched opened object or array */
+  if (parser->toksuper != -1) {
+    return json_index_fallback;
+  }
+
+  parser->pos = x->length;
+  return JSMN_SUCCESS;
+}
+
+/**
+ * @name json_index_release:
+ */
+void json_index_release(json_index_t *x) {
+
+  free(x->positions);
+
+  x->positions = NULL;
+  x->count = x->size = x->length = 0;
+}
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
@@ -0,0 +1,126 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jsmn.h>
+#include <stdint.h>
+
+#include "types.h"
+
+#ifndef __JSON_INDEX_H__
+#define __JSON_INDEX_H__
+
+/** --- **/
+
+/**
+ * @name json_index_threshold:
+ *   The shortest JSON string, in bytes, for which `parse_json` will
+ *   build a structural index rather than running jsmn directly. The
+ *   index only pays for itself once there are long runs of bytes
+ *   that can be classified in bulk.
+ */
+#define json_index_threshold    (4096)
+
+/**
+ * @name json_index_start:
+ *   The initial number of positions in a structural index.
+ */
+#define json_index_start        (256)
+
+/**
+ * @name json_index_fallback:
+ *   Returned by `json_index_tokenize` when the index can't be used
+ *   to reproduce jsmn's result exactly; the caller must then run
+ *   jsmn itself. This never happens for well-formed JSON.
+ */
+#define json_index_fallback     (1)
+
+/**
+ * @name json_index_t:
+ *   A structural index of a JSON string: the positions of every
+ *   unescaped quote, every bracket or brace outside of a string,
+ *   and the first byte of every value that is neither a string nor
+ *   a container, in ascending order. Colons, commas, and whitespace
+ *   are classified but not recorded; jsmn's grammar ignores them.
+ */
+typedef struct json_index {
+
+  uint32_t *positions;
+  size_t count;
+  size_t size;
+  size_t length;
+
+} json_index_t;
+
+/**
+ * @name json_index_is_accelerated:
+ *   Return true if `json_index_build` can use vector instructions
+ *   on this processor. The scalar implementation is correct but
+ *   slower than jsmn alone, so the index is only worth building
+ *   when this is true.
+ */
+boolean_t json_index_is_accelerated(void);
+
+/**
+ * @name json_index_build:
+ *   Stage one: classify the `length`-byte string `json` sixty-four
+ *   bytes at a time, and store the positions of its structural
+ *   characters in `x`, whose buffer is reused and enlarged as
+ *   needed. Returns false if memory couldn't be allocated, or if
+ *   `json` is too long for jsmn's compact tokens.
+ */
+boolean_t json_index_build(json_index_t *x, const char *json, size_t length);
+
+/**
+ * @name json_index_tokenize:
+ *   Stage two: fill `tokens` from the index `x` of `json`, exactly
+ *   as `jsmn_parse_compact` would from a freshly-initialized
+ *   `parser`, visiting only the indexed positions. Returns
+ *   `JSMN_SUCCESS`, `JSMN_ERROR_NOMEM` if `num_tokens` tokens are
+ *   not enough, or `json_index_fallback`.
+ */
+int json_index_tokenize(json_index_t *x, jsmn_parser *parser,
+                        const char *json, jsmn_compact_t *tokens,
+                        unsigned int num_tokens);
+
+/**
+ * @name json_index_release:
+ *   Free the buffer held by `x`, leaving it empty and reusable.
+ */
+void json_index_release(json_index_t *x);
+
+/** --- **/
+
+#endif /* __JSON_INDEX_H__ */
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
@@ -0,0 +1,503 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "allocate.h"
+#include "json_stream.h"
+
+/** --- **/
+
+/**
+ * @name json_stream_reset:
+ *   Forget the current command, and expect a new top-level value.
+ */
+static void json_stream_reset(json_stream_t *j) {
+
+  j->depth = 0;
+  j->is_key = FALSE;
+  j->value_length = 0;
+
+  j->err = V_ERR_NONE;
+  j->key = JK_OTHER;
+  j->in_arguments = FALSE;
+  j->matched_command = FALSE;
+  j->matched_arguments = FALSE;
+}
+
+/**
+ * @name json_stream_create:
+ */
+json_stream_t *json_stream_create(const json_stream_handler_t *h) {
+
+  json_stream_t *rv = allocate(sizeof(*rv));
+
+  rv->handler = *h;
+  rv->state = JS_VALUE;
+
+  rv->stack = allocate_array(sizeof(char), json_stream_stack_start, 0);
+  rv->stack_size = json_stream_stack_start;
+
+  rv->value = allocate_array(sizeof(char), json_stream_buffer_start, 1);
+  rv->value_size = json_stream_buffer_start;
+  rv->hex_digits = 0;
+
+  json_stream_reset(rv);
+  return rv;
+}
+
+/**
+ * @name json_stream_destroy:
+ */
+void json_stream_destroy(json_stream_t *j) {
+
+  free(j->stack);
+  free(j->value);
+  free(j);
+}
+
+/**
+ * @name json_stream_fail:
+ *   Reject the current top-level value with `err`, because input
+ *   couldn't be tokenized, and discard the rest of the current line.
+ */
+static void json_stream_fail(json_stream_t *j, json_validation_error_t err) {
+
+  j->handler.end(j->handler.data, err);
+
+  json_stream_reset(j);
+  j->state = JS_DISCARD;
+}
+
+/**
+ * @name json_stream_append:
+ *   Append `length` bytes at `p` to the value being read.
+ */
+static boolean_t json_stream_append(json_stream_t *j,
+                                    const char *p, size_t length) {
+
+  if (j->value_length + length > j->value_size) {
+
+    size_t n = j->value_size * 2;
+
+    while (n < j->value_length + length) {
+      n *= 2;
+    }
+
+    char *v = reallocate_array(j->value, sizeof(char), n, 1);
+
+    if (!v) {
+      return FALSE;
+    }
+
+    j->value = v;
+    j->value_size = n;
+  }
+
+  memcpy(j->value + j->value_length, p, length);
+  j->value_length += length;
+
+  return TRUE;
+}
+
+/**
+ * @name json_stream_complete:
+ *   The top-level value has ended: report the result.
+ */
+static void json_stream_complete(json_stream_t *j) {
+
+  json_validation_error_t err = j->err;
+
+  if (!err && !(j->matched_command && j->matched_arguments)) {
+    err = V_ERR_PROPS_MISSING;
+  }
+
+  j->handler.end(j->handler.data, err);
+  json_stream_reset(j);
+}
+
+/**
+ * @name json_stream_on_open:
+ *   A container is about to be opened, at the current depth.
+ */
+static void json_stream_on_open(json_stream_t *j, char c) {
+
+  if (j->depth == 0) {
+    if (c != '{') {
+      j->err = V_ERR_ROOT_TYPE;
+    }
+    return;
+  }
+
+  if (j->err) {
+    return;
+  }
+
+  if (j->depth == 1 && j->is_key) {
+    j->err = V_ERR_PROPS_TYPE;
+  } else if (j->depth == 1 && j->key == JK_COMMAND) {
+    j->err = V_ERR_CMD_TYPE;
+  } else if (j->depth == 1 && j->key == JK_ARGUMENTS) {
+    if (c == '[') {
+      j->in_arguments = j->matched_arguments = TRUE;
+    } else {
+      j->err = V_ERR_ARGS_TYPE;
+    }
+  } else if (j->depth == 2 && j->in_arguments) {
+    j->err = V_ERR_ARG_TYPE;
+  }
+}
+
+/**
+ * @name json_stream_on_close:
+ *   A container has just been closed; the depth is that of its parent.
+ */
+static void json_stream_on_close(json_stream_t *j) {
+
+  if (j->depth == 0) {
+
+    /* A key without a value */
+    if (!j->err && j->stack[0] == '{' && !j->is_key) {
+      j->err = V_ERR_PROPS_ODD;
+    }
+
+    json_stream_complete(j);
+
+  } else if (j->depth == 1) {
+    j->in_arguments = FALSE;
+    j->is_key = !j->is_key;
+  }
+}
+
+/**
+ * @name json_stream_on_scalar:
+ *   A string or primitive value has been read in to `j->value`.
+ */
+static void json_stream_on_scalar(json_stream_t *j, boolean_t is_string) {
+
+  char *s = j->value;
+  size_t length = j->value_length;
+
+  s[length] = '\0';
+
+  if (j->depth == 0) {
+    j->err = V_ERR_ROOT_TYPE;
+    json_stream_complete(j);
+    return;
+  }
+
+  if (j->err) {
+    return;
+  }
+
+  if (j->depth == 1 && j->is_key) {
+
+    if (!is_string) {
+      j->err = V_ERR_PROPS_TYPE;
+    } else if (strcmp(s, "command") == 0) {
+      j->key = JK_COMMAND;
+    } else if (strcmp(s, "arguments") == 0) {
+      j->key = JK_ARGUMENTS;
+    } else {
+      j->key = JK_OTHER;
+    }
+
+  } else if (j->depth == 1 && j->key == JK_COMMAND) {
+
+    if (!is_string) {
+      j->err = V_ERR_CMD_TYPE;
+      return;
+    }
+
+    j->matched_command = TRUE;
+    j->handler.command(j->handler.data, s, length);
+
+  } else if (j->depth == 1 && j->key == JK_ARGUMENTS) {
+
+    j->err = V_ERR_ARGS_TYPE;
+
+  } else if (j->depth == 2 && j->in_arguments) {
+
+    /* Require that primitives are numeric */
+    if (!is_string && !isdigit(s[0])) {
+      j->err = V_ERR_ARGS_NUMERIC;
+      return;
+    }
+
+    j->handler.argument(j->handler.data, s, length);
+  }
+}
+
+/**
+ * @name json_stream_after_value:
+ *   A string or primitive value has ended. Properties of the root
+ *   object alternate between keys and values by position alone.
+ */
+static void json_stream_after_value(json_stream_t *j) {
+
+  if (j->depth == 1) {
+    j->is_key = !j->is_key;
+  }
+
+  j->state = JS_VALUE;
+}
+
+/**
+ * @name json_stream_close:
+ *   Close the innermost container with `c`, if it matches.
+ */
+static boolean_t json_stream_close(json_stream_t *j, char c) {
+
+  if (j->depth == 0 || j->stack[j->depth - 1] != (c == '}' ? '{' : '[')) {
+    return FALSE;
+  }
+
+  j->depth--;
+  json_stream_on_close(j);
+
+  j->state = JS_VALUE;
+  return TRUE;
+}
+
+/**
+ * @name json_stream_value:
+ *   Handle the byte `c`, outside of any string or primitive. As in
+ *   `jsmn_parse`, separators are treated as whitespace, so that any
+ *   input `parse_json` accepts is accepted here too.
+ */
+static void json_stream_value(json_stream_t *j, char c) {
+
+  switch (c) {
+
+    case ' ': case '\t': case '\r': case '\n':
+    case ',': case ':':
+      return;
+
+    case '"':
+      j->value_length = 0;
+      j->state = JS_STRING;
+      return;
+
+    case '{': case '[':
+
+      if (j->depth == j->stack_size) {
+
+        char *s = reallocate_array(
+          j->stack, sizeof(char), j->stack_size * 2, 0
+        );
+
+        if (!s) {
+          json_stream_fail(j, V_ERR_MEM_ALLOC);
+          return;
+        }
+
+        j->stack = s;
+        j->stack_size *= 2;
+      }
+
+      json_stream_on_open(j, c);
+
+      /* The root object's first property is a key */
+      if (j->depth == 0) {
+        j->is_key = (c == '{');
+      }
+
+      j->stack[j->depth++] = c;
+      return;
+
+    case '}': case ']':
+
+      if (!json_stream_close(j, c)) {
+        json_stream_fail(j, V_ERR_PARSE);
+      }
+      return;
+
+    case '-': case '0': case '1': case '2': case '3': case '4':
+    case '5': case '6': case '7': case '8': case '9':
+    case 't': case 'f': case 'n':
+
+      j->value[0] = c;
+      j->value_length = 1;
+      j->state = JS_PRIMITIVE;
+      return;
+
+    default:
+      json_stream_fail(j, V_ERR_PARSE);
+      return;
+  }
+}
+
+/**
+ * @name json_stream_feed:
+ */
+void json_stream_feed(json_stream_t *j, const char *p, size_t length) {
+
+  const char *e = p + length;
+
+  while (p < e) {
+
+    char c = *p;
+
+    switch (j->state) {
+
+      case JS_DISCARD: {
+
+        const char *n = memchr(p, '\n', e - p);
+
+        if (!n) {
+          return;
+        }
+
+        j->state = JS_VALUE;
+        p = n + 1;
+        continue;
+      }
+
+      case JS_VALUE:
+        json_stream_value(j, c);
+        break;
+
+      case JS_STRING: {
+
+        /* Copy everything up to the next quote or escape at once */
+        const char *q = p;
+
+        while (q < e && *q != '"' && *q != '\\') {
+          q++;
+        }
+
+        if (!json_stream_append(j, p, q - p)) {
+          json_stream_fail(j, V_ERR_MEM_ALLOC);
+          p = q;
+          continue;
+        }
+
+        p = q;
+
+        if (p == e) {
+          return;
+        }
+
+        if (*p == '"') {
+          json_stream_on_scalar(j, TRUE);
+          json_stream_after_value(j);
+        } else {
+          j->state = JS_ESCAPE;
+          if (!json_stream_append(j, p, 1)) {
+            json_stream_fail(j, V_ERR_MEM_ALLOC);
+          }
+        }
+        break;
+      }
+
+      case JS_ESCAPE:
+        switch (c) {
+          case '"': case '/': case '\\': case 'b':
+          case 'f': case 'r': case 'n': case 't':
+            j->state = JS_STRING;
+            break;
+          case 'u':
+            j->hex_digits = 4;
+            j->state = JS_UNICODE;
+            break;
+          default:
+            json_stream_fail(j, V_ERR_PARSE);
+            break;
+        }
+        if (j->state != JS_DISCARD && !json_stream_append(j, p, 1)) {
+          json_stream_fail(j, V_ERR_MEM_ALLOC);
+        }
+        break;
+
+      case JS_UNICODE:
+        if (!isxdigit((unsigned char) c)) {
+          json_stream_fail(j, V_ERR_PARSE);
+          break;
+        }
+        if (!json_stream_append(j, p, 1)) {
+          json_stream_fail(j, V_ERR_MEM_ALLOC);
+          break;
+        }
+        if (--j->hex_digits == 0) {
+          j->state = JS_STRING;
+        }
+        break;
+
+      case JS_PRIMITIVE:
+        switch (c) {
+          case ' ': case '\t': case '\r': case '\n':
+          case ',': case ']': case '}':
+            /* The delimiter belongs to what follows */
+            json_stream_on_scalar(j, FALSE);
+            json_stream_after_value(j);
+            continue;
+          default:
+            if (c < 32 || c >= 127) {
+              json_stream_fail(j, V_ERR_PARSE);
+            } else if (!json_stream_append(j, p, 1)) {
+              json_stream_fail(j, V_ERR_MEM_ALLOC);
+            }
+            break;
+        }
+        break;
+    }
+
+    p++;
+  }
+}
+
+/**
+ * @name json_stream_finish:
+ */
+void json_stream_finish(json_stream_t *j) {
+
+  /* A top-level primitive ends at the end of input */
+  if (j->state == JS_PRIMITIVE && j->depth == 0) {
+    json_stream_on_scalar(j, FALSE);
+    j->state = JS_VALUE;
+  }
+
+  if (j->state != JS_VALUE && j->state != JS_DISCARD) {
+    json_stream_fail(j, V_ERR_PARSE);
+  } else if (j->depth > 0) {
+    json_stream_fail(j, V_ERR_PARSE);
+  }
+
+  json_stream_reset(j);
+  j->state = JS_VALUE;
+}
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
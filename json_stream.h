@@ -0,0 +1,161 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stddef.h>
+
+#include "types.h"
+#include "json.h"
+
+#ifndef __JSON_STREAM_H__
+#define __JSON_STREAM_H__
+
+/** --- **/
+
+/**
+ * @name json_stream_buffer_start:
+ *   The initial size of the buffer that holds the string or
+ *   primitive value currently being read.
+ */
+#define json_stream_buffer_start    (256)
+
+/**
+ * @name json_stream_stack_start:
+ *   The initial number of nesting levels that can be tracked.
+ */
+#define json_stream_stack_start     (16)
+
+/**
+ * @name json_stream_handler_t:
+ *   Functions called by a stream parser as it reads each command.
+ *   `command` receives the value of a `command` property, and
+ *   `argument` receives each element of an `arguments` array, as
+ *   soon as it has been read; strings are passed exactly as they
+ *   appear in the input, as `parse_json` does. The value is null-
+ *   terminated, and is valid only until the function returns. `end`
+ *   is called once for every top-level value, when it's complete or
+ *   has been rejected, with a `json_validation_error_t` value.
+ */
+typedef struct json_stream_handler {
+
+  void (*command)(void *data, const char *s, size_t length);
+  void (*argument)(void *data, const char *s, size_t length);
+  void (*end)(void *data, json_validation_error_t err);
+  void *data;
+
+} json_stream_handler_t;
+
+/**
+ * @name json_stream_state_t:
+ */
+typedef enum {
+  JS_VALUE = 0, JS_STRING, JS_ESCAPE,
+    JS_UNICODE, JS_PRIMITIVE, JS_DISCARD
+} json_stream_state_t;
+
+/**
+ * @name json_stream_key_t:
+ */
+typedef enum {
+  JK_OTHER = 0, JK_COMMAND, JK_ARGUMENTS
+} json_stream_key_t;
+
+/**
+ * @name json_stream_t:
+ *   An incremental parser for a sequence of JSON commands, of the
+ *   same form as those accepted by `parsed_json_to_arguments`. Input
+ *   may be split at any byte, and commands needn't be separated by
+ *   newlines. Memory use depends only upon the longest single value
+ *   and the deepest nesting, never upon the number of arguments.
+ */
+typedef struct json_stream {
+
+  json_stream_handler_t handler;
+  json_stream_state_t state;
+
+  /* Open containers, as '{' or '[' */
+  char *stack;
+  size_t depth;
+  size_t stack_size;
+
+  /* Whether the root object's next property is a key */
+  boolean_t is_key;
+
+  /* The string or primitive being read */
+  char *value;
+  size_t value_length;
+  size_t value_size;
+  unsigned int hex_digits;
+
+  /* Validation of the current command */
+  json_validation_error_t err;
+  json_stream_key_t key;
+  boolean_t in_arguments;
+  boolean_t matched_command;
+  boolean_t matched_arguments;
+
+} json_stream_t;
+
+/**
+ * @name json_stream_create:
+ */
+json_stream_t *json_stream_create(const json_stream_handler_t *h);
+
+/**
+ * @name json_stream_destroy:
+ */
+void json_stream_destroy(json_stream_t *j);
+
+/**
+ * @name json_stream_feed:
+ *   Parse the next `length` bytes of input, calling the handler's
+ *   functions as values are completed. Grammar and validation errors
+ *   are reported via the handler's `end` function. Validation errors
+ *   are reported once the offending command is complete; after a
+ *   grammar error, which leaves the input's structure unknown, input
+ *   is discarded up to and including the next newline.
+ */
+void json_stream_feed(json_stream_t *j, const char *p, size_t length);
+
+/**
+ * @name json_stream_finish:
+ *   Signal the end of input. If a command is incomplete, it's
+ *   rejected with `V_ERR_PARSE`.
+ */
+void json_stream_finish(json_stream_t *j);
+
+/** --- **/
+
+#endif /* __JSON_STREAM_H__ */
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
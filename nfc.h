@@ -0,0 +1,1303 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __NFC_H__
+#define __NFC_H__
+
+/** --- **/
+
+/**
+ * @name UNICODE_COMPOSITIONS:
+ *   X-macro listing every primary composite in the Basic Multilingual
+ *   Plane, as `X(first, second, composite, a)`: the canonical pairs
+ *   that Unicode Normalization Form C composes, excluding the
+ *   composition exclusions and the algorithmic Hangul syllables.
+ *   Entries are sorted by `first`, then `second`, so that the table
+ *   can be binary searched. Derived from the Unicode Character
+ *   Database, version 14.0.0.
+ *
+ *   Copyright (c) 1991-2021 Unicode, Inc. All rights reserved.
+ *   Distributed under the Terms of Use in
+ *   https://www.unicode.org/copyright.html.
+ */
+#define UNICODE_COMPOSITIONS(X, a) \
+  X(0x003c, 0x0338, 0x226e, a)  /* NOT LESS-THAN */ \
+  X(0x003d, 0x0338, 0x2260, a)  /* NOT EQUAL TO */ \
+  X(0x003e, 0x0338, 0x226f, a)  /* NOT GREATER-THAN */ \
+  X(0x0041, 0x0300, 0x00c0, a)  /* LATIN CAPITAL LETTER A WITH GRAVE */ \
+  X(0x0041, 0x0301, 0x00c1, a)  /* LATIN CAPITAL LETTER A WITH ACUTE */ \
+  X(0x0041, 0x0302, 0x00c2, a)  /* LATIN CAPITAL LETTER A WITH CIRCUMFLEX */ \
+  X(0x0041, 0x0303, 0x00c3, a)  /* LATIN CAPITAL LETTER A WITH TILDE */ \
+  X(0x0041, 0x0304, 0x0100, a)  /* LATIN CAPITAL LETTER A WITH MACRON */ \
+  X(0x0041, 0x0306, 0x0102, a)  /* LATIN CAPITAL LETTER A WITH BREVE */ \
+  X(0x0041, 0x0307, 0x0226, a)  /* LATIN CAPITAL LETTER A WITH DOT ABOVE */ \
+  X(0x0041, 0x0308, 0x00c4, a)  /* LATIN CAPITAL LETTER A WITH DIAERESIS */ \
+  X(0x0041, 0x0309, 0x1ea2, a)  /* LATIN CAPITAL LETTER A WITH HOOK ABOVE */ \
+  X(0x0041, 0x030a, 0x00c5, a)  /* LATIN CAPITAL LETTER A WITH RING ABOVE */ \
+  X(0x0041, 0x030c, 0x01cd, a)  /* LATIN CAPITAL LETTER A WITH CARON */ \
+  X(0x0041, 0x030f, 0x0200, a)  /* LATIN CAPITAL LETTER A WITH DOUBLE GRAVE */ \
+  X(0x0041, 0x0311, 0x0202, a)  /* LATIN CAPITAL LETTER A WITH INVERTED BREVE */ \
+  X(0x0041, 0x0323, 0x1ea0, a)  /* LATIN CAPITAL LETTER A WITH DOT BELOW */ \
+  X(0x0041, 0x0325, 0x1e00, a)  /* LATIN CAPITAL LETTER A WITH RING BELOW */ \
+  X(0x0041, 0x0328, 0x0104, a)  /* LATIN CAPITAL LETTER A WITH OGONEK */ \
+  X(0x0042, 0x0307, 0x1e02, a)  /* LATIN CAPITAL LETTER B WITH DOT ABOVE */ \
+  X(0x0042, 0x0323, 0x1e04, a)  /* LATIN CAPITAL LETTER B WITH DOT BELOW */ \
+  X(0x0042, 0x0331, 0x1e06, a)  /* LATIN CAPITAL LETTER B WITH LINE BELOW */ \
+  X(0x0043, 0x0301, 0x0106, a)  /* LATIN CAPITAL LETTER C WITH ACUTE */ \
+  X(0x0043, 0x0302, 0x0108, a)  /* LATIN CAPITAL LETTER C WITH CIRCUMFLEX */ \
+  X(0x0043, 0x0307, 0x010a, a)  /* LATIN CAPITAL LETTER C WITH DOT ABOVE */ \
+  X(0x0043, 0x030c, 0x010c, a)  /* LATIN CAPITAL LETTER C WITH CARON */ \
+  X(0x0043, 0x0327, 0x00c7, a)  /* LATIN CAPITAL LETTER C WITH CEDILLA */ \
+  X(0x0044, 0x0307, 0x1e0a, a)  /* LATIN CAPITAL LETTER D WITH DOT ABOVE */ \
+  X(0x0044, 0x030c, 0x010e, a)  /* LATIN CAPITAL LETTER D WITH CARON */ \
+  X(0x0044, 0x0323, 0x1e0c, a)  /* LATIN CAPITAL LETTER D WITH DOT BELOW */ \
+  X(0x0044, 0x0327, 0x1e10, a)  /* LATIN CAPITAL LETTER D WITH CEDILLA */ \
+  X(0x0044, 0x032d, 0x1e12, a)  /* LATIN CAPITAL LETTER D WITH CIRCUMFLEX BELOW */ \
+  X(0x0044, 0x0331, 0x1e0e, a)  /* LATIN CAPITAL LETTER D WITH LINE BELOW */ \
+  X(0x0045, 0x0300, 0x00c8, a)  /* LATIN CAPITAL LETTER E WITH GRAVE */ \
+  X(0x0045, 0x0301, 0x00c9, a)  /* LATIN CAPITAL LETTER E WITH ACUTE */ \
+  X(0x0045, 0x0302, 0x00ca, a)  /* LATIN CAPITAL LETTER E WITH CIRCUMFLEX */ \
+  X(0x0045, 0x0303, 0x1ebc, a)  /* LATIN CAPITAL LETTER E WITH TILDE */ \
+  X(0x0045, 0x0304, 0x0112, a)  /* LATIN CAPITAL LETTER E WITH MACRON */ \
+  X(0x0045, 0x0306, 0x0114, a)  /* LATIN CAPITAL LETTER E WITH BREVE */ \
+  X(0x0045, 0x0307, 0x0116, a)  /* LATIN CAPITAL LETTER E WITH DOT ABOVE */ \
+  X(0x0045, 0x0308, 0x00cb, a)  /* LATIN CAPITAL LETTER E WITH DIAERESIS */ \
+  X(0x0045, 0x0309, 0x1eba, a)  /* LATIN CAPITAL LETTER E WITH HOOK ABOVE */ \
+  X(0x0045, 0x030c, 0x011a, a)  /* LATIN CAPITAL LETTER E WITH CARON */ \
+  X(0x0045, 0x030f, 0x0204, a)  /* LATIN CAPITAL LETTER E WITH DOUBLE GRAVE */ \
+  X(0x0045, 0x0311, 0x0206, a)  /* LATIN CAPITAL LETTER E WITH INVERTED BREVE */ \
+  X(0x0045, 0x0323, 0x1eb8, a)  /* LATIN CAPITAL LETTER E WITH DOT BELOW */ \
+  X(0x0045, 0x0327, 0x0228, a)  /* LATIN CAPITAL LETTER E WITH CEDILLA */ \
+  X(0x0045, 0x0328, 0x0118, a)  /* LATIN CAPITAL LETTER E WITH OGONEK */ \
+  X(0x0045, 0x032d, 0x1e18, a)  /* LATIN CAPITAL LETTER E WITH CIRCUMFLEX BELOW */ \
+  X(0x0045, 0x0330, 0x1e1a, a)  /* LATIN CAPITAL LETTER E WITH TILDE BELOW */ \
+  X(0x0046, 0x0307, 0x1e1e, a)  /* LATIN CAPITAL LETTER F WITH DOT ABOVE */ \
+  X(0x0047, 0x0301, 0x01f4, a)  /* LATIN CAPITAL LETTER G WITH ACUTE */ \
+  X(0x0047, 0x0302, 0x011c, a)  /* LATIN CAPITAL LETTER G WITH CIRCUMFLEX */ \
+  X(0x0047, 0x0304, 0x1e20, a)  /* LATIN CAPITAL LETTER G WITH MACRON */ \
+  X(0x0047, 0x0306, 0x011e, a)  /* LATIN CAPITAL LETTER G WITH BREVE */ \
+  X(0x0047, 0x0307, 0x0120, a)  /* LATIN CAPITAL LETTER G WITH DOT ABOVE */ \
+  X(0x0047, 0x030c, 0x01e6, a)  /* LATIN CAPITAL LETTER G WITH CARON */ \
+  X(0x0047, 0x0327, 0x0122, a)  /* LATIN CAPITAL LETTER G WITH CEDILLA */ \
+  X(0x0048, 0x0302, 0x0124, a)  /* LATIN CAPITAL LETTER H WITH CIRCUMFLEX */ \
+  X(0x0048, 0x0307, 0x1e22, a)  /* LATIN CAPITAL LETTER H WITH DOT ABOVE */ \
+  X(0x0048, 0x0308, 0x1e26, a)  /* LATIN CAPITAL LETTER H WITH DIAERESIS */ \
+  X(0x0048, 0x030c, 0x021e, a)  /* LATIN CAPITAL LETTER H WITH CARON */ \
+  X(0x0048, 0x0323, 0x1e24, a)  /* LATIN CAPITAL LETTER H WITH DOT BELOW */ \
+  X(0x0048, 0x0327, 0x1e28, a)  /* LATIN CAPITAL LETTER H WITH CEDILLA */ \
+  X(0x0048, 0x032e, 0x1e2a, a)  /* LATIN CAPITAL LETTER H WITH BREVE BELOW */ \
+  X(0x0049, 0x0300, 0x00cc, a)  /* LATIN CAPITAL LETTER I WITH GRAVE */ \
+  X(0x0049, 0x0301, 0x00cd, a)  /* LATIN CAPITAL LETTER I WITH ACUTE */ \
+  X(0x0049, 0x0302, 0x00ce, a)  /* LATIN CAPITAL LETTER I WITH CIRCUMFLEX */ \
+  X(0x0049, 0x0303, 0x0128, a)  /* LATIN CAPITAL LETTER I WITH TILDE */ \
+  X(0x0049, 0x0304, 0x012a, a)  /* LATIN CAPITAL LETTER I WITH MACRON */ \
+  X(0x0049, 0x0306, 0x012c, a)  /* LATIN CAPITAL LETTER I WITH BREVE */ \
+  X(0x0049, 0x0307, 0x0130, a)  /* LATIN CAPITAL LETTER I WITH DOT ABOVE */ \
+  X(0x0049, 0x0308, 0x00cf, a)  /* LATIN CAPITAL LETTER I WITH DIAERESIS */ \
+  X(0x0049, 0x0309, 0x1ec8, a)  /* LATIN CAPITAL LETTER I WITH HOOK ABOVE */ \
+  X(0x0049, 0x030c, 0x01cf, a)  /* LATIN CAPITAL LETTER I WITH CARON */ \
+  X(0x0049, 0x030f, 0x0208, a)  /* LATIN CAPITAL LETTER I WITH DOUBLE GRAVE */ \
+  X(0x0049, 0x0311, 0x020a, a)  /* LATIN CAPITAL LETTER I WITH INVERTED BREVE */ \
+  X(0x0049, 0x0323, 0x1eca, a)  /* LATIN CAPITAL LETTER I WITH DOT BELOW */ \
+  X(0x0049, 0x0328, 0x012e, a)  /* LATIN CAPITAL LETTER I WITH OGONEK */ \
+  X(0x0049, 0x0330, 0x1e2c, a)  /* LATIN CAPITAL LETTER I WITH TILDE BELOW */ \
+  X(0x004a, 0x0302, 0x0134, a)  /* LATIN CAPITAL LETTER J WITH CIRCUMFLEX */ \
+  X(0x004b, 0x0301, 0x1e30, a)  /* LATIN CAPITAL LETTER K WITH ACUTE */ \
+  X(0x004b, 0x030c, 0x01e8, a)  /* LATIN CAPITAL LETTER K WITH CARON */ \
+  X(0x004b, 0x0323, 0x1e32, a)  /* LATIN CAPITAL LETTER K WITH DOT BELOW */ \
+  X(0x004b, 0x0327, 0x0136, a)  /* LATIN CAPITAL LETTER K WITH CEDILLA */ \
+  X(0x004b, 0x0331, 0x1e34, a)  /* LATIN CAPITAL LETTER K WITH LINE BELOW */ \
+  X(0x004c, 0x0301, 0x0139, a)  /* LATIN CAPITAL LETTER L WITH ACUTE */ \
+  X(0x004c, 0x030c, 0x013d, a)  /* LATIN CAPITAL LETTER L WITH CARON */ \
+  X(0x004c, 0x0323, 0x1e36, a)  /* LATIN CAPITAL LETTER L WITH DOT BELOW */ \
+  X(0x004c, 0x0327, 0x013b, a)  /* LATIN CAPITAL LETTER L WITH CEDILLA */ \
+  X(0x004c, 0x032d, 0x1e3c, a)  /* LATIN CAPITAL LETTER L WITH CIRCUMFLEX BELOW */ \
+  X(0x004c, 0x0331, 0x1e3a, a)  /* LATIN CAPITAL LETTER L WITH LINE BELOW */ \
+  X(0x004d, 0x0301, 0x1e3e, a)  /* LATIN CAPITAL LETTER M WITH ACUTE */ \
+  X(0x004d, 0x0307, 0x1e40, a)  /* LATIN CAPITAL LETTER M WITH DOT ABOVE */ \
+  X(0x004d, 0x0323, 0x1e42, a)  /* LATIN CAPITAL LETTER M WITH DOT BELOW */ \
+  X(0x004e, 0x0300, 0x01f8, a)  /* LATIN CAPITAL LETTER N WITH GRAVE */ \
+  X(0x004e, 0x0301, 0x0143, a)  /* LATIN CAPITAL LETTER N WITH ACUTE */ \
+  X(0x004e, 0x0303, 0x00d1, a)  /* LATIN CAPITAL LETTER N WITH TILDE */ \
+  X(0x004e, 0x0307, 0x1e44, a)  /* LATIN CAPITAL LETTER N WITH DOT ABOVE */ \
+  X(0x004e, 0x030c, 0x0147, a)  /* LATIN CAPITAL LETTER N WITH CARON */ \
+  X(0x004e, 0x0323, 0x1e46, a)  /* LATIN CAPITAL LETTER N WITH DOT BELOW */ \
+  X(0x004e, 0x0327, 0x0145, a)  /* LATIN CAPITAL LETTER N WITH CEDILLA */ \
+  X(0x004e, 0x032d, 0x1e4a, a)  /* LATIN CAPITAL LETTER N WITH CIRCUMFLEX BELOW */ \
+  X(0x004e, 0x0331, 0x1e48, a)  /* LATIN CAPITAL LETTER N WITH LINE BELOW */ \
+  X(0x004f, 0x0300, 0x00d2, a)  /* LATIN CAPITAL LETTER O WITH GRAVE */ \
+  X(0x004f, 0x0301, 0x00d3, a)  /* LATIN CAPITAL LETTER O WITH ACUTE */ \
+  X(0x004f, 0x0302, 0x00d4, a)  /* LATIN CAPITAL LETTER O WITH CIRCUMFLEX */ \
+  X(0x004f, 0x0303, 0x00d5, a)  /* LATIN CAPITAL LETTER O WITH TILDE */ \
+  X(0x004f, 0x0304, 0x014c, a)  /* LATIN CAPITAL LETTER O WITH MACRON */ \
+  X(0x004f, 0x0306, 0x014e, a)  /* LATIN CAPITAL LETTER O WITH BREVE */ \
+  X(0x004f, 0x0307, 0x022e, a)  /* LATIN CAPITAL LETTER O WITH DOT ABOVE */ \
+  X(0x004f, 0x0308, 0x00d6, a)  /* LATIN CAPITAL LETTER O WITH DIAERESIS */ \
+  X(0x004f, 0x0309, 0x1ece, a)  /* LATIN CAPITAL LETTER O WITH HOOK ABOVE */ \
+  X(0x004f, 0x030b, 0x0150, a)  /* LATIN CAPITAL LETTER O WITH DOUBLE ACUTE */ \
+  X(0x004f, 0x030c, 0x01d1, a)  /* LATIN CAPITAL LETTER O WITH CARON */ \
+  X(0x004f, 0x030f, 0x020c, a)  /* LATIN CAPITAL LETTER O WITH DOUBLE GRAVE */ \
+  X(0x004f, 0x0311, 0x020e, a)  /* LATIN CAPITAL LETTER O WITH INVERTED BREVE */ \
+  X(0x004f, 0x031b, 0x01a0, a)  /* LATIN CAPITAL LETTER O WITH HORN */ \
+  X(0x004f, 0x0323, 0x1ecc, a)  /* LATIN CAPITAL LETTER O WITH DOT BELOW */ \
+  X(0x004f, 0x0328, 0x01ea, a)  /* LATIN CAPITAL LETTER O WITH OGONEK */ \
+  X(0x0050, 0x0301, 0x1e54, a)  /* LATIN CAPITAL LETTER P WITH ACUTE */ \
+  X(0x0050, 0x0307, 0x1e56, a)  /* LATIN CAPITAL LETTER P WITH DOT ABOVE */ \
+  X(0x0052, 0x0301, 0x0154, a)  /* LATIN CAPITAL LETTER R WITH ACUTE */ \
+  X(0x0052, 0x0307, 0x1e58, a)  /* LATIN CAPITAL LETTER R WITH DOT ABOVE */ \
+  X(0x0052, 0x030c, 0x0158, a)  /* LATIN CAPITAL LETTER R WITH CARON */ \
+  X(0x0052, 0x030f, 0x0210, a)  /* LATIN CAPITAL LETTER R WITH DOUBLE GRAVE */ \
+  X(0x0052, 0x0311, 0x0212, a)  /* LATIN CAPITAL LETTER R WITH INVERTED BREVE */ \
+  X(0x0052, 0x0323, 0x1e5a, a)  /* LATIN CAPITAL LETTER R WITH DOT BELOW */ \
+  X(0x0052, 0x0327, 0x0156, a)  /* LATIN CAPITAL LETTER R WITH CEDILLA */ \
+  X(0x0052, 0x0331, 0x1e5e, a)  /* LATIN CAPITAL LETTER R WITH LINE BELOW */ \
+  X(0x0053, 0x0301, 0x015a, a)  /* LATIN CAPITAL LETTER S WITH ACUTE */ \
+  X(0x0053, 0x0302, 0x015c, a)  /* LATIN CAPITAL LETTER S WITH CIRCUMFLEX */ \
+  X(0x0053, 0x0307, 0x1e60, a)  /* LATIN CAPITAL LETTER S WITH DOT ABOVE */ \
+  X(0x0053, 0x030c, 0x0160, a)  /* LATIN CAPITAL LETTER S WITH CARON */ \
+  X(0x0053, 0x0323, 0x1e62, a)  /* LATIN CAPITAL LETTER S WITH DOT BELOW */ \
+  X(0x0053, 0x0326, 0x0218, a)  /* LATIN CAPITAL LETTER S WITH COMMA BELOW */ \
+  X(0x0053, 0x0327, 0x015e, a)  /* LATIN CAPITAL LETTER S WITH CEDILLA */ \
+  X(0x0054, 0x0307, 0x1e6a, a)  /* LATIN CAPITAL LETTER T WITH DOT ABOVE */ \
+  X(0x0054, 0x030c, 0x0164, a)  /* LATIN CAPITAL LETTER T WITH CARON */ \
+  X(0x0054, 0x0323, 0x1e6c, a)  /* LATIN CAPITAL LETTER T WITH DOT BELOW */ \
+  X(0x0054, 0x0326, 0x021a, a)  /* LATIN CAPITAL LETTER T WITH COMMA BELOW */ \
+  X(0x0054, 0x0327, 0x0162, a)  /* LATIN CAPITAL LETTER T WITH CEDILLA */ \
+  X(0x0054, 0x032d, 0x1e70, a)  /* LATIN CAPITAL LETTER T WITH CIRCUMFLEX BELOW */ \
+  X(0x0054, 0x0331, 0x1e6e, a)  /* LATIN CAPITAL LETTER T WITH LINE BELOW */ \
+  X(0x0055, 0x0300, 0x00d9, a)  /* LATIN CAPITAL LETTER U WITH GRAVE */ \
+  X(0x0055, 0x0301, 0x00da, a)  /* LATIN CAPITAL LETTER U WITH ACUTE */ \
+  X(0x0055, 0x0302, 0x00db, a)  /* LATIN CAPITAL LETTER U WITH CIRCUMFLEX */ \
+  X(0x0055, 0x0303, 0x0168, a)  /* LATIN CAPITAL LETTER U WITH TILDE */ \
+  X(0x0055, 0x0304, 0x016a, a)  /* LATIN CAPITAL LETTER U WITH MACRON */ \
+  X(0x0055, 0x0306, 0x016c, a)  /* LATIN CAPITAL LETTER U WITH BREVE */ \
+  X(0x0055, 0x0308, 0x00dc, a)  /* LATIN CAPITAL LETTER U WITH DIAERESIS */ \
+  X(0x0055, 0x0309, 0x1ee6, a)  /* LATIN CAPITAL LETTER U WITH HOOK ABOVE */ \
+  X(0x0055, 0x030a, 0x016e, a)  /* LATIN CAPITAL LETTER U WITH RING ABOVE */ \
+  X(0x0055, 0x030b, 0x0170, a)  /* LATIN CAPITAL LETTER U WITH DOUBLE ACUTE */ \
+  X(0x0055, 0x030c, 0x01d3, a)  /* LATIN CAPITAL LETTER U WITH CARON */ \
+  X(0x0055, 0x030f, 0x0214, a)  /* LATIN CAPITAL LETTER U WITH DOUBLE GRAVE */ \
+  X(0x0055, 0x0311, 0x0216, a)  /* LATIN CAPITAL LETTER U WITH INVERTED BREVE */ \
+  X(0x0055, 0x031b, 0x01af, a)  /* LATIN CAPITAL LETTER U WITH HORN */ \
+  X(0x0055, 0x0323, 0x1ee4, a)  /* LATIN CAPITAL LETTER U WITH DOT BELOW */ \
+  X(0x0055, 0x0324, 0x1e72, a)  /* LATIN CAPITAL LETTER U WITH DIAERESIS BELOW */ \
+  X(0x0055, 0x0328, 0x0172, a)  /* LATIN CAPITAL LETTER U WITH OGONEK */ \
+  X(0x0055, 0x032d, 0x1e76, a)  /* LATIN CAPITAL LETTER U WITH CIRCUMFLEX BELOW */ \
+  X(0x0055, 0x0330, 0x1e74, a)  /* LATIN CAPITAL LETTER U WITH TILDE BELOW */ \
+  X(0x0056, 0x0303, 0x1e7c, a)  /* LATIN CAPITAL LETTER V WITH TILDE */ \
+  X(0x0056, 0x0323, 0x1e7e, a)  /* LATIN CAPITAL LETTER V WITH DOT BELOW */ \
+  X(0x0057, 0x0300, 0x1e80, a)  /* LATIN CAPITAL LETTER W WITH GRAVE */ \
+  X(0x0057, 0x0301, 0x1e82, a)  /* LATIN CAPITAL LETTER W WITH ACUTE */ \
+  X(0x0057, 0x0302, 0x0174, a)  /* LATIN CAPITAL LETTER W WITH CIRCUMFLEX */ \
+  X(0x0057, 0x0307, 0x1e86, a)  /* LATIN CAPITAL LETTER W WITH DOT ABOVE */ \
+  X(0x0057, 0x0308, 0x1e84, a)  /* LATIN CAPITAL LETTER W WITH DIAERESIS */ \
+  X(0x0057, 0x0323, 0x1e88, a)  /* LATIN CAPITAL LETTER W WITH DOT BELOW */ \
+  X(0x0058, 0x0307, 0x1e8a, a)  /* LATIN CAPITAL LETTER X WITH DOT ABOVE */ \
+  X(0x0058, 0x0308, 0x1e8c, a)  /* LATIN CAPITAL LETTER X WITH DIAERESIS */ \
+  X(0x0059, 0x0300, 0x1ef2, a)  /* LATIN CAPITAL LETTER Y WITH GRAVE */ \
+  X(0x0059, 0x0301, 0x00dd, a)  /* LATIN CAPITAL LETTER Y WITH ACUTE */ \
+  X(0x0059, 0x0302, 0x0176, a)  /* LATIN CAPITAL LETTER Y WITH CIRCUMFLEX */ \
+  X(0x0059, 0x0303, 0x1ef8, a)  /* LATIN CAPITAL LETTER Y WITH TILDE */ \
+  X(0x0059, 0x0304, 0x0232, a)  /* LATIN CAPITAL LETTER Y WITH MACRON */ \
+  X(0x0059, 0x0307, 0x1e8e, a)  /* LATIN CAPITAL LETTER Y WITH DOT ABOVE */ \
+  X(0x0059, 0x0308, 0x0178, a)  /* LATIN CAPITAL LETTER Y WITH DIAERESIS */ \
+  X(0x0059, 0x0309, 0x1ef6, a)  /* LATIN CAPITAL LETTER Y WITH HOOK ABOVE */ \
+  X(0x0059, 0x0323, 0x1ef4, a)  /* LATIN CAPITAL LETTER Y WITH DOT BELOW */ \
+  X(0x005a, 0x0301, 0x0179, a)  /* LATIN CAPITAL LETTER Z WITH ACUTE */ \
+  X(0x005a, 0x0302, 0x1e90, a)  /* LATIN CAPITAL LETTER Z WITH CIRCUMFLEX */ \
+  X(0x005a, 0x0307, 0x017b, a)  /* LATIN CAPITAL LETTER Z WITH DOT ABOVE */ \
+  X(0x005a, 0x030c, 0x017d, a)  /* LATIN CAPITAL LETTER Z WITH CARON */ \
+  X(0x005a, 0x0323, 0x1e92, a)  /* LATIN CAPITAL LETTER Z WITH DOT BELOW */ \
+  X(0x005a, 0x0331, 0x1e94, a)  /* LATIN CAPITAL LETTER Z WITH LINE BELOW */ \
+  X(0x0061, 0x0300, 0x00e0, a)  /* LATIN SMALL LETTER A WITH GRAVE */ \
+  X(0x0061, 0x0301, 0x00e1, a)  /* LATIN SMALL LETTER A WITH ACUTE */ \
+  X(0x0061, 0x0302, 0x00e2, a)  /* LATIN SMALL LETTER A WITH CIRCUMFLEX */ \
+  X(0x0061, 0x0303, 0x00e3, a)  /* LATIN SMALL LETTER A WITH TILDE */ \
+  X(0x0061, 0x0304, 0x0101, a)  /* LATIN SMALL LETTER A WITH MACRON */ \
+  X(0x0061, 0x0306, 0x0103, a)  /* LATIN SMALL LETTER A WITH BREVE */ \
+  X(0x0061, 0x0307, 0x0227, a)  /* LATIN SMALL LETTER A WITH DOT ABOVE */ \
+  X(0x0061, 0x0308, 0x00e4, a)  /* LATIN SMALL LETTER A WITH DIAERESIS */ \
+  X(0x0061, 0x0309, 0x1ea3, a)  /* LATIN SMALL LETTER A WITH HOOK ABOVE */ \
+  X(0x0061, 0x030a, 0x00e5, a)  /* LATIN SMALL LETTER A WITH RING ABOVE */ \
+  X(0x0061, 0x030c, 0x01ce, a)  /* LATIN SMALL LETTER A WITH CARON */ \
+  X(0x0061, 0x030f, 0x0201, a)  /* LATIN SMALL LETTER A WITH DOUBLE GRAVE */ \
+  X(0x0061, 0x0311, 0x0203, a)  /* LATIN SMALL LETTER A WITH INVERTED BREVE */ \
+  X(0x0061, 0x0323, 0x1ea1, a)  /* LATIN SMALL LETTER A WITH DOT BELOW */ \
+  X(0x0061, 0x0325, 0x1e01, a)  /* LATIN SMALL LETTER A WITH RING BELOW */ \
+  X(0x0061, 0x0328, 0x0105, a)  /* LATIN SMALL LETTER A WITH OGONEK */ \
+  X(0x0062, 0x0307, 0x1e03, a)  /* LATIN SMALL LETTER B WITH DOT ABOVE */ \
+  X(0x0062, 0x0323, 0x1e05, a)  /* LATIN SMALL LETTER B WITH DOT BELOW */ \
+  X(0x0062, 0x0331, 0x1e07, a)  /* LATIN SMALL LETTER B WITH LINE BELOW */ \
+  X(0x0063, 0x0301, 0x0107, a)  /* LATIN SMALL LETTER C WITH ACUTE */ \
+  X(0x0063, 0x0302, 0x0109, a)  /* LATIN SMALL LETTER C WITH CIRCUMFLEX */ \
+  X(0x0063, 0x0307, 0x010b, a)  /* LATIN SMALL LETTER C WITH DOT ABOVE */ \
+  X(0x0063, 0x030c, 0x010d, a)  /* LATIN SMALL LETTER C WITH CARON */ \
+  X(0x0063, 0x0327, 0x00e7, a)  /* LATIN SMALL LETTER C WITH CEDILLA */ \
+  X(0x0064, 0x0307, 0x1e0b, a)  /* LATIN SMALL LETTER D WITH DOT ABOVE */ \
+  X(0x0064, 0x030c, 0x010f, a)  /* LATIN SMALL LETTER D WITH CARON */ \
+  X(0x0064, 0x0323, 0x1e0d, a)  /* LATIN SMALL LETTER D WITH DOT BELOW */ \
+  X(0x0064, 0x0327, 0x1e11, a)  /* LATIN SMALL LETTER D WITH CEDILLA */ \
+  X(0x0064, 0x032d, 0x1e13, a)  /* LATIN SMALL LETTER D WITH CIRCUMFLEX BELOW */ \
+  X(0x0064, 0x0331, 0x1e0f, a)  /* LATIN SMALL LETTER D WITH LINE BELOW */ \
+  X(0x0065, 0x0300, 0x00e8, a)  /* LATIN SMALL LETTER E WITH GRAVE */ \
+  X(0x0065, 0x0301, 0x00e9, a)  /* LATIN SMALL LETTER E WITH ACUTE */ \
+  X(0x0065, 0x0302, 0x00ea, a)  /* LATIN SMALL LETTER E WITH CIRCUMFLEX */ \
+  X(0x0065, 0x0303, 0x1ebd, a)  /* LATIN SMALL LETTER E WITH TILDE */ \
+  X(0x0065, 0x0304, 0x0113, a)  /* LATIN SMALL LETTER E WITH MACRON */ \
+  X(0x0065, 0x0306, 0x0115, a)  /* LATIN SMALL LETTER E WITH BREVE */ \
+  X(0x0065, 0x0307, 0x0117, a)  /* LATIN SMALL LETTER E WITH DOT ABOVE */ \
+  X(0x0065, 0x0308, 0x00eb, a)  /* LATIN SMALL LETTER E WITH DIAERESIS */ \
+  X(0x0065, 0x0309, 0x1ebb, a)  /* LATIN SMALL LETTER E WITH HOOK ABOVE */ \
+  X(0x0065, 0x030c, 0x011b, a)  /* LATIN SMALL LETTER E WITH CARON */ \
+  X(0x0065, 0x030f, 0x0205, a)  /* LATIN SMALL LETTER E WITH DOUBLE GRAVE */ \
+  X(0x0065, 0x0311, 0x0207, a)  /* LATIN SMALL LETTER E WITH INVERTED BREVE */ \
+  X(0x0065, 0x0323, 0x1eb9, a)  /* LATIN SMALL LETTER E WITH DOT BELOW */ \
+  X(0x0065, 0x0327, 0x0229, a)  /* LATIN SMALL LETTER E WITH CEDILLA */ \
+  X(0x0065, 0x0328, 0x0119, a)  /* LATIN SMALL LETTER E WITH OGONEK */ \
+  X(0x0065, 0x032d, 0x1e19, a)  /* LATIN SMALL LETTER E WITH CIRCUMFLEX BELOW */ \
+  X(0x0065, 0x0330, 0x1e1b, a)  /* LATIN SMALL LETTER E WITH TILDE BELOW */ \
+  X(0x0066, 0x0307, 0x1e1f, a)  /* LATIN SMALL LETTER F WITH DOT ABOVE */ \
+  X(0x0067, 0x0301, 0x01f5, a)  /* LATIN SMALL LETTER G WITH ACUTE */ \
+  X(0x0067, 0x0302, 0x011d, a)  /* LATIN SMALL LETTER G WITH CIRCUMFLEX */ \
+  X(0x0067, 0x0304, 0x1e21, a)  /* LATIN SMALL LETTER G WITH MACRON */ \
+  X(0x0067, 0x0306, 0x011f, a)  /* LATIN SMALL LETTER G WITH BREVE */ \
+  X(0x0067, 0x0307, 0x0121, a)  /* LATIN SMALL LETTER G WITH DOT ABOVE */ \
+  X(0x0067, 0x030c, 0x01e7, a)  /* LATIN SMALL LETTER G WITH CARON */ \
+  X(0x0067, 0x0327, 0x0123, a)  /* LATIN SMALL LETTER G WITH CEDILLA */ \
+  X(0x0068, 0x0302, 0x0125, a)  /* LATIN SMALL LETTER H WITH CIRCUMFLEX */ \
+  X(0x0068, 0x0307, 0x1e23, a)  /* LATIN SMALL LETTER H WITH DOT ABOVE */ \
+  X(0x0068, 0x0308, 0x1e27, a)  /* LATIN SMALL LETTER H WITH DIAERESIS */ \
+  X(0x0068, 0x030c, 0x021f, a)  /* LATIN SMALL LETTER H WITH CARON */ \
+  X(0x0068, 0x0323, 0x1e25, a)  /* LATIN SMALL LETTER H WITH DOT BELOW */ \
+  X(0x0068, 0x0327, 0x1e29, a)  /* LATIN SMALL LETTER H WITH CEDILLA */ \
+  X(0x0068, 0x032e, 0x1e2b, a)  /* LATIN SMALL LETTER H WITH BREVE BELOW */ \
+  X(0x0068, 0x0331, 0x1e96, a)  /* LATIN SMALL LETTER H WITH LINE BELOW */ \
+  X(0x0069, 0x0300, 0x00ec, a)  /* LATIN SMALL LETTER I WITH GRAVE */ \
+  X(0x0069, 0x0301, 0x00ed, a)  /* LATIN SMALL LETTER I WITH ACUTE */ \
+  X(0x0069, 0x0302, 0x00ee, a)  /* LATIN SMALL LETTER I WITH CIRCUMFLEX */ \
+  X(0x0069, 0x0303, 0x0129, a)  /* LATIN SMALL LETTER I WITH TILDE */ \
+  X(0x0069, 0x0304, 0x012b, a)  /* LATIN SMALL LETTER I WITH MACRON */ \
+  X(0x0069, 0x0306, 0x012d, a)  /* LATIN SMALL LETTER I WITH BREVE */ \
+  X(0x0069, 0x0308, 0x00ef, a)  /* LATIN SMALL LETTER I WITH DIAERESIS */ \
+  X(0x0069, 0x0309, 0x1ec9, a)  /* LATIN SMALL LETTER I WITH HOOK ABOVE */ \
+  X(0x0069, 0x030c, 0x01d0, a)  /* LATIN SMALL LETTER I WITH CARON */ \
+  X(0x0069, 0x030f, 0x0209, a)  /* LATIN SMALL LETTER I WITH DOUBLE GRAVE */ \
+  X(0x0069, 0x0311, 0x020b, a)  /* LATIN SMALL LETTER I WITH INVERTED BREVE */ \
+  X(0x0069, 0x0323, 0x1ecb, a)  /* LATIN SMALL LETTER I WITH DOT BELOW */ \
+  X(0x0069, 0x0328, 0x012f, a)  /* LATIN SMALL LETTER I WITH OGONEK */ \
+  X(0x0069, 0x0330, 0x1e2d, a)  /* LATIN SMALL LETTER I WITH TILDE BELOW */ \
+  X(0x006a, 0x0302, 0x0135, a)  /* LATIN SMALL LETTER J WITH CIRCUMFLEX */ \
+  X(0x006a, 0x030c, 0x01f0, a)  /* LATIN SMALL LETTER J WITH CARON */ \
+  X(0x006b, 0x0301, 0x1e31, a)  /* LATIN SMALL LETTER K WITH ACUTE */ \
+  X(0x006b, 0x030c, 0x01e9, a)  /* LATIN SMALL LETTER K WITH CARON */ \
+  X(0x006b, 0x0323, 0x1e33, a)  /* LATIN SMALL LETTER K WITH DOT BELOW */ \
+  X(0x006b, 0x0327, 0x0137, a)  /* LATIN SMALL LETTER K WITH CEDILLA */ \
+  X(0x006b, 0x0331, 0x1e35, a)  /* LATIN SMALL LETTER K WITH LINE BELOW */ \
+  X(0x006c, 0x0301, 0x013a, a)  /* LATIN SMALL LETTER L WITH ACUTE */ \
+  X(0x006c, 0x030c, 0x013e, a)  /* LATIN SMALL LETTER L WITH CARON */ \
+  X(0x006c, 0x0323, 0x1e37, a)  /* LATIN SMALL LETTER L WITH DOT BELOW */ \
+  X(0x006c, 0x0327, 0x013c, a)  /* LATIN SMALL LETTER L WITH CEDILLA */ \
+  X(0x006c, 0x032d, 0x1e3d, a)  /* LATIN SMALL LETTER L WITH CIRCUMFLEX BELOW */ \
+  X(0x006c, 0x0331, 0x1e3b, a)  /* LATIN SMALL LETTER L WITH LINE BELOW */ \
+  X(0x006d, 0x0301, 0x1e3f, a)  /* LATIN SMALL LETTER M WITH ACUTE */ \
+  X(0x006d, 0x0307, 0x1e41, a)  /* LATIN SMALL LETTER M WITH DOT ABOVE */ \
+  X(0x006d, 0x0323, 0x1e43, a)  /* LATIN SMALL LETTER M WITH DOT BELOW */ \
+  X(0x006e, 0x0300, 0x01f9, a)  /* LATIN SMALL LETTER N WITH GRAVE */ \
+  X(0x006e, 0x0301, 0x0144, a)  /* LATIN SMALL LETTER N WITH ACUTE */ \
+  X(0x006e, 0x0303, 0x00f1, a)  /* LATIN SMALL LETTER N WITH TILDE */ \
+  X(0x006e, 0x0307, 0x1e45, a)  /* LATIN SMALL LETTER N WITH DOT ABOVE */ \
+  X(0x006e, 0x030c, 0x0148, a)  /* LATIN SMALL LETTER N WITH CARON */ \
+  X(0x006e, 0x0323, 0x1e47, a)  /* LATIN SMALL LETTER N WITH DOT BELOW */ \
+  X(0x006e, 0x0327, 0x0146, a)  /* LATIN SMALL LETTER N WITH CEDILLA */ \
+  X(0x006e, 0x032d, 0x1e4b, a)  /* LATIN SMALL LETTER N WITH CIRCUMFLEX BELOW */ \
+  X(0x006e, 0x0331, 0x1e49, a)  /* LATIN SMALL LETTER N WITH LINE BELOW */ \
+  X(0x006f, 0x0300, 0x00f2, a)  /* LATIN SMALL LETTER O WITH GRAVE */ \
+  X(0x006f, 0x0301, 0x00f3, a)  /* LATIN SMALL LETTER O WITH ACUTE */ \
+  X(0x006f, 0x0302, 0x00f4, a)  /* LATIN SMALL LETTER O WITH CIRCUMFLEX */ \
+  X(0x006f, 0x0303, 0x00f5, a)  /* LATIN SMALL LETTER O WITH TILDE */ \
+  X(0x006f, 0x0304, 0x014d, a)  /* LATIN SMALL LETTER O WITH MACRON */ \
+  X(0x006f, 0x0306, 0x014f, a)  /* LATIN SMALL LETTER O WITH BREVE */ \
+  X(0x006f, 0x0307, 0x022f, a)  /* LATIN SMALL LETTER O WITH DOT ABOVE */ \
+  X(0x006f, 0x0308, 0x00f6, a)  /* LATIN SMALL LETTER O WITH DIAERESIS */ \
+  X(0x006f, 0x0309, 0x1ecf, a)  /* LATIN SMALL LETTER O WITH HOOK ABOVE */ \
+  X(0x006f, 0x030b, 0x0151, a)  /* LATIN SMALL LETTER O WITH DOUBLE ACUTE */ \
+  X(0x006f, 0x030c, 0x01d2, a)  /* LATIN SMALL LETTER O WITH CARON */ \
+  X(0x006f, 0x030f, 0x020d, a)  /* LATIN SMALL LETTER O WITH DOUBLE GRAVE */ \
+  X(0x006f, 0x0311, 0x020f, a)  /* LATIN SMALL LETTER O WITH INVERTED BREVE */ \
+  X(0x006f, 0x031b, 0x01a1, a)  /* LATIN SMALL LETTER O WITH HORN */ \
+  X(0x006f, 0x0323, 0x1ecd, a)  /* LATIN SMALL LETTER O WITH DOT BELOW */ \
+  X(0x006f, 0x0328, 0x01eb, a)  /* LATIN SMALL LETTER O WITH OGONEK */ \
+  X(0x0070, 0x0301, 0x1e55, a)  /* LATIN SMALL LETTER P WITH ACUTE */ \
+  X(0x0070, 0x0307, 0x1e57, a)  /* LATIN SMALL LETTER P WITH DOT ABOVE */ \
+  X(0x0072, 0x0301, 0x0155, a)  /* LATIN SMALL LETTER R WITH ACUTE */ \
+  X(0x0072, 0x0307, 0x1e59, a)  /* LATIN SMALL LETTER R WITH DOT ABOVE */ \
+  X(0x0072, 0x030c, 0x0159, a)  /* LATIN SMALL LETTER R WITH CARON */ \
+  X(0x0072, 0x030f, 0x0211, a)  /* LATIN SMALL LETTER R WITH DOUBLE GRAVE */ \
+  X(0x0072, 0x0311, 0x0213, a)  /* LATIN SMALL LETTER R WITH INVERTED BREVE */ \
+  X(0x0072, 0x0323, 0x1e5b, a)  /* LATIN SMALL LETTER R WITH DOT BELOW */ \
+  X(0x0072, 0x0327, 0x0157, a)  /* LATIN SMALL LETTER R WITH CEDILLA */ \
+  X(0x0072, 0x0331, 0x1e5f, a)  /* LATIN SMALL LETTER R WITH LINE BELOW */ \
+  X(0x0073, 0x0301, 0x015b, a)  /* LATIN SMALL LETTER S WITH ACUTE */ \
+  X(0x0073, 0x0302, 0x015d, a)  /* LATIN SMALL LETTER S WITH CIRCUMFLEX */ \
+  X(0x0073, 0x0307, 0x1e61, a)  /* LATIN SMALL LETTER S WITH DOT ABOVE */ \
+  X(0x0073, 0x030c, 0x0161, a)  /* LATIN SMALL LETTER S WITH CARON */ \
+  X(0x0073, 0x0323, 0x1e63, a)  /* LATIN SMALL LETTER S WITH DOT BELOW */ \
+  X(0x0073, 0x0326, 0x0219, a)  /* LATIN SMALL LETTER S WITH COMMA BELOW */ \
+  X(0x0073, 0x0327, 0x015f, a)  /* LATIN SMALL LETTER S WITH CEDILLA */ \
+  X(0x0074, 0x0307, 0x1e6b, a)  /* LATIN SMALL LETTER T WITH DOT ABOVE */ \
+  X(0x0074, 0x0308, 0x1e97, a)  /* LATIN SMALL LETTER T WITH DIAERESIS */ \
+  X(0x0074, 0x030c, 0x0165, a)  /* LATIN SMALL LETTER T WITH CARON */ \
+  X(0x0074, 0x0323, 0x1e6d, a)  /* LATIN SMALL LETTER T WITH DOT BELOW */ \
+  X(0x0074, 0x0326, 0x021b, a)  /* LATIN SMALL LETTER T WITH COMMA BELOW */ \
+  X(0x0074, 0x0327, 0x0163, a)  /* LATIN SMALL LETTER T WITH CEDILLA */ \
+  X(0x0074, 0x032d, 0x1e71, a)  /* LATIN SMALL LETTER T WITH CIRCUMFLEX BELOW */ \
+  X(0x0074, 0x0331, 0x1e6f, a)  /* LATIN SMALL LETTER T WITH LINE BELOW */ \
+  X(0x0075, 0x0300, 0x00f9, a)  /* LATIN SMALL LETTER U WITH GRAVE */ \
+  X(0x0075, 0x0301, 0x00fa, a)  /* LATIN SMALL LETTER U WITH ACUTE */ \
+  X(0x0075, 0x0302, 0x00fb, a)  /* LATIN SMALL LETTER U WITH CIRCUMFLEX */ \
+  X(0x0075, 0x0303, 0x0169, a)  /* LATIN SMALL LETTER U WITH TILDE */ \
+  X(0x0075, 0x0304, 0x016b, a)  /* LATIN SMALL LETTER U WITH MACRON */ \
+  X(0x0075, 0x0306, 0x016d, a)  /* LATIN SMALL LETTER U WITH BREVE */ \
+  X(0x0075, 0x0308, 0x00fc, a)  /* LATIN SMALL LETTER U WITH DIAERESIS */ \
+  X(0x0075, 0x0309, 0x1ee7, a)  /* LATIN SMALL LETTER U WITH HOOK ABOVE */ \
+  X(0x0075, 0x030a, 0x016f, a)  /* LATIN SMALL LETTER U WITH RING ABOVE */ \
+  X(0x0075, 0x030b, 0x0171, a)  /* LATIN SMALL LETTER U WITH DOUBLE ACUTE */ \
+  X(0x0075, 0x030c, 0x01d4, a)  /* LATIN SMALL LETTER U WITH CARON */ \
+  X(0x0075, 0x030f, 0x0215, a)  /* LATIN SMALL LETTER U WITH DOUBLE GRAVE */ \
+  X(0x0075, 0x0311, 0x0217, a)  /* LATIN SMALL LETTER U WITH INVERTED BREVE */ \
+  X(0x0075, 0x031b, 0x01b0, a)  /* LATIN SMALL LETTER U WITH HORN */ \
+  X(0x0075, 0x0323, 0x1ee5, a)  /* LATIN SMALL LETTER U WITH DOT BELOW */ \
+  X(0x0075, 0x0324, 0x1e73, a)  /* LATIN SMALL LETTER U WITH DIAERESIS BELOW */ \
+  X(0x0075, 0x0328, 0x0173, a)  /* LATIN SMALL LETTER U WITH OGONEK */ \
+  X(0x0075, 0x032d, 0x1e77, a)  /* LATIN SMALL LETTER U WITH CIRCUMFLEX BELOW */ \
+  X(0x0075, 0x0330, 0x1e75, a)  /* LATIN SMALL LETTER U WITH TILDE BELOW */ \
+  X(0x0076, 0x0303, 0x1e7d, a)  /* LATIN SMALL LETTER V WITH TILDE */ \
+  X(0x0076, 0x0323, 0x1e7f, a)  /* LATIN SMALL LETTER V WITH DOT BELOW */ \
+  X(0x0077, 0x0300, 0x1e81, a)  /* LATIN SMALL LETTER W WITH GRAVE */ \
+  X(0x0077, 0x0301, 0x1e83, a)  /* LATIN SMALL LETTER W WITH ACUTE */ \
+  X(0x0077, 0x0302, 0x0175, a)  /* LATIN SMALL LETTER W WITH CIRCUMFLEX */ \
+  X(0x0077, 0x0307, 0x1e87, a)  /* LATIN SMALL LETTER W WITH DOT ABOVE */ \
+  X(0x0077, 0x0308, 0x1e85, a)  /* LATIN SMALL LETTER W WITH DIAERESIS */ \
+  X(0x0077, 0x030a, 0x1e98, a)  /* LATIN SMALL LETTER W WITH RING ABOVE */ \
+  X(0x0077, 0x0323, 0x1e89, a)  /* LATIN SMALL LETTER W WITH DOT BELOW */ \
+  X(0x0078, 0x0307, 0x1e8b, a)  /* LATIN SMALL LETTER X WITH DOT ABOVE */ \
+  X(0x0078, 0x0308, 0x1e8d, a)  /* LATIN SMALL LETTER X WITH DIAERESIS */ \
+  X(0x0079, 0x0300, 0x1ef3, a)  /* LATIN SMALL LETTER Y WITH GRAVE */ \
+  X(0x0079, 0x0301, 0x00fd, a)  /* LATIN SMALL LETTER Y WITH ACUTE */ \
+  X(0x0079, 0x0302, 0x0177, a)  /* LATIN SMALL LETTER Y WITH CIRCUMFLEX */ \
+  X(0x0079, 0x0303, 0x1ef9, a)  /* LATIN SMALL LETTER Y WITH TILDE */ \
+  X(0x0079, 0x0304, 0x0233, a)  /* LATIN SMALL LETTER Y WITH MACRON */ \
+  X(0x0079, 0x0307, 0x1e8f, a)  /* LATIN SMALL LETTER Y WITH DOT ABOVE */ \
+  X(0x0079, 0x0308, 0x00ff, a)  /* LATIN SMALL LETTER Y WITH DIAERESIS */ \
+  X(0x0079, 0x0309, 0x1ef7, a)  /* LATIN SMALL LETTER Y WITH HOOK ABOVE */ \
+  X(0x0079, 0x030a, 0x1e99, a)  /* LATIN SMALL LETTER Y WITH RING ABOVE */ \
+  X(0x0079, 0x0323, 0x1ef5, a)  /* LATIN SMALL LETTER Y WITH DOT BELOW */ \
+  X(0x007a, 0x0301, 0x017a, a)  /* LATIN SMALL LETTER Z WITH ACUTE */ \
+  X(0x007a, 0x0302, 0x1e91, a)  /* LATIN SMALL LETTER Z WITH CIRCUMFLEX */ \
+  X(0x007a, 0x0307, 0x017c, a)  /* LATIN SMALL LETTER Z WITH DOT ABOVE */ \
+  X(0x007a, 0x030c, 0x017e, a)  /* LATIN SMALL LETTER Z WITH CARON */ \
+  X(0x007a, 0x0323, 0x1e93, a)  /* LATIN SMALL LETTER Z WITH DOT BELOW */ \
+  X(0x007a, 0x0331, 0x1e95, a)  /* LATIN SMALL LETTER Z WITH LINE BELOW */ \
+  X(0x00a8, 0x0300, 0x1fed, a)  /* GREEK DIALYTIKA AND VARIA */ \
+  X(0x00a8, 0x0301, 0x0385, a)  /* GREEK DIALYTIKA TONOS */ \
+  X(0x00a8, 0x0342, 0x1fc1, a)  /* GREEK DIALYTIKA AND PERISPOMENI */ \
+  X(0x00c2, 0x0300, 0x1ea6, a)  /* LATIN CAPITAL LETTER A WITH CIRCUMFLEX AND GRAVE */ \
+  X(0x00c2, 0x0301, 0x1ea4, a)  /* LATIN CAPITAL LETTER A WITH CIRCUMFLEX AND ACUTE */ \
+  X(0x00c2, 0x0303, 0x1eaa, a)  /* LATIN CAPITAL LETTER A WITH CIRCUMFLEX AND TILDE */ \
+  X(0x00c2, 0x0309, 0x1ea8, a)  /* LATIN CAPITAL LETTER A WITH CIRCUMFLEX AND HOOK ABOVE */ \
+  X(0x00c4, 0x0304, 0x01de, a)  /* LATIN CAPITAL LETTER A WITH DIAERESIS AND MACRON */ \
+  X(0x00c5, 0x0301, 0x01fa, a)  /* LATIN CAPITAL LETTER A WITH RING ABOVE AND ACUTE */ \
+  X(0x00c6, 0x0301, 0x01fc, a)  /* LATIN CAPITAL LETTER AE WITH ACUTE */ \
+  X(0x00c6, 0x0304, 0x01e2, a)  /* LATIN CAPITAL LETTER AE WITH MACRON */ \
+  X(0x00c7, 0x0301, 0x1e08, a)  /* LATIN CAPITAL LETTER C WITH CEDILLA AND ACUTE */ \
+  X(0x00ca, 0x0300, 0x1ec0, a)  /* LATIN CAPITAL LETTER E WITH CIRCUMFLEX AND GRAVE */ \
+  X(0x00ca, 0x0301, 0x1ebe, a)  /* LATIN CAPITAL LETTER E WITH CIRCUMFLEX AND ACUTE */ \
+  X(0x00ca, 0x0303, 0x1ec4, a)  /* LATIN CAPITAL LETTER E WITH CIRCUMFLEX AND TILDE */ \
+  X(0x00ca, 0x0309, 0x1ec2, a)  /* LATIN CAPITAL LETTER E WITH CIRCUMFLEX AND HOOK ABOVE */ \
+  X(0x00cf, 0x0301, 0x1e2e, a)  /* LATIN CAPITAL LETTER I WITH DIAERESIS AND ACUTE */ \
+  X(0x00d4, 0x0300, 0x1ed2, a)  /* LATIN CAPITAL LETTER O WITH CIRCUMFLEX AND GRAVE */ \
+  X(0x00d4, 0x0301, 0x1ed0, a)  /* LATIN CAPITAL LETTER O WITH CIRCUMFLEX AND ACUTE */ \
+  X(0x00d4, 0x0303, 0x1ed6, a)  /* LATIN CAPITAL LETTER O WITH CIRCUMFLEX AND TILDE */ \
+  X(0x00d4, 0x0309, 0x1ed4, a)  /* LATIN CAPITAL LETTER O WITH CIRCUMFLEX AND HOOK ABOVE */ \
+  X(0x00d5, 0x0301, 0x1e4c, a)  /* LATIN CAPITAL LETTER O WITH TILDE AND ACUTE */ \
+  X(0x00d5, 0x0304, 0x022c, a)  /* LATIN CAPITAL LETTER O WITH TILDE AND MACRON */ \
+  X(0x00d5, 0x0308, 0x1e4e, a)  /* LATIN CAPITAL LETTER O WITH TILDE AND DIAERESIS */ \
+  X(0x00d6, 0x0304, 0x022a, a)  /* LATIN CAPITAL LETTER O WITH DIAERESIS AND MACRON */ \
+  X(0x00d8, 0x0301, 0x01fe, a)  /* LATIN CAPITAL LETTER O WITH STROKE AND ACUTE */ \
+  X(0x00dc, 0x0300, 0x01db, a)  /* LATIN CAPITAL LETTER U WITH DIAERESIS AND GRAVE */ \
+  X(0x00dc, 0x0301, 0x01d7, a)  /* LATIN CAPITAL LETTER U WITH DIAERESIS AND ACUTE */ \
+  X(0x00dc, 0x0304, 0x01d5, a)  /* LATIN CAPITAL LETTER U WITH DIAERESIS AND MACRON */ \
+  X(0x00dc, 0x030c, 0x01d9, a)  /* LATIN CAPITAL LETTER U WITH DIAERESIS AND CARON */ \
+  X(0x00e2, 0x0300, 0x1ea7, a)  /* LATIN SMALL LETTER A WITH CIRCUMFLEX AND GRAVE */ \
+  X(0x00e2, 0x0301, 0x1ea5, a)  /* LATIN SMALL LETTER A WITH CIRCUMFLEX AND ACUTE */ \
+  X(0x00e2, 0x0303, 0x1eab, a)  /* LATIN SMALL LETTER A WITH CIRCUMFLEX AND TILDE */ \
+  X(0x00e2, 0x0309, 0x1ea9, a)  /* LATIN SMALL LETTER A WITH CIRCUMFLEX AND HOOK ABOVE */ \
+  X(0x00e4, 0x0304, 0x01df, a)  /* LATIN SMALL LETTER A WITH DIAERESIS AND MACRON */ \
+  X(0x00e5, 0x0301, 0x01fb, a)  /* LATIN SMALL LETTER A WITH RING ABOVE AND ACUTE */ \
+  X(0x00e6, 0x0301, 0x01fd, a)  /* LATIN SMALL LETTER AE WITH ACUTE */ \
+  X(0x00e6, 0x0304, 0x01e3, a)  /* LATIN SMALL LETTER AE WITH MACRON */ \
+  X(0x00e7, 0x0301, 0x1e09, a)  /* LATIN SMALL LETTER C WITH CEDILLA AND ACUTE */ \
+  X(0x00ea, 0x0300, 0x1ec1, a)  /* LATIN SMALL LETTER E WITH CIRCUMFLEX AND GRAVE */ \
+  X(0x00ea, 0x0301, 0x1ebf, a)  /* LATIN SMALL LETTER E WITH CIRCUMFLEX AND ACUTE */ \
+  X(0x00ea, 0x0303, 0x1ec5, a)  /* LATIN SMALL LETTER E WITH CIRCUMFLEX AND TILDE */ \
+  X(0x00ea, 0x0309, 0x1ec3, a)  /* LATIN SMALL LETTER E WITH CIRCUMFLEX AND HOOK ABOVE */ \
+  X(0x00ef, 0x0301, 0x1e2f, a)  /* LATIN SMALL LETTER I WITH DIAERESIS AND ACUTE */ \
+  X(0x00f4, 0x0300, 0x1ed3, a)  /* LATIN SMALL LETTER O WITH CIRCUMFLEX AND GRAVE */ \
+  X(0x00f4, 0x0301, 0x1ed1, a)  /* LATIN SMALL LETTER O WITH CIRCUMFLEX AND ACUTE */ \
+  X(0x00f4, 0x0303, 0x1ed7, a)  /* LATIN SMALL LETTER O WITH CIRCUMFLEX AND TILDE */ \
+  X(0x00f4, 0x0309, 0x1ed5, a)  /* LATIN SMALL LETTER O WITH CIRCUMFLEX AND HOOK ABOVE */ \
+  X(0x00f5, 0x0301, 0x1e4d, a)  /* LATIN SMALL LETTER O WITH TILDE AND ACUTE */ \
+  X(0x00f5, 0x0304, 0x022d, a)  /* LATIN SMALL LETTER O WITH TILDE AND MACRON */ \
+  X(0x00f5, 0x0308, 0x1e4f, a)  /* LATIN SMALL LETTER O WITH TILDE AND DIAERESIS */ \
+  X(0x00f6, 0x0304, 0x022b, a)  /* LATIN SMALL LETTER O WITH DIAERESIS AND MACRON */ \
+  X(0x00f8, 0x0301, 0x01ff, a)  /* LATIN SMALL LETTER O WITH STROKE AND ACUTE */ \
+  X(0x00fc, 0x0300, 0x01dc, a)  /* LATIN SMALL LETTER U WITH DIAERESIS AND GRAVE */ \
+  X(0x00fc, 0x0301, 0x01d8, a)  /* LATIN SMALL LETTER U WITH DIAERESIS AND ACUTE */ \
+  X(0x00fc, 0x0304, 0x01d6, a)  /* LATIN SMALL LETTER U WITH DIAERESIS AND MACRON */ \
+  X(0x00fc, 0x030c, 0x01da, a)  /* LATIN SMALL LETTER U WITH DIAERESIS AND CARON */ \
+  X(0x0102, 0x0300, 0x1eb0, a)  /* LATIN CAPITAL LETTER A WITH BREVE AND GRAVE */ \
+  X(0x0102, 0x0301, 0x1eae, a)  /* LATIN CAPITAL LETTER A WITH BREVE AND ACUTE */ \
+  X(0x0102, 0x0303, 0x1eb4, a)  /* LATIN CAPITAL LETTER A WITH BREVE AND TILDE */ \
+  X(0x0102, 0x0309, 0x1eb2, a)  /* LATIN CAPITAL LETTER A WITH BREVE AND HOOK ABOVE */ \
+  X(0x0103, 0x0300, 0x1eb1, a)  /* LATIN SMALL LETTER A WITH BREVE AND GRAVE */ \
+  X(0x0103, 0x0301, 0x1eaf, a)  /* LATIN SMALL LETTER A WITH BREVE AND ACUTE */ \
+  X(0x0103, 0x0303, 0x1eb5, a)  /* LATIN SMALL LETTER A WITH BREVE AND TILDE */ \
+  X(0x0103, 0x0309, 0x1eb3, a)  /* LATIN SMALL LETTER A WITH BREVE AND HOOK ABOVE */ \
+  X(0x0112, 0x0300, 0x1e14, a)  /* LATIN CAPITAL LETTER E WITH MACRON AND GRAVE */ \
+  X(0x0112, 0x0301, 0x1e16, a)  /* LATIN CAPITAL LETTER E WITH MACRON AND ACUTE */ \
+  X(0x0113, 0x0300, 0x1e15, a)  /* LATIN SMALL LETTER E WITH MACRON AND GRAVE */ \
+  X(0x0113, 0x0301, 0x1e17, a)  /* LATIN SMALL LETTER E WITH MACRON AND ACUTE */ \
+  X(0x014c, 0x0300, 0x1e50, a)  /* LATIN CAPITAL LETTER O WITH MACRON AND GRAVE */ \
+  X(0x014c, 0x0301, 0x1e52, a)  /* LATIN CAPITAL LETTER O WITH MACRON AND ACUTE */ \
+  X(0x014d, 0x0300, 0x1e51, a)  /* LATIN SMALL LETTER O WITH MACRON AND GRAVE */ \
+  X(0x014d, 0x0301, 0x1e53, a)  /* LATIN SMALL LETTER O WITH MACRON AND ACUTE */ \
+  X(0x015a, 0x0307, 0x1e64, a)  /* LATIN CAPITAL LETTER S WITH ACUTE AND DOT ABOVE */ \
+  X(0x015b, 0x0307, 0x1e65, a)  /* LATIN SMALL LETTER S WITH ACUTE AND DOT ABOVE */ \
+  X(0x0160, 0x0307, 0x1e66, a)  /* LATIN CAPITAL LETTER S WITH CARON AND DOT ABOVE */ \
+  X(0x0161, 0x0307, 0x1e67, a)  /* LATIN SMALL LETTER S WITH CARON AND DOT ABOVE */ \
+  X(0x0168, 0x0301, 0x1e78, a)  /* LATIN CAPITAL LETTER U WITH TILDE AND ACUTE */ \
+  X(0x0169, 0x0301, 0x1e79, a)  /* LATIN SMALL LETTER U WITH TILDE AND ACUTE */ \
+  X(0x016a, 0x0308, 0x1e7a, a)  /* LATIN CAPITAL LETTER U WITH MACRON AND DIAERESIS */ \
+  X(0x016b, 0x0308, 0x1e7b, a)  /* LATIN SMALL LETTER U WITH MACRON AND DIAERESIS */ \
+  X(0x017f, 0x0307, 0x1e9b, a)  /* LATIN SMALL LETTER LONG S WITH DOT ABOVE */ \
+  X(0x01a0, 0x0300, 0x1edc, a)  /* LATIN CAPITAL LETTER O WITH HORN AND GRAVE */ \
+  X(0x01a0, 0x0301, 0x1eda, a)  /* LATIN CAPITAL LETTER O WITH HORN AND ACUTE */ \
+  X(0x01a0, 0x0303, 0x1ee0, a)  /* LATIN CAPITAL LETTER O WITH HORN AND TILDE */ \
+  X(0x01a0, 0x0309, 0x1ede, a)  /* LATIN CAPITAL LETTER O WITH HORN AND HOOK ABOVE */ \
+  X(0x01a0, 0x0323, 0x1ee2, a)  /* LATIN CAPITAL LETTER O WITH HORN AND DOT BELOW */ \
+  X(0x01a1, 0x0300, 0x1edd, a)  /* LATIN SMALL LETTER O WITH HORN AND GRAVE */ \
+  X(0x01a1, 0x0301, 0x1edb, a)  /* LATIN SMALL LETTER O WITH HORN AND ACUTE */ \
+  X(0x01a1, 0x0303, 0x1ee1, a)  /* LATIN SMALL LETTER O WITH HORN AND TILDE */ \
+  X(0x01a1, 0x0309, 0x1edf, a)  /* LATIN SMALL LETTER O WITH HORN AND HOOK ABOVE */ \
+  X(0x01a1, 0x0323, 0x1ee3, a)  /* LATIN SMALL LETTER O WITH HORN AND DOT BELOW */ \
+  X(0x01af, 0x0300, 0x1eea, a)  /* LATIN CAPITAL LETTER U WITH HORN AND GRAVE */ \
+  X(0x01af, 0x0301, 0x1ee8, a)  /* LATIN CAPITAL LETTER U WITH HORN AND ACUTE */ \
+  X(0x01af, 0x0303, 0x1eee, a)  /* LATIN CAPITAL LETTER U WITH HORN AND TILDE */ \
+  X(0x01af, 0x0309, 0x1eec, a)  /* LATIN CAPITAL LETTER U WITH HORN AND HOOK ABOVE */ \
+  X(0x01af, 0x0323, 0x1ef0, a)  /* LATIN CAPITAL LETTER U WITH HORN AND DOT BELOW */ \
+  X(0x01b0, 0x0300, 0x1eeb, a)  /* LATIN SMALL LETTER U WITH HORN AND GRAVE */ \
+  X(0x01b0, 0x0301, 0x1ee9, a)  /* LATIN SMALL LETTER U WITH HORN AND ACUTE */ \
+  X(0x01b0, 0x0303, 0x1eef, a)  /* LATIN SMALL LETTER U WITH HORN AND TILDE */ \
+  X(0x01b0, 0x0309, 0x1eed, a)  /* LATIN SMALL LETTER U WITH HORN AND HOOK ABOVE */ \
+  X(0x01b0, 0x0323, 0x1ef1, a)  /* LATIN SMALL LETTER U WITH HORN AND DOT BELOW */ \
+  X(0x01b7, 0x030c, 0x01ee, a)  /* LATIN CAPITAL LETTER EZH WITH CARON */ \
+  X(0x01ea, 0x0304, 0x01ec, a)  /* LATIN CAPITAL LETTER O WITH OGONEK AND MACRON */ \
+  X(0x01eb, 0x0304, 0x01ed, a)  /* LATIN SMALL LETTER O WITH OGONEK AND MACRON */ \
+  X(0x0226, 0x0304, 0x01e0, a)  /* LATIN CAPITAL LETTER A WITH DOT ABOVE AND MACRON */ \
+  X(0x0227, 0x0304, 0x01e1, a)  /* LATIN SMALL LETTER A WITH DOT ABOVE AND MACRON */ \
+  X(0x0228, 0x0306, 0x1e1c, a)  /* LATIN CAPITAL LETTER E WITH CEDILLA AND BREVE */ \
+  X(0x0229, 0x0306, 0x1e1d, a)  /* LATIN SMALL LETTER E WITH CEDILLA AND BREVE */ \
+  X(0x022e, 0x0304, 0x0230, a)  /* LATIN CAPITAL LETTER O WITH DOT ABOVE AND MACRON */ \
+  X(0x022f, 0x0304, 0x0231, a)  /* LATIN SMALL LETTER O WITH DOT ABOVE AND MACRON */ \
+  X(0x0292, 0x030c, 0x01ef, a)  /* LATIN SMALL LETTER EZH WITH CARON */ \
+  X(0x0391, 0x0300, 0x1fba, a)  /* GREEK CAPITAL LETTER ALPHA WITH VARIA */ \
+  X(0x0391, 0x0301, 0x0386, a)  /* GREEK CAPITAL LETTER ALPHA WITH TONOS */ \
+  X(0x0391, 0x0304, 0x1fb9, a)  /* GREEK CAPITAL LETTER ALPHA WITH MACRON */ \
+  X(0x0391, 0x0306, 0x1fb8, a)  /* GREEK CAPITAL LETTER ALPHA WITH VRACHY */ \
+  X(0x0391, 0x0313, 0x1f08, a)  /* GREEK CAPITAL LETTER ALPHA WITH PSILI */ \
+  X(0x0391, 0x0314, 0x1f09, a)  /* GREEK CAPITAL LETTER ALPHA WITH DASIA */ \
+  X(0x0391, 0x0345, 0x1fbc, a)  /* GREEK CAPITAL LETTER ALPHA WITH PROSGEGRAMMENI */ \
+  X(0x0395, 0x0300, 0x1fc8, a)  /* GREEK CAPITAL LETTER EPSILON WITH VARIA */ \
+  X(0x0395, 0x0301, 0x0388, a)  /* GREEK CAPITAL LETTER EPSILON WITH TONOS */ \
+  X(0x0395, 0x0313, 0x1f18, a)  /* GREEK CAPITAL LETTER EPSILON WITH PSILI */ \
+  X(0x0395, 0x0314, 0x1f19, a)  /* GREEK CAPITAL LETTER EPSILON WITH DASIA */ \
+  X(0x0397, 0x0300, 0x1fca, a)  /* GREEK CAPITAL LETTER ETA WITH VARIA */ \
+  X(0x0397, 0x0301, 0x0389, a)  /* GREEK CAPITAL LETTER ETA WITH TONOS */ \
+  X(0x0397, 0x0313, 0x1f28, a)  /* GREEK CAPITAL LETTER ETA WITH PSILI */ \
+  X(0x0397, 0x0314, 0x1f29, a)  /* GREEK CAPITAL LETTER ETA WITH DASIA */ \
+  X(0x0397, 0x0345, 0x1fcc, a)  /* GREEK CAPITAL LETTER ETA WITH PROSGEGRAMMENI */ \
+  X(0x0399, 0x0300, 0x1fda, a)  /* GREEK CAPITAL LETTER IOTA WITH VARIA */ \
+  X(0x0399, 0x0301, 0x038a, a)  /* GREEK CAPITAL LETTER IOTA WITH TONOS */ \
+  X(0x0399, 0x0304, 0x1fd9, a)  /* GREEK CAPITAL LETTER IOTA WITH MACRON */ \
+  X(0x0399, 0x0306, 0x1fd8, a)  /* GREEK CAPITAL LETTER IOTA WITH VRACHY */ \
+  X(0x0399, 0x0308, 0x03aa, a)  /* GREEK CAPITAL LETTER IOTA WITH DIALYTIKA */ \
+  X(0x0399, 0x0313, 0x1f38, a)  /* GREEK CAPITAL LETTER IOTA WITH PSILI */ \
+  X(0x0399, 0x0314, 0x1f39, a)  /* GREEK CAPITAL LETTER IOTA WITH DASIA */ \
+  X(0x039f, 0x0300, 0x1ff8, a)  /* GREEK CAPITAL LETTER OMICRON WITH VARIA */ \
+  X(0x039f, 0x0301, 0x038c, a)  /* GREEK CAPITAL LETTER OMICRON WITH TONOS */ \
+  X(0x039f, 0x0313, 0x1f48, a)  /* GREEK CAPITAL LETTER OMICRON WITH PSILI */ \
+  X(0x039f, 0x0314, 0x1f49, a)  /* GREEK CAPITAL LETTER OMICRON WITH DASIA */ \
+  X(0x03a1, 0x0314, 0x1fec, a)  /* GREEK CAPITAL LETTER RHO WITH DASIA */ \
+  X(0x03a5, 0x0300, 0x1fea, a)  /* GREEK CAPITAL LETTER UPSILON WITH VARIA */ \
+  X(0x03a5, 0x0301, 0x038e, a)  /* GREEK CAPITAL LETTER UPSILON WITH TONOS */ \
+  X(0x03a5, 0x0304, 0x1fe9, a)  /* GREEK CAPITAL LETTER UPSILON WITH MACRON */ \
+  X(0x03a5, 0x0306, 0x1fe8, a)  /* GREEK CAPITAL LETTER UPSILON WITH VRACHY */ \
+  X(0x03a5, 0x0308, 0x03ab, a)  /* GREEK CAPITAL LETTER UPSILON WITH DIALYTIKA */ \
+  X(0x03a5, 0x0314, 0x1f59, a)  /* GREEK CAPITAL LETTER UPSILON WITH DASIA */ \
+  X(0x03a9, 0x0300, 0x1ffa, a)  /* GREEK CAPITAL LETTER OMEGA WITH VARIA */ \
+  X(0x03a9, 0x0301, 0x038f, a)  /* GREEK CAPITAL LETTER OMEGA WITH TONOS */ \
+  X(0x03a9, 0x0313, 0x1f68, a)  /* GREEK CAPITAL LETTER OMEGA WITH PSILI */ \
+  X(0x03a9, 0x0314, 0x1f69, a)  /* GREEK CAPITAL LETTER OMEGA WITH DASIA */ \
+  X(0x03a9, 0x0345, 0x1ffc, a)  /* GREEK CAPITAL LETTER OMEGA WITH PROSGEGRAMMENI */ \
+  X(0x03ac, 0x0345, 0x1fb4, a)  /* GREEK SMALL LETTER ALPHA WITH OXIA AND YPOGEGRAMMENI */ \
+  X(0x03ae, 0x0345, 0x1fc4, a)  /* GREEK SMALL LETTER ETA WITH OXIA AND YPOGEGRAMMENI */ \
+  X(0x03b1, 0x0300, 0x1f70, a)  /* GREEK SMALL LETTER ALPHA WITH VARIA */ \
+  X(0x03b1, 0x0301, 0x03ac, a)  /* GREEK SMALL LETTER ALPHA WITH TONOS */ \
+  X(0x03b1, 0x0304, 0x1fb1, a)  /* GREEK SMALL LETTER ALPHA WITH MACRON */ \
+  X(0x03b1, 0x0306, 0x1fb0, a)  /* GREEK SMALL LETTER ALPHA WITH VRACHY */ \
+  X(0x03b1, 0x0313, 0x1f00, a)  /* GREEK SMALL LETTER ALPHA WITH PSILI */ \
+  X(0x03b1, 0x0314, 0x1f01, a)  /* GREEK SMALL LETTER ALPHA WITH DASIA */ \
+  X(0x03b1, 0x0342, 0x1fb6, a)  /* GREEK SMALL LETTER ALPHA WITH PERISPOMENI */ \
+  X(0x03b1, 0x0345, 0x1fb3, a)  /* GREEK SMALL LETTER ALPHA WITH YPOGEGRAMMENI */ \
+  X(0x03b5, 0x0300, 0x1f72, a)  /* GREEK SMALL LETTER EPSILON WITH VARIA */ \
+  X(0x03b5, 0x0301, 0x03ad, a)  /* GREEK SMALL LETTER EPSILON WITH TONOS */ \
+  X(0x03b5, 0x0313, 0x1f10, a)  /* GREEK SMALL LETTER EPSILON WITH PSILI */ \
+  X(0x03b5, 0x0314, 0x1f11, a)  /* GREEK SMALL LETTER EPSILON WITH DASIA */ \
+  X(0x03b7, 0x0300, 0x1f74, a)  /* GREEK SMALL LETTER ETA WITH VARIA */ \
+  X(0x03b7, 0x0301, 0x03ae, a)  /* GREEK SMALL LETTER ETA WITH TONOS */ \
+  X(0x03b7, 0x0313, 0x1f20, a)  /* GREEK SMALL LETTER ETA WITH PSILI */ \
+  X(0x03b7, 0x0314, 0x1f21, a)  /* GREEK SMALL LETTER ETA WITH DASIA */ \
+  X(0x03b7, 0x0342, 0x1fc6, a)  /* GREEK SMALL LETTER ETA WITH PERISPOMENI */ \
+  X(0x03b7, 0x0345, 0x1fc3, a)  /* GREEK SMALL LETTER ETA WITH YPOGEGRAMMENI */ \
+  X(0x03b9, 0x0300, 0x1f76, a)  /* GREEK SMALL LETTER IOTA WITH VARIA */ \
+  X(0x03b9, 0x0301, 0x03af, a)  /* GREEK SMALL LETTER IOTA WITH TONOS */ \
+  X(0x03b9, 0x0304, 0x1fd1, a)  /* GREEK SMALL LETTER IOTA WITH MACRON */ \
+  X(0x03b9, 0x0306, 0x1fd0, a)  /* GREEK SMALL LETTER IOTA WITH VRACHY */ \
+  X(0x03b9, 0x0308, 0x03ca, a)  /* GREEK SMALL LETTER IOTA WITH DIALYTIKA */ \
+  X(0x03b9, 0x0313, 0x1f30, a)  /* GREEK SMALL LETTER IOTA WITH PSILI */ \
+  X(0x03b9, 0x0314, 0x1f31, a)  /* GREEK SMALL LETTER IOTA WITH DASIA */ \
+  X(0x03b9, 0x0342, 0x1fd6, a)  /* GREEK SMALL LETTER IOTA WITH PERISPOMENI */ \
+  X(0x03bf, 0x0300, 0x1f78, a)  /* GREEK SMALL LETTER OMICRON WITH VARIA */ \
+  X(0x03bf, 0x0301, 0x03cc, a)  /* GREEK SMALL LETTER OMICRON WITH TONOS */ \
+  X(0x03bf, 0x0313, 0x1f40, a)  /* GREEK SMALL LETTER OMICRON WITH PSILI */ \
+  X(0x03bf, 0x0314, 0x1f41, a)  /* GREEK SMALL LETTER OMICRON WITH DASIA */ \
+  X(0x03c1, 0x0313, 0x1fe4, a)  /* GREEK SMALL LETTER RHO WITH PSILI */ \
+  X(0x03c1, 0x0314, 0x1fe5, a)  /* GREEK SMALL LETTER RHO WITH DASIA */ \
+  X(0x03c5, 0x0300, 0x1f7a, a)  /* GREEK SMALL LETTER UPSILON WITH VARIA */ \
+  X(0x03c5, 0x0301, 0x03cd, a)  /* GREEK SMALL LETTER UPSILON WITH TONOS */ \
+  X(0x03c5, 0x0304, 0x1fe1, a)  /* GREEK SMALL LETTER UPSILON WITH MACRON */ \
+  X(0x03c5, 0x0306, 0x1fe0, a)  /* GREEK SMALL LETTER UPSILON WITH VRACHY */ \
+  X(0x03c5, 0x0308, 0x03cb, a)  /* GREEK SMALL LETTER UPSILON WITH DIALYTIKA */ \
+  X(0x03c5, 0x0313, 0x1f50, a)  /* GREEK SMALL LETTER UPSILON WITH PSILI */ \
+  X(0x03c5, 0x0314, 0x1f51, a)  /* GREEK SMALL LETTER UPSILON WITH DASIA */ \
+  X(0x03c5, 0x0342, 0x1fe6, a)  /* GREEK SMALL LETTER UPSILON WITH PERISPOMENI */ \
+  X(0x03c9, 0x0300, 0x1f7c, a)  /* GREEK SMALL LETTER OMEGA WITH VARIA */ \
+  X(0x03c9, 0x0301, 0x03ce, a)  /* GREEK SMALL LETTER OMEGA WITH TONOS */ \
+  X(0x03c9, 0x0313, 0x1f60, a)  /* GREEK SMALL LETTER OMEGA WITH PSILI */ \
+  X(0x03c9, 0x0314, 0x1f61, a)  /* GREEK SMALL LETTER OMEGA WITH DASIA */ \
+  X(0x03c9, 0x0342, 0x1ff6, a)  /* GREEK SMALL LETTER OMEGA WITH PERISPOMENI */ \
+  X(0x03c9, 0x0345, 0x1ff3, a)  /* GREEK SMALL LETTER OMEGA WITH YPOGEGRAMMENI */ \
+  X(0x03ca, 0x0300, 0x1fd2, a)  /* GREEK SMALL LETTER IOTA WITH DIALYTIKA AND VARIA */ \
+  X(0x03ca, 0x0301, 0x0390, a)  /* GREEK SMALL LETTER IOTA WITH DIALYTIKA AND TONOS */ \
+  X(0x03ca, 0x0342, 0x1fd7, a)  /* GREEK SMALL LETTER IOTA WITH DIALYTIKA AND PERISPOMENI */ \
+  X(0x03cb, 0x0300, 0x1fe2, a)  /* GREEK SMALL LETTER UPSILON WITH DIALYTIKA AND VARIA */ \
+  X(0x03cb, 0x0301, 0x03b0, a)  /* GREEK SMALL LETTER UPSILON WITH DIALYTIKA AND TONOS */ \
+  X(0x03cb, 0x0342, 0x1fe7, a)  /* GREEK SMALL LETTER UPSILON WITH DIALYTIKA AND PERISPOMENI */ \
+  X(0x03ce, 0x0345, 0x1ff4, a)  /* GREEK SMALL LETTER OMEGA WITH OXIA AND YPOGEGRAMMENI */ \
+  X(0x03d2, 0x0301, 0x03d3, a)  /* GREEK UPSILON WITH ACUTE AND HOOK SYMBOL */ \
+  X(0x03d2, 0x0308, 0x03d4, a)  /* GREEK UPSILON WITH DIAERESIS AND HOOK SYMBOL */ \
+  X(0x0406, 0x0308, 0x0407, a)  /* CYRILLIC CAPITAL LETTER YI */ \
+  X(0x0410, 0x0306, 0x04d0, a)  /* CYRILLIC CAPITAL LETTER A WITH BREVE */ \
+  X(0x0410, 0x0308, 0x04d2, a)  /* CYRILLIC CAPITAL LETTER A WITH DIAERESIS */ \
+  X(0x0413, 0x0301, 0x0403, a)  /* CYRILLIC CAPITAL LETTER GJE */ \
+  X(0x0415, 0x0300, 0x0400, a)  /* CYRILLIC CAPITAL LETTER IE WITH GRAVE */ \
+  X(0x0415, 0x0306, 0x04d6, a)  /* CYRILLIC CAPITAL LETTER IE WITH BREVE */ \
+  X(0x0415, 0x0308, 0x0401, a)  /* CYRILLIC CAPITAL LETTER IO */ \
+  X(0x0416, 0x0306, 0x04c1, a)  /* CYRILLIC CAPITAL LETTER ZHE WITH BREVE */ \
+  X(0x0416, 0x0308, 0x04dc, a)  /* CYRILLIC CAPITAL LETTER ZHE WITH DIAERESIS */ \
+  X(0x0417, 0x0308, 0x04de, a)  /* CYRILLIC CAPITAL LETTER ZE WITH DIAERESIS */ \
+  X(0x0418, 0x0300, 0x040d, a)  /* CYRILLIC CAPITAL LETTER I WITH GRAVE */ \
+  X(0x0418, 0x0304, 0x04e2, a)  /* CYRILLIC CAPITAL LETTER I WITH MACRON */ \
+  X(0x0418, 0x0306, 0x0419, a)  /* CYRILLIC CAPITAL LETTER SHORT I */ \
+  X(0x0418, 0x0308, 0x04e4, a)  /* CYRILLIC CAPITAL LETTER I WITH DIAERESIS */ \
+  X(0x041a, 0x0301, 0x040c, a)  /* CYRILLIC CAPITAL LETTER KJE */ \
+  X(0x041e, 0x0308, 0x04e6, a)  /* CYRILLIC CAPITAL LETTER O WITH DIAERESIS */ \
+  X(0x0423, 0x0304, 0x04ee, a)  /* CYRILLIC CAPITAL LETTER U WITH MACRON */ \
+  X(0x0423, 0x0306, 0x040e, a)  /* CYRILLIC CAPITAL LETTER SHORT U */ \
+  X(0x0423, 0x0308, 0x04f0, a)  /* CYRILLIC CAPITAL LETTER U WITH DIAERESIS */ \
+  X(0x0423, 0x030b, 0x04f2, a)  /* CYRILLIC CAPITAL LETTER U WITH DOUBLE ACUTE */ \
+  X(0x0427, 0x0308, 0x04f4, a)  /* CYRILLIC CAPITAL LETTER CHE WITH DIAERESIS */ \
+  X(0x042b, 0x0308, 0x04f8, a)  /* CYRILLIC CAPITAL LETTER YERU WITH DIAERESIS */ \
+  X(0x042d, 0x0308, 0x04ec, a)  /* CYRILLIC CAPITAL LETTER E WITH DIAERESIS */ \
+  X(0x0430, 0x0306, 0x04d1, a)  /* CYRILLIC SMALL LETTER A WITH BREVE */ \
+  X(0x0430, 0x0308, 0x04d3, a)  /* CYRILLIC SMALL LETTER A WITH DIAERESIS */ \
+  X(0x0433, 0x0301, 0x0453, a)  /* CYRILLIC SMALL LETTER GJE */ \
+  X(0x0435, 0x0300, 0x0450, a)  /* CYRILLIC SMALL LETTER IE WITH GRAVE */ \
+  X(0x0435, 0x0306, 0x04d7, a)  /* CYRILLIC SMALL LETTER IE WITH BREVE */ \
+  X(0x0435, 0x0308, 0x0451, a)  /* CYRILLIC SMALL LETTER IO */ \
+  X(0x0436, 0x0306, 0x04c2, a)  /* CYRILLIC SMALL LETTER ZHE WITH BREVE */ \
+  X(0x0436, 0x0308, 0x04dd, a)  /* CYRILLIC SMALL LETTER ZHE WITH DIAERESIS */ \
+  X(0x0437, 0x0308, 0x04df, a)  /* CYRILLIC SMALL LETTER ZE WITH DIAERESIS */ \
+  X(0x0438, 0x0300, 0x045d, a)  /* CYRILLIC SMALL LETTER I WITH GRAVE */ \
+  X(0x0438, 0x0304, 0x04e3, a)  /* CYRILLIC SMALL LETTER I WITH MACRON */ \
+  X(0x0438, 0x0306, 0x0439, a)  /* CYRILLIC SMALL LETTER SHORT I */ \
+  X(0x0438, 0x0308, 0x04e5, a)  /* CYRILLIC SMALL LETTER I WITH DIAERESIS */ \
+  X(0x043a, 0x0301, 0x045c, a)  /* CYRILLIC SMALL LETTER KJE */ \
+  X(0x043e, 0x0308, 0x04e7, a)  /* CYRILLIC SMALL LETTER O WITH DIAERESIS */ \
+  X(0x0443, 0x0304, 0x04ef, a)  /* CYRILLIC SMALL LETTER U WITH MACRON */ \
+  X(0x0443, 0x0306, 0x045e, a)  /* CYRILLIC SMALL LETTER SHORT U */ \
+  X(0x0443, 0x0308, 0x04f1, a)  /* CYRILLIC SMALL LETTER U WITH DIAERESIS */ \
+  X(0x0443, 0x030b, 0x04f3, a)  /* CYRILLIC SMALL LETTER U WITH DOUBLE ACUTE */ \
+  X(0x0447, 0x0308, 0x04f5, a)  /* CYRILLIC SMALL LETTER CHE WITH DIAERESIS */ \
+  X(0x044b, 0x0308, 0x04f9, a)  /* CYRILLIC SMALL LETTER YERU WITH DIAERESIS */ \
+  X(0x044d, 0x0308, 0x04ed, a)  /* CYRILLIC SMALL LETTER E WITH DIAERESIS */ \
+  X(0x0456, 0x0308, 0x0457, a)  /* CYRILLIC SMALL LETTER YI */ \
+  X(0x0474, 0x030f, 0x0476, a)  /* CYRILLIC CAPITAL LETTER IZHITSA WITH DOUBLE GRAVE ACCENT */ \
+  X(0x0475, 0x030f, 0x0477, a)  /* CYRILLIC SMALL LETTER IZHITSA WITH DOUBLE GRAVE ACCENT */ \
+  X(0x04d8, 0x0308, 0x04da, a)  /* CYRILLIC CAPITAL LETTER SCHWA WITH DIAERESIS */ \
+  X(0x04d9, 0x0308, 0x04db, a)  /* CYRILLIC SMALL LETTER SCHWA WITH DIAERESIS */ \
+  X(0x04e8, 0x0308, 0x04ea, a)  /* CYRILLIC CAPITAL LETTER BARRED O WITH DIAERESIS */ \
+  X(0x04e9, 0x0308, 0x04eb, a)  /* CYRILLIC SMALL LETTER BARRED O WITH DIAERESIS */ \
+  X(0x0627, 0x0653, 0x0622, a)  /* ARABIC LETTER ALEF WITH MADDA ABOVE */ \
+  X(0x0627, 0x0654, 0x0623, a)  /* ARABIC LETTER ALEF WITH HAMZA ABOVE */ \
+  X(0x0627, 0x0655, 0x0625, a)  /* ARABIC LETTER ALEF WITH HAMZA BELOW */ \
+  X(0x0648, 0x0654, 0x0624, a)  /* ARABIC LETTER WAW WITH HAMZA ABOVE */ \
+  X(0x064a, 0x0654, 0x0626, a)  /* ARABIC LETTER YEH WITH HAMZA ABOVE */ \
+  X(0x06c1, 0x0654, 0x06c2, a)  /* ARABIC LETTER HEH GOAL WITH HAMZA ABOVE */ \
+  X(0x06d2, 0x0654, 0x06d3, a)  /* ARABIC LETTER YEH BARREE WITH HAMZA ABOVE */ \
+  X(0x06d5, 0x0654, 0x06c0, a)  /* ARABIC LETTER HEH WITH YEH ABOVE */ \
+  X(0x0928, 0x093c, 0x0929, a)  /* DEVANAGARI LETTER NNNA */ \
+  X(0x0930, 0x093c, 0x0931, a)  /* DEVANAGARI LETTER RRA */ \
+  X(0x0933, 0x093c, 0x0934, a)  /* DEVANAGARI LETTER LLLA */ \
+  X(0x09c7, 0x09be, 0x09cb, a)  /* BENGALI VOWEL SIGN O */ \
+  X(0x09c7, 0x09d7, 0x09cc, a)  /* BENGALI VOWEL SIGN AU */ \
+  X(0x0b47, 0x0b3e, 0x0b4b, a)  /* ORIYA VOWEL SIGN O */ \
+  X(0x0b47, 0x0b56, 0x0b48, a)  /* ORIYA VOWEL SIGN AI */ \
+  X(0x0b47, 0x0b57, 0x0b4c, a)  /* ORIYA VOWEL SIGN AU */ \
+  X(0x0b92, 0x0bd7, 0x0b94, a)  /* TAMIL LETTER AU */ \
+  X(0x0bc6, 0x0bbe, 0x0bca, a)  /* TAMIL VOWEL SIGN O */ \
+  X(0x0bc6, 0x0bd7, 0x0bcc, a)  /* TAMIL VOWEL SIGN AU */ \
+  X(0x0bc7, 0x0bbe, 0x0bcb, a)  /* TAMIL VOWEL SIGN OO */ \
+  X(0x0c46, 0x0c56, 0x0c48, a)  /* TELUGU VOWEL SIGN AI */ \
+  X(0x0cbf, 0x0cd5, 0x0cc0, a)  /* KANNADA VOWEL SIGN II */ \
+  X(0x0cc6, 0x0cc2, 0x0cca, a)  /* KANNADA VOWEL SIGN O */ \
+  X(0x0cc6, 0x0cd5, 0x0cc7, a)  /* KANNADA VOWEL SIGN EE */ \
+  X(0x0cc6, 0x0cd6, 0x0cc8, a)  /* KANNADA VOWEL SIGN AI */ \
+  X(0x0cca, 0x0cd5, 0x0ccb, a)  /* KANNADA VOWEL SIGN OO */ \
+  X(0x0d46, 0x0d3e, 0x0d4a, a)  /* MALAYALAM VOWEL SIGN O */ \
+  X(0x0d46, 0x0d57, 0x0d4c, a)  /* MALAYALAM VOWEL SIGN AU */ \
+  X(0x0d47, 0x0d3e, 0x0d4b, a)  /* MALAYALAM VOWEL SIGN OO */ \
+  X(0x0dd9, 0x0dca, 0x0dda, a)  /* SINHALA VOWEL SIGN DIGA KOMBUVA */ \
+  X(0x0dd9, 0x0dcf, 0x0ddc, a)  /* SINHALA VOWEL SIGN KOMBUVA HAA AELA-PILLA */ \
+  X(0x0dd9, 0x0ddf, 0x0dde, a)  /* SINHALA VOWEL SIGN KOMBUVA HAA GAYANUKITTA */ \
+  X(0x0ddc, 0x0dca, 0x0ddd, a)  /* SINHALA VOWEL SIGN KOMBUVA HAA DIGA AELA-PILLA */ \
+  X(0x1025, 0x102e, 0x1026, a)  /* MYANMAR LETTER UU */ \
+  X(0x1b05, 0x1b35, 0x1b06, a)  /* BALINESE LETTER AKARA TEDUNG */ \
+  X(0x1b07, 0x1b35, 0x1b08, a)  /* BALINESE LETTER IKARA TEDUNG */ \
+  X(0x1b09, 0x1b35, 0x1b0a, a)  /* BALINESE LETTER UKARA TEDUNG */ \
+  X(0x1b0b, 0x1b35, 0x1b0c, a)  /* BALINESE LETTER RA REPA TEDUNG */ \
+  X(0x1b0d, 0x1b35, 0x1b0e, a)  /* BALINESE LETTER LA LENGA TEDUNG */ \
+  X(0x1b11, 0x1b35, 0x1b12, a)  /* BALINESE LETTER OKARA TEDUNG */ \
+  X(0x1b3a, 0x1b35, 0x1b3b, a)  /* BALINESE VOWEL SIGN RA REPA TEDUNG */ \
+  X(0x1b3c, 0x1b35, 0x1b3d, a)  /* BALINESE VOWEL SIGN LA LENGA TEDUNG */ \
+  X(0x1b3e, 0x1b35, 0x1b40, a)  /* BALINESE VOWEL SIGN TALING TEDUNG */ \
+  X(0x1b3f, 0x1b35, 0x1b41, a)  /* BALINESE VOWEL SIGN TALING REPA TEDUNG */ \
+  X(0x1b42, 0x1b35, 0x1b43, a)  /* BALINESE VOWEL SIGN PEPET TEDUNG */ \
+  X(0x1e36, 0x0304, 0x1e38, a)  /* LATIN CAPITAL LETTER L WITH DOT BELOW AND MACRON */ \
+  X(0x1e37, 0x0304, 0x1e39, a)  /* LATIN SMALL LETTER L WITH DOT BELOW AND MACRON */ \
+  X(0x1e5a, 0x0304, 0x1e5c, a)  /* LATIN CAPITAL LETTER R WITH DOT BELOW AND MACRON */ \
+  X(0x1e5b, 0x0304, 0x1e5d, a)  /* LATIN SMALL LETTER R WITH DOT BELOW AND MACRON */ \
+  X(0x1e62, 0x0307, 0x1e68, a)  /* LATIN CAPITAL LETTER S WITH DOT BELOW AND DOT ABOVE */ \
+  X(0x1e63, 0x0307, 0x1e69, a)  /* LATIN SMALL LETTER S WITH DOT BELOW AND DOT ABOVE */ \
+  X(0x1ea0, 0x0302, 0x1eac, a)  /* LATIN CAPITAL LETTER A WITH CIRCUMFLEX AND DOT BELOW */ \
+  X(0x1ea0, 0x0306, 0x1eb6, a)  /* LATIN CAPITAL LETTER A WITH BREVE AND DOT BELOW */ \
+  X(0x1ea1, 0x0302, 0x1ead, a)  /* LATIN SMALL LETTER A WITH CIRCUMFLEX AND DOT BELOW */ \
+  X(0x1ea1, 0x0306, 0x1eb7, a)  /* LATIN SMALL LETTER A WITH BREVE AND DOT BELOW */ \
+  X(0x1eb8, 0x0302, 0x1ec6, a)  /* LATIN CAPITAL LETTER E WITH CIRCUMFLEX AND DOT BELOW */ \
+  X(0x1eb9, 0x0302, 0x1ec7, a)  /* LATIN SMALL LETTER E WITH CIRCUMFLEX AND DOT BELOW */ \
+  X(0x1ecc, 0x0302, 0x1ed8, a)  /* LATIN CAPITAL LETTER O WITH CIRCUMFLEX AND DOT BELOW */ \
+  X(0x1ecd, 0x0302, 0x1ed9, a)  /* LATIN SMALL LETTER O WITH CIRCUMFLEX AND DOT BELOW */ \
+  X(0x1f00, 0x0300, 0x1f02, a)  /* GREEK SMALL LETTER ALPHA WITH PSILI AND VARIA */ \
+  X(0x1f00, 0x0301, 0x1f04, a)  /* GREEK SMALL LETTER ALPHA WITH PSILI AND OXIA */ \
+  X(0x1f00, 0x0342, 0x1f06, a)  /* GREEK SMALL LETTER ALPHA WITH PSILI AND PERISPOMENI */ \
+  X(0x1f00, 0x0345, 0x1f80, a)  /* GREEK SMALL LETTER ALPHA WITH PSILI AND YPOGEGRAMMENI */ \
+  X(0x1f01, 0x0300, 0x1f03, a)  /* GREEK SMALL LETTER ALPHA WITH DASIA AND VARIA */ \
+  X(0x1f01, 0x0301, 0x1f05, a)  /* GREEK SMALL LETTER ALPHA WITH DASIA AND OXIA */ \
+  X(0x1f01, 0x0342, 0x1f07, a)  /* GREEK SMALL LETTER ALPHA WITH DASIA AND PERISPOMENI */ \
+  X(0x1f01, 0x0345, 0x1f81, a)  /* GREEK SMALL LETTER ALPHA WITH DASIA AND YPOGEGRAMMENI */ \
+  X(0x1f02, 0x0345, 0x1f82, a)  /* GREEK SMALL LETTER ALPHA WITH PSILI AND VARIA AND YPOGEGRAMMENI */ \
+  X(0x1f03, 0x0345, 0x1f83, a)  /* GREEK SMALL LETTER ALPHA WITH DASIA AND VARIA AND YPOGEGRAMMENI */ \
+  X(0x1f04, 0x0345, 0x1f84, a)  /* GREEK SMALL LETTER ALPHA WITH PSILI AND OXIA AND YPOGEGRAMMENI */ \
+  X(0x1f05, 0x0345, 0x1f85, a)  /* GREEK SMALL LETTER ALPHA WITH DASIA AND OXIA AND YPOGEGRAMMENI */ \
+  X(0x1f06, 0x0345, 0x1f86, a)  /* GREEK SMALL LETTER ALPHA WITH PSILI AND PERISPOMENI AND YPOGEGRAMMENI */ \
+  X(0x1f07, 0x0345, 0x1f87, a)  /* GREEK SMALL LETTER ALPHA WITH DASIA AND PERISPOMENI AND YPOGEGRAMMENI */ \
+  X(0x1f08, 0x0300, 0x1f0a, a)  /* GREEK CAPITAL LETTER ALPHA WITH PSILI AND VARIA */ \
+  X(0x1f08, 0x0301, 0x1f0c, a)  /* GREEK CAPITAL LETTER ALPHA WITH PSILI AND OXIA */ \
+  X(0x1f08, 0x0342, 0x1f0e, a)  /* GREEK CAPITAL LETTER ALPHA WITH PSILI AND PERISPOMENI */ \
+  X(0x1f08, 0x0345, 0x1f88, a)  /* GREEK CAPITAL LETTER ALPHA WITH PSILI AND PROSGEGRAMMENI */ \
+  X(0x1f09, 0x0300, 0x1f0b, a)  /* GREEK CAPITAL LETTER ALPHA WITH DASIA AND VARIA */ \
+  X(0x1f09, 0x0301, 0x1f0d, a)  /* GREEK CAPITAL LETTER ALPHA WITH DASIA AND OXIA */ \
+  X(0x1f09, 0x0342, 0x1f0f, a)  /* GREEK CAPITAL LETTER ALPHA WITH DASIA AND PERISPOMENI */ \
+  X(0x1f09, 0x0345, 0x1f89, a)  /* GREEK CAPITAL LETTER ALPHA WITH DASIA AND PROSGEGRAMMENI */ \
+  X(0x1f0a, 0x0345, 0x1f8a, a)  /* GREEK CAPITAL LETTER ALPHA WITH PSILI AND VARIA AND PROSGEGRAMMENI */ \
+  X(0x1f0b, 0x0345, 0x1f8b, a)  /* GREEK CAPITAL LETTER ALPHA WITH DASIA AND VARIA AND PROSGEGRAMMENI */ \
+  X(0x1f0c, 0x0345, 0x1f8c, a)  /* GREEK CAPITAL LETTER ALPHA WITH PSILI AND OXIA AND PROSGEGRAMMENI */ \
+  X(0x1f0d, 0x0345, 0x1f8d, a)  /* GREEK CAPITAL LETTER ALPHA WITH DASIA AND OXIA AND PROSGEGRAMMENI */ \
+  X(0x1f0e, 0x0345, 0x1f8e, a)  /* GREEK CAPITAL LETTER ALPHA WITH PSILI AND PERISPOMENI AND PROSGEGRAMMENI */ \
+  X(0x1f0f, 0x0345, 0x1f8f, a)  /* GREEK CAPITAL LETTER ALPHA WITH DASIA AND PERISPOMENI AND PROSGEGRAMMENI */ \
+  X(0x1f10, 0x0300, 0x1f12, a)  /* GREEK SMALL LETTER EPSILON WITH PSILI AND VARIA */ \
+  X(0x1f10, 0x0301, 0x1f14, a)  /* GREEK SMALL LETTER EPSILON WITH PSILI AND OXIA */ \
+  X(0x1f11, 0x0300, 0x1f13, a)  /* GREEK SMALL LETTER EPSILON WITH DASIA AND VARIA */ \
+  X(0x1f11, 0x0301, 0x1f15, a)  /* GREEK SMALL LETTER EPSILON WITH DASIA AND OXIA */ \
+  X(0x1f18, 0x0300, 0x1f1a, a)  /* GREEK CAPITAL LETTER EPSILON WITH PSILI AND VARIA */ \
+  X(0x1f18, 0x0301, 0x1f1c, a)  /* GREEK CAPITAL LETTER EPSILON WITH PSILI AND OXIA */ \
+  X(0x1f19, 0x0300, 0x1f1b, a)  /* GREEK CAPITAL LETTER EPSILON WITH DASIA AND VARIA */ \
+  X(0x1f19, 0x0301, 0x1f1d, a)  /* GREEK CAPITAL LETTER EPSILON WITH DASIA AND OXIA */ \
+  X(0x1f20, 0x0300, 0x1f22, a)  /* GREEK SMALL LETTER ETA WITH PSILI AND VARIA */ \
+  X(0x1f20, 0x0301, 0x1f24, a)  /* GREEK SMALL LETTER ETA WITH PSILI AND OXIA */ \
+  X(0x1f20, 0x0342, 0x1f26, a)  /* GREEK SMALL LETTER ETA WITH PSILI AND PERISPOMENI */ \
+  X(0x1f20, 0x0345, 0x1f90, a)  /* GREEK SMALL LETTER ETA WITH PSILI AND YPOGEGRAMMENI */ \
+  X(0x1f21, 0x0300, 0x1f23, a)  /* GREEK SMALL LETTER ETA WITH DASIA AND VARIA */ \
+  X(0x1f21, 0x0301, 0x1f25, a)  /* GREEK SMALL LETTER ETA WITH DASIA AND OXIA */ \
+  X(0x1f21, 0x0342, 0x1f27, a)  /* GREEK SMALL LETTER ETA WITH DASIA AND PERISPOMENI */ \
+  X(0x1f21, 0x0345, 0x1f91, a)  /* GREEK SMALL LETTER ETA WITH DASIA AND YPOGEGRAMMENI */ \
+  X(0x1f22, 0x0345, 0x1f92, a)  /* GREEK SMALL LETTER ETA WITH PSILI AND VARIA AND YPOGEGRAMMENI */ \
+  X(0x1f23, 0x0345, 0x1f93, a)  /* GREEK SMALL LETTER ETA WITH DASIA AND VARIA AND YPOGEGRAMMENI */ \
+  X(0x1f24, 0x0345, 0x1f94, a)  /* GREEK SMALL LETTER ETA WITH PSILI AND OXIA AND YPOGEGRAMMENI */ \
+  X(0x1f25, 0x0345, 0x1f95, a)  /* GREEK SMALL LETTER ETA WITH DASIA AND OXIA AND YPOGEGRAMMENI */ \
+  X(0x1f26, 0x0345, 0x1f96, a)  /* GREEK SMALL LETTER ETA WITH PSILI AND PERISPOMENI AND YPOGEGRAMMENI */ \
+  X(0x1f27, 0x0345, 0x1f97, a)  /* GREEK SMALL LETTER ETA WITH DASIA AND PERISPOMENI AND YPOGEGRAMMENI */ \
+  X(0x1f28, 0x0300, 0x1f2a, a)  /* GREEK CAPITAL LETTER ETA WITH PSILI AND VARIA */ \
+  X(0x1f28, 0x0301, 0x1f2c, a)  /* GREEK CAPITAL LETTER ETA WITH PSILI AND OXIA */ \
+  X(0x1f28, 0x0342, 0x1f2e, a)  /* GREEK CAPITAL LETTER ETA WITH PSILI AND PERISPOMENI */ \
+  X(0x1f28, 0x0345, 0x1f98, a)  /* GREEK CAPITAL LETTER ETA WITH PSILI AND PROSGEGRAMMENI */ \
+  X(0x1f29, 0x0300, 0x1f2b, a)  /* GREEK CAPITAL LETTER ETA WITH DASIA AND VARIA */ \
+  X(0x1f29, 0x0301, 0x1f2d, a)  /* GREEK CAPITAL LETTER ETA WITH DASIA AND OXIA */ \
+  X(0x1f29, 0x0342, 0x1f2f, a)  /* GREEK CAPITAL LETTER ETA WITH DASIA AND PERISPOMENI */ \
+  X(0x1f29, 0x0345, 0x1f99, a)  /* GREEK CAPITAL LETTER ETA WITH DASIA AND PROSGEGRAMMENI */ \
+  X(0x1f2a, 0x0345, 0x1f9a, a)  /* GREEK CAPITAL LETTER ETA WITH PSILI AND VARIA AND PROSGEGRAMMENI */ \
+  X(0x1f2b, 0x0345, 0x1f9b, a)  /* GREEK CAPITAL LETTER ETA WITH DASIA AND VARIA AND PROSGEGRAMMENI */ \
+  X(0x1f2c, 0x0345, 0x1f9c, a)  /* GREEK CAPITAL LETTER ETA WITH PSILI AND OXIA AND PROSGEGRAMMENI */ \
+  X(0x1f2d, 0x0345, 0x1f9d, a)  /* GREEK CAPITAL LETTER ETA WITH DASIA AND OXIA AND PROSGEGRAMMENI */ \
+  X(0x1f2e, 0x0345, 0x1f9e, a)  /* GREEK CAPITAL LETTER ETA WITH PSILI AND PERISPOMENI AND PROSGEGRAMMENI */ \
+  X(0x1f2f, 0x0345, 0x1f9f, a)  /* GREEK CAPITAL LETTER ETA WITH DASIA AND PERISPOMENI AND PROSGEGRAMMENI */ \
+  X(0x1f30, 0x0300, 0x1f32, a)  /* GREEK SMALL LETTER IOTA WITH PSILI AND VARIA */ \
+  X(0x1f30, 0x0301, 0x1f34, a)  /* GREEK SMALL LETTER IOTA WITH PSILI AND OXIA */ \
+  X(0x1f30, 0x0342, 0x1f36, a)  /* GREEK SMALL LETTER IOTA WITH PSILI AND PERISPOMENI */ \
+  X(0x1f31, 0x0300, 0x1f33, a)  /* GREEK SMALL LETTER IOTA WITH DASIA AND VARIA */ \
+  X(0x1f31, 0x0301, 0x1f35, a)  /* GREEK SMALL LETTER IOTA WITH DASIA AND OXIA */ \
+  X(0x1f31, 0x0342, 0x1f37, a)  /* GREEK SMALL LETTER IOTA WITH DASIA AND PERISPOMENI */ \
+  X(0x1f38, 0x0300, 0x1f3a, a)  /* GREEK CAPITAL LETTER IOTA WITH PSILI AND VARIA */ \
+  X(0x1f38, 0x0301, 0x1f3c, a)  /* GREEK CAPITAL LETTER IOTA WITH PSILI AND OXIA */ \
+  X(0x1f38, 0x0342, 0x1f3e, a)  /* GREEK CAPITAL LETTER IOTA WITH PSILI AND PERISPOMENI */ \
+  X(0x1f39, 0x0300, 0x1f3b, a)  /* GREEK CAPITAL LETTER IOTA WITH DASIA AND VARIA */ \
+  X(0x1f39, 0x0301, 0x1f3d, a)  /* GREEK CAPITAL LETTER IOTA WITH DASIA AND OXIA */ \
+  X(0x1f39, 0x0342, 0x1f3f, a)  /* GREEK CAPITAL LETTER IOTA WITH DASIA AND PERISPOMENI */ \
+  X(0x1f40, 0x0300, 0x1f42, a)  /* GREEK SMALL LETTER OMICRON WITH PSILI AND VARIA */ \
+  X(0x1f40, 0x0301, 0x1f44, a)  /* GREEK SMALL LETTER OMICRON WITH PSILI AND OXIA */ \
+  X(0x1f41, 0x0300, 0x1f43, a)  /* GREEK SMALL LETTER OMICRON WITH DASIA AND VARIA */ \
+  X(0x1f41, 0x0301, 0x1f45, a)  /* GREEK SMALL LETTER OMICRON WITH DASIA AND OXIA */ \
+  X(0x1f48, 0x0300, 0x1f4a, a)  /* GREEK CAPITAL LETTER OMICRON WITH PSILI AND VARIA */ \
+  X(0x1f48, 0x0301, 0x1f4c, a)  /* GREEK CAPITAL LETTER OMICRON WITH PSILI AND OXIA */ \
+  X(0x1f49, 0x0300, 0x1f4b, a)  /* GREEK CAPITAL LETTER OMICRON WITH DASIA AND VARIA */ \
+  X(0x1f49, 0x0301, 0x1f4d, a)  /* GREEK CAPITAL LETTER OMICRON WITH DASIA AND OXIA */ \
+  X(0x1f50, 0x0300, 0x1f52, a)  /* GREEK SMALL LETTER UPSILON WITH PSILI AND VARIA */ \
+  X(0x1f50, 0x0301, 0x1f54, a)  /* GREEK SMALL LETTER UPSILON WITH PSILI AND OXIA */ \
+  X(0x1f50, 0x0342, 0x1f56, a)  /* GREEK SMALL LETTER UPSILON WITH PSILI AND PERISPOMENI */ \
+  X(0x1f51, 0x0300, 0x1f53, a)  /* GREEK SMALL LETTER UPSILON WITH DASIA AND VARIA */ \
+  X(0x1f51, 0x0301, 0x1f55, a)  /* GREEK SMALL LETTER UPSILON WITH DASIA AND OXIA */ \
+  X(0x1f51, 0x0342, 0x1f57, a)  /* GREEK SMALL LETTER UPSILON WITH DASIA AND PERISPOMENI */ \
+  X(0x1f59, 0x0300, 0x1f5b, a)  /* GREEK CAPITAL LETTER UPSILON WITH DASIA AND VARIA */ \
+  X(0x1f59, 0x0301, 0x1f5d, a)  /* GREEK CAPITAL LETTER UPSILON WITH DASIA AND OXIA */ \
+  X(0x1f59, 0x0342, 0x1f5f, a)  /* GREEK CAPITAL LETTER UPSILON WITH DASIA AND PERISPOMENI */ \
+  X(0x1f60, 0x0300, 0x1f62, a)  /* GREEK SMALL LETTER OMEGA WITH PSILI AND VARIA */ \
+  X(0x1f60, 0x0301, 0x1f64, a)  /* GREEK SMALL LETTER OMEGA WITH PSILI AND OXIA */ \
+  X(0x1f60, 0x0342, 0x1f66, a)  /* GREEK SMALL LETTER OMEGA WITH PSILI AND PERISPOMENI */ \
+  X(0x1f60, 0x0345, 0x1fa0, a)  /* GREEK SMALL LETTER OMEGA WITH PSILI AND YPOGEGRAMMENI */ \
+  X(0x1f61, 0x0300, 0x1f63, a)  /* GREEK SMALL LETTER OMEGA WITH DASIA AND VARIA */ \
+  X(0x1f61, 0x0301, 0x1f65, a)  /* GREEK SMALL LETTER OMEGA WITH DASIA AND OXIA */ \
+  X(0x1f61, 0x0342, 0x1f67, a)  /* GREEK SMALL LETTER OMEGA WITH DASIA AND PERISPOMENI */ \
+  X(0x1f61, 0x0345, 0x1fa1, a)  /* GREEK SMALL LETTER OMEGA WITH DASIA AND YPOGEGRAMMENI */ \
+  X(0x1f62, 0x0345, 0x1fa2, a)  /* GREEK SMALL LETTER OMEGA WITH PSILI AND VARIA AND YPOGEGRAMMENI */ \
+  X(0x1f63, 0x0345, 0x1fa3, a)  /* GREEK SMALL LETTER OMEGA WITH DASIA AND VARIA AND YPOGEGRAMMENI */ \
+  X(0x1f64, 0x0345, 0x1fa4, a)  /* GREEK SMALL LETTER OMEGA WITH PSILI AND OXIA AND YPOGEGRAMMENI */ \
+  X(0x1f65, 0x0345, 0x1fa5, a)  /* GREEK SMALL LETTER OMEGA WITH DASIA AND OXIA AND YPOGEGRAMMENI */ \
+  X(0x1f66, 0x0345, 0x1fa6, a)  /* GREEK SMALL LETTER OMEGA WITH PSILI AND PERISPOMENI AND YPOGEGRAMMENI */ \
+  X(0x1f67, 0x0345, 0x1fa7, a)  /* GREEK SMALL LETTER OMEGA WITH DASIA AND PERISPOMENI AND YPOGEGRAMMENI */ \
+  X(0x1f68, 0x0300, 0x1f6a, a)  /* GREEK CAPITAL LETTER OMEGA WITH PSILI AND VARIA */ \
+  X(0x1f68, 0x0301, 0x1f6c, a)  /* GREEK CAPITAL LETTER OMEGA WITH PSILI AND OXIA */ \
+  X(0x1f68, 0x0342, 0x1f6e, a)  /* GREEK CAPITAL LETTER OMEGA WITH PSILI AND PERISPOMENI */ \
+  X(0x1f68, 0x0345, 0x1fa8, a)  /* GREEK CAPITAL LETTER OMEGA WITH PSILI AND PROSGEGRAMMENI */ \
+  X(0x1f69, 0x0300, 0x1f6b, a)  /* GREEK CAPITAL LETTER OMEGA WITH DASIA AND VARIA */ \
+  X(0x1f69, 0x0301, 0x1f6d, a)  /* GREEK CAPITAL LETTER OMEGA WITH DASIA AND OXIA */ \
+  X(0x1f69, 0x0342, 0x1f6f, a)  /* GREEK CAPITAL LETTER OMEGA WITH DASIA AND PERISPOMENI */ \
+  X(0x1f69, 0x0345, 0x1fa9, a)  /* GREEK CAPITAL LETTER OMEGA WITH DASIA AND PROSGEGRAMMENI */ \
+  X(0x1f6a, 0x0345, 0x1faa, a)  /* GREEK CAPITAL LETTER OMEGA WITH PSILI AND VARIA AND PROSGEGRAMMENI */ \
+  X(0x1f6b, 0x0345, 0x1fab, a)  /* GREEK CAPITAL LETTER OMEGA WITH DASIA AND VARIA AND PROSGEGRAMMENI */ \
+  X(0x1f6c, 0x0345, 0x1fac, a)  /* GREEK CAPITAL LETTER OMEGA WITH PSILI AND OXIA AND PROSGEGRAMMENI */ \
+  X(0x1f6d, 0x0345, 0x1fad, a)  /* GREEK CAPITAL LETTER OMEGA WITH DASIA AND OXIA AND PROSGEGRAMMENI */ \
+  X(0x1f6e, 0x0345, 0x1fae, a)  /* GREEK CAPITAL LETTER OMEGA WITH PSILI AND PERISPOMENI AND PROSGEGRAMMENI */ \
+  X(0x1f6f, 0x0345, 0x1faf, a)  /* GREEK CAPITAL LETTER OMEGA WITH DASIA AND PERISPOMENI AND PROSGEGRAMMENI */ \
+  X(0x1f70, 0x0345, 0x1fb2, a)  /* GREEK SMALL LETTER ALPHA WITH VARIA AND YPOGEGRAMMENI */ \
+  X(0x1f74, 0x0345, 0x1fc2, a)  /* GREEK SMALL LETTER ETA WITH VARIA AND YPOGEGRAMMENI */ \
+  X(0x1f7c, 0x0345, 0x1ff2, a)  /* GREEK SMALL LETTER OMEGA WITH VARIA AND YPOGEGRAMMENI */ \
+  X(0x1fb6, 0x0345, 0x1fb7, a)  /* GREEK SMALL LETTER ALPHA WITH PERISPOMENI AND YPOGEGRAMMENI */ \
+  X(0x1fbf, 0x0300, 0x1fcd, a)  /* GREEK PSILI AND VARIA */ \
+  X(0x1fbf, 0x0301, 0x1fce, a)  /* GREEK PSILI AND OXIA */ \
+  X(0x1fbf, 0x0342, 0x1fcf, a)  /* GREEK PSILI AND PERISPOMENI */ \
+  X(0x1fc6, 0x0345, 0x1fc7, a)  /* GREEK SMALL LETTER ETA WITH PERISPOMENI AND YPOGEGRAMMENI */ \
+  X(0x1ff6, 0x0345, 0x1ff7, a)  /* GREEK SMALL LETTER OMEGA WITH PERISPOMENI AND YPOGEGRAMMENI */ \
+  X(0x1ffe, 0x0300, 0x1fdd, a)  /* GREEK DASIA AND VARIA */ \
+  X(0x1ffe, 0x0301, 0x1fde, a)  /* GREEK DASIA AND OXIA */ \
+  X(0x1ffe, 0x0342, 0x1fdf, a)  /* GREEK DASIA AND PERISPOMENI */ \
+  X(0x2190, 0x0338, 0x219a, a)  /* LEFTWARDS ARROW WITH STROKE */ \
+  X(0x2192, 0x0338, 0x219b, a)  /* RIGHTWARDS ARROW WITH STROKE */ \
+  X(0x2194, 0x0338, 0x21ae, a)  /* LEFT RIGHT ARROW WITH STROKE */ \
+  X(0x21d0, 0x0338, 0x21cd, a)  /* LEFTWARDS DOUBLE ARROW WITH STROKE */ \
+  X(0x21d2, 0x0338, 0x21cf, a)  /* RIGHTWARDS DOUBLE ARROW WITH STROKE */ \
+  X(0x21d4, 0x0338, 0x21ce, a)  /* LEFT RIGHT DOUBLE ARROW WITH STROKE */ \
+  X(0x2203, 0x0338, 0x2204, a)  /* THERE DOES NOT EXIST */ \
+  X(0x2208, 0x0338, 0x2209, a)  /* NOT AN ELEMENT OF */ \
+  X(0x220b, 0x0338, 0x220c, a)  /* DOES NOT CONTAIN AS MEMBER */ \
+  X(0x2223, 0x0338, 0x2224, a)  /* DOES NOT DIVIDE */ \
+  X(0x2225, 0x0338, 0x2226, a)  /* NOT PARALLEL TO */ \
+  X(0x223c, 0x0338, 0x2241, a)  /* NOT TILDE */ \
+  X(0x2243, 0x0338, 0x2244, a)  /* NOT ASYMPTOTICALLY EQUAL TO */ \
+  X(0x2245, 0x0338, 0x2247, a)  /* NEITHER APPROXIMATELY NOR ACTUALLY EQUAL TO */ \
+  X(0x2248, 0x0338, 0x2249, a)  /* NOT ALMOST EQUAL TO */ \
+  X(0x224d, 0x0338, 0x226d, a)  /* NOT EQUIVALENT TO */ \
+  X(0x2261, 0x0338, 0x2262, a)  /* NOT IDENTICAL TO */ \
+  X(0x2264, 0x0338, 0x2270, a)  /* NEITHER LESS-THAN NOR EQUAL TO */ \
+  X(0x2265, 0x0338, 0x2271, a)  /* NEITHER GREATER-THAN NOR EQUAL TO */ \
+  X(0x2272, 0x0338, 0x2274, a)  /* NEITHER LESS-THAN NOR EQUIVALENT TO */ \
+  X(0x2273, 0x0338, 0x2275, a)  /* NEITHER GREATER-THAN NOR EQUIVALENT TO */ \
+  X(0x2276, 0x0338, 0x2278, a)  /* NEITHER LESS-THAN NOR GREATER-THAN */ \
+  X(0x2277, 0x0338, 0x2279, a)  /* NEITHER GREATER-THAN NOR LESS-THAN */ \
+  X(0x227a, 0x0338, 0x2280, a)  /* DOES NOT PRECEDE */ \
+  X(0x227b, 0x0338, 0x2281, a)  /* DOES NOT SUCCEED */ \
+  X(0x227c, 0x0338, 0x22e0, a)  /* DOES NOT PRECEDE OR EQUAL */ \
+  X(0x227d, 0x0338, 0x22e1, a)  /* DOES NOT SUCCEED OR EQUAL */ \
+  X(0x2282, 0x0338, 0x2284, a)  /* NOT A SUBSET OF */ \
+  X(0x2283, 0x0338, 0x2285, a)  /* NOT A SUPERSET OF */ \
+  X(0x2286, 0x0338, 0x2288, a)  /* NEITHER A SUBSET OF NOR EQUAL TO */ \
+  X(0x2287, 0x0338, 0x2289, a)  /* NEITHER A SUPERSET OF NOR EQUAL TO */ \
+  X(0x2291, 0x0338, 0x22e2, a)  /* NOT SQUARE IMAGE OF OR EQUAL TO */ \
+  X(0x2292, 0x0338, 0x22e3, a)  /* NOT SQUARE ORIGINAL OF OR EQUAL TO */ \
+  X(0x22a2, 0x0338, 0x22ac, a)  /* DOES NOT PROVE */ \
+  X(0x22a8, 0x0338, 0x22ad, a)  /* NOT TRUE */ \
+  X(0x22a9, 0x0338, 0x22ae, a)  /* DOES NOT FORCE */ \
+  X(0x22ab, 0x0338, 0x22af, a)  /* NEGATED DOUBLE VERTICAL BAR DOUBLE RIGHT TURNSTILE */ \
+  X(0x22b2, 0x0338, 0x22ea, a)  /* NOT NORMAL SUBGROUP OF */ \
+  X(0x22b3, 0x0338, 0x22eb, a)  /* DOES NOT CONTAIN AS NORMAL SUBGROUP */ \
+  X(0x22b4, 0x0338, 0x22ec, a)  /* NOT NORMAL SUBGROUP OF OR EQUAL TO */ \
+  X(0x22b5, 0x0338, 0x22ed, a)  /* DOES NOT CONTAIN AS NORMAL SUBGROUP OR EQUAL */ \
+  X(0x3046, 0x3099, 0x3094, a)  /* HIRAGANA LETTER VU */ \
+  X(0x304b, 0x3099, 0x304c, a)  /* HIRAGANA LETTER GA */ \
+  X(0x304d, 0x3099, 0x304e, a)  /* HIRAGANA LETTER GI */ \
+  X(0x304f, 0x3099, 0x3050, a)  /* HIRAGANA LETTER GU */ \
+  X(0x3051, 0x3099, 0x3052, a)  /* HIRAGANA LETTER GE */ \
+  X(0x3053, 0x3099, 0x3054, a)  /* HIRAGANA LETTER GO */ \
+  X(0x3055, 0x3099, 0x3056, a)  /* HIRAGANA LETTER ZA */ \
+  X(0x3057, 0x3099, 0x3058, a)  /* HIRAGANA LETTER ZI */ \
+  X(0x3059, 0x3099, 0x305a, a)  /* HIRAGANA LETTER ZU */ \
+  X(0x305b, 0x3099, 0x305c, a)  /* HIRAGANA LETTER ZE */ \
+  X(0x305d, 0x3099, 0x305e, a)  /* HIRAGANA LETTER ZO */ \
+  X(0x305f, 0x3099, 0x3060, a)  /* HIRAGANA LETTER DA */ \
+  X(0x3061, 0x3099, 0x3062, a)  /* HIRAGANA LETTER DI */ \
+  X(0x3064, 0x3099, 0x3065, a)  /* HIRAGANA LETTER DU */ \
+  X(0x3066, 0x3099, 0x3067, a)  /* HIRAGANA LETTER DE */ \
+  X(0x3068, 0x3099, 0x3069, a)  /* HIRAGANA LETTER DO */ \
+  X(0x306f, 0x3099, 0x3070, a)  /* HIRAGANA LETTER BA */ \
+  X(0x306f, 0x309a, 0x3071, a)  /* HIRAGANA LETTER PA */ \
+  X(0x3072, 0x3099, 0x3073, a)  /* HIRAGANA LETTER BI */ \
+  X(0x3072, 0x309a, 0x3074, a)  /* HIRAGANA LETTER PI */ \
+  X(0x3075, 0x3099, 0x3076, a)  /* HIRAGANA LETTER BU */ \
+  X(0x3075, 0x309a, 0x3077, a)  /* HIRAGANA LETTER PU */ \
+  X(0x3078, 0x3099, 0x3079, a)  /* HIRAGANA LETTER BE */ \
+  X(0x3078, 0x309a, 0x307a, a)  /* HIRAGANA LETTER PE */ \
+  X(0x307b, 0x3099, 0x307c, a)  /* HIRAGANA LETTER BO */ \
+  X(0x307b, 0x309a, 0x307d, a)  /* HIRAGANA LETTER PO */ \
+  X(0x309d, 0x3099, 0x309e, a)  /* HIRAGANA VOICED ITERATION MARK */ \
+  X(0x30a6, 0x3099, 0x30f4, a)  /* KATAKANA LETTER VU */ \
+  X(0x30ab, 0x3099, 0x30ac, a)  /* KATAKANA LETTER GA */ \
+  X(0x30ad, 0x3099, 0x30ae, a)  /* KATAKANA LETTER GI */ \
+  X(0x30af, 0x3099, 0x30b0, a)  /* KATAKANA LETTER GU */ \
+  X(0x30b1, 0x3099, 0x30b2, a)  /* KATAKANA LETTER GE */ \
+  X(0x30b3, 0x3099, 0x30b4, a)  /* KATAKANA LETTER GO */ \
+  X(0x30b5, 0x3099, 0x30b6, a)  /* KATAKANA LETTER ZA */ \
+  X(0x30b7, 0x3099, 0x30b8, a)  /* KATAKANA LETTER ZI */ \
+  X(0x30b9, 0x3099, 0x30ba, a)  /* KATAKANA LETTER ZU */ \
+  X(0x30bb, 0x3099, 0x30bc, a)  /* KATAKANA LETTER ZE */ \
+  X(0x30bd, 0x3099, 0x30be, a)  /* KATAKANA LETTER ZO */ \
+  X(0x30bf, 0x3099, 0x30c0, a)  /* KATAKANA LETTER DA */ \
+  X(0x30c1, 0x3099, 0x30c2, a)  /* KATAKANA LETTER DI */ \
+  X(0x30c4, 0x3099, 0x30c5, a)  /* KATAKANA LETTER DU */ \
+  X(0x30c6, 0x3099, 0x30c7, a)  /* KATAKANA LETTER DE */ \
+  X(0x30c8, 0x3099, 0x30c9, a)  /* KATAKANA LETTER DO */ \
+  X(0x30cf, 0x3099, 0x30d0, a)  /* KATAKANA LETTER BA */ \
+  X(0x30cf, 0x309a, 0x30d1, a)  /* KATAKANA LETTER PA */ \
+  X(0x30d2, 0x3099, 0x30d3, a)  /* KATAKANA LETTER BI */ \
+  X(0x30d2, 0x309a, 0x30d4, a)  /* KATAKANA LETTER PI */ \
+  X(0x30d5, 0x3099, 0x30d6, a)  /* KATAKANA LETTER BU */ \
+  X(0x30d5, 0x309a, 0x30d7, a)  /* KATAKANA LETTER PU */ \
+  X(0x30d8, 0x3099, 0x30d9, a)  /* KATAKANA LETTER BE */ \
+  X(0x30d8, 0x309a, 0x30da, a)  /* KATAKANA LETTER PE */ \
+  X(0x30db, 0x3099, 0x30dc, a)  /* KATAKANA LETTER BO */ \
+  X(0x30db, 0x309a, 0x30dd, a)  /* KATAKANA LETTER PO */ \
+  X(0x30ef, 0x3099, 0x30f7, a)  /* KATAKANA LETTER VA */ \
+  X(0x30f0, 0x3099, 0x30f8, a)  /* KATAKANA LETTER VI */ \
+  X(0x30f1, 0x3099, 0x30f9, a)  /* KATAKANA LETTER VE */ \
+  X(0x30f2, 0x3099, 0x30fa, a)  /* KATAKANA LETTER VO */ \
+  X(0x30fd, 0x3099, 0x30fe, a)  /* KATAKANA VOICED ITERATION MARK */
+
+/**
+ * @name unicode_composition_count:
+ *   The number of entries in `UNICODE_COMPOSITIONS`.
+ */
+#define unicode_composition_count  (928)
+
+/**
+ * @name UNICODE_COMBINING_CLASSES:
+ *   X-macro listing every range of codepoints in the Basic Multilingual
+ *   Plane with a non-zero canonical combining class, as `X(first, last,
+ *   class, a)`, sorted by `first`. Source and copyright are as above.
+ */
+#define UNICODE_COMBINING_CLASSES(X, a) \
+  X(0x0300, 0x0314, 230, a) \
+  X(0x0315, 0x0315, 232, a) \
+  X(0x0316, 0x0319, 220, a) \
+  X(0x031a, 0x031a, 232, a) \
+  X(0x031b, 0x031b, 216, a) \
+  X(0x031c, 0x0320, 220, a) \
+  X(0x0321, 0x0322, 202, a) \
+  X(0x0323, 0x0326, 220, a) \
+  X(0x0327, 0x0328, 202, a) \
+  X(0x0329, 0x0333, 220, a) \
+  X(0x0334, 0x0338, 1, a) \
+  X(0x0339, 0x033c, 220, a) \
+  X(0x033d, 0x0344, 230, a) \
+  X(0x0345, 0x0345, 240, a) \
+  X(0x0346, 0x0346, 230, a) \
+  X(0x0347, 0x0349, 220, a) \
+  X(0x034a, 0x034c, 230, a) \
+  X(0x034d, 0x034e, 220, a) \
+  X(0x0350, 0x0352, 230, a) \
+  X(0x0353, 0x0356, 220, a) \
+  X(0x0357, 0x0357, 230, a) \
+  X(0x0358, 0x0358, 232, a) \
+  X(0x0359, 0x035a, 220, a) \
+  X(0x035b, 0x035b, 230, a) \
+  X(0x035c, 0x035c, 233, a) \
+  X(0x035d, 0x035e, 234, a) \
+  X(0x035f, 0x035f, 233, a) \
+  X(0x0360, 0x0361, 234, a) \
+  X(0x0362, 0x0362, 233, a) \
+  X(0x0363, 0x036f, 230, a) \
+  X(0x0483, 0x0487, 230, a) \
+  X(0x0591, 0x0591, 220, a) \
+  X(0x0592, 0x0595, 230, a) \
+  X(0x0596, 0x0596, 220, a) \
+  X(0x0597, 0x0599, 230, a) \
+  X(0x059a, 0x059a, 222, a) \
+  X(0x059b, 0x059b, 220, a) \
+  X(0x059c, 0x05a1, 230, a) \
+  X(0x05a2, 0x05a7, 220, a) \
+  X(0x05a8, 0x05a9, 230, a) \
+  X(0x05aa, 0x05aa, 220, a) \
+  X(0x05ab, 0x05ac, 230, a) \
+  X(0x05ad, 0x05ad, 222, a) \
+  X(0x05ae, 0x05ae, 228, a) \
+  X(0x05af, 0x05af, 230, a) \
+  X(0x05b0, 0x05b0, 10, a) \
+  X(0x05b1, 0x05b1, 11, a) \
+  X(0x05b2, 0x05b2, 12, a) \
+  X(0x05b3, 0x05b3, 13, a) \
+  X(0x05b4, 0x05b4, 14, a) \
+  X(0x05b5, 0x05b5, 15, a) \
+  X(0x05b6, 0x05b6, 16, a) \
+  X(0x05b7, 0x05b7, 17, a) \
+  X(0x05b8, 0x05b8, 18, a) \
+  X(0x05b9, 0x05ba, 19, a) \
+  X(0x05bb, 0x05bb, 20, a) \
+  X(0x05bc, 0x05bc, 21, a) \
+  X(0x05bd, 0x05bd, 22, a) \
+  X(0x05bf, 0x05bf, 23, a) \
+  X(0x05c1, 0x05c1, 24, a) \
+  X(0x05c2, 0x05c2, 25, a) \
+  X(0x05c4, 0x05c4, 230, a) \
+  X(0x05c5, 0x05c5, 220, a) \
+  X(0x05c7, 0x05c7, 18, a) \
+  X(0x0610, 0x0617, 230, a) \
+  X(0x0618, 0x0618, 30, a) \
+  X(0x0619, 0x0619, 31, a) \
+  X(0x061a, 0x061a, 32, a) \
+  X(0x064b, 0x064b, 27, a) \
+  X(0x064c, 0x064c, 28, a) \
+  X(0x064d, 0x064d, 29, a) \
+  X(0x064e, 0x064e, 30, a) \
+  X(0x064f, 0x064f, 31, a) \
+  X(0x0650, 0x0650, 32, a) \
+  X(0x0651, 0x0651, 33, a) \
+  X(0x0652, 0x0652, 34, a) \
+  X(0x0653, 0x0654, 230, a) \
+  X(0x0655, 0x0656, 220, a) \
+  X(0x0657, 0x065b, 230, a) \
+  X(0x065c, 0x065c, 220, a) \
+  X(0x065d, 0x065e, 230, a) \
+  X(0x065f, 0x065f, 220, a) \
+  X(0x0670, 0x0670, 35, a) \
+  X(0x06d6, 0x06dc, 230, a) \
+  X(0x06df, 0x06e2, 230, a) \
+  X(0x06e3, 0x06e3, 220, a) \
+  X(0x06e4, 0x06e4, 230, a) \
+  X(0x06e7, 0x06e8, 230, a) \
+  X(0x06ea, 0x06ea, 220, a) \
+  X(0x06eb, 0x06ec, 230, a) \
+  X(0x06ed, 0x06ed, 220, a) \
+  X(0x0711, 0x0711, 36, a) \
+  X(0x0730, 0x0730, 230, a) \
+  X(0x0731, 0x0731, 220, a) \
+  X(0x0732, 0x0733, 230, a) \
+  X(0x0734, 0x0734, 220, a) \
+  X(0x0735, 0x0736, 230, a) \
+  X(0x0737, 0x0739, 220, a) \
+  X(0x073a, 0x073a, 230, a) \
+  X(0x073b, 0x073c, 220, a) \
+  X(0x073d, 0x073d, 230, a) \
+  X(0x073e, 0x073e, 220, a) \
+  X(0x073f, 0x0741, 230, a) \
+  X(0x0742, 0x0742, 220, a) \
+  X(0x0743, 0x0743, 230, a) \
+  X(0x0744, 0x0744, 220, a) \
+  X(0x0745, 0x0745, 230, a) \
+  X(0x0746, 0x0746, 220, a) \
+  X(0x0747, 0x0747, 230, a) \
+  X(0x0748, 0x0748, 220, a) \
+  X(0x0749, 0x074a, 230, a) \
+  X(0x07eb, 0x07f1, 230, a) \
+  X(0x07f2, 0x07f2, 220, a) \
+  X(0x07f3, 0x07f3, 230, a) \
+  X(0x07fd, 0x07fd, 220, a) \
+  X(0x0816, 0x0819, 230, a) \
+  X(0x081b, 0x0823, 230, a) \
+  X(0x0825, 0x0827, 230, a) \
+  X(0x0829, 0x082d, 230, a) \
+  X(0x0859, 0x085b, 220, a) \
+  X(0x0898, 0x0898, 230, a) \
+  X(0x0899, 0x089b, 220, a) \
+  X(0x089c, 0x089f, 230, a) \
+  X(0x08ca, 0x08ce, 230, a) \
+  X(0x08cf, 0x08d3, 220, a) \
+  X(0x08d4, 0x08e1, 230, a) \
+  X(0x08e3, 0x08e3, 220, a) \
+  X(0x08e4, 0x08e5, 230, a) \
+  X(0x08e6, 0x08e6, 220, a) \
+  X(0x08e7, 0x08e8, 230, a) \
+  X(0x08e9, 0x08e9, 220, a) \
+  X(0x08ea, 0x08ec, 230, a) \
+  X(0x08ed, 0x08ef, 220, a) \
+  X(0x08f0, 0x08f0, 27, a) \
+  X(0x08f1, 0x08f1, 28, a) \
+  X(0x08f2, 0x08f2, 29, a) \
+  X(0x08f3, 0x08f5, 230, a) \
+  X(0x08f6, 0x08f6, 220, a) \
+  X(0x08f7, 0x08f8, 230, a) \
+  X(0x08f9, 0x08fa, 220, a) \
+  X(0x08fb, 0x08ff, 230, a) \
+  X(0x093c, 0x093c, 7, a) \
+  X(0x094d, 0x094d, 9, a) \
+  X(0x0951, 0x0951, 230, a) \
+  X(0x0952, 0x0952, 220, a) \
+  X(0x0953, 0x0954, 230, a) \
+  X(0x09bc, 0x09bc, 7, a) \
+  X(0x09cd, 0x09cd, 9, a) \
+  X(0x09fe, 0x09fe, 230, a) \
+  X(0x0a3c, 0x0a3c, 7, a) \
+  X(0x0a4d, 0x0a4d, 9, a) \
+  X(0x0abc, 0x0abc, 7, a) \
+  X(0x0acd, 0x0acd, 9, a) \
+  X(0x0b3c, 0x0b3c, 7, a) \
+  X(0x0b4d, 0x0b4d, 9, a) \
+  X(0x0bcd, 0x0bcd, 9, a) \
+  X(0x0c3c, 0x0c3c, 7, a) \
+  X(0x0c4d, 0x0c4d, 9, a) \
+  X(0x0c55, 0x0c55, 84, a) \
+  X(0x0c56, 0x0c56, 91, a) \
+  X(0x0cbc, 0x0cbc, 7, a) \
+  X(0x0ccd, 0x0ccd, 9, a) \
+  X(0x0d3b, 0x0d3c, 9, a) \
+  X(0x0d4d, 0x0d4d, 9, a) \
+  X(0x0dca, 0x0dca, 9, a) \
+  X(0x0e38, 0x0e39, 103, a) \
+  X(0x0e3a, 0x0e3a, 9, a) \
+  X(0x0e48, 0x0e4b, 107, a) \
+  X(0x0eb8, 0x0eb9, 118, a) \
+  X(0x0eba, 0x0eba, 9, a) \
+  X(0x0ec8, 0x0ecb, 122, a) \
+  X(0x0f18, 0x0f19, 220, a) \
+  X(0x0f35, 0x0f35, 220, a) \
+  X(0x0f37, 0x0f37, 220, a) \
+  X(0x0f39, 0x0f39, 216, a) \
+  X(0x0f71, 0x0f71, 129, a) \
+  X(0x0f72, 0x0f72, 130, a) \
+  X(0x0f74, 0x0f74, 132, a) \
+  X(0x0f7a, 0x0f7d, 130, a) \
+  X(0x0f80, 0x0f80, 130, a) \
+  X(0x0f82, 0x0f83, 230, a) \
+  X(0x0f84, 0x0f84, 9, a) \
+  X(0x0f86, 0x0f87, 230, a) \
+  X(0x0fc6, 0x0fc6, 220, a) \
+  X(0x1037, 0x1037, 7, a) \
+  X(0x1039, 0x103a, 9, a) \
+  X(0x108d, 0x108d, 220, a) \
+  X(0x135d, 0x135f, 230, a) \
+  X(0x1714, 0x1715, 9, a) \
+  X(0x1734, 0x1734, 9, a) \
+  X(0x17d2, 0x17d2, 9, a) \
+  X(0x17dd, 0x17dd, 230, a) \
+  X(0x18a9, 0x18a9, 228, a) \
+  X(0x1939, 0x1939, 222, a) \
+  X(0x193a, 0x193a, 230, a) \
+  X(0x193b, 0x193b, 220, a) \
+  X(0x1a17, 0x1a17, 230, a) \
+  X(0x1a18, 0x1a18, 220, a) \
+  X(0x1a60, 0x1a60, 9, a) \
+  X(0x1a75, 0x1a7c, 230, a) \
+  X(0x1a7f, 0x1a7f, 220, a) \
+  X(0x1ab0, 0x1ab4, 230, a) \
+  X(0x1ab5, 0x1aba, 220, a) \
+  X(0x1abb, 0x1abc, 230, a) \
+  X(0x1abd, 0x1abd, 220, a) \
+  X(0x1abf, 0x1ac0, 220, a) \
+  X(0x1ac1, 0x1ac2, 230, a) \
+  X(0x1ac3, 0x1ac4, 220, a) \
+  X(0x1ac5, 0x1ac9, 230, a) \
+  X(0x1aca, 0x1aca, 220, a) \
+  X(0x1acb, 0x1ace, 230, a) \
+  X(0x1b34, 0x1b34, 7, a) \
+  X(0x1b44, 0x1b44, 9, a) \
+  X(0x1b6b, 0x1b6b, 230, a) \
+  X(0x1b6c, 0x1b6c, 220, a) \
+  X(0x1b6d, 0x1b73, 230, a) \
+  X(0x1baa, 0x1bab, 9, a) \
+  X(0x1be6, 0x1be6, 7, a) \
+  X(0x1bf2, 0x1bf3, 9, a) \
+  X(0x1c37, 0x1c37, 7, a) \
+  X(0x1cd0, 0x1cd2, 230, a) \
+  X(0x1cd4, 0x1cd4, 1, a) \
+  X(0x1cd5, 0x1cd9, 220, a) \
+  X(0x1cda, 0x1cdb, 230, a) \
+  X(0x1cdc, 0x1cdf, 220, a) \
+  X(0x1ce0, 0x1ce0, 230, a) \
+  X(0x1ce2, 0x1ce8, 1, a) \
+  X(0x1ced, 0x1ced, 220, a) \
+  X(0x1cf4, 0x1cf4, 230, a) \
+  X(0x1cf8, 0x1cf9, 230, a) \
+  X(0x1dc0, 0x1dc1, 230, a) \
+  X(0x1dc2, 0x1dc2, 220, a) \
+  X(0x1dc3, 0x1dc9, 230, a) \
+  X(0x1dca, 0x1dca, 220, a) \
+  X(0x1dcb, 0x1dcc, 230, a) \
+  X(0x1dcd, 0x1dcd, 234, a) \
+  X(0x1dce, 0x1dce, 214, a) \
+  X(0x1dcf, 0x1dcf, 220, a) \
+  X(0x1dd0, 0x1dd0, 202, a) \
+  X(0x1dd1, 0x1df5, 230, a) \
+  X(0x1df6, 0x1df6, 232, a) \
+  X(0x1df7, 0x1df8, 228, a) \
+  X(0x1df9, 0x1df9, 220, a) \
+  X(0x1dfa, 0x1dfa, 218, a) \
+  X(0x1dfb, 0x1dfb, 230, a) \
+  X(0x1dfc, 0x1dfc, 233, a) \
+  X(0x1dfd, 0x1dfd, 220, a) \
+  X(0x1dfe, 0x1dfe, 230, a) \
+  X(0x1dff, 0x1dff, 220, a) \
+  X(0x20d0, 0x20d1, 230, a) \
+  X(0x20d2, 0x20d3, 1, a) \
+  X(0x20d4, 0x20d7, 230, a) \
+  X(0x20d8, 0x20da, 1, a) \
+  X(0x20db, 0x20dc, 230, a) \
+  X(0x20e1, 0x20e1, 230, a) \
+  X(0x20e5, 0x20e6, 1, a) \
+  X(0x20e7, 0x20e7, 230, a) \
+  X(0x20e8, 0x20e8, 220, a) \
+  X(0x20e9, 0x20e9, 230, a) \
+  X(0x20ea, 0x20eb, 1, a) \
+  X(0x20ec, 0x20ef, 220, a) \
+  X(0x20f0, 0x20f0, 230, a) \
+  X(0x2cef, 0x2cf1, 230, a) \
+  X(0x2d7f, 0x2d7f, 9, a) \
+  X(0x2de0, 0x2dff, 230, a) \
+  X(0x302a, 0x302a, 218, a) \
+  X(0x302b, 0x302b, 228, a) \
+  X(0x302c, 0x302c, 232, a) \
+  X(0x302d, 0x302d, 222, a) \
+  X(0x302e, 0x302f, 224, a) \
+  X(0x3099, 0x309a, 8, a) \
+  X(0xa66f, 0xa66f, 230, a) \
+  X(0xa674, 0xa67d, 230, a) \
+  X(0xa69e, 0xa69f, 230, a) \
+  X(0xa6f0, 0xa6f1, 230, a) \
+  X(0xa806, 0xa806, 9, a) \
+  X(0xa82c, 0xa82c, 9, a) \
+  X(0xa8c4, 0xa8c4, 9, a) \
+  X(0xa8e0, 0xa8f1, 230, a) \
+  X(0xa92b, 0xa92d, 220, a) \
+  X(0xa953, 0xa953, 9, a) \
+  X(0xa9b3, 0xa9b3, 7, a) \
+  X(0xa9c0, 0xa9c0, 9, a) \
+  X(0xaab0, 0xaab0, 230, a) \
+  X(0xaab2, 0xaab3, 230, a) \
+  X(0xaab4, 0xaab4, 220, a) \
+  X(0xaab7, 0xaab8, 230, a) \
+  X(0xaabe, 0xaabf, 230, a) \
+  X(0xaac1, 0xaac1, 230, a) \
+  X(0xaaf6, 0xaaf6, 9, a) \
+  X(0xabed, 0xabed, 9, a) \
+  X(0xfb1e, 0xfb1e, 26, a) \
+  X(0xfe20, 0xfe26, 230, a) \
+  X(0xfe27, 0xfe2d, 220, a) \
+  X(0xfe2e, 0xfe2f, 230, a)
+
+/**
+ * @name unicode_combining_class_count:
+ *   The number of entries in `UNICODE_COMBINING_CLASSES`.
+ */
+#define unicode_combining_class_count  (295)
+
+/** --- **/
+
+#endif /* __NFC_H__ */
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
@@ -0,0 +1,874 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+
+#include "types.h"
+#include "septet.h"
+#include "encoding.h"
+#include "pdu.h"
+
+/** --- **/
+
+/**
+ * @name pdu_address_international, pdu_address_unknown:
+ *   Type-of-address octets for international and unknown numbers,
+ *   both using the ISDN/telephone numbering plan.
+ */
+#define pdu_address_international   (0x91)
+#define pdu_address_unknown         (0x81)
+
+/**
+ * @name pdu_address_ton_*:
+ *   Values of the type-of-number bits of a type-of-address octet.
+ */
+#define pdu_address_ton_mask          (0x70)
+#define pdu_address_ton_international (0x10)
+#define pdu_address_ton_alphanumeric  (0x50)
+
+/**
+ * @name pdu_flag_*:
+ *   Bits of the first octet of a TPDU. The status report bit is
+ *   TP-SRR in an SMS-SUBMIT, and TP-SRI in an SMS-DELIVER. The
+ *   more-messages bit (TP-MMS) is set when no more messages wait.
+ */
+#define pdu_flag_type_mask        (0x03)
+#define pdu_flag_no_more_messages (0x04)
+#define pdu_flag_validity_mask    (0x18)
+#define pdu_flag_validity_relative (0x10)
+#define pdu_flag_status_report    (0x20)
+#define pdu_flag_udh              (0x40)
+
+/**
+ * @name pdu_udh_*:
+ *   User data header information element identifiers.
+ */
+#define pdu_udh_concatenation     (0x00)
+#define pdu_udh_concatenation_16  (0x08)
+#define pdu_udh_single_shift      (0x24)
+#define pdu_udh_locking_shift     (0x25)
+
+/**
+ * @name pdu_bcd_encode, pdu_bcd_decode:
+ *   Convert a two-digit value to and from "semi-octet" form, in
+ *   which the least significant digit is held in the high nibble.
+ */
+#define pdu_bcd_encode(v) \
+  ((uint8_t) ((((v) % 10) << 4) | (((v) / 10) % 10)))
+
+#define pdu_bcd_decode(o) \
+  (((o) & 0x0f) * 10 + ((o) >> 4))
+
+/**
+ * @name pdu_address_symbols:
+ *   The character for each semi-octet value in an address field.
+ */
+static const char pdu_address_symbols[] = "0123456789*#abc";
+
+/** --- **/
+
+/**
+ * @name pdu_address_symbol_value:
+ *   Return the semi-octet value of the address character `c`,
+ *   or -1 if `c` can't appear in an address.
+ */
+static int pdu_address_symbol_value(char c) {
+
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+
+  switch (c) {
+    case '*':
+      return 0x0a;
+    case '#':
+      return 0x0b;
+    case 'a': case 'A':
+      return 0x0c;
+    case 'b': case 'B':
+      return 0x0d;
+    case 'c': case 'C':
+      return 0x0e;
+  }
+
+  return -1;
+}
+
+/**
+ * @name pdu_encode_address:
+ *   Write the address `s`, of type `type`, to `q`. A service centre
+ *   address (if `is_smsc` is true) has its length given in octets and
+ *   may be empty; any other address has its length given in digits.
+ *   Returns the number of octets written, or zero on failure.
+ */
+static size_t pdu_encode_address(const char *s, uint8_t type,
+                                 boolean_t is_smsc, uint8_t *q) {
+  if (s[0] == '+') {
+    s++;
+  }
+
+  size_t digits = strlen(s);
+
+  if (digits > pdu_address_digits_maximum) {
+    return 0;
+  }
+
+  if (digits == 0) {
+    q[0] = 0;
+    return (is_smsc ? 1 : 0);
+  }
+
+  /* We don't encode alphanumeric addresses */
+  if ((type & pdu_address_ton_mask) == pdu_address_ton_alphanumeric) {
+    return 0;
+  }
+
+  size_t octets = (digits + 1) / 2;
+
+  q[0] = (uint8_t) (is_smsc ? octets + 1 : digits);
+  q[1] = type;
+
+  for (size_t i = 0; i < digits; ++i) {
+
+    int v = pdu_address_symbol_value(s[i]);
+
+    if (v < 0) {
+      return 0;
+    }
+
+    if (i % 2 == 0) {
+      q[2 + i / 2] = (uint8_t) (0xf0 | v);
+    } else {
+      q[2 + i / 2] = (uint8_t) ((q[2 + i / 2] & 0x0f) | (v << 4));
+    }
+  }
+
+  return octets + 2;
+}
+
+/**
+ * @name pdu_decode_address:
+ *   Decode the address of type `type` that begins at `p`, and holds
+ *   at most `nibbles` semi-octets, in to `out`. Alphanumeric addresses
+ *   are packed GSM 7-bit characters, and are converted to UTF-8.
+ */
+static void pdu_decode_address(const uint8_t *p, size_t nibbles,
+                               uint8_t type, char *out) {
+
+  if ((type & pdu_address_ton_mask) == pdu_address_ton_alphanumeric) {
+
+    uint8_t septets[(pdu_address_digits_maximum * 4) / 7];
+    char utf16[2 * (sizeof(septets) + 1)];
+
+    size_t count = (nibbles * 4) / 7;
+
+    septets_unpack(p, count, 0, septets);
+    size_t units = gsm_decode_utf16be(septets, count, 0, 0, utf16);
+
+    if (convert_utf8_utf16be_slice_into(utf16be_slice_units(utf16, units),
+          TRUE, out, pdu_address_buffer_size) == 0) {
+      out[0] = '\0';
+    }
+
+    return;
+  }
+
+  if ((type & pdu_address_ton_mask) == pdu_address_ton_international) {
+    *out++ = '+';
+  }
+
+  for (size_t i = 0; i < nibbles; ++i) {
+
+    unsigned int v = (i % 2 == 0 ? p[i / 2] & 0x0f : p[i / 2] >> 4);
+
+    if (v == 0x0f) {
+      break;
+    }
+
+    *out++ = pdu_address_symbols[v];
+  }
+
+  *out = '\0';
+}
+
+/**
+ * @name pdu_data_coding_scheme:
+ *   Return the TP-DCS octet that describes the coding and class of `m`.
+ */
+static uint8_t pdu_data_coding_scheme(const pdu_message_t *m) {
+
+  uint8_t rv = (uint8_t) (m->coding << 2);
+
+  if (m->message_class >= 0) {
+    rv |= (uint8_t) (0x10 | (m->message_class & 0x03));
+  }
+
+  return rv;
+}
+
+/**
+ * @name pdu_decode_data_coding_scheme:
+ *   Set the coding and class of `m` from the TP-DCS octet `dcs`, as
+ *   described in 3GPP TS 23.038, section 4. Returns false if `dcs`
+ *   indicates compressed user data, which we don't support.
+ */
+static boolean_t pdu_decode_data_coding_scheme(uint8_t dcs,
+                                               pdu_message_t *m) {
+  unsigned int group = (dcs >> 4);
+
+  m->coding = PDU_CODING_GSM;
+  m->message_class = -1;
+
+  if (group < 0x08) {
+
+    /* General data coding, with or without automatic deletion */
+    if (dcs & 0x20) {
+      return FALSE;
+    }
+
+    unsigned int alphabet = (dcs >> 2) & 0x03;
+    m->coding = (alphabet == 3 ? PDU_CODING_8BIT : alphabet);
+
+    if (dcs & 0x10) {
+      m->message_class = (dcs & 0x03);
+    }
+
+  } else if (group == 0x0e) {
+
+    /* Message waiting indication, UCS-2 */
+    m->coding = PDU_CODING_UCS2;
+
+  } else if (group == 0x0f) {
+
+    /* Data coding and message class */
+    m->coding = (dcs & 0x04 ? PDU_CODING_8BIT : PDU_CODING_GSM);
+    m->message_class = (dcs & 0x03);
+  }
+
+  return TRUE;
+}
+
+/**
+ * @name pdu_build_udh:
+ *   Build the user data header for `m` in `udh`, starting with its
+ *   length octet. National language shift elements are included only
+ *   for GSM 7-bit messages. Returns the length of the header in
+ *   octets, including the length octet, or zero if `m` needs none.
+ */
+static size_t pdu_build_udh(const pdu_message_t *m, uint8_t *udh) {
+
+  size_t h = 1;
+  const pdu_concatenation_t *c = &m->concatenation;
+
+  if (c->parts > 0) {
+
+    if (c->is_16bit) {
+      udh[h++] = pdu_udh_concatenation_16;
+      udh[h++] = 4;
+      udh[h++] = (uint8_t) (c->reference >> 8);
+    } else {
+      udh[h++] = pdu_udh_concatenation;
+      udh[h++] = 3;
+    }
+
+    udh[h++] = (uint8_t) (c->reference & 0xff);
+    udh[h++] = c->parts;
+    udh[h++] = c->part;
+  }
+
+  if (m->coding == PDU_CODING_GSM && m->locking) {
+    udh[h++] = pdu_udh_locking_shift;
+    udh[h++] = 1;
+    udh[h++] = gsm_language_identifier(m->locking);
+  }
+
+  if (m->coding == PDU_CODING_GSM && m->single) {
+    udh[h++] = pdu_udh_single_shift;
+    udh[h++] = 1;
+    udh[h++] = gsm_language_identifier(m->single);
+  }
+
+  if (h == 1) {
+    return 0;
+  }
+
+  udh[0] = (uint8_t) (h - 1);
+  return h;
+}
+
+/**
+ * @name pdu_decode_udh:
+ *   Parse the `length`-octet user data header at `p`, which begins
+ *   with its length octet, and record the information elements that
+ *   we understand in `m`. Unknown elements are skipped. Returns false
+ *   if an element extends past the end of the header.
+ */
+static boolean_t pdu_decode_udh(const uint8_t *p, size_t length,
+                                pdu_message_t *m) {
+  size_t i = 1;
+
+  memcpy(m->udh, p, length);
+  m->udh_length = length;
+
+  while (i < length) {
+
+    if (i + 2 > length || i + 2 + p[i + 1] > length) {
+      return FALSE;
+    }
+
+    uint8_t id = p[i], n = p[i + 1];
+    const uint8_t *v = &p[i + 2];
+
+    pdu_concatenation_t *c = &m->concatenation;
+
+    switch (id) {
+
+      case pdu_udh_concatenation:
+        if (n == 3) {
+          c->is_16bit = FALSE;
+          c->reference = v[0];
+          c->parts = v[1];
+          c->part = v[2];
+        }
+        break;
+
+      case pdu_udh_concatenation_16:
+        if (n == 4) {
+          c->is_16bit = TRUE;
+          c->reference = (uint16_t) ((v[0] << 8) | v[1]);
+          c->parts = v[2];
+          c->part = v[3];
+        }
+        break;
+
+      case pdu_udh_locking_shift:
+      case pdu_udh_single_shift:
+        if (n == 1) {
+          int l = gsm_language_index(v[0]);
+          if (l > 0 && id == pdu_udh_locking_shift) {
+            m->locking = (unsigned int) l;
+          } else if (l > 0) {
+            m->single = (unsigned int) l;
+          }
+        }
+        break;
+    }
+
+    i += 2 + n;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @name pdu_split_pass:
+ *   Split `text` as described for `pdu_split_utf16be`, using the
+ *   capacity of either a single or a concatenated message, without
+ *   filling in any concatenation information. Returns the number of
+ *   parts written, or zero if more than `maximum` would be needed.
+ */
+static unsigned int pdu_split_pass(const pdu_message_t *base,
+                                   const char *text,
+                                   const gsm_national_info_t *n,
+                                   boolean_t is_multipart,
+                                   pdu_message_t *parts,
+                                   unsigned int maximum) {
+  size_t capacity;
+  unsigned int rv = 0;
+  const char *p = text;
+
+  if (n) {
+    capacity = sms_gsm_septet_capacity(
+      gsm_national_shift_elements(n), is_multipart
+    );
+  } else {
+    capacity = (
+      is_multipart ? sms_ucs2_multipart_units : sms_ucs2_single_units
+    );
+  }
+
+  /* An empty message still has one part */
+  do {
+
+    if (rv >= maximum) {
+      return 0;
+    }
+
+    pdu_message_t *m = &parts[rv++];
+
+    *m = *base;
+    m->concatenation.parts = 0;
+
+    if (n) {
+
+      m->coding = PDU_CODING_GSM;
+      m->locking = n->locking;
+      m->single = n->single;
+      m->length = utf16be_encode_gsm_part(&p, n, capacity, m->data);
+
+      /* Unrepresentable character */
+      if (m->length == 0 && (p[0] || p[1])) {
+        return 0;
+      }
+
+    } else {
+
+      size_t units = 0;
+      const uint8_t *u = (const uint8_t *) p;
+
+      m->coding = PDU_CODING_UCS2;
+      m->locking = m->single = 0;
+
+      while (u[2 * units] || u[2 * units + 1]) {
+
+        size_t width = 1;
+        const uint8_t *c = &u[2 * units];
+
+        /* Keep surrogate pairs together */
+        if (c[0] >= 0xd8 && c[0] <= 0xdb && c[2] >= 0xdc && c[2] <= 0xdf) {
+          width = 2;
+        }
+
+        if (units + width > capacity) {
+          break;
+        }
+
+        units += width;
+      }
+
+      memcpy(m->data, p, 2 * units);
+      m->length = 2 * units;
+      p += 2 * units;
+    }
+
+  } while (p[0] || p[1]);
+
+  return rv;
+}
+
+/** --- **/
+
+/**
+ * @name pdu_initialize:
+ */
+pdu_message_t *pdu_initialize(pdu_message_t *m, pdu_type_t type) {
+
+  memset(m, 0, sizeof(*m));
+
+  m->type = type;
+  m->address_type = pdu_address_unknown;
+  m->coding = PDU_CODING_GSM;
+  m->message_class = -1;
+  m->validity = -1;
+
+  return m;
+}
+
+/**
+ * @name pdu_set_address:
+ */
+boolean_t pdu_set_address(pdu_message_t *m, string_slice_t s) {
+
+  boolean_t is_international = (s.length > 0 && s.data[0] == '+');
+  size_t digits = s.length - (is_international ? 1 : 0);
+
+  if (digits == 0 || digits > pdu_address_digits_maximum) {
+    return FALSE;
+  }
+
+  for (size_t i = (is_international ? 1 : 0); i < s.length; ++i) {
+    if (pdu_address_symbol_value(s.data[i]) < 0) {
+      return FALSE;
+    }
+  }
+
+  memcpy(m->address, s.data, s.length);
+  m->address[s.length] = '\0';
+
+  m->address_type = (
+    is_international ? pdu_address_international : pdu_address_unknown
+  );
+
+  return TRUE;
+}
+
+/**
+ * @name pdu_split_utf16be:
+ */
+unsigned int pdu_split_utf16be(const pdu_message_t *base, const char *text,
+                               const gsm_national_info_t *n,
+                               uint8_t reference, pdu_message_t *parts,
+                               unsigned int maximum) {
+
+  /* Try a single part first:
+      A concatenation header reduces the capacity of every part,
+      so it's only added once we know that one part isn't enough. */
+
+  if (maximum > 0 && pdu_split_pass(base, text, n, FALSE, parts, 1) == 1) {
+    return 1;
+  }
+
+  unsigned int rv = pdu_split_pass(base, text, n, TRUE, parts, maximum);
+
+  for (unsigned int i = 0; i < rv; ++i) {
+    pdu_concatenation_t *c = &parts[i].concatenation;
+    c->reference = reference;
+    c->is_16bit = FALSE;
+    c->parts = (uint8_t) rv;
+    c->part = (uint8_t) (i + 1);
+  }
+
+  return rv;
+}
+
+/**
+ * @name pdu_encode:
+ */
+size_t pdu_encode(const pdu_message_t *m, uint8_t *out, size_t *tpdu_length) {
+
+  size_t n;
+  uint8_t *q = out;
+  uint8_t udh[sms_user_data_octets];
+
+  /* Service centre address */
+  if (!(n = pdu_encode_address(m->smsc, m->smsc_type, TRUE, q))) {
+    return 0;
+  }
+
+  q += n;
+  uint8_t *tpdu = q;
+
+  /* First octet */
+  size_t udh_length = pdu_build_udh(m, udh);
+  uint8_t first = (uint8_t) m->type;
+
+  if (udh_length > 0) {
+    first |= pdu_flag_udh;
+  }
+
+  if (m->status_report) {
+    first |= pdu_flag_status_report;
+  }
+
+  if (m->type == PDU_SUBMIT) {
+
+    if (m->validity >= 0) {
+      first |= pdu_flag_validity_relative;
+    }
+
+    *q++ = first;
+    *q++ = m->reference;
+
+  } else {
+
+    *q++ = (first | pdu_flag_no_more_messages);
+  }
+
+  /* Destination or originating address */
+  if (!(n = pdu_encode_address(m->address, m->address_type, FALSE, q))) {
+    return 0;
+  }
+
+  q += n;
+
+  *q++ = m->protocol;
+  *q++ = pdu_data_coding_scheme(m);
+
+  /* Validity period or service centre timestamp */
+  if (m->type == PDU_SUBMIT) {
+
+    if (m->validity >= 0) {
+      *q++ = (uint8_t) (m->validity & 0xff);
+    }
+
+  } else {
+
+    const pdu_timestamp_t *t = &m->timestamp;
+    unsigned int tz = (t->timezone < 0 ? -t->timezone : t->timezone);
+
+    *q++ = pdu_bcd_encode(t->year);
+    *q++ = pdu_bcd_encode(t->month);
+    *q++ = pdu_bcd_encode(t->day);
+    *q++ = pdu_bcd_encode(t->hour);
+    *q++ = pdu_bcd_encode(t->minute);
+    *q++ = pdu_bcd_encode(t->second);
+    *q++ = (uint8_t) (pdu_bcd_encode(tz) | (t->timezone < 0 ? 0x08 : 0));
+  }
+
+  /* User data:
+      For GSM 7-bit messages, the user data length is in septets, and
+      counts the header as if it were septets too; fill bits follow the
+      header so that the first character starts on a septet boundary. */
+
+  if (m->coding == PDU_CODING_GSM) {
+
+    unsigned int fill = septet_fill_bits(udh_length);
+    size_t header_septets = (udh_length * 8 + fill) / 7;
+
+    if (m->length > sms_gsm_single_septets ||
+        udh_length + septet_packed_length(m->length, fill)
+          > sms_user_data_octets) {
+      return 0;
+    }
+
+    *q++ = (uint8_t) (header_septets + m->length);
+
+    memcpy(q, udh, udh_length);
+    q += udh_length;
+    q += septets_pack(m->data, m->length, fill, q);
+
+  } else {
+
+    if (udh_length + m->length > sms_user_data_octets) {
+      return 0;
+    }
+
+    *q++ = (uint8_t) (udh_length + m->length);
+
+    memcpy(q, udh, udh_length);
+    q += udh_length;
+    memcpy(q, m->data, m->length);
+    q += m->length;
+  }
+
+  if (tpdu_length) {
+    *tpdu_length = (q - tpdu);
+  }
+
+  return (q - out);
+}
+
+/**
+ * @name pdu_decode:
+ */
+boolean_t pdu_decode(const uint8_t *p, size_t length, pdu_message_t *m) {
+
+  const uint8_t *end = p + length;
+
+  #define pdu_require(n) \
+    do { if ((size_t) (end - p) < (size_t) (n)) return FALSE; } while (0)
+
+  pdu_initialize(m, PDU_DELIVER);
+
+  /* Service centre address:
+      The length is in octets, and includes the type octet. */
+
+  pdu_require(1);
+  size_t smsc_octets = *p++;
+
+  if (smsc_octets > 1 + pdu_address_digits_maximum / 2) {
+    return FALSE;
+  }
+
+  pdu_require(smsc_octets);
+
+  if (smsc_octets > 0) {
+    m->smsc_type = p[0];
+    pdu_decode_address(p + 1, 2 * (smsc_octets - 1), p[0], m->smsc);
+  }
+
+  p += smsc_octets;
+
+  /* First octet, and message reference */
+  pdu_require(1);
+  uint8_t first = *p++;
+
+  switch (first & pdu_flag_type_mask) {
+    case PDU_DELIVER:
+      m->type = PDU_DELIVER;
+      break;
+    case PDU_SUBMIT:
+      m->type = PDU_SUBMIT;
+      pdu_require(1);
+      m->reference = *p++;
+      break;
+    default:
+      return FALSE;
+  }
+
+  m->status_report = !!(first & pdu_flag_status_report);
+
+  /* Address:
+      The length is in semi-octets, and excludes the type octet. */
+
+  pdu_require(2);
+  size_t digits = p[0];
+  size_t address_octets = (digits + 1) / 2;
+
+  if (digits > pdu_address_digits_maximum) {
+    return FALSE;
+  }
+
+  pdu_require(2 + address_octets);
+  m->address_type = p[1];
+  pdu_decode_address(p + 2, digits, p[1], m->address);
+  p += 2 + address_octets;
+
+  /* Protocol identifier, data coding scheme */
+  pdu_require(2);
+  m->protocol = *p++;
+
+  if (!pdu_decode_data_coding_scheme(*p++, m)) {
+    return FALSE;
+  }
+
+  /* Validity period or service centre timestamp */
+  if (m->type == PDU_SUBMIT) {
+
+    switch (first & pdu_flag_validity_mask) {
+      case 0:
+        break;
+      case pdu_flag_validity_relative:
+        pdu_require(1);
+        m->validity = *p++;
+        break;
+      default:
+        /* Enhanced or absolute; not retained */
+        pdu_require(7);
+        p += 7;
+        break;
+    }
+
+  } else {
+
+    pdu_timestamp_t *t = &m->timestamp;
+
+    pdu_require(7);
+    t->year = pdu_bcd_decode(p[0]);
+    t->month = pdu_bcd_decode(p[1]);
+    t->day = pdu_bcd_decode(p[2]);
+    t->hour = pdu_bcd_decode(p[3]);
+    t->minute = pdu_bcd_decode(p[4]);
+    t->second = pdu_bcd_decode(p[5]);
+    t->timezone = pdu_bcd_decode(p[6] & 0xf7);
+
+    if (p[6] & 0x08) {
+      t->timezone = -t->timezone;
+    }
+
+    p += 7;
+  }
+
+  /* User data */
+  pdu_require(1);
+  size_t udl = *p++;
+  size_t udh_length = 0;
+
+  if (m->coding == PDU_CODING_GSM) {
+
+    size_t octets = septet_packed_length(udl, 0);
+
+    if (udl > sms_gsm_single_septets) {
+      return FALSE;
+    }
+
+    pdu_require(octets);
+
+    if (first & pdu_flag_udh) {
+
+      if (octets < 1 || (udh_length = p[0] + 1) > octets) {
+        return FALSE;
+      }
+
+      if (!pdu_decode_udh(p, udh_length, m)) {
+        return FALSE;
+      }
+    }
+
+    unsigned int fill = septet_fill_bits(udh_length);
+    size_t header_septets = (udh_length * 8 + fill) / 7;
+
+    if (header_septets > udl) {
+      return FALSE;
+    }
+
+    m->length = udl - header_septets;
+    septets_unpack(p + udh_length, m->length, fill, m->data);
+
+  } else {
+
+    if (udl > sms_user_data_octets) {
+      return FALSE;
+    }
+
+    pdu_require(udl);
+
+    if (first & pdu_flag_udh) {
+
+      if (udl < 1 || (udh_length = p[0] + 1) > udl) {
+        return FALSE;
+      }
+
+      if (!pdu_decode_udh(p, udh_length, m)) {
+        return FALSE;
+      }
+    }
+
+    m->length = udl - udh_length;
+    memcpy(m->data, p + udh_length, m->length);
+  }
+
+  #undef pdu_require
+
+  return TRUE;
+}
+
+/**
+ * @name pdu_text_utf16be:
+ */
+size_t pdu_text_utf16be(const pdu_message_t *m, char *out) {
+
+  size_t units = 0;
+
+  switch (m->coding) {
+
+    case PDU_CODING_GSM:
+      return gsm_decode_utf16be(
+        m->data, m->length, m->locking, m->single, out
+      );
+
+    case PDU_CODING_UCS2:
+      units = m->length / 2;
+      memcpy(out, m->data, 2 * units);
+      break;
+
+    default:
+      break;
+  }
+
+  out[2 * units] = out[2 * units + 1] = '\0';
+  return units;
+}
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
@@ -0,0 +1,228 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "types.h"
+#include "encoding.h"
+
+#ifndef __PDU_H__
+#define __PDU_H__
+
+/** --- **/
+
+/**
+ * @name pdu_address_digits_maximum:
+ *   The largest number of digits in a 3GPP TS 23.040 address field.
+ */
+#define pdu_address_digits_maximum  (20)
+
+/**
+ * @name pdu_address_buffer_size:
+ *   The size of a buffer that can hold any decoded address as
+ *   null-terminated UTF-8, including an alphanumeric address.
+ */
+#define pdu_address_buffer_size     (48)
+
+/**
+ * @name pdu_octets_maximum:
+ *   The largest encoded PDU, in octets: a twelve-octet service centre
+ *   address, followed by a TPDU holding a twelve-octet address, a
+ *   seven-octet validity period, and a full user data field.
+ */
+#define pdu_octets_maximum          (176)
+
+/**
+ * @name pdu_type_t:
+ *   The message type indicator (TP-MTI) of a PDU.
+ */
+typedef enum {
+  PDU_DELIVER = 0, PDU_SUBMIT = 1
+} pdu_type_t;
+
+/**
+ * @name pdu_coding_t:
+ *   The character set of a PDU's user data, with values matching
+ *   bits 2 and 3 of a general data coding scheme (TP-DCS) octet.
+ */
+typedef enum {
+  PDU_CODING_GSM = 0, PDU_CODING_8BIT = 1, PDU_CODING_UCS2 = 2
+} pdu_coding_t;
+
+/**
+ * @name pdu_timestamp_t:
+ *   A service centre timestamp (TP-SCTS). The `year` has two digits,
+ *   and `timezone` is the offset from UTC, in quarter-hours.
+ */
+typedef struct pdu_timestamp {
+
+  unsigned int year;
+  unsigned int month;
+  unsigned int day;
+  unsigned int hour;
+  unsigned int minute;
+  unsigned int second;
+  int timezone;
+
+} pdu_timestamp_t;
+
+/**
+ * @name pdu_concatenation_t:
+ *   The concatenation information element of a user data header.
+ *   If `parts` is zero, the message isn't concatenated.
+ */
+typedef struct pdu_concatenation {
+
+  uint16_t reference;
+  boolean_t is_16bit;
+
+  uint8_t parts;
+  uint8_t part;
+
+} pdu_concatenation_t;
+
+/**
+ * @name pdu_message_t:
+ *   A single SMS-SUBMIT or SMS-DELIVER message. Addresses are held
+ *   as null-terminated UTF-8, with a leading `+` for international
+ *   numbers; an empty service centre address selects the device's
+ *   default. The user data holds one unpacked septet per byte when
+ *   `coding` is `PDU_CODING_GSM`, otherwise octets (big-endian
+ *   UTF-16 for `PDU_CODING_UCS2`); `length` counts septets or octets
+ *   respectively, and excludes the user data header. The header is
+ *   built from `concatenation`, `locking` and `single` when encoding;
+ *   when decoding, those fields are filled in, and the raw header
+ *   (including its length octet) is also copied to `udh`.
+ */
+typedef struct pdu_message {
+
+  pdu_type_t type;
+
+  char smsc[pdu_address_buffer_size];
+  uint8_t smsc_type;
+
+  char address[pdu_address_buffer_size];
+  uint8_t address_type;
+
+  uint8_t reference;
+  uint8_t protocol;
+  boolean_t status_report;
+
+  pdu_coding_t coding;
+  int message_class;
+  int validity;
+
+  pdu_timestamp_t timestamp;
+  pdu_concatenation_t concatenation;
+
+  unsigned int locking;
+  unsigned int single;
+
+  size_t udh_length;
+  uint8_t udh[sms_user_data_octets];
+
+  size_t length;
+  uint8_t data[sms_gsm_single_septets];
+
+} pdu_message_t;
+
+/** --- **/
+
+/**
+ * @name pdu_initialize:
+ *   Reset `m` to an empty message of the given `type`: no service
+ *   centre address, no message class or validity period, GSM 7-bit
+ *   coding, and no user data. Returns `m`.
+ */
+pdu_message_t *pdu_initialize(pdu_message_t *m, pdu_type_t type);
+
+/**
+ * @name pdu_set_address:
+ *   Set the destination (or originating) address of `m` from the
+ *   phone number in `s`, which may contain only digits, `*` and `#`,
+ *   optionally preceded by `+` to mark an international number.
+ *   Returns false, leaving `m` unchanged, if `s` isn't a valid number.
+ */
+boolean_t pdu_set_address(pdu_message_t *m, string_slice_t s);
+
+/**
+ * @name pdu_split_utf16be:
+ *   Split the big-endian UTF-16 string `text` in to as many parts as
+ *   necessary, writing each part to `parts` as a copy of `base` with
+ *   its user data and concatenation information filled in. If `n` is
+ *   non-null, the text is encoded using the GSM tables it selects,
+ *   and every character of `text` must be representable using them;
+ *   otherwise, the text is encoded as UCS-2, without splitting any
+ *   surrogate pair. Concatenated parts carry the 8-bit `reference`.
+ *   Returns the number of parts written, or zero if more than
+ *   `maximum` parts would be needed.
+ */
+unsigned int pdu_split_utf16be(const pdu_message_t *base, const char *text,
+                               const gsm_national_info_t *n,
+                               uint8_t reference, pdu_message_t *parts,
+                               unsigned int maximum);
+
+/**
+ * @name pdu_encode:
+ *   Encode `m` as a binary PDU in `out`, which must have room for
+ *   `pdu_octets_maximum` octets. The PDU begins with the service
+ *   centre address, as expected by AT+CMGS and most other senders;
+ *   if `tpdu_length` is non-null, the length of the remainder (the
+ *   TPDU) is stored there. Returns the total number of octets
+ *   written, or zero if the message can't be encoded.
+ */
+size_t pdu_encode(const pdu_message_t *m, uint8_t *out, size_t *tpdu_length);
+
+/**
+ * @name pdu_decode:
+ *   Decode the `length`-octet binary PDU at `p`, which begins with a
+ *   service centre address, in to `m`. Returns false if the PDU is
+ *   truncated, malformed, of a type other than SMS-SUBMIT or
+ *   SMS-DELIVER, or uses compressed user data.
+ */
+boolean_t pdu_decode(const uint8_t *p, size_t length, pdu_message_t *m);
+
+/**
+ * @name pdu_text_utf16be:
+ *   Convert the user data of the decoded text message `m` to
+ *   null-terminated big-endian UTF-16 in `out`, using the national
+ *   language tables given by its header. The buffer `out` must have
+ *   room for `2 * (sms_gsm_single_septets + 1)` bytes. Returns the
+ *   number of code units written, excluding the terminator.
+ */
+size_t pdu_text_utf16be(const pdu_message_t *m, char *out);
+
+/** --- **/
+
+#endif /* __PDU_H__ */
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
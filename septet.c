@@ -0,0 +1,504 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+  #include <immintrin.h>
+  #define SEPTET_X86_SIMD (1)
+#endif
+
+#include "cpu.h"
+#include "types.h"
+#include "septet.h"
+
+/**
+ * Packing layout:
+ *
+ *   Septet `n` occupies bits `fill + 7n` through `fill + 7n + 6`
+ *   of the packed bit stream, where bit zero is the least
+ *   significant bit of the first octet. Every run of eight septets
+ *   therefore forms a 56-bit group that starts at octet `7 * (n / 8)`
+ *   and is shifted left by `fill` bits; the top `fill` bits of each
+ *   group spill into the first octet of the next one. Both the
+ *   scalar and the vectorized routines below work a group at a
+ *   time, and may hand off to one another at any group boundary.
+ */
+
+/** --- **/
+
+/**
+ * @name septet_group_offset:
+ *   The octet offset of the group that contains septet `n`.
+ */
+#define septet_group_offset(n) (((n) / 8) * 7)
+
+/**
+ * @name septet_carry:
+ *   The bits of septet `s` that spill over into the following
+ *   group's first octet, when packing with `fill` bits of padding.
+ */
+#define septet_carry(s, fill) \
+  ((fill) > 0 ? (uint64_t) ((s) & 0x7f) >> (7 - (fill)) : 0)
+
+/** --- **/
+
+/**
+ * @name septets_pack_scalar:
+ *   Portable implementation of `septets_pack`, starting at septet
+ *   `i`. The value of `i` must be a multiple of eight, and all
+ *   septets prior to `i` must already have been packed into `out`.
+ */
+static void septets_pack_scalar(const uint8_t *s, size_t i, size_t count,
+                                unsigned int fill, uint8_t *out) {
+
+  unsigned int j, bits = fill;
+  uint8_t *q = out + septet_group_offset(i);
+  uint64_t acc = (i > 0 ? septet_carry(s[i - 1], fill) : 0);
+
+  /* Whole groups of eight septets */
+  while (count - i >= 8) {
+
+    uint64_t g = 0;
+
+    for (j = 0; j < 8; j++) {
+      g |= (uint64_t) (s[i + j] & 0x7f) << (7 * j);
+    }
+
+    acc |= g << bits;
+
+    for (j = 0; j < 7; j++) {
+      q[j] = (uint8_t) (acc >> (8 * j));
+    }
+
+    acc >>= 56; q += 7; i += 8;
+  }
+
+  /* Remaining septets */
+  while (i < count) {
+
+    acc |= (uint64_t) (s[i++] & 0x7f) << bits;
+    bits += 7;
+
+    if (bits >= 8) {
+      *q++ = (uint8_t) acc;
+      acc >>= 8; bits -= 8;
+    }
+  }
+
+  if (count > 0 && bits > 0) {
+    *q = (uint8_t) acc;
+  }
+}
+
+/**
+ * @name septets_unpack_scalar:
+ *   Portable implementation of `septets_unpack`, starting at septet
+ *   `i`. The value of `i` must be a multiple of eight.
+ */
+static void septets_unpack_scalar(const uint8_t *p, size_t i, size_t count,
+                                  unsigned int fill, uint8_t *out) {
+
+  unsigned int j;
+  size_t length = septet_packed_length(count, fill);
+
+  /* Whole groups, while a full eight-octet read is in bounds */
+  while (count - i >= 8 && septet_group_offset(i) + 8 <= length) {
+
+    uint64_t v = 0;
+    const uint8_t *g = p + septet_group_offset(i);
+
+    for (j = 0; j < 8; j++) {
+      v |= (uint64_t) g[j] << (8 * j);
+    }
+
+    v >>= fill;
+
+    for (j = 0; j < 8; j++) {
+      out[i + j] = (uint8_t) ((v >> (7 * j)) & 0x7f);
+    }
+
+    i += 8;
+  }
+
+  /* Remaining septets */
+  while (i < count) {
+
+    size_t bit = fill + 7 * i;
+    size_t offset = bit / 8;
+    unsigned int v = p[offset];
+
+    if (offset + 1 < length) {
+      v |= (unsigned int) p[offset + 1] << 8;
+    }
+
+    out[i++] = (uint8_t) ((v >> (bit % 8)) & 0x7f);
+  }
+}
+
+/** --- **/
+
+#ifdef SEPTET_X86_SIMD
+
+/**
+ * @name septets_group_ssse3:
+ *   Combine the sixteen septets in `v` into two 56-bit groups, one
+ *   in each 64-bit lane, by merging adjacent fields of doubling
+ *   width: 7 + 7 bits in 16-bit lanes, 14 + 14 bits in 32-bit
+ *   lanes, and finally 28 + 28 bits in 64-bit lanes.
+ */
+__attribute__((target("ssse3")))
+static __m128i septets_group_ssse3(__m128i v) {
+
+  v = _mm_and_si128(v, _mm_set1_epi8(0x7f));
+
+  v = _mm_or_si128(
+    _mm_and_si128(v, _mm_set1_epi16(0x007f)),
+    _mm_and_si128(_mm_srli_epi16(v, 1), _mm_set1_epi16(0x3f80))
+  );
+
+  v = _mm_or_si128(
+    _mm_and_si128(v, _mm_set1_epi32(0x00003fff)),
+    _mm_and_si128(_mm_srli_epi32(v, 2), _mm_set1_epi32(0x0fffc000))
+  );
+
+  return _mm_or_si128(
+    _mm_and_si128(v, _mm_set1_epi64x(0x000000000fffffffLL)),
+    _mm_and_si128(_mm_srli_epi64(v, 4), _mm_set1_epi64x(0x00fffffff0000000LL))
+  );
+}
+
+/**
+ * @name septets_ungroup_ssse3:
+ *   The inverse of `septets_group_ssse3`. Bits above the low 56
+ *   bits of each 64-bit lane are ignored.
+ */
+__attribute__((target("ssse3")))
+static __m128i septets_ungroup_ssse3(__m128i v) {
+
+  v = _mm_or_si128(
+    _mm_and_si128(v, _mm_set1_epi64x(0x000000000fffffffLL)),
+    _mm_and_si128(_mm_slli_epi64(v, 4), _mm_set1_epi64x(0x0fffffff00000000LL))
+  );
+
+  v = _mm_or_si128(
+    _mm_and_si128(v, _mm_set1_epi32(0x00003fff)),
+    _mm_and_si128(_mm_slli_epi32(v, 2), _mm_set1_epi32(0x3fff0000))
+  );
+
+  return _mm_or_si128(
+    _mm_and_si128(v, _mm_set1_epi16(0x007f)),
+    _mm_and_si128(_mm_slli_epi16(v, 1), _mm_set1_epi16(0x7f00))
+  );
+}
+
+/**
+ * @name septets_pack_ssse3:
+ *   SSSE3 implementation of `septets_pack`; packs sixteen septets
+ *   into fourteen octets per iteration. Each group is shifted left
+ *   by `fill` bits and merged with the spill-over from the group
+ *   before it, then the two seven-octet groups are made contiguous
+ *   with a byte shuffle. Returns the index of the first septet that
+ *   was not packed; the caller finishes the remainder.
+ */
+__attribute__((target("ssse3")))
+static size_t septets_pack_ssse3(const uint8_t *s, size_t i, size_t count,
+                                 unsigned int fill, uint8_t *out) {
+
+  size_t length = septet_packed_length(count, fill);
+
+  const __m128i left = _mm_cvtsi32_si128((int) fill);
+  const __m128i right = _mm_cvtsi32_si128((int) (56 - fill));
+
+  const __m128i compact = _mm_setr_epi8(
+    0, 1, 2, 3, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, -1, -1
+  );
+
+  /* Upper lane holds the previous group; only its top bits matter */
+  __m128i prev = _mm_set_epi64x(
+    (long long) (i > 0 ? (uint64_t) (s[i - 1] & 0x7f) << 49 : 0), 0
+  );
+
+  while (count - i >= 16 && septet_group_offset(i) + 16 <= length) {
+
+    __m128i g = septets_group_ssse3(
+      _mm_loadu_si128((const __m128i *) (s + i))
+    );
+
+    /* Lanes: previous group's last, this group's first */
+    __m128i p = _mm_alignr_epi8(g, prev, 8);
+
+    __m128i u = _mm_or_si128(
+      _mm_sll_epi64(g, left), _mm_srl_epi64(p, right)
+    );
+
+    _mm_storeu_si128(
+      (__m128i *) (out + septet_group_offset(i)),
+        _mm_shuffle_epi8(u, compact)
+    );
+
+    prev = g; i += 16;
+  }
+
+  return i;
+}
+
+/**
+ * @name septets_unpack_ssse3:
+ *   SSSE3 implementation of `septets_unpack`; unpacks sixteen
+ *   septets from fourteen octets per iteration. Returns the index
+ *   of the first septet that was not unpacked.
+ */
+__attribute__((target("ssse3")))
+static size_t septets_unpack_ssse3(const uint8_t *p, size_t i, size_t count,
+                                   unsigned int fill, uint8_t *out) {
+
+  size_t length = septet_packed_length(count, fill);
+  const __m128i right = _mm_cvtsi32_si128((int) fill);
+
+  /* Moves each seven-octet group into its own 64-bit lane */
+  const __m128i spread = _mm_setr_epi8(
+    0, 1, 2, 3, 4, 5, 6, 7, 7, 8, 9, 10, 11, 12, 13, 14
+  );
+
+  while (count - i >= 16 && septet_group_offset(i) + 16 <= length) {
+
+    __m128i v = _mm_loadu_si128(
+      (const __m128i *) (p + septet_group_offset(i))
+    );
+
+    v = _mm_srl_epi64(_mm_shuffle_epi8(v, spread), right);
+    _mm_storeu_si128((__m128i *) (out + i), septets_ungroup_ssse3(v));
+
+    i += 16;
+  }
+
+  return i;
+}
+
+/**
+ * @name septets_group_avx2:
+ *   AVX2 version of `septets_group_ssse3`; produces four groups.
+ */
+__attribute__((target("avx2")))
+static __m256i septets_group_avx2(__m256i v) {
+
+  v = _mm256_and_si256(v, _mm256_set1_epi8(0x7f));
+
+  v = _mm256_or_si256(
+    _mm256_and_si256(v, _mm256_set1_epi16(0x007f)),
+    _mm256_and_si256(_mm256_srli_epi16(v, 1), _mm256_set1_epi16(0x3f80))
+  );
+
+  v = _mm256_or_si256(
+    _mm256_and_si256(v, _mm256_set1_epi32(0x00003fff)),
+    _mm256_and_si256(_mm256_srli_epi32(v, 2), _mm256_set1_epi32(0x0fffc000))
+  );
+
+  return _mm256_or_si256(
+    _mm256_and_si256(v, _mm256_set1_epi64x(0x000000000fffffffLL)),
+    _mm256_and_si256(
+      _mm256_srli_epi64(v, 4), _mm256_set1_epi64x(0x00fffffff0000000LL)
+    )
+  );
+}
+
+/**
+ * @name septets_ungroup_avx2:
+ *   AVX2 version of `septets_ungroup_ssse3`.
+ */
+__attribute__((target("avx2")))
+static __m256i septets_ungroup_avx2(__m256i v) {
+
+  v = _mm256_or_si256(
+    _mm256_and_si256(v, _mm256_set1_epi64x(0x000000000fffffffLL)),
+    _mm256_and_si256(
+      _mm256_slli_epi64(v, 4), _mm256_set1_epi64x(0x0fffffff00000000LL)
+    )
+  );
+
+  v = _mm256_or_si256(
+    _mm256_and_si256(v, _mm256_set1_epi32(0x00003fff)),
+    _mm256_and_si256(_mm256_slli_epi32(v, 2), _mm256_set1_epi32(0x3fff0000))
+  );
+
+  return _mm256_or_si256(
+    _mm256_and_si256(v, _mm256_set1_epi16(0x007f)),
+    _mm256_and_si256(_mm256_slli_epi16(v, 1), _mm256_set1_epi16(0x7f00))
+  );
+}
+
+/**
+ * @name septets_pack_avx2:
+ *   AVX2 implementation of `septets_pack`; packs thirty-two septets
+ *   into twenty-eight octets per iteration. The remainder is left to
+ *   the scalar code rather than `septets_pack_ssse3`: calling legacy
+ *   SSE code from here would incur an AVX-SSE transition penalty
+ *   that costs more, on short messages, than the remainder itself.
+ */
+__attribute__((target("avx2")))
+static size_t septets_pack_avx2(const uint8_t *s, size_t i, size_t count,
+                                unsigned int fill, uint8_t *out) {
+
+  size_t length = septet_packed_length(count, fill);
+
+  const __m128i left = _mm_cvtsi32_si128((int) fill);
+  const __m128i right = _mm_cvtsi32_si128((int) (56 - fill));
+
+  const __m256i compact = _mm256_setr_epi8(
+    0, 1, 2, 3, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, -1, -1,
+    0, 1, 2, 3, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, -1, -1
+  );
+
+  /* Lowest lane holds the previous group; only its top bits matter */
+  __m256i prev = _mm256_set_epi64x(
+    0, 0, 0, (long long) (i > 0 ? (uint64_t) (s[i - 1] & 0x7f) << 49 : 0)
+  );
+
+  while (count - i >= 32 && septet_group_offset(i) + 30 <= length) {
+
+    uint8_t *q = out + septet_group_offset(i);
+
+    __m256i g = septets_group_avx2(
+      _mm256_loadu_si256((const __m256i *) (s + i))
+    );
+
+    /* Lanes: previous group's last, then this group's first three */
+    __m256i p = _mm256_blend_epi32(
+      _mm256_permute4x64_epi64(g, _MM_SHUFFLE(2, 1, 0, 3)), prev, 0x03
+    );
+
+    __m256i u = _mm256_shuffle_epi8(
+      _mm256_or_si256(
+        _mm256_sll_epi64(g, left), _mm256_srl_epi64(p, right)
+      ),
+      compact
+    );
+
+    /* The second store overwrites the first store's two spare octets */
+    _mm_storeu_si128((__m128i *) q, _mm256_castsi256_si128(u));
+    _mm_storeu_si128((__m128i *) (q + 14), _mm256_extracti128_si256(u, 1));
+
+    prev = _mm256_permute4x64_epi64(g, _MM_SHUFFLE(3, 3, 3, 3));
+    i += 32;
+  }
+
+  return i;
+}
+
+/**
+ * @name septets_unpack_avx2:
+ *   AVX2 implementation of `septets_unpack`; unpacks thirty-two
+ *   septets from twenty-eight octets per iteration. The remainder
+ *   is left to the scalar code, as in `septets_pack_avx2`.
+ */
+__attribute__((target("avx2")))
+static size_t septets_unpack_avx2(const uint8_t *p, size_t i, size_t count,
+                                  unsigned int fill, uint8_t *out) {
+
+  size_t length = septet_packed_length(count, fill);
+  const __m128i right = _mm_cvtsi32_si128((int) fill);
+
+  const __m256i spread = _mm256_setr_epi8(
+    0, 1, 2, 3, 4, 5, 6, 7, 7, 8, 9, 10, 11, 12, 13, 14,
+    0, 1, 2, 3, 4, 5, 6, 7, 7, 8, 9, 10, 11, 12, 13, 14
+  );
+
+  while (count - i >= 32 && septet_group_offset(i) + 30 <= length) {
+
+    const uint8_t *g = p + septet_group_offset(i);
+
+    __m256i v = _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) g)),
+        _mm_loadu_si128((const __m128i *) (g + 14)), 1
+    );
+
+    v = _mm256_srl_epi64(_mm256_shuffle_epi8(v, spread), right);
+    _mm256_storeu_si256((__m256i *) (out + i), septets_ungroup_avx2(v));
+
+    i += 32;
+  }
+
+  return i;
+}
+
+#endif /* SEPTET_X86_SIMD */
+
+/** --- **/
+
+/**
+ * @name septets_pack:
+ */
+size_t septets_pack(const uint8_t *septets, size_t count,
+                    unsigned int fill_bits, uint8_t *out) {
+
+  size_t i = 0;
+
+  #ifdef SEPTET_X86_SIMD
+    unsigned int features = cpu_features();
+
+    if (features & CPU_AVX2) {
+      i = septets_pack_avx2(septets, i, count, fill_bits, out);
+    } else if (features & CPU_SSSE3) {
+      i = septets_pack_ssse3(septets, i, count, fill_bits, out);
+    }
+  #endif
+
+  septets_pack_scalar(septets, i, count, fill_bits, out);
+  return septet_packed_length(count, fill_bits);
+}
+
+/**
+ * @name septets_unpack:
+ */
+size_t septets_unpack(const uint8_t *octets, size_t count,
+                      unsigned int fill_bits, uint8_t *out) {
+
+  size_t i = 0;
+
+  #ifdef SEPTET_X86_SIMD
+    unsigned int features = cpu_features();
+
+    if (features & CPU_AVX2) {
+      i = septets_unpack_avx2(octets, i, count, fill_bits, out);
+    } else if (features & CPU_SSSE3) {
+      i = septets_unpack_ssse3(octets, i, count, fill_bits, out);
+    }
+  #endif
+
+  septets_unpack_scalar(octets, i, count, fill_bits, out);
+  return count;
+}
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
@@ -0,0 +1,91 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "types.h"
+
+#ifndef __SEPTET_H__
+#define __SEPTET_H__
+
+/** --- **/
+
+/**
+ * @name septet_packed_length:
+ *   The number of octets occupied by `septets` packed GSM 7-bit
+ *   characters, when the packed data is preceded by `fill_bits`
+ *   zero bits of padding (see `septet_fill_bits`). Padding on its
+ *   own never occupies an octet: zero septets require zero octets.
+ */
+#define septet_packed_length(septets, fill_bits) \
+  ((septets) > 0 ? \
+    ((size_t) (fill_bits) + 7 * (size_t) (septets) + 7) / 8 : 0)
+
+/**
+ * @name septet_fill_bits:
+ *   The number of zero bits that must follow a user data header of
+ *   `udh_octets` octets (including the length octet itself), so that
+ *   the first packed septet begins on a septet boundary. This is the
+ *   alignment rule from 3GPP TS 23.040, section 9.2.3.24.
+ */
+#define septet_fill_bits(udh_octets) \
+  ((7 - (((size_t) (udh_octets) * 8) % 7)) % 7)
+
+/**
+ * @name septets_pack:
+ *   Pack `count` GSM 7-bit characters from `septets` into `out`,
+ *   least significant bit first, after `fill_bits` (at most six)
+ *   zero bits of padding. Only the low seven bits of each input
+ *   byte are used. The buffer `out` must have room for at least
+ *   `septet_packed_length(count, fill_bits)` octets; this function
+ *   returns that same value. Vector instructions are used when the
+ *   processor supports them.
+ */
+size_t septets_pack(const uint8_t *septets, size_t count,
+                    unsigned int fill_bits, uint8_t *out);
+
+/**
+ * @name septets_unpack:
+ *   Unpack `count` GSM 7-bit characters from `octets`, skipping
+ *   `fill_bits` (at most six) bits of leading padding. The buffer
+ *   `octets` must contain at least `septet_packed_length(count,
+ *   fill_bits)` octets, and `out` must have room for `count` bytes.
+ *   Each output byte holds one septet. Returns `count`.
+ */
+size_t septets_unpack(const uint8_t *octets, size_t count,
+                      unsigned int fill_bits, uint8_t *out);
+
+/** --- **/
+
+#endif /* __SEPTET_H__ */
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
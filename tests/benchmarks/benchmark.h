@@ -0,0 +1,88 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <time.h>
+#include <stdio.h>
+
+#include "types.h"
+
+#ifndef __BENCHMARK_H__
+#define __BENCHMARK_H__
+
+/**
+ * @name benchmark_now:
+ *   Return the current value of the monotonic clock, in seconds.
+ */
+static inline double benchmark_now(void) {
+
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (ts.tv_sec + ts.tv_nsec / 1e9);
+}
+
+/**
+ * @name benchmark_report:
+ *   Print a single result line: the name of the benchmark, the
+ *   number of `iterations` that completed in `elapsed` seconds,
+ *   and the resulting rate per second.
+ */
+static inline void benchmark_report(const char *name,
+                                    unsigned long iterations,
+                                    double elapsed) {
+
+  printf(
+    "%-40s %10lu iterations in %8.3fs  %14.1f/s\n",
+      name, iterations, elapsed, iterations / elapsed
+  );
+}
+
+/**
+ * @name benchmark_report_bytes:
+ *   Like `benchmark_report`, but also prints throughput in
+ *   megabytes per second, given `bytes` processed per iteration.
+ */
+static inline void benchmark_report_bytes(const char *name,
+                                          unsigned long iterations,
+                                          size_t bytes, double elapsed) {
+
+  printf(
+    "%-40s %10lu iterations in %8.3fs  %10.1f MB/s\n",
+      name, iterations, elapsed, (iterations * (double) bytes) / elapsed / 1e6
+  );
+}
+
+#endif /* __BENCHMARK_H__ */
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
@@ -0,0 +1,114 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+
+#include <iconv.h>
+#include <string.h>
+
+#include "allocate.h"
+#include "encoding.h"
+#include "benchmark.h"
+
+/** --- **/
+
+#define benchmark_iterations (200000)
+
+/** --- **/
+
+/**
+ * @name convert_uncached:
+ *   Equivalent to `convert_utf8_utf16be(s, FALSE)` prior to the
+ *   introduction of cached conversion descriptors: opens and closes
+ *   an iconv descriptor for every single conversion.
+ */
+char *convert_uncached(char *s) {
+
+  iconv_t iv = iconv_open("UTF-16BE", "UTF-8");
+
+  if (iv == (iconv_t) -1) {
+    return NULL;
+  }
+
+  size_t len = strlen(s);
+  char *rv = allocate_array(4, len, 1);
+
+  char *fp = s, *tp = rv;
+  size_t in = len, out = 4 * len;
+
+  if (iconv(iv, &fp, &in, &tp, &out) == (size_t) -1) {
+    free(rv);
+    rv = NULL;
+  } else {
+    tp[0] = tp[1] = '\0';
+  }
+
+  iconv_close(iv);
+  return rv;
+}
+
+/**
+ * @name main:
+ */
+int main(int argc, char *argv[]) {
+
+  char *s = "This is a simple test message. This is only a test.";
+
+  double start = benchmark_now();
+
+  for (unsigned long i = 0; i < benchmark_iterations; ++i) {
+    free(convert_uncached(s));
+  }
+
+  benchmark_report(
+    "iconv_open per conversion (before)",
+      benchmark_iterations, benchmark_now() - start
+  );
+
+  start = benchmark_now();
+
+  for (unsigned long i = 0; i < benchmark_iterations; ++i) {
+    free(convert_utf8_utf16be(s, FALSE));
+  }
+
+  benchmark_report(
+    "cached descriptor (after), now native",
+      benchmark_iterations, benchmark_now() - start
+  );
+
+  release_conversion_descriptors();
+  return 0;
+}
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
@@ -0,0 +1,181 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+
+#include <string.h>
+
+#include "cpu.h"
+#include "json.h"
+#include "allocate.h"
+#include "benchmark.h"
+#include "json_index.h"
+
+/** --- **/
+
+/**
+ * @name level_t:
+ */
+typedef struct level {
+  const char *name;
+  unsigned int features;
+} level_t;
+
+/**
+ * @name levels:
+ */
+static const level_t levels[] = {
+  { "scalar", CPU_NONE },
+  { "sse2", CPU_SSE2 },
+  { "avx2", CPU_ALL }
+};
+
+/** --- **/
+
+/**
+ * @name build_command:
+ *   Build a single-line `send` command of about `size` bytes, made
+ *   of phone number and message pairs with `text_length`-byte texts.
+ *   Every fourth text has an escape sequence, as JSON encoders emit
+ *   for quotes and non-ASCII characters.
+ */
+static char *build_command(size_t size, size_t text_length) {
+
+  char *rv = allocate_array(sizeof(char), size + text_length + 128, 1);
+  char *text = allocate_array(sizeof(char), text_length, 1);
+
+  for (size_t i = 0; i < text_length; ++i) {
+    text[i] = 'a' + (i % 26);
+  }
+
+  text[text_length] = '\0';
+
+  size_t n = sprintf(rv, "{ \"command\": \"send\", \"arguments\": [ ");
+
+  for (unsigned int i = 0; n < size; ++i) {
+    n += sprintf(
+      rv + n, "%s\"+1503555%04u\", \"%s%s\"", (i ? ", " : ""),
+        i % 10000, (i % 4 ? "" : "\\u00e9\\\""), text
+    );
+  }
+
+  sprintf(rv + n, " ] }");
+
+  free(text);
+  return rv;
+}
+
+/**
+ * @name run:
+ *   Tokenize a command of about `size` bytes `iterations` times,
+ *   with jsmn alone and via the structural index at every dispatch
+ *   level. Stage one is also reported on its own.
+ */
+void run(const char *label, size_t size,
+         size_t text_length, unsigned long iterations) {
+
+  char name[64];
+  jsmn_parser parser;
+  json_index_t x = { NULL, 0, 0, 0 };
+  unsigned int n = json_parser_tokens_maximum;
+
+  char *json = build_command(size, text_length);
+  size_t length = strlen(json);
+
+  jsmn_compact_t *tokens = allocate_array(sizeof(jsmn_compact_t), n, 0);
+
+  printf("%s: %zu bytes\n", label, length);
+
+  /* Reference: jsmn alone */
+  double start = benchmark_now();
+
+  for (unsigned long i = 0; i < iterations; ++i) {
+    jsmn_init(&parser);
+    if (jsmn_parse_compact(&parser, json, tokens, n) != JSMN_SUCCESS) {
+      fprintf(stderr, "Parse failed for %s\n", label);
+      return;
+    }
+  }
+
+  benchmark_report_bytes("  jsmn", iterations, length, benchmark_now() - start);
+
+  for (unsigned int l = 0; l < sizeof(levels) / sizeof(*levels); ++l) {
+
+    cpu_features_restrict(levels[l].features);
+
+    /* Stage one only */
+    start = benchmark_now();
+
+    for (unsigned long i = 0; i < iterations; ++i) {
+      json_index_build(&x, json, length);
+    }
+
+    snprintf(name, sizeof(name), "  index, %s", levels[l].name);
+    benchmark_report_bytes(name, iterations, length, benchmark_now() - start);
+
+    /* Both stages */
+    start = benchmark_now();
+
+    for (unsigned long i = 0; i < iterations; ++i) {
+      json_index_build(&x, json, length);
+      if (json_index_tokenize(&x, &parser, json, tokens, n) != JSMN_SUCCESS) {
+        fprintf(stderr, "Indexed parse failed for %s\n", label);
+        return;
+      }
+    }
+
+    snprintf(name, sizeof(name), "  index and tokens, %s", levels[l].name);
+    benchmark_report_bytes(name, iterations, length, benchmark_now() - start);
+  }
+
+  cpu_features_restrict(CPU_ALL);
+
+  json_index_release(&x);
+  free(tokens);
+  free(json);
+}
+
+/**
+ * @name main:
+ */
+int main(int argc, char *argv[]) {
+
+  run("64 KB", 64 * 1024, 160, 5000);
+  run("1 MB", 1024 * 1024, 160, 300);
+  run("10 MB", 10 * 1024 * 1024, 1024, 30);
+
+  return 0;
+}
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
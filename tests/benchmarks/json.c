@@ -0,0 +1,179 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+
+#include <string.h>
+
+#include "json.h"
+#include "allocate.h"
+#include "benchmark.h"
+
+/** --- **/
+
+/**
+ * @name legacy_tokens_maximum:
+ *   The token limit used by `parse_json`; the benchmark's lines are
+ *   sized to fit within it.
+ */
+#define legacy_tokens_maximum (32768)
+
+/**
+ * @name legacy_parse_json:
+ *   The previous tokenizer loop, kept here for comparison: on
+ *   `JSMN_ERROR_NOMEM`, it quadruples the token array, marks every
+ *   token invalid, and reparses the whole string from the start.
+ *   Returns the number of passes made, or zero on failure.
+ */
+static unsigned int legacy_parse_json(char *json, jsmntok_t **tokens) {
+
+  jsmn_parser parser;
+  unsigned int passes = 0, n = 32;
+
+  for (;;) {
+
+    if (n > legacy_tokens_maximum) {
+      return 0;
+    }
+
+    jsmn_init(&parser);
+    *tokens = reallocate_array(*tokens, sizeof(jsmntok_t), n, 0);
+
+    for (unsigned int i = 0; i < n; ++i) {
+      jsmn_mark_token_invalid(&(*tokens)[i]);
+    }
+
+    passes++;
+    jsmnerr_t result = jsmn_parse(&parser, json, *tokens, n);
+
+    if (result == JSMN_ERROR_NOMEM) {
+      n *= 4;
+      continue;
+    }
+
+    return (result < 0 ? 0 : passes);
+  }
+}
+
+/**
+ * @name build_command:
+ *   Build a single-line `send` command of about `size` bytes, made
+ *   of phone number and message pairs with `text_length`-byte texts.
+ */
+static char *build_command(size_t size, size_t text_length) {
+
+  char *rv = allocate_array(sizeof(char), size + text_length + 128, 1);
+  char *text = allocate_array(sizeof(char), text_length, 1);
+
+  for (size_t i = 0; i < text_length; ++i) {
+    text[i] = 'a' + (i % 26);
+  }
+
+  text[text_length] = '\0';
+
+  size_t n = sprintf(rv, "{ \"command\": \"send\", \"arguments\": [ ");
+
+  for (unsigned int i = 0; n < size; ++i) {
+    n += sprintf(
+      rv + n, "%s\"+1503555%04u\", \"%s\"", (i ? ", " : ""), i % 10000, text
+    );
+  }
+
+  sprintf(rv + n, " ] }");
+
+  free(text);
+  return rv;
+}
+
+/**
+ * @name run:
+ */
+void run(const char *label, size_t size,
+         size_t text_length, unsigned long iterations) {
+
+  char name[64];
+  jsmntok_t *tokens = NULL;
+  unsigned int passes = 0;
+
+  char *json = build_command(size, text_length);
+  size_t length = strlen(json);
+
+  /* Resumable, single-pass tokenizer */
+  double start = benchmark_now();
+
+  for (unsigned long i = 0; i < iterations; ++i) {
+
+    parsed_json_t *p = parse_json(json);
+
+    if (!p) {
+      fprintf(stderr, "Parse failed for %s\n", label);
+      return;
+    }
+
+    release_parsed_json(p);
+  }
+
+  snprintf(name, sizeof(name), "%s, single pass", label);
+  benchmark_report_bytes(name, iterations, length, benchmark_now() - start);
+
+  /* Previous reparse-on-growth tokenizer */
+  start = benchmark_now();
+
+  for (unsigned long i = 0; i < iterations; ++i) {
+    if (!(passes = legacy_parse_json(json, &tokens))) {
+      fprintf(stderr, "Legacy parse failed for %s\n", label);
+      return;
+    }
+  }
+
+  snprintf(name, sizeof(name), "%s, reparse (%u passes)", label, passes);
+  benchmark_report_bytes(name, iterations, length, benchmark_now() - start);
+
+  free(tokens);
+  free(json);
+}
+
+/**
+ * @name main:
+ */
+int main(int argc, char *argv[]) {
+
+  run("1 KB", 1024, 40, 200000);
+  run("1 MB", 1024 * 1024, 160, 100);
+  run("10 MB", 10 * 1024 * 1024, 1024, 10);
+
+  return 0;
+}
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
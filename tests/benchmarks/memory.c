@@ -0,0 +1,165 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+#include "allocate.h"
+#include "encoding.h"
+#include "benchmark.h"
+
+/** --- **/
+
+#define benchmark_messages  (2000)
+#define benchmark_units     (1530)
+
+/** --- **/
+
+/**
+ * @name encode_json_worst_case:
+ *   Equivalent to `utf16be_encode_json_utf8` prior to exact-size
+ *   allocation: reserves six bytes for every code unit.
+ */
+char *encode_json_worst_case(const char *s) {
+
+  size_t units = utf16be_length(s);
+  char *rv = allocate_array(6, units, 1);
+
+  utf16be_encode_json_utf8_into(s, rv, 6 * units + 1);
+  return rv;
+}
+
+/**
+ * @name convert_worst_case:
+ *   Equivalent to `convert_utf8_utf16be(s, TRUE)` prior to exact-size
+ *   allocation: reserves four bytes for every code unit.
+ */
+char *convert_worst_case(const char *s) {
+
+  size_t units = utf16be_length(s);
+  char *rv = allocate_array(4, units, 1);
+
+  convert_utf8_utf16be_into(s, TRUE, rv, 4 * units + 1);
+  return rv;
+}
+
+/**
+ * @name encode_json_exact:
+ */
+char *encode_json_exact(const char *s) {
+
+  return utf16be_encode_json_utf8(s);
+}
+
+/**
+ * @name convert_exact:
+ */
+char *convert_exact(const char *s) {
+
+  return convert_utf8_utf16be((char *) s, TRUE);
+}
+
+/**
+ * @name peak_rss:
+ *   Run `fn` on `s` once for each of `benchmark_messages` messages in
+ *   a child process, keeping every result alive, as a retrieve of a
+ *   full phone memory would. Returns the child's peak RSS in kilobytes.
+ */
+long peak_rss(char *(*fn)(const char *), const char *s) {
+
+  pid_t pid = fork();
+
+  if (pid == 0) {
+
+    char **results = allocate_array(sizeof(char *), benchmark_messages, 0);
+
+    for (unsigned int i = 0; fn && i < benchmark_messages; ++i) {
+      results[i] = fn(s);
+    }
+
+    _exit(0);
+  }
+
+  int status;
+  struct rusage usage;
+
+  wait4(pid, &status, 0, &usage);
+  return usage.ru_maxrss;
+}
+
+/**
+ * @name main:
+ */
+int main(int argc, char *argv[]) {
+
+  /* A ten-part Latin message */
+  char *s = allocate_array(2, benchmark_units, 1);
+
+  for (size_t i = 0; i < benchmark_units; ++i) {
+    s[2 * i] = '\0';
+    s[2 * i + 1] = (i % 6 == 5 ? ' ' : 'a' + (i % 26));
+  }
+
+  s[2 * benchmark_units] = s[2 * benchmark_units + 1] = '\0';
+
+  long baseline = peak_rss(NULL, s);
+
+  printf(
+    "%u messages of %u code units; peak RSS above baseline (%ld KB):\n",
+      benchmark_messages, benchmark_units, baseline
+  );
+
+  const char *format = "  %-36s %8ld KB\n";
+
+  printf(format, "json, six bytes per unit (before)",
+         peak_rss(encode_json_worst_case, s) - baseline);
+
+  printf(format, "json, exact (after)",
+         peak_rss(encode_json_exact, s) - baseline);
+
+  printf(format, "utf-8, four bytes per unit (before)",
+         peak_rss(convert_worst_case, s) - baseline);
+
+  printf(format, "utf-8, exact (after)",
+         peak_rss(convert_exact, s) - baseline);
+
+  free(s);
+  return 0;
+}
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
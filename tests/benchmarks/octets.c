@@ -0,0 +1,142 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+
+#include <string.h>
+
+#include "cpu.h"
+#include "allocate.h"
+#include "encoding.h"
+#include "benchmark.h"
+
+/** --- **/
+
+/**
+ * @name level_t:
+ */
+typedef struct level {
+  const char *name;
+  unsigned int features;
+} level_t;
+
+/**
+ * @name levels:
+ */
+static const level_t levels[] = {
+  { "scalar", CPU_NONE },
+  { "ssse3", CPU_SSE2 | CPU_SSSE3 },
+  { "avx2", CPU_ALL }
+};
+
+/** --- **/
+
+/**
+ * @name run:
+ *   Encode `length` octets as hexadecimal and as base64,
+ *   `iterations` times, at every dispatch level.
+ */
+void run(const char *label, size_t length, unsigned long iterations) {
+
+  char name[64];
+  uint32_t seed = 0x5eed;
+
+  uint8_t *p = allocate_array(sizeof(uint8_t), length, 0);
+  uint8_t *d = allocate_array(sizeof(uint8_t), length, 1);
+  char *b = allocate_array(sizeof(char), 2 * length, 1);
+
+  for (size_t i = 0; i < length; ++i) {
+    seed = seed * 1103515245 + 12345;
+    p[i] = (uint8_t) (seed >> 16);
+  }
+
+  printf("%s: %zu octets\n", label, length);
+
+  for (unsigned int l = 0; l < sizeof(levels) / sizeof(*levels); ++l) {
+
+    cpu_features_restrict(levels[l].features);
+    double start = benchmark_now();
+
+    for (unsigned long i = 0; i < iterations; ++i) {
+      octets_encode_hex(p, length, b);
+    }
+
+    snprintf(name, sizeof(name), "  hex, %s", levels[l].name);
+    benchmark_report_bytes(name, iterations, length, benchmark_now() - start);
+
+    if (hex_decode_octets(utf8_slice(b), d, length) != (ssize_t) length
+          || memcmp(p, d, length) != 0) {
+      fprintf(stderr, "Hexadecimal round trip failed at %s\n", name);
+      return;
+    }
+
+    start = benchmark_now();
+
+    for (unsigned long i = 0; i < iterations; ++i) {
+      octets_encode_base64(p, length, b);
+    }
+
+    snprintf(name, sizeof(name), "  base64, %s", levels[l].name);
+    benchmark_report_bytes(name, iterations, length, benchmark_now() - start);
+
+    if (base64_decode_octets(utf8_slice(b), d, length) != (ssize_t) length
+          || memcmp(p, d, length) != 0) {
+      fprintf(stderr, "Base64 round trip failed at %s\n", name);
+      return;
+    }
+  }
+
+  cpu_features_restrict(CPU_ALL);
+
+  free(p);
+  free(d);
+  free(b);
+}
+
+/**
+ * @name main:
+ */
+int main(int argc, char *argv[]) {
+
+  /* A single 8-bit part, and one part of a concatenated message */
+  run("single part", 140, 2000000);
+  run("concatenated part", 134, 2000000);
+
+  /* Bulk throughput */
+  run("bulk", 1024 * 1024, 200);
+
+  return 0;
+}
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
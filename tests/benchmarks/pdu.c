@@ -0,0 +1,140 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+
+#include <string.h>
+
+#include "allocate.h"
+#include "encoding.h"
+#include "pdu.h"
+#include "benchmark.h"
+
+/** --- **/
+
+#define benchmark_iterations (200000)
+
+/** --- **/
+
+/**
+ * @name fill_text:
+ *   Fill `b` with `symbols` copies of the UTF-8 character `c`, cycled
+ *   with spaces, followed by a null terminator. Returns `b`.
+ */
+char *fill_text(char *b, size_t symbols, const char *c) {
+
+  size_t n = strlen(c), len = 0;
+
+  for (size_t i = 0; i < symbols; ++i) {
+    const char *s = (i % 6 == 5 ? " " : c);
+    size_t l = (i % 6 == 5 ? 1 : n);
+    memcpy(b + len, s, l);
+    len += l;
+  }
+
+  b[len] = '\0';
+  return b;
+}
+
+/**
+ * @name run:
+ *   Encode `text` to hexadecimal SMS-SUBMIT PDUs, as the `encode`
+ *   command does: convert and classify it, split it in to parts,
+ *   encode each part, and convert each PDU to hexadecimal.
+ */
+void run(const char *label, const char *text) {
+
+  string_info_t si;
+  sms_segment_info_t seg;
+  pdu_message_t base, parts[8];
+  gsm_national_info_t none;
+
+  uint8_t b[pdu_octets_maximum];
+  char hex[2 * pdu_octets_maximum + 1];
+
+  unsigned long octets = 0;
+  unsigned int count = 0;
+
+  memset(&none, 0, sizeof(none));
+  pdu_initialize(&base, PDU_SUBMIT);
+  pdu_set_address(&base, utf8_slice("+15035551212"));
+
+  double start = benchmark_now();
+
+  for (unsigned long i = 0; i < benchmark_iterations; ++i) {
+
+    char *u = utf8_preflight((char *) text, &si, &seg);
+    boolean_t is_gsm = (seg.non_gsm_offset < 0);
+
+    count = pdu_split_utf16be(
+      &base, u, (is_gsm ? &none : NULL), (uint8_t) i, parts, 8
+    );
+
+    for (unsigned int j = 0; j < count; ++j) {
+      size_t length = pdu_encode(&parts[j], b, NULL);
+      octets += octets_encode_hex(b, length, hex);
+    }
+
+    free(u);
+  }
+
+  double elapsed = benchmark_now() - start;
+
+  printf(
+    "%s: %zu bytes, %u parts, %lu hex digits per message\n",
+      label, si.bytes, count, octets / benchmark_iterations
+  );
+
+  benchmark_report("  messages", benchmark_iterations, elapsed);
+  benchmark_report("  parts", benchmark_iterations * count, elapsed);
+}
+
+/**
+ * @name main:
+ */
+int main(int argc, char *argv[]) {
+
+  char *b = allocate(8192);
+
+  run("gsm, 1 part", fill_text(b, 150, "a"));
+  run("gsm, 3 parts", fill_text(b, 450, "a"));
+  run("gsm extension, 2 parts", fill_text(b, 150, "{"));
+  run("ucs-2, 1 part", fill_text(b, 60, "\xd0\x96"));
+  run("ucs-2, 3 parts", fill_text(b, 200, "\xd0\x96"));
+
+  free(b);
+  return 0;
+}
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
@@ -0,0 +1,152 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+
+#include <string.h>
+
+#include "allocate.h"
+#include "encoding.h"
+#include "benchmark.h"
+
+/** --- **/
+
+#define benchmark_iterations (100000)
+
+/** --- **/
+
+/**
+ * @name fill_text:
+ *   Fill `b` with `symbols` copies of the UTF-8 character `c`, cycled
+ *   with spaces, followed by a null terminator. Returns `b`.
+ */
+char *fill_text(char *b, size_t symbols, const char *c) {
+
+  size_t n = strlen(c), len = 0;
+
+  for (size_t i = 0; i < symbols; ++i) {
+    const char *s = (i % 6 == 5 ? " " : c);
+    size_t l = (i % 6 == 5 ? 1 : n);
+    memcpy(b + len, s, l);
+    len += l;
+  }
+
+  b[len] = '\0';
+  return b;
+}
+
+/**
+ * @name run:
+ *   Compare the null-terminated and slice-based variants of the
+ *   outbound preflight and the inbound JSON encoder on `text`, whose
+ *   length is already known to the caller in the slice case.
+ */
+void run(const char *label, const char *text) {
+
+  char name[64];
+  string_info_t si;
+  sms_segment_info_t seg;
+
+  string_slice_t slice = utf8_slice(text);
+  char *u = utf8_preflight_slice(slice, &si, &seg);
+  string_slice_t wide = utf16be_slice_units(u, si.units);
+
+  printf(
+    "%s: %zu bytes, %zu units, %u gsm parts, %u ucs-2 parts\n",
+      label, si.bytes, si.units, seg.gsm_parts, seg.ucs2_parts
+  );
+
+  double start = benchmark_now();
+
+  for (unsigned long i = 0; i < benchmark_iterations; ++i) {
+    free(utf8_preflight((char *) text, &si, &seg));
+  }
+
+  snprintf(name, sizeof(name), "  preflight, measured (before)");
+  benchmark_report_bytes(
+    name, benchmark_iterations, slice.length, benchmark_now() - start
+  );
+
+  start = benchmark_now();
+
+  for (unsigned long i = 0; i < benchmark_iterations; ++i) {
+    free(utf8_preflight_slice(slice, &si, &seg));
+  }
+
+  snprintf(name, sizeof(name), "  preflight, slice (after)");
+  benchmark_report_bytes(
+    name, benchmark_iterations, slice.length, benchmark_now() - start
+  );
+
+  start = benchmark_now();
+
+  for (unsigned long i = 0; i < benchmark_iterations; ++i) {
+    free(utf16be_encode_json_utf8(u));
+  }
+
+  snprintf(name, sizeof(name), "  json, measured (before)");
+  benchmark_report_bytes(
+    name, benchmark_iterations, wide.length, benchmark_now() - start
+  );
+
+  start = benchmark_now();
+
+  for (unsigned long i = 0; i < benchmark_iterations; ++i) {
+    free(utf16be_encode_json_utf8_slice(wide));
+  }
+
+  snprintf(name, sizeof(name), "  json, slice (after)");
+  benchmark_report_bytes(
+    name, benchmark_iterations, wide.length, benchmark_now() - start
+  );
+
+  free(u);
+}
+
+/**
+ * @name main:
+ */
+int main(int argc, char *argv[]) {
+
+  /* Ten-part messages, in each encoding */
+  char *b = allocate(8192);
+
+  run("gsm, 10 parts", fill_text(b, 1530, "a"));
+  run("ucs-2, 10 parts", fill_text(b, 670, "\xd0\x96"));
+
+  free(b);
+  return 0;
+}
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
@@ -0,0 +1,167 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+
+#include <string.h>
+
+#include "json.h"
+#include "allocate.h"
+#include "benchmark.h"
+
+/** --- **/
+
+/**
+ * @name build_arguments:
+ *   Build a command whose `arguments` array holds `count` short
+ *   values, alternating between strings and numeric primitives.
+ *   Tokenizing these is dominated by per-token costs, rather than
+ *   by scanning long strings.
+ */
+static char *build_arguments(unsigned int count) {
+
+  size_t n = 0;
+  char *rv = allocate_array(sizeof(char), 16 * (count + 4), 1);
+
+  n += sprintf(rv + n, "{ \"command\": \"send\", \"arguments\": [");
+
+  for (unsigned int i = 0; i < count; ++i) {
+    if (i % 2 == 0) {
+      n += sprintf(rv + n, "%s\"+1%u\"", (i ? ", " : ""), i);
+    } else {
+      n += sprintf(rv + n, ", %u", i);
+    }
+  }
+
+  sprintf(rv + n, "] }");
+  return rv;
+}
+
+/**
+ * @name run:
+ *   Tokenize a command with `count` arguments `iterations` times,
+ *   using each token layout, and report tokens per second. The
+ *   token arrays are allocated once, so that only tokenizing and
+ *   argument conversion are measured.
+ */
+void run(const char *label, unsigned int count, unsigned long iterations) {
+
+  char name[64];
+  jsmn_parser parser;
+  unsigned int n = count + 5;
+
+  char *json = build_arguments(count);
+  size_t length = strlen(json);
+  char *copy = allocate_array(sizeof(char), length, 1);
+
+  jsmntok_t *tokens = allocate_array(sizeof(jsmntok_t), n, 0);
+  jsmn_compact_t *compact = allocate_array(sizeof(jsmn_compact_t), n, 0);
+
+  /* Full-sized tokens, with parent links */
+  double start = benchmark_now();
+
+  for (unsigned long i = 0; i < iterations; ++i) {
+    jsmn_init(&parser);
+    if (jsmn_parse(&parser, json, tokens, n) != JSMN_SUCCESS) {
+      fprintf(stderr, "Parse failed for %s\n", label);
+      return;
+    }
+  }
+
+  snprintf(
+    name, sizeof(name), "%s, tokens (%zu bytes)", label, sizeof(*tokens)
+  );
+  benchmark_report(name, iterations * n, benchmark_now() - start);
+
+  /* Compact tokens, with subtree sizes */
+  start = benchmark_now();
+
+  for (unsigned long i = 0; i < iterations; ++i) {
+    jsmn_init(&parser);
+    if (jsmn_parse_compact(&parser, json, compact, n) != JSMN_SUCCESS) {
+      fprintf(stderr, "Compact parse failed for %s\n", label);
+      return;
+    }
+  }
+
+  snprintf(
+    name, sizeof(name), "%s, compact (%zu bytes)", label, sizeof(*compact)
+  );
+  benchmark_report(name, iterations * n, benchmark_now() - start);
+
+  /* Compact tokens, then conversion to an argument vector:
+   *   Conversion writes null terminators in to the string, so
+   *   each iteration works on a fresh copy, using the same reused
+   *   buffers as the REPL. */
+
+  json_context_t *c = json_context_create(0);
+  start = benchmark_now();
+
+  for (unsigned long i = 0; i < iterations; ++i) {
+
+    int argc = 0, err = 0;
+    char **argv = NULL;
+
+    memcpy(copy, json, length + 1);
+
+    if (!json_context_parse(c, copy) ||
+        !json_context_arguments(c, &argc, &argv, &err)) {
+      fprintf(stderr, "Conversion failed for %s\n", label);
+      return;
+    }
+  }
+
+  snprintf(name, sizeof(name), "%s, compact to argv", label);
+  benchmark_report(name, iterations * n, benchmark_now() - start);
+
+  json_context_destroy(c);
+  free(compact);
+  free(tokens);
+  free(copy);
+  free(json);
+}
+
+/**
+ * @name main:
+ */
+int main(int argc, char *argv[]) {
+
+  run("100 arguments", 100, 100000);
+  run("4000 arguments", 4000, 2500);
+  run("32000 arguments", 32000, 300);
+
+  return 0;
+}
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
@@ -0,0 +1,194 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+
+#include <iconv.h>
+#include <string.h>
+
+#include "allocate.h"
+#include "encoding.h"
+#include "benchmark.h"
+
+/** --- **/
+
+#define benchmark_bytes_total (1024UL * 1024 * 1024)
+
+/** --- **/
+
+/**
+ * @name convert_iconv:
+ *   Equivalent to `convert_utf8_utf16be(s, FALSE)` prior to the
+ *   introduction of the native encoder: measures the string with a
+ *   separate pass, allocates for the worst case, and converts using
+ *   the cached iconv descriptor `iv`.
+ */
+char *convert_iconv(iconv_t iv, char *s) {
+
+  size_t len = strlen(s);
+  char *rv = allocate_array(4, len, 1);
+
+  char *fp = s, *tp = rv;
+  size_t in = len, out = 4 * len;
+
+  if (iconv(iv, &fp, &in, &tp, &out) == (size_t) -1) {
+    free(rv);
+    return NULL;
+  }
+
+  tp[0] = tp[1] = '\0';
+  return rv;
+}
+
+/**
+ * @name fill_input:
+ *   Fill `b` with `bytes` bytes of valid UTF-8, followed by a null
+ *   terminator. If `is_mixed` is true, roughly one character in four
+ *   is a two, three, or four-byte sequence; otherwise, the input is
+ *   entirely ASCII text.
+ */
+void fill_input(char *b, size_t bytes, boolean_t is_mixed) {
+
+  static const char *const mixed[] = {
+    "\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80"
+  };
+
+  const char *ascii = "This is a simple test message. ";
+  size_t i = 0, j = 0;
+
+  while (i < bytes) {
+
+    const char *s = ascii + (j % strlen(ascii));
+    size_t n = 1;
+
+    if (is_mixed && j % 4 == 3) {
+      s = mixed[(j / 4) % 3];
+      n = strlen(s);
+    }
+
+    if (i + n > bytes) {
+      break;
+    }
+
+    memcpy(b + i, s, n);
+    i += n; j++;
+  }
+
+  b[i] = '\0';
+}
+
+/**
+ * @name run:
+ *   Benchmark the iconv path, validation alone, the native encoder,
+ *   and the native encoder followed by a separate segment information
+ *   pass versus the fused preflight, on `bytes` bytes of either ASCII
+ *   or mixed input.
+ */
+void run(const char *label, size_t bytes, boolean_t is_mixed) {
+
+  char name[64];
+  string_info_t si;
+
+  char *s = allocate(bytes + 1);
+  fill_input(s, bytes, is_mixed);
+
+  unsigned long iterations = benchmark_bytes_total / bytes;
+  iconv_t iv = iconv_open("UTF-16BE", "UTF-8");
+
+  double start = benchmark_now();
+
+  for (unsigned long i = 0; i < iterations; ++i) {
+    free(convert_iconv(iv, s));
+  }
+
+  snprintf(name, sizeof(name), "%s: iconv (before)", label);
+  benchmark_report_bytes(name, iterations, bytes, benchmark_now() - start);
+
+  start = benchmark_now();
+
+  for (unsigned long i = 0; i < iterations; ++i) {
+    utf8_string_info(s, &si);
+  }
+
+  snprintf(name, sizeof(name), "%s: validate only", label);
+  benchmark_report_bytes(name, iterations, bytes, benchmark_now() - start);
+
+  start = benchmark_now();
+
+  for (unsigned long i = 0; i < iterations; ++i) {
+    free(utf8_encode_utf16be(s, &si));
+  }
+
+  snprintf(name, sizeof(name), "%s: native (after)", label);
+  benchmark_report_bytes(name, iterations, bytes, benchmark_now() - start);
+
+  sms_segment_info_t seg;
+  start = benchmark_now();
+
+  for (unsigned long i = 0; i < iterations; ++i) {
+    char *u = utf8_encode_utf16be(s, &si);
+    utf16be_segment_info(u, &seg);
+    free(u);
+  }
+
+  snprintf(name, sizeof(name), "%s: native + segment info", label);
+  benchmark_report_bytes(name, iterations, bytes, benchmark_now() - start);
+
+  start = benchmark_now();
+
+  for (unsigned long i = 0; i < iterations; ++i) {
+    free(utf8_preflight(s, &si, &seg));
+  }
+
+  snprintf(name, sizeof(name), "%s: fused preflight", label);
+  benchmark_report_bytes(name, iterations, bytes, benchmark_now() - start);
+
+  iconv_close(iv);
+  free(s);
+}
+
+/**
+ * @name main:
+ */
+int main(int argc, char *argv[]) {
+
+  run("1 KB ascii", 1024, FALSE);
+  run("1 KB mixed", 1024, TRUE);
+  run("100 KB ascii", 100 * 1024, FALSE);
+  run("100 KB mixed", 100 * 1024, TRUE);
+
+  return 0;
+}
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
@@ -0,0 +1,223 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "allocate.h"
+#include "cache.h"
+
+/**
+ * @name released:
+ *   The number of values freed by `release_value`.
+ */
+static unsigned int released = 0;
+
+/**
+ * @name release_value:
+ */
+static void release_value(void *value) {
+
+  released++;
+  free(value);
+}
+
+/**
+ * @name make_value:
+ */
+static int *make_value(int n) {
+
+  int *rv = allocate(sizeof(*rv));
+  *rv = n;
+
+  return rv;
+}
+
+/**
+ * @name lookup:
+ *   Look up the null-terminated key `k` with tag `tag`, returning the
+ *   integer value found, or -1 if there isn't one.
+ */
+static int lookup(cache_t *c, unsigned int tag, const char *k) {
+
+  int *v = cache_lookup(c, tag, k, strlen(k));
+  return (v ? *v : -1);
+}
+
+/**
+ * @name test_basic:
+ */
+static void test_basic() {
+
+  released = 0;
+  cache_t *c = cache_create(3, release_value);
+
+  assert(lookup(c, 0, "a") == -1);
+  assert(c->misses == 1 && c->hits == 0);
+
+  cache_insert(c, 0, "a", 1, make_value(1));
+  cache_insert(c, 0, "b", 1, make_value(2));
+  cache_insert(c, 1, "b", 1, make_value(3));
+
+  /* Tags are part of the key */
+  assert(lookup(c, 0, "a") == 1);
+  assert(lookup(c, 0, "b") == 2);
+  assert(lookup(c, 1, "b") == 3);
+  assert(lookup(c, 1, "a") == -1);
+  assert(c->hits == 3 && c->misses == 2);
+
+  /* Replacement releases the old value */
+  cache_insert(c, 0, "a", 1, make_value(4));
+  assert(released == 1 && c->count == 3);
+  assert(lookup(c, 0, "a") == 4);
+
+  /* The empty key is a valid key */
+  assert(lookup(c, 0, "") == -1);
+  cache_insert(c, 0, "", 0, make_value(5));
+  assert(lookup(c, 0, "") == 5);
+  assert(c->evictions == 1 && c->count == 3);
+
+  cache_destroy(c);
+  assert(released == 5);
+}
+
+/**
+ * @name test_eviction_order:
+ */
+static void test_eviction_order() {
+
+  released = 0;
+  cache_t *c = cache_create(2, release_value);
+
+  cache_insert(c, 0, "a", 1, make_value(1));
+  cache_insert(c, 0, "b", 1, make_value(2));
+
+  /* Using `a` makes `b` the least recently used */
+  assert(lookup(c, 0, "a") == 1);
+  cache_insert(c, 0, "c", 1, make_value(3));
+
+  assert(lookup(c, 0, "b") == -1);
+  assert(lookup(c, 0, "a") == 1);
+  assert(lookup(c, 0, "c") == 3);
+
+  /* Replacing `a` makes it the most recently used */
+  cache_insert(c, 0, "a", 1, make_value(4));
+  cache_insert(c, 0, "d", 1, make_value(5));
+
+  assert(lookup(c, 0, "c") == -1);
+  assert(lookup(c, 0, "a") == 4);
+  assert(lookup(c, 0, "d") == 5);
+
+  assert(c->evictions == 2 && c->count == 2);
+
+  cache_destroy(c);
+  assert(released == 5);
+}
+
+/**
+ * @name test_many:
+ *   Compare the cache against a simple model, using many keys that
+ *   share hash buckets, so that chains of every length are exercised.
+ */
+static void test_many() {
+
+  char k[32];
+  const size_t capacity = 17;
+  unsigned long age[400], clock = 0;
+
+  released = 0;
+  cache_t *c = cache_create(capacity, release_value);
+
+  for (unsigned int i = 0; i < 400; ++i) {
+    age[i] = 0;
+  }
+
+  uint32_t seed = 1;
+
+  for (unsigned int n = 0; n < 20000; ++n) {
+
+    seed = seed * 1103515245 + 12345;
+    unsigned int i = (seed >> 16) % 40;
+
+    snprintf(k, sizeof(k), "key %u", i);
+    int v = lookup(c, 0, k);
+
+    /* The model: present if among the most recent `capacity` keys */
+    size_t newer = 0;
+
+    for (unsigned int j = 0; j < 400; ++j) {
+      newer += (age[j] > age[i]);
+    }
+
+    boolean_t expect = (age[i] != 0 && newer < capacity);
+
+    assert(expect ? (v == (int) i) : (v == -1));
+
+    if (v < 0) {
+      cache_insert(c, 0, k, strlen(k), make_value(i));
+    }
+
+    age[i] = ++clock;
+    assert(c->count <= capacity);
+  }
+
+  assert(c->hits + c->misses == 20000);
+  assert(released == c->evictions);
+
+  cache_destroy(c);
+}
+
+/**
+ * @name test_hash:
+ */
+static void test_hash() {
+
+  /* Published FNV-1a test vectors */
+  assert(cache_hash("", 0) == 0xcbf29ce484222325ULL);
+  assert(cache_hash("a", 1) == 0xaf63dc4c8601ec8cULL);
+  assert(cache_hash("foobar", 6) == 0x85944171f73967e8ULL);
+}
+
+int main(int argc, char *argv[]) {
+
+  test_hash();
+  test_basic();
+  test_eviction_order();
+  test_many();
+
+  return 0;
+}
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
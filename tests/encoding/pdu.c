@@ -0,0 +1,426 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "allocate.h"
+#include "encoding.h"
+#include "septet.h"
+#include "pdu.h"
+
+/**
+ * @name decode_hex:
+ *   Decode the null-terminated hexadecimal string `s` in to `out`,
+ *   and return the number of octets written.
+ */
+size_t decode_hex(const char *s, uint8_t *out) {
+
+  ssize_t rv = hex_decode_octets(utf8_slice(s), out, pdu_octets_maximum);
+
+  assert(rv >= 0);
+  return (size_t) rv;
+}
+
+/**
+ * @name assert_encodes_to:
+ *   Check that `m` encodes to exactly the hexadecimal PDU `hex`,
+ *   with a TPDU of `tpdu` octets.
+ */
+void assert_encodes_to(const pdu_message_t *m, const char *hex, size_t tpdu) {
+
+  size_t tpdu_length;
+  uint8_t b[pdu_octets_maximum];
+  char h[2 * pdu_octets_maximum + 1];
+
+  size_t length = pdu_encode(m, b, &tpdu_length);
+
+  assert(length > 0);
+  octets_encode_hex(b, length, h);
+
+  assert(strcmp(h, hex) == 0);
+  assert(tpdu_length == tpdu);
+}
+
+/**
+ * @name next_random:
+ */
+static uint32_t next_random(uint32_t *seed) {
+
+  *seed = *seed * 1103515245 + 12345;
+  return (*seed >> 16);
+}
+
+/**
+ * @name round_trip_text:
+ *   Split the UTF-8 string `utf8` in to parts, as either GSM using
+ *   the tables in `n` or UCS-2 if `n` is null, then encode and decode
+ *   every part, and check that the reassembled text is unchanged.
+ *   Returns the number of parts.
+ */
+unsigned int round_trip_text(const char *utf8, const gsm_national_info_t *n) {
+
+  string_info_t si;
+  pdu_message_t base, decoded;
+  pdu_message_t parts[16];
+
+  char *text = utf8_encode_utf16be(utf8, &si);
+  char *joined = allocate_array(2, si.units, 1);
+  size_t joined_units = 0;
+
+  assert(text != NULL);
+
+  pdu_initialize(&base, PDU_SUBMIT);
+  assert(pdu_set_address(&base, utf8_slice("+15035551212")));
+
+  unsigned int count = pdu_split_utf16be(&base, text, n, 0x42, parts, 16);
+  assert(count > 0);
+
+  for (unsigned int i = 0; i < count; ++i) {
+
+    size_t tpdu_length;
+    uint8_t b[pdu_octets_maximum];
+    char u[2 * (sms_gsm_single_septets + 1)];
+
+    size_t length = pdu_encode(&parts[i], b, &tpdu_length);
+
+    assert(length > 0);
+    assert(length == tpdu_length + 1);
+    assert(pdu_decode(b, length, &decoded));
+
+    assert(decoded.type == PDU_SUBMIT);
+    assert(strcmp(decoded.address, "+15035551212") == 0);
+    assert(decoded.coding == (n ? PDU_CODING_GSM : PDU_CODING_UCS2));
+
+    if (count > 1) {
+      assert(decoded.concatenation.reference == 0x42);
+      assert(decoded.concatenation.parts == count);
+      assert(decoded.concatenation.part == i + 1);
+    } else {
+      assert(decoded.concatenation.parts == 0);
+    }
+
+    if (n) {
+      assert(decoded.locking == n->locking);
+      assert(decoded.single == n->single);
+    }
+
+    size_t units = pdu_text_utf16be(&decoded, u);
+    memcpy(joined + 2 * joined_units, u, 2 * units);
+    joined_units += units;
+  }
+
+  assert(joined_units == si.units);
+  assert(memcmp(joined, text, 2 * si.units) == 0);
+
+  free(text);
+  free(joined);
+
+  return count;
+}
+
+/** --- **/
+
+/**
+ * @name test_known_vectors:
+ *   Widely-published examples of an SMS-SUBMIT and SMS-DELIVER PDU,
+ *   each carrying the text "hellohello".
+ */
+void test_known_vectors() {
+
+  pdu_message_t m;
+  uint8_t b[pdu_octets_maximum];
+  char u[2 * (sms_gsm_single_septets + 1)];
+
+  /* SMS-SUBMIT, with a relative validity period */
+  const char *submit = "0011000B916407281553F80000AA0AE8329BFD4697D9EC37";
+
+  assert(pdu_decode(b, decode_hex(submit, b), &m));
+  assert(m.type == PDU_SUBMIT);
+  assert(m.smsc[0] == '\0');
+  assert(strcmp(m.address, "+46708251358") == 0);
+  assert(m.address_type == 0x91);
+  assert(m.coding == PDU_CODING_GSM);
+  assert(m.message_class == -1);
+  assert(m.validity == 0xaa);
+  assert(m.length == 10);
+  assert(m.udh_length == 0);
+
+  pdu_text_utf16be(&m, u);
+  assert(memcmp(u, "\0h\0e\0l\0l\0o\0h\0e\0l\0l\0o\0\0", 22) == 0);
+  assert_encodes_to(&m, submit, 23);
+
+  /* SMS-DELIVER, with a service centre address */
+  const char *deliver = (
+    "07917283010010F5040BC87238880900F10000993092516195800AE8329BFD4697D9EC37"
+  );
+
+  assert(pdu_decode(b, decode_hex(deliver, b), &m));
+  assert(m.type == PDU_DELIVER);
+  assert(strcmp(m.smsc, "+27381000015") == 0);
+  assert(strcmp(m.address, "27838890001") == 0);
+  assert(m.timestamp.year == 99 && m.timestamp.month == 3);
+  assert(m.timestamp.day == 29 && m.timestamp.hour == 15);
+  assert(m.timestamp.minute == 16 && m.timestamp.second == 59);
+  assert(m.timestamp.timezone == 8);
+  assert(m.length == 10);
+  assert_encodes_to(&m, deliver, 28);
+
+  /* SMS-DELIVER, from an alphanumeric address */
+  const char *alphanumeric = (
+    "000409D0CD32393D060000993092516195800AE8329BFD4697D9EC37"
+  );
+
+  assert(pdu_decode(b, decode_hex(alphanumeric, b), &m));
+  assert(strcmp(m.address, "Medic") == 0);
+}
+
+/**
+ * @name test_addresses:
+ */
+void test_addresses() {
+
+  pdu_message_t m;
+  pdu_initialize(&m, PDU_SUBMIT);
+
+  assert(!pdu_set_address(&m, utf8_slice("")));
+  assert(!pdu_set_address(&m, utf8_slice("+")));
+  assert(!pdu_set_address(&m, utf8_slice("+1 503")));
+  assert(!pdu_set_address(&m, utf8_slice("Medic")));
+  assert(!pdu_set_address(&m, utf8_slice("123456789012345678901")));
+
+  assert(pdu_set_address(&m, utf8_slice("12345678901234567890")));
+  assert(pdu_set_address(&m, utf8_slice("*100#")));
+  assert(m.address_type == 0x81);
+
+  m.length = 0;
+  assert_encodes_to(&m, "00010005811A00FB000000", 10);
+
+  assert(pdu_set_address(&m, utf8_slice("+15035551212")));
+  assert(m.address_type == 0x91);
+  assert(strcmp(m.address, "+15035551212") == 0);
+}
+
+/**
+ * @name test_split:
+ *   Split, encode, and decode messages of many lengths, in each
+ *   encoding, and check the number of parts against the segment
+ *   counts that `plan` reports.
+ */
+void test_split() {
+
+  char b[4096];
+  uint32_t seed = 0x5eed;
+
+  const char *gsm[] = { "a", "{", "\xe2\x82\xac", "\xc3\xa9" };
+  const char *ucs2[] = { "a", "\xd0\x96", "\xf0\x9f\x98\x80", "\xe2\x82\xac" };
+
+  gsm_national_info_t none;
+  memset(&none, 0, sizeof(none));
+
+  for (unsigned int length = 0; length < 700; length += 7) {
+
+    sms_segment_info_t seg;
+    string_info_t si;
+
+    /* GSM default alphabet and extension table */
+    size_t n = 0;
+
+    for (unsigned int i = 0; i < length; ++i) {
+      const char *c = gsm[next_random(&seed) % 4];
+      memcpy(b + n, c, strlen(c));
+      n += strlen(c);
+    }
+
+    b[n] = '\0';
+
+    char *u = utf8_preflight(b, &si, &seg);
+    assert(round_trip_text(b, &none) == seg.gsm_parts);
+    free(u);
+
+    /* UCS-2, including surrogate pairs */
+    if (length > 400) {
+      continue;
+    }
+
+    n = 0;
+
+    for (unsigned int i = 0; i < length; ++i) {
+      const char *c = ucs2[next_random(&seed) % 4];
+      memcpy(b + n, c, strlen(c));
+      n += strlen(c);
+    }
+
+    b[n] = '\0';
+
+    u = utf8_preflight(b, &si, &seg);
+    assert(round_trip_text(b, NULL) == seg.ucs2_parts);
+    free(u);
+  }
+}
+
+/**
+ * @name test_national:
+ *   National language shift tables must be announced in the header
+ *   of every part, and must survive a round trip.
+ */
+void test_national() {
+
+  string_info_t si;
+  gsm_national_info_t n;
+
+  const char *turkish = (
+    "Yar\xc4\xb1n sabah \xc5\x9e" "i\xc5\x9fli'deki ofiste bulu\xc5\x9f"
+    "al\xc4\xb1m m\xc4\xb1? \xc3\x87ok \xc3\xb6nemli bir toplant\xc4\xb1"
+    "m\xc4\xb1z var ve herkesin kat\xc4\xb1lmas\xc4\xb1 gerekiyor. "
+    "Yar\xc4\xb1n sabah \xc5\x9e" "i\xc5\x9fli'deki ofiste bulu\xc5\x9f"
+    "al\xc4\xb1m m\xc4\xb1? \xc3\x87ok \xc3\xb6nemli bir toplant\xc4\xb1"
+  );
+
+  char *u = utf8_encode_utf16be(turkish, &si);
+  assert(utf16be_national_info(u, &n));
+  assert(n.locking != 0 || n.single != 0);
+
+  assert(round_trip_text(turkish, &n) == n.parts);
+  free(u);
+}
+
+/**
+ * @name test_binary:
+ *   Eight-bit user data, with a concatenation header using a 16-bit
+ *   reference, must survive a round trip octet for octet.
+ */
+void test_binary() {
+
+  pdu_message_t m, d;
+  uint8_t b[pdu_octets_maximum];
+
+  pdu_initialize(&m, PDU_SUBMIT);
+  assert(pdu_set_address(&m, utf8_slice("+15035551212")));
+
+  m.coding = PDU_CODING_8BIT;
+  m.message_class = 1;
+  m.concatenation.is_16bit = TRUE;
+  m.concatenation.reference = 0xbeef;
+  m.concatenation.parts = 2;
+  m.concatenation.part = 1;
+  m.length = 133;
+
+  for (size_t i = 0; i < m.length; ++i) {
+    m.data[i] = (uint8_t) (255 - i);
+  }
+
+  size_t length = pdu_encode(&m, b, NULL);
+  assert(length > 0);
+
+  assert(pdu_decode(b, length, &d));
+  assert(d.coding == PDU_CODING_8BIT);
+  assert(d.message_class == 1);
+  assert(d.concatenation.is_16bit);
+  assert(d.concatenation.reference == 0xbeef);
+  assert(d.concatenation.parts == 2 && d.concatenation.part == 1);
+  assert(d.udh_length == 7);
+  assert(d.length == 133);
+  assert(memcmp(d.data, m.data, 133) == 0);
+
+  /* One octet too many for the user data field */
+  m.length = 134;
+  assert(pdu_encode(&m, b, NULL) == 0);
+}
+
+/**
+ * @name test_malformed:
+ *   Every truncation of a valid PDU must be rejected, and random
+ *   input must never be read beyond its end; the latter is checked
+ *   by running this test under a memory checker.
+ */
+void test_malformed() {
+
+  pdu_message_t m;
+  uint8_t b[pdu_octets_maximum];
+  uint32_t seed = 0xbad;
+
+  const char *concatenated = (
+    "0051000B915130551512F20000A70B050003420201D065361B"
+  );
+
+  size_t length = decode_hex(concatenated, b);
+  assert(pdu_decode(b, length, &m));
+  assert(m.concatenation.parts == 2 && m.length == 4);
+  assert(memcmp(m.data, "hell", 4) == 0);
+
+  for (size_t i = 0; i < length; ++i) {
+
+    uint8_t *p = allocate(i + 1);
+    memcpy(p, b, i);
+
+    assert(!pdu_decode(p, i, &m));
+    free(p);
+  }
+
+  for (unsigned int i = 0; i < 20000; ++i) {
+
+    size_t n = next_random(&seed) % 64;
+    uint8_t *p = allocate(n + 1);
+
+    for (size_t j = 0; j < n; ++j) {
+      p[j] = (uint8_t) next_random(&seed);
+    }
+
+    /* Favour plausible headers, so that later fields are reached */
+    if (n > 2) {
+      p[0] = 0;
+      p[1] = (uint8_t) (p[1] & 0x43);
+    }
+
+    pdu_decode(p, n, &m);
+    free(p);
+  }
+}
+
+/** --- **/
+
+int main(int argc, char *argv[]) {
+
+  test_known_vectors();
+  test_addresses();
+  test_split();
+  test_national();
+  test_binary();
+  test_malformed();
+
+  return 0;
+}
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
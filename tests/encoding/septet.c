@@ -0,0 +1,297 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "cpu.h"
+#include "allocate.h"
+#include "septet.h"
+
+/**
+ * @name levels:
+ *   Every instruction set level that `septet.c` dispatches on.
+ */
+static const unsigned int levels[] = {
+  CPU_NONE, CPU_SSE2 | CPU_SSSE3, CPU_ALL
+};
+
+/**
+ * @name next_random:
+ */
+static uint32_t next_random(uint32_t *seed) {
+
+  *seed = *seed * 1103515245 + 12345;
+  return (*seed >> 16);
+}
+
+/**
+ * @name reference_pack:
+ *   Pack septets one bit at a time, directly from the definition.
+ */
+void reference_pack(const uint8_t *s, size_t count,
+                    unsigned int fill, uint8_t *out) {
+
+  memset(out, 0, septet_packed_length(count, fill));
+
+  for (size_t i = 0; i < count; ++i) {
+    for (unsigned int j = 0; j < 7; ++j) {
+      if (s[i] & (1 << j)) {
+        size_t bit = fill + 7 * i + j;
+        out[bit / 8] |= (uint8_t) (1 << (bit % 8));
+      }
+    }
+  }
+}
+
+/**
+ * @name check_round_trip:
+ *   Pack and unpack `count` septets from `s` at every dispatch level,
+ *   using exactly-sized heap buffers so that any out-of-bounds access
+ *   is visible to a memory checker. Returns nothing; asserts instead.
+ */
+void check_round_trip(const uint8_t *s, size_t count, unsigned int fill) {
+
+  size_t length = septet_packed_length(count, fill);
+
+  uint8_t *in = allocate_array(sizeof(uint8_t), count, 1);
+  uint8_t *expect = allocate_array(sizeof(uint8_t), length, 1);
+  uint8_t *packed = allocate_array(sizeof(uint8_t), length, 0);
+  uint8_t *unpacked = allocate_array(sizeof(uint8_t), count, 0);
+
+  memcpy(in, s, count);
+  reference_pack(in, count, fill, expect);
+
+  for (unsigned int l = 0; l < sizeof(levels) / sizeof(*levels); ++l) {
+
+    cpu_features_restrict(levels[l]);
+
+    if (length > 0) {
+      memset(packed, 0xa5, length);
+    }
+
+    assert(septets_pack(in, count, fill, packed) == length);
+    assert(length == 0 || memcmp(packed, expect, length) == 0);
+
+    assert(septets_unpack(packed, count, fill, unpacked) == count);
+
+    for (size_t i = 0; i < count; ++i) {
+      assert(unpacked[i] == (in[i] & 0x7f));
+    }
+  }
+
+  cpu_features_restrict(CPU_ALL);
+
+  free(in);
+  free(expect);
+  free(packed);
+  free(unpacked);
+}
+
+/** --- **/
+
+/**
+ * @name test_lengths:
+ */
+void test_lengths() {
+
+  assert(septet_packed_length(0, 0) == 0);
+  assert(septet_packed_length(0, 6) == 0);
+  assert(septet_packed_length(1, 0) == 1);
+  assert(septet_packed_length(8, 0) == 7);
+  assert(septet_packed_length(8, 1) == 8);
+  assert(septet_packed_length(153, 1) == 134);
+  assert(septet_packed_length(160, 0) == 140);
+
+  /* Concatenation headers: 8-bit and 16-bit references */
+  assert(septet_fill_bits(6) == 1);
+  assert(septet_fill_bits(7) == 0);
+  assert(septet_fill_bits(0) == 0);
+
+  for (size_t udh = 0; udh < 141; ++udh) {
+    assert((udh * 8 + septet_fill_bits(udh)) % 7 == 0);
+    assert(septet_fill_bits(udh) < 7);
+  }
+}
+
+/**
+ * @name test_known_vectors:
+ *   The "hellohello" example from 3GPP TS 23.038, section 6.1.2.1.1,
+ *   both with and without a leading concatenation header's fill bit.
+ */
+void test_known_vectors() {
+
+  uint8_t b[16], s[16];
+  const char *hello = "hellohello";
+
+  const uint8_t expect[] = {
+    0xe8, 0x32, 0x9b, 0xfd, 0x46, 0x97, 0xd9, 0xec, 0x37
+  };
+
+  const uint8_t expect_fill[] = {
+    0xd0, 0x65, 0x36, 0xfb, 0x8d, 0x2e, 0xb3, 0xd9, 0x6f
+  };
+
+  for (unsigned int l = 0; l < sizeof(levels) / sizeof(*levels); ++l) {
+
+    cpu_features_restrict(levels[l]);
+
+    assert(septets_pack((const uint8_t *) hello, 10, 0, b) == 9);
+    assert(memcmp(b, expect, sizeof(expect)) == 0);
+    assert(septets_unpack(b, 10, 0, s) == 10);
+    assert(memcmp(s, hello, 10) == 0);
+
+    assert(septets_pack((const uint8_t *) hello, 10, 1, b) == 9);
+    assert(memcmp(b, expect_fill, sizeof(expect_fill)) == 0);
+    assert(septets_unpack(b, 10, 1, s) == 10);
+    assert(memcmp(s, hello, 10) == 0);
+  }
+
+  cpu_features_restrict(CPU_ALL);
+}
+
+/**
+ * @name test_exhaustive_pairs:
+ *   Every one- and two-septet message, with every amount of fill.
+ */
+void test_exhaustive_pairs() {
+
+  uint8_t s[2];
+
+  for (unsigned int fill = 0; fill < 7; ++fill) {
+    for (unsigned int a = 0; a < 128; ++a) {
+
+      s[0] = (uint8_t) a;
+      check_round_trip(s, 1, fill);
+
+      for (unsigned int b = 0; b < 128; ++b) {
+        s[1] = (uint8_t) b;
+        check_round_trip(s, 2, fill);
+      }
+    }
+  }
+}
+
+/**
+ * @name test_exhaustive_positions:
+ *   Every septet value, in every position of every vector lane and
+ *   across every group boundary, against a background of each of
+ *   the two extreme values.
+ */
+void test_exhaustive_positions() {
+
+  uint8_t s[72];
+
+  for (unsigned int fill = 0; fill < 7; ++fill) {
+    for (unsigned int background = 0; background < 2; ++background) {
+      for (size_t position = 0; position < sizeof(s); ++position) {
+        for (unsigned int v = 0; v < 128; v += 3) {
+
+          memset(s, (background ? 0x7f : 0x00), sizeof(s));
+          s[position] = (uint8_t) v;
+          check_round_trip(s, sizeof(s), fill);
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @name test_round_trip:
+ *   Random septets, with random high bits that must be ignored, at
+ *   every length up to and beyond the largest concatenated message.
+ */
+void test_round_trip() {
+
+  uint8_t s[1200];
+  uint32_t seed = 0x5eed;
+
+  for (size_t count = 0; count <= sizeof(s); ++count) {
+
+    for (size_t i = 0; i < count; ++i) {
+      s[i] = (uint8_t) next_random(&seed);
+    }
+
+    for (unsigned int fill = 0; fill < 7; ++fill) {
+      check_round_trip(s, count, fill);
+    }
+  }
+}
+
+/**
+ * @name test_udh_alignment:
+ *   A packed payload that follows a user data header must unpack
+ *   correctly when the header and payload share one buffer.
+ */
+void test_udh_alignment() {
+
+  uint8_t s[160], r[160], b[141];
+  uint32_t seed = 0xf111;
+
+  for (size_t udh = 1; udh < 20; ++udh) {
+
+    unsigned int fill = septet_fill_bits(udh);
+    size_t septets = (140 * 8 - udh * 8 - fill) / 7;
+
+    for (size_t i = 0; i < septets; ++i) {
+      s[i] = (uint8_t) (next_random(&seed) & 0x7f);
+    }
+
+    memset(b, 0xee, sizeof(b));
+    size_t length = septets_pack(s, septets, fill, b + udh);
+
+    assert(udh + length <= 140);
+    assert(b[0] == 0xee && b[udh - 1] == 0xee);
+    assert((b[udh] & ((1 << fill) - 1)) == 0);
+
+    septets_unpack(b + udh, septets, fill, r);
+    assert(memcmp(r, s, septets) == 0);
+  }
+}
+
+/** --- **/
+
+int main(int argc, char *argv[]) {
+
+  test_lengths();
+  test_known_vectors();
+  test_exhaustive_pairs();
+  test_exhaustive_positions();
+  test_round_trip();
+  test_udh_alignment();
+
+  return 0;
+}
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
@@ -32,9 +32,221 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#define _POSIX_C_SOURCE 200112L
+
+#include <iconv.h>
 #include <assert.h>
+#include <string.h>
+
+#include "cpu.h"
+#include "gsm.h"
+#include "nfc.h"
+#include "allocate.h"
 #include "encoding.h"
 
+/**
+ * @name reference_string_info:
+ *   The original scalar implementation of `utf16be_string_info`,
+ *   retained here as a reference for differential testing.
+ */
+boolean_t reference_string_info(const char *s, string_info_t *i) {
+
+  const char *p = s;
+  boolean_t in_surrogate = FALSE;
+
+  #define record_error(i, e) \
+    do { \
+      (i)->invalid_bytes += 2; \
+      if (!(i)->error) { \
+        (i)->error = (e); \
+        (i)->error_offset = (i)->bytes; \
+      } \
+    } while (0)
+
+  i->bytes = 0;
+  i->units = 0;
+  i->symbols = 0;
+  i->error_offset = 0;
+  i->invalid_bytes = 0;
+  i->error = D_ERR_NONE;
+
+  for (;;) {
+
+    uint16_t v = (p[0] << 8) | (uint8_t) p[1];
+
+    if (!v) {
+      break;
+    }
+
+    if (!in_surrogate) {
+      if (v < 0xd800 || v > 0xdfff) {
+        i->symbols++;
+      } else if (v < 0xdc00) {
+        in_surrogate = TRUE;
+      } else {
+        record_error(i, D_ERR_UNEXPECTED_SURROGATE);
+      }
+    } else {
+      in_surrogate = FALSE;
+      if (v >= 0xdc00 && v <= 0xdfff) {
+        i->symbols++;
+      } else {
+        record_error(i, D_ERR_UNMATCHED_SURROGATE);
+        continue;
+      }
+    }
+
+    p += 2;
+    i->units++;
+    i->bytes += 2;
+  }
+
+  if (in_surrogate) {
+    record_error(i, D_ERR_UNMATCHED_SURROGATE);
+  }
+
+  if (i->error == D_ERR_UNMATCHED_SURROGATE) {
+    i->error_offset -= 2;
+  }
+
+  #undef record_error
+  return (i->invalid_bytes == 0);
+}
+
+/**
+ * @name reference_is_gsm_codepoint:
+ *   The original switch-based implementation of
+ *   `utf16be_is_gsm_codepoint`, retained here as a reference.
+ */
+boolean_t reference_is_gsm_codepoint(uint8_t msb, uint8_t lsb) {
+
+  switch (msb) {
+
+    case 0x00: {
+      int rv = (
+        (lsb >= 0x20 && lsb <= 0x5f)
+          || (lsb >= 0x61 && lsb <= 0x7e)
+          || (lsb >= 0xa3 && lsb <= 0xa5)
+          || (lsb >= 0xc4 && lsb <= 0xc6)
+          || (lsb >= 0xe4 && lsb <= 0xe9)
+      );
+      if (rv) {
+        return TRUE;
+      }
+      switch (lsb) {
+        case 0x0a: case 0x0c: case 0x0d:
+        case 0xa0: case 0xa1: case 0xa7:
+        case 0xbf: case 0xc9: case 0xd1:
+        case 0xd6: case 0xd8: case 0xdc:
+        case 0xdf: case 0xe0: case 0xec:
+        case 0xf1: case 0xf2: case 0xf6:
+        case 0xf8: case 0xf9: case 0xfc:
+          return TRUE;
+        default:
+          return FALSE;
+      }
+    }
+    case 0x03: {
+      switch (lsb) {
+        case 0x93: case 0x94:
+        case 0x98: case 0x9b:
+        case 0x9e: case 0xa0:
+        case 0xa3: case 0xa6:
+        case 0xa8: case 0xa9:
+          return TRUE;
+        default:
+          return FALSE;
+      }
+    }
+    case 0x20: {
+      return (lsb == 0xac);
+    }
+    default:
+      break;
+  }
+
+  return FALSE;
+}
+
+/**
+ * @name reference_is_gsm_string:
+ */
+boolean_t reference_is_gsm_string(const char *s) {
+
+  for (size_t i = 0; s[2 * i] || s[2 * i + 1]; ++i) {
+    if (!reference_is_gsm_codepoint(s[2 * i], s[2 * i + 1])) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+ * @name reference_encode_json_utf8:
+ *   The original iconv-based implementation of
+ *   `utf16be_encode_json_utf8`, retained here as a reference for
+ *   differential testing. Returns NULL if iconv rejects the input.
+ */
+char *reference_encode_json_utf8(const char *s) {
+
+  size_t j = 0, units = utf16be_length(s);
+  char *b = allocate_array(6, units, 1);
+
+  for (size_t i = 0; i < units; ++i) {
+
+    char msb = s[2 * i];
+    char lsb = s[2 * i + 1];
+
+    if (msb == '\0') {
+      char escape = '\0';
+
+      switch (lsb) {
+        case '\r':
+          escape = 'r'; break;
+        case '\n':
+          escape = 'n'; break;
+        case '\f':
+          escape = 'f'; break;
+        case '\b':
+          escape = 'b'; break;
+        case '\t':
+          escape = 't'; break;
+        case '\\': case '"':
+          escape = lsb; break;
+        default:
+          break;
+      };
+
+      if (escape != '\0') {
+        b[j++] = '\0';
+        b[j++] = '\\';
+        lsb = escape;
+      }
+    }
+
+    b[j++] = msb;
+    b[j++] = lsb;
+  }
+
+  iconv_t iv = iconv_open("UTF-8", "UTF-16BE");
+  assert(iv != (iconv_t) -1);
+
+  char *rv = allocate_array(4, j, 1);
+  char *fp = b, *tp = rv;
+  size_t in = j, out = 4 * j;
+
+  if (iconv(iv, &fp, &in, &tp, &out) == (size_t) -1) {
+    free(rv);
+    rv = NULL;
+  }
+
+  iconv_close(iv);
+  free(b);
+
+  return rv;
+}
+
 /**
  * @name string_info_assert:
  */
@@ -150,12 +362,1212 @@ void test_string_info() {
 
 }
 
+/**
+ * @name random_utf16be_string:
+ *   Fill `b` with `units` pseudo-random UTF-16BE code units, followed
+ *   by a null terminator. Output is mostly printable ASCII, with runs
+ *   of whitespace, GSM and non-GSM characters, and both valid and
+ *   invalid surrogates mixed in at a rate determined by `noise`.
+ */
+void random_utf16be_string(char *b, size_t units,
+                           unsigned int noise, uint32_t *seed) {
+
+  static const uint16_t specials[] = {
+    0x000a, 0x000d, 0x0060, 0x007f, 0x00e9, 0x20ac,
+    0x0939, 0x0100, 0x4100, 0xd83d, 0xde2c, 0xdc00
+  };
+
+  for (size_t i = 0; i < units; ++i) {
+
+    uint16_t v;
+    *seed = *seed * 1103515245 + 12345;
+
+    if ((*seed >> 16) % 100 < noise) {
+      v = specials[(*seed >> 8) % (sizeof(specials) / sizeof(*specials))];
+    } else {
+      v = 0x20 + ((*seed >> 8) % 0x5f);
+    }
+
+    b[2 * i] = v >> 8;
+    b[2 * i + 1] = v & 0xff;
+  }
+
+  b[2 * units] = b[2 * units + 1] = '\0';
+}
+
+/**
+ * @name string_info_differential_assert:
+ */
+void string_info_differential_assert(const char *s) {
+
+  string_info_t si, expect;
+
+  boolean_t rv = utf16be_string_info(s, &si);
+  boolean_t expect_rv = reference_string_info(s, &expect);
+
+  assert(rv == expect_rv);
+  assert(si.bytes == expect.bytes);
+  assert(si.units == expect.units);
+  assert(si.symbols == expect.symbols);
+  assert(si.error == expect.error);
+  assert(si.error_offset == expect.error_offset);
+  assert(si.invalid_bytes == expect.invalid_bytes);
+
+  assert(utf16be_is_gsm_string(s) == reference_is_gsm_string(s));
+
+  /* Slice variants:
+      The copy has no terminator, so any read past the end of
+      the slice is a read past the end of the allocation. */
+
+  size_t length = 2 * utf16be_length(s);
+  char *copy = allocate(length + 1);
+
+  memcpy(copy + 1, s, length);
+  string_slice_t slice = { copy + 1, length };
+
+  rv = utf16be_string_info_slice(slice, &si);
+
+  assert(rv == expect_rv);
+  assert(si.bytes == expect.bytes);
+  assert(si.units == expect.units);
+  assert(si.symbols == expect.symbols);
+  assert(si.error == expect.error);
+  assert(si.error_offset == expect.error_offset);
+  assert(si.invalid_bytes == expect.invalid_bytes);
+
+  assert(utf16be_find_non_gsm_slice(slice) == utf16be_find_non_gsm(s));
+  free(copy);
+}
+
+/**
+ * @name test_string_info_vectorized:
+ *   Compare the vectorized fast paths against the original scalar
+ *   code, for every available instruction set. Strings are placed
+ *   at every alignment, and right up against the end of a page.
+ */
+void test_string_info_vectorized() {
+
+  unsigned int levels[] = { CPU_NONE, CPU_SSE2, CPU_ALL };
+
+  size_t page = 4096;
+  char *region = NULL;
+
+  assert(posix_memalign((void **) &region, page, 2 * page) == 0);
+  char *end = region + page;
+
+  for (unsigned int l = 0; l < sizeof(levels) / sizeof(*levels); ++l) {
+
+    uint32_t seed = 0x5eed;
+    cpu_features_restrict(levels[l]);
+
+    for (unsigned int noise = 0; noise <= 30; noise += 3) {
+      for (size_t units = 0; units < 80; ++units) {
+        for (size_t offset = 0; offset < 2; ++offset) {
+
+          /* Somewhere in the middle of the first page */
+          char *b = region + 64 + offset;
+          random_utf16be_string(b, units, noise, &seed);
+          string_info_differential_assert(b);
+
+          /* Terminator ends exactly at the end of the first page */
+          b = end - (2 * units + 2) - offset;
+          random_utf16be_string(b, units, noise, &seed);
+          string_info_differential_assert(b);
+        }
+      }
+    }
+  }
+
+  cpu_features_restrict(CPU_ALL);
+  free(region);
+}
+
+/**
+ * @name test_gsm_classification:
+ */
+void test_gsm_classification() {
+
+  /* Exhaustive: every code unit in the BMP */
+  for (unsigned int c = 0; c <= 0xffff; ++c) {
+    assert(
+      utf16be_is_gsm_codepoint(c >> 8, c & 0xff)
+        == reference_is_gsm_codepoint(c >> 8, c & 0xff)
+    );
+  }
+
+  /* Offsets of the first non-GSM character */
+  assert(utf16be_find_non_gsm("\0\0") == -1);
+  assert(utf16be_find_non_gsm("\0T\0e\0s\0t\x20\xac\0\n\0\0") == -1);
+  assert(utf16be_find_non_gsm("\0`\0\0") == 0);
+  assert(utf16be_find_non_gsm("\0T\0e\0s\0t\0\t\0\0") == 8);
+  assert(utf16be_find_non_gsm("\0a\0\xe9\x09\x39\0\xe9\0\0") == 4);
+  assert(utf16be_find_non_gsm("\0a\xd8\x3d\xde\x2c\0\0") == 2);
+
+  /* Character decoding, for reporting */
+  size_t units = 0;
+
+  assert(utf16be_decode_codepoint("\x09\x39\0\0", &units) == 0x0939);
+  assert(units == 1);
+  assert(utf16be_decode_codepoint("\xd8\x3d\xde\x2c\0\0", &units) == 0x1f62c);
+  assert(units == 2);
+  assert(utf16be_decode_codepoint("\xd8\x3d\0\0", &units) == 0xd83d);
+  assert(units == 1);
+}
+
+/**
+ * @name build_utf16be_string:
+ *   Append `count` copies of the code unit sequence `units` (of
+ *   length `n`) to the UTF-16BE string `b`, which holds `*len` units.
+ */
+void build_utf16be_string(char *b, size_t *len,
+                          const uint16_t *units, size_t n, size_t count) {
+
+  for (size_t i = 0; i < count; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      b[2 * *len] = units[j] >> 8;
+      b[2 * *len + 1] = units[j] & 0xff;
+      (*len)++;
+    }
+  }
+
+  b[2 * *len] = b[2 * *len + 1] = '\0';
+}
+
+/**
+ * @name segment_info_assert:
+ */
+void segment_info_assert(const char *s, size_t septets, size_t units,
+                         unsigned int gsm_parts, unsigned int ucs2_parts) {
+
+  sms_segment_info_t si;
+  boolean_t rv = utf16be_segment_info(s, &si);
+
+  assert(rv == (gsm_parts > 0));
+  assert(si.septets == septets);
+  assert(si.units == units);
+  assert(si.gsm_parts == gsm_parts);
+  assert(si.ucs2_parts == ucs2_parts);
+  assert((si.non_gsm_offset < 0) == rv);
+}
+
+/**
+ * @name test_segment_info:
+ */
+void test_segment_info() {
+
+  char b[2 * 1024];
+  size_t len;
+
+  const uint16_t a[] = { 'a' };
+  const uint16_t bracket[] = { '[' };
+  const uint16_t euro[] = { 0x20ac };
+  const uint16_t ff[] = { '\f' };
+  const uint16_t ha[] = { 0x0939 };
+  const uint16_t grimace[] = { 0xd83d, 0xde2c };
+
+  /* Empty message: still one part */
+  segment_info_assert("\0\0", 0, 0, 1, 1);
+
+  /* Single-part limits */
+  len = 0; build_utf16be_string(b, &len, a, 1, 160);
+  segment_info_assert(b, 160, 160, 1, 3);
+
+  len = 0; build_utf16be_string(b, &len, a, 1, 161);
+  segment_info_assert(b, 161, 161, 2, 3);
+
+  /* Extension table characters cost two septets */
+  len = 0; build_utf16be_string(b, &len, a, 1, 159);
+  build_utf16be_string(b, &len, euro, 1, 1);
+  segment_info_assert(b, 161, 160, 2, 3);
+
+  len = 0; build_utf16be_string(b, &len, ff, 1, 80);
+  segment_info_assert(b, 160, 80, 1, 2);
+
+  /* Multipart limits */
+  len = 0; build_utf16be_string(b, &len, a, 1, 306);
+  segment_info_assert(b, 306, 306, 2, 5);
+
+  len = 0; build_utf16be_string(b, &len, a, 1, 307);
+  segment_info_assert(b, 307, 307, 3, 5);
+
+  /* Escape sequences are never split across parts */
+  len = 0; build_utf16be_string(b, &len, a, 1, 152);
+  build_utf16be_string(b, &len, bracket, 1, 1);
+  build_utf16be_string(b, &len, a, 1, 152);
+  segment_info_assert(b, 306, 305, 3, 5);
+
+  /* UCS-2 limits */
+  len = 0; build_utf16be_string(b, &len, ha, 1, 70);
+  segment_info_assert(b, 0, 70, 0, 1);
+
+  len = 0; build_utf16be_string(b, &len, ha, 1, 71);
+  segment_info_assert(b, 0, 71, 0, 2);
+
+  len = 0; build_utf16be_string(b, &len, ha, 1, 134);
+  segment_info_assert(b, 0, 134, 0, 2);
+
+  /* Surrogate pairs are never split across parts */
+  len = 0; build_utf16be_string(b, &len, ha, 1, 66);
+  build_utf16be_string(b, &len, grimace, 2, 1);
+  build_utf16be_string(b, &len, ha, 1, 66);
+  segment_info_assert(b, 0, 134, 0, 3);
+}
+
+/**
+ * @name encode_json_assert:
+ */
+void encode_json_assert(const char *s, const char *expect) {
+
+  char *rv = utf16be_encode_json_utf8(s);
+
+  assert(strcmp(rv, expect) == 0);
+  free(rv);
+}
+
+/**
+ * @name encode_json_differential_assert:
+ */
+void encode_json_differential_assert(const char *s) {
+
+  char *rv = utf16be_encode_json_utf8(s);
+  char *expect = reference_encode_json_utf8(s);
+
+  assert(expect != NULL);
+  assert(strcmp(rv, expect) == 0);
+
+  free(expect);
+  free(rv);
+}
+
+/**
+ * @name test_encode_json_utf8:
+ */
+void test_encode_json_utf8() {
+
+  /* Empty string */
+  encode_json_differential_assert("\0\0");
+
+  /* ASCII, with JSON escapes */
+  encode_json_differential_assert(
+    "\0T\0e\0s\0t\0\"\0\\\0\r\0\n\0\t\0\b\0\f\0/\0\0"
+  );
+
+  /* U+00E9, U+20AC, U+0939: two and three-byte forms */
+  encode_json_differential_assert("\x00\xe9\x20\xac\x09\x39\0\0");
+
+  /* U+1F62C: Grimacing Face, U+1F610: Neutral Face */
+  encode_json_differential_assert("\xd8\x3d\xde\x2c\xd8\x3d\xde\x10\0\0");
+
+  /* U+FFFF and U+10FFFF: upper bounds */
+  encode_json_differential_assert("\xff\xff\xdb\xff\xdf\xff\0\0");
+
+  /* Pseudo-random valid BMP and astral text */
+  char b[2 * 512 + 2];
+  uint32_t seed = 0x5eed;
+
+  for (unsigned int n = 0; n < 256; ++n) {
+
+    size_t j = 0;
+
+    while (j < 2 * 500) {
+
+      seed = seed * 1103515245 + 12345;
+      codepoint_t c = (seed >> 8) % 0x110000;
+
+      if (c < 0x20 || (c >= 0xd800 && c <= 0xdfff)) {
+        continue;
+      }
+
+      if (c >= 0x10000) {
+        c -= 0x10000;
+        uint16_t lead = 0xd800 + (c >> 10), trail = 0xdc00 + (c & 0x3ff);
+        b[j++] = lead >> 8; b[j++] = lead & 0xff;
+        b[j++] = trail >> 8; b[j++] = trail & 0xff;
+      } else {
+        b[j++] = c >> 8; b[j++] = c & 0xff;
+      }
+    }
+
+    b[j++] = '\0'; b[j] = '\0';
+    encode_json_differential_assert(b);
+  }
+
+  /* Other control characters: escaped as \u00XX */
+  encode_json_assert("\0\x01\0a\0\x1f\0\0", "\\u0001a\\u001f");
+
+  /* Unmatched surrogates: iconv fails; U+FFFD is substituted */
+  assert(reference_encode_json_utf8("\xd8\x3d\0a\0\0") == NULL);
+  encode_json_assert("\xd8\x3d\0a\0\0", "\xef\xbf\xbd" "a");
+  encode_json_assert("\0a\xde\x2c\0\0", "a\xef\xbf\xbd");
+  encode_json_assert("\xd8\x3d\0\0", "\xef\xbf\xbd");
+}
+
 /**
  * @name main:
  */
+/**
+ * @name national_info_assert:
+ */
+void national_info_assert(const char *utf8, boolean_t possible,
+                          unsigned int locking, unsigned int single,
+                          size_t septets, unsigned int parts) {
+
+  gsm_national_info_t i;
+  char *s = convert_utf8_utf16be((char *) utf8, FALSE);
+
+  assert(s);
+  assert(utf16be_national_info(s, &i) == possible);
+
+  if (possible) {
+    assert(i.locking == locking);
+    assert(i.single == single);
+    assert(i.septets == septets);
+    assert(i.parts == parts);
+  }
+
+  free(s);
+}
+
+#define national_locking_entry(septet, codepoint, a) \
+  [(septet)] = (codepoint),
+
+static const uint16_t turkish_locking[128] = {
+  GSM0338_TURKISH_LOCKING_SHIFT(national_locking_entry, 0)
+};
+
+static const uint16_t spanish_single[128] = {
+  GSM0338_SPANISH_SINGLE_SHIFT(national_locking_entry, 0)
+};
+
+void test_national_info() {
+
+  char b[2 * 1024];
+  size_t len;
+  uint8_t septets[sms_gsm_single_septets];
+
+  const uint16_t a[] = { 'a' };
+  const uint16_t s_cedilla[] = { 0x015f };
+  const uint16_t u_acute[] = { 0x00fa };
+
+  /* Capacity, including the user data header */
+  assert(sms_gsm_septet_capacity(0, FALSE) == sms_gsm_single_septets);
+  assert(sms_gsm_septet_capacity(0, TRUE) == sms_gsm_multipart_septets);
+  assert(sms_gsm_septet_capacity(1, FALSE) == 155);
+  assert(sms_gsm_septet_capacity(2, FALSE) == 152);
+  assert(sms_gsm_septet_capacity(1, TRUE) == 149);
+  assert(sms_gsm_septet_capacity(2, TRUE) == 146);
+
+  /* Language names and identifiers */
+  assert(strcmp(gsm_language_name(0), "default") == 0);
+  assert(strcmp(gsm_language_name(1), "turkish") == 0);
+  assert(gsm_language_name(gsm0338_language_count) == NULL);
+  assert(gsm_language_identifier(4) == 0x06);
+  assert(gsm_default_codepoint(0x1b) == 0x00a0);
+  assert(gsm_default_codepoint(0x41) == 'A');
+
+  /* Default alphabet needs no shift tables */
+  national_info_assert("hello", TRUE, 0, 0, 5, 1);
+
+  /* Single shift is preferred to locking shift, all else equal */
+  national_info_assert("ışığ", TRUE, 0, 1, 8, 1);
+  national_info_assert("canción", TRUE, 0, 2, 8, 1);
+
+  /* Locking shift, where single shift isn't enough */
+  national_info_assert("नमस्ते दुनिया", TRUE, 4, 0, 13, 1);
+  national_info_assert("\xe4\xbd\xa0\xe5\xa5\xbd", FALSE, 0, 0, 0, 0);
+
+  /* Fewest parts wins over fewest information elements */
+  len = 0; build_utf16be_string(b, &len, s_cedilla, 1, 200);
+
+  gsm_national_info_t i;
+  assert(utf16be_national_info(b, &i));
+  assert(i.locking == 1 && i.single == 0);
+  assert(i.septets == 200 && i.parts == 2);
+
+  const char *p = b;
+  assert(utf16be_encode_gsm_part(&p, &i, 149, septets) == 149);
+  assert(turkish_locking[septets[0]] == 0x015f);
+  assert(p == b + 2 * 149);
+  assert(utf16be_encode_gsm_part(&p, &i, 149, septets) == 51);
+  assert(p[0] == 0 && p[1] == 0);
+
+  /* Escape sequences are never split across parts */
+  len = 0; build_utf16be_string(b, &len, a, 1, 148);
+  build_utf16be_string(b, &len, u_acute, 1, 1);
+  build_utf16be_string(b, &len, a, 1, 10);
+
+  assert(utf16be_national_info(b, &i));
+  assert(i.locking == 0 && i.single == 2);
+  assert(i.septets == 160 && i.parts == 2);
+
+  p = b;
+  assert(utf16be_encode_gsm_part(&p, &i, 149, septets) == 148);
+  assert(utf16be_encode_gsm_part(&p, &i, 149, septets) == 12);
+  assert(septets[0] == 0x1b && spanish_single[septets[1]] == 0x00fa);
+  assert(septets[2] == 0x61);
+}
+
+/**
+ * @name compose_assert:
+ */
+void compose_assert(const char *utf8, const char *expect, size_t count) {
+
+  char *s = convert_utf8_utf16be((char *) utf8, FALSE);
+
+  assert(s);
+  assert(utf16be_compose(s) == count);
+
+  char *rv = convert_utf8_utf16be(s, TRUE);
+
+  assert(rv);
+  assert(strcmp(rv, expect) == 0);
+
+  free(rv);
+  free(s);
+}
+
+#define composition_pair_entry(first, second, composite, a) \
+  { (first), (second), (composite) },
+
+void test_compose() {
+
+  const uint16_t pairs[][3] = {
+    UNICODE_COMPOSITIONS(composition_pair_entry, 0)
+  };
+
+  /* Every pair composes, and the table is sorted */
+  for (size_t i = 0; i < unicode_composition_count; ++i) {
+
+    char b[8];
+    size_t len = 0;
+
+    build_utf16be_string(b, &len, pairs[i], 2, 1);
+    assert(utf16be_compose(b) == 1);
+    assert(utf16be_length(b) == 1);
+    assert(((uint8_t) b[0] << 8 | (uint8_t) b[1]) == pairs[i][2]);
+
+    if (i > 0) {
+      assert(pairs[i - 1][0] < pairs[i][0] ||
+        (pairs[i - 1][0] == pairs[i][0] && pairs[i - 1][1] < pairs[i][1]));
+    }
+  }
+
+  compose_assert("", "", 0);
+  compose_assert("plain text", "plain text", 0);
+  compose_assert("e\xcc\x81", "\xc3\xa9", 1);
+  compose_assert("Cafe\xcc\x81 cre\xcc\x80me", "Caf\xc3\xa9 cr\xc3\xa8me", 2);
+
+  /* Marks in canonical order compose in turn */
+  compose_assert("a\xcc\xa3\xcc\x82", "\xe1\xba\xad", 2);
+
+  /* Blocked by an earlier mark of the same class */
+  compose_assert("a\xcc\x81\xcc\x81", "\xc3\xa1\xcc\x81", 1);
+
+  /* Leading combining mark; nothing to compose with */
+  compose_assert("\xcc\x81" "e", "\xcc\x81" "e", 0);
+
+  /* Algorithmic Hangul syllables */
+  compose_assert("\xe1\x84\x80\xe1\x85\xa1\xe1\x86\xa8", "\xea\xb0\x81", 2);
+
+  /* Composition exclusions are left alone */
+  compose_assert("\xe0\xa4\x95\xe0\xa4\xbc", "\xe0\xa4\x95\xe0\xa4\xbc", 0);
+
+  /* Supplementary characters are copied, and never compose */
+  compose_assert(
+    "\xf0\x9f\x98\x80" "e\xcc\x81\xf0\x9f\x98\x80\xcc\x81",
+    "\xf0\x9f\x98\x80\xc3\xa9\xf0\x9f\x98\x80\xcc\x81", 1
+  );
+}
+
+/**
+ * @name transliterate_assert:
+ */
+void transliterate_assert(const transliteration_table_t *t,
+                          const char *utf8, const char *expect,
+                          size_t substitutions) {
+  size_t n;
+  char *s = convert_utf8_utf16be((char *) utf8, FALSE);
+
+  assert(s);
+  char *r = utf16be_transliterate(s, t, &n);
+  char *rv = convert_utf8_utf16be(r, TRUE);
+
+  assert(rv);
+  assert(n == substitutions);
+  assert(strcmp(rv, expect) == 0);
+
+  free(rv);
+  free(r);
+  free(s);
+}
+
+void test_transliterate() {
+
+  transliteration_table_t *t = create_transliteration_table(TRUE);
+
+  /* Entries are sorted and unique */
+  for (size_t i = 1; i < t->count; ++i) {
+    assert(t->entries[i - 1].codepoint < t->entries[i].codepoint);
+  }
+
+  transliterate_assert(t, "", "", 0);
+  transliterate_assert(t, "plain", "plain", 0);
+
+  transliterate_assert(
+    t, "\xe2\x80\x9cHello\xe2\x80\x9d \xe2\x80\x94 it\xe2\x80\x99s ok\xe2\x80\xa6",
+    "\"Hello\" - it's ok...", 5
+  );
+
+  /* Removal, and supplementary characters */
+  transliterate_assert(
+    t, "a\xe2\x80\x8b" "b\xf0\x9f\x98\x80", "ab\xf0\x9f\x98\x80", 1
+  );
+
+  /* Overrides and additions */
+  assert(transliteration_table_add(t, 0x2014, "--"));
+  assert(transliteration_table_add(t, 0x1f600, ":)"));
+  assert(!transliteration_table_add(t, 0xd800, "x"));
+  assert(!transliteration_table_add(t, 0x110000, "x"));
+  assert(!transliteration_table_add(t, 0x2014, "\xff"));
+
+  transliterate_assert(
+    t, "a\xe2\x80\x94" "b\xf0\x9f\x98\x80", "a--b:)", 2
+  );
+
+  release_transliteration_table(t);
+
+  /* Empty table */
+  t = create_transliteration_table(FALSE);
+  assert(t->count == 0);
+  transliterate_assert(t, "\xe2\x80\xa6", "\xe2\x80\xa6", 0);
+  release_transliteration_table(t);
+}
+
+/**
+ * @name utf8_info_assert:
+ */
+void utf8_info_assert(const char *s, boolean_t valid,
+                      size_t bytes, size_t units, size_t symbols,
+                      string_decode_error_t error, size_t error_offset,
+                      size_t invalid_bytes) {
+  string_info_t si;
+
+  assert(utf8_string_info(s, &si) == valid);
+  assert(si.bytes == bytes);
+  assert(si.units == units);
+  assert(si.symbols == symbols);
+  assert(si.error == error);
+  assert(si.error_offset == error_offset);
+  assert(si.invalid_bytes == invalid_bytes);
+
+  char *u = utf8_encode_utf16be(s, &si);
+  assert((u != NULL) == valid);
+  free(u);
+}
+
+/**
+ * @name test_utf8_string_info:
+ */
+void test_utf8_string_info() {
+
+  /* Valid: one, two, three, and four-byte sequences */
+  utf8_info_assert("", TRUE, 0, 0, 0, D_ERR_NONE, 0, 0);
+  utf8_info_assert("abc", TRUE, 3, 3, 3, D_ERR_NONE, 0, 0);
+  utf8_info_assert("\xc3\xa9", TRUE, 2, 1, 1, D_ERR_NONE, 0, 0);
+  utf8_info_assert("\xe2\x82\xac", TRUE, 3, 1, 1, D_ERR_NONE, 0, 0);
+  utf8_info_assert("\xf0\x9f\x98\x80", TRUE, 4, 2, 1, D_ERR_NONE, 0, 0);
+  utf8_info_assert("\xf4\x8f\xbf\xbf", TRUE, 4, 2, 1, D_ERR_NONE, 0, 0);
+  utf8_info_assert("\xed\x9f\xbf", TRUE, 3, 1, 1, D_ERR_NONE, 0, 0);
+  utf8_info_assert("\xee\x80\x80", TRUE, 3, 1, 1, D_ERR_NONE, 0, 0);
+
+  /* Stray continuation bytes, and bytes that never appear */
+  utf8_info_assert("a\x80z", FALSE, 3, 2, 2, D_ERR_INVALID_BYTE, 1, 1);
+  utf8_info_assert("ab\xbf\xbf", FALSE, 4, 2, 2, D_ERR_INVALID_BYTE, 2, 2);
+  utf8_info_assert("\xff", FALSE, 1, 0, 0, D_ERR_INVALID_BYTE, 0, 1);
+  utf8_info_assert("\xf8\x88\x80\x80", FALSE,
+                   4, 0, 0, D_ERR_INVALID_BYTE, 0, 4);
+
+  /* Overlong encodings */
+  utf8_info_assert("a\xc0\xaf", FALSE, 3, 1, 1, D_ERR_OVERLONG, 1, 2);
+  utf8_info_assert("\xc1\xbf", FALSE, 2, 0, 0, D_ERR_OVERLONG, 0, 2);
+  utf8_info_assert("\xe0\x80\xaf", FALSE, 3, 0, 0, D_ERR_OVERLONG, 0, 3);
+  utf8_info_assert("\xf0\x8f\xbf\xbf", FALSE, 4, 0, 0, D_ERR_OVERLONG, 0, 4);
+
+  /* Encoded surrogates */
+  utf8_info_assert("x\xed\xa0\x80", FALSE,
+                   4, 1, 1, D_ERR_ENCODED_SURROGATE, 1, 3);
+  utf8_info_assert("\xed\xbf\xbf", FALSE,
+                   3, 0, 0, D_ERR_ENCODED_SURROGATE, 0, 3);
+
+  /* Beyond U+10FFFF */
+  utf8_info_assert("\xf4\x90\x80\x80", FALSE,
+                   4, 0, 0, D_ERR_OUT_OF_RANGE, 0, 4);
+  utf8_info_assert("\xf5\x80\x80\x80", FALSE,
+                   4, 0, 0, D_ERR_OUT_OF_RANGE, 0, 4);
+
+  /* Truncation: by another character, and by the terminator */
+  utf8_info_assert("\xe2\x82z", FALSE, 3, 1, 1, D_ERR_TRUNCATED, 0, 2);
+  utf8_info_assert("ab\xf0\x9f\x98", FALSE, 5, 2, 2, D_ERR_TRUNCATED, 2, 3);
+  utf8_info_assert("\xc3", FALSE, 1, 0, 0, D_ERR_TRUNCATED, 0, 1);
+
+  /* Only the first error is reported; all invalid bytes are counted */
+  utf8_info_assert("\xc3\xa9\xc3(\xed\xa0\x80\xe2\x82\xac", FALSE,
+                   10, 3, 3, D_ERR_TRUNCATED, 2, 4);
+}
+
+/**
+ * @name utf8_write_codepoint:
+ *   Write the UTF-8 encoding of `c` to `b`, and return the
+ *   number of bytes written. No terminator is written.
+ */
+size_t utf8_write_codepoint(char *b, codepoint_t c) {
+
+  uint8_t *p = (uint8_t *) b;
+
+  if (c < 0x80) {
+    p[0] = c;
+    return 1;
+  } else if (c < 0x800) {
+    p[0] = 0xc0 | (c >> 6);
+    p[1] = 0x80 | (c & 0x3f);
+    return 2;
+  } else if (c < 0x10000) {
+    p[0] = 0xe0 | (c >> 12);
+    p[1] = 0x80 | ((c >> 6) & 0x3f);
+    p[2] = 0x80 | (c & 0x3f);
+    return 3;
+  }
+
+  p[0] = 0xf0 | (c >> 18);
+  p[1] = 0x80 | ((c >> 12) & 0x3f);
+  p[2] = 0x80 | ((c >> 6) & 0x3f);
+  p[3] = 0x80 | (c & 0x3f);
+  return 4;
+}
+
+/**
+ * @name utf8_iconv_utf16be:
+ *   Convert the valid UTF-8 string `s` to UTF-16BE using iconv,
+ *   writing the result to `out`. Returns the number of bytes written.
+ */
+size_t utf8_iconv_utf16be(const char *s, char *out, size_t size) {
+
+  iconv_t iv = iconv_open("UTF-16BE", "UTF-8");
+  assert(iv != (iconv_t) -1);
+
+  char *fp = (char *) s, *tp = out;
+  size_t in = strlen(s), remaining = size;
+
+  assert(iconv(iv, &fp, &in, &tp, &remaining) != (size_t) -1);
+  iconv_close(iv);
+
+  return (size - remaining);
+}
+
+/**
+ * @name test_utf8_encode_utf16be:
+ *   Encode every Unicode scalar value, both alone and following a
+ *   long run of ASCII, then compare randomized mixed-script strings
+ *   against iconv for every available instruction set. Strings are
+ *   placed at every alignment, and right up against a page boundary.
+ */
+void test_utf8_encode_utf16be() {
+
+  char b[64];
+  string_info_t si;
+
+  for (codepoint_t c = 1; c < 0x110000; ++c) {
+
+    /* Skip surrogates */
+    if (c == 0xd800) {
+      c = 0xe000;
+    }
+
+    memcpy(b, "0123456789abcdefghijklmnopqrstu", 31);
+    size_t n = utf8_write_codepoint(b + 31, c);
+    b[31 + n] = '\0';
+
+    for (size_t offset = 0; offset <= 31; offset += 31) {
+
+      char *u = utf8_encode_utf16be(b + offset, &si);
+      size_t units = (c >= 0x10000 ? 2 : 1) + (31 - offset);
+
+      assert(u != NULL);
+      assert(si.units == units);
+      assert(si.bytes == n + (31 - offset));
+      assert(u[2 * units] == '\0' && u[2 * units + 1] == '\0');
+
+      size_t decoded = 0;
+      codepoint_t d = utf16be_decode_codepoint(u + 2 * (31 - offset), &decoded);
+      assert(d == c && decoded == units - (31 - offset));
+
+      if (offset == 0) {
+        assert(u[0] == '\0' && u[1] == '0' && u[61] == 'u');
+      }
+
+      free(u);
+    }
+  }
+
+  static const char *const samples[] = {
+    "a", "Z", " ", "\xc3\xa9", "\xe2\x82\xac", "\xe0\xa4\xb9",
+    "\xf0\x9f\x98\x80", "\xd0\x96", "\n"
+  };
+
+  unsigned int levels[] = { CPU_NONE, CPU_SSE2, CPU_ALL };
+
+  size_t page = 4096;
+  char *region = NULL, expect[1024];
+
+  assert(posix_memalign((void **) &region, page, 2 * page) == 0);
+
+  for (unsigned int l = 0; l < sizeof(levels) / sizeof(*levels); ++l) {
+
+    uint32_t seed = 0x5eed;
+    cpu_features_restrict(levels[l]);
+
+    for (unsigned int noise = 0; noise <= 30; noise += 5) {
+      for (size_t symbols = 0; symbols < 96; ++symbols) {
+
+        char s[512];
+        size_t len = 0;
+
+        for (size_t i = 0; i < symbols; ++i) {
+
+          seed = seed * 1103515245 + 12345;
+
+          const char *sample = (
+            (seed >> 16) % 100 < noise ?
+              samples[(seed >> 8) % (sizeof(samples) / sizeof(*samples))]
+              : samples[(seed >> 8) % 3]
+          );
+
+          memcpy(s + len, sample, strlen(sample));
+          len += strlen(sample);
+        }
+
+        s[len] = '\0';
+        size_t expect_bytes = utf8_iconv_utf16be(s, expect, sizeof(expect));
+
+        char *placements[] = {
+          region + 64, region + 65, region + page - len - 1
+        };
+
+        for (unsigned int p = 0; p < 3; ++p) {
+
+          memcpy(placements[p], s, len + 1);
+          char *u = utf8_encode_utf16be(placements[p], &si);
+
+          assert(u != NULL);
+          assert(si.bytes == len);
+          assert(2 * si.units == expect_bytes);
+          assert(memcmp(u, expect, expect_bytes) == 0);
+
+          free(u);
+        }
+      }
+    }
+  }
+
+  cpu_features_restrict(CPU_ALL);
+  free(region);
+}
+
+/**
+ * @name preflight_differential_assert:
+ *   Check that `utf8_preflight` agrees with the separate validation,
+ *   conversion, and segment information passes that it replaces.
+ */
+void preflight_differential_assert(const char *s) {
+
+  sms_segment_info_t seg, expect_seg;
+  string_info_t si, expect_si;
+
+  char *u = utf8_preflight(s, &si, &seg);
+  char *expect = utf8_encode_utf16be(s, &expect_si);
+
+  assert(si.bytes == expect_si.bytes);
+  assert(si.units == expect_si.units);
+  assert(si.symbols == expect_si.symbols);
+  assert(si.error == expect_si.error);
+  assert(si.error_offset == expect_si.error_offset);
+  assert(si.invalid_bytes == expect_si.invalid_bytes);
+
+  if (!expect) {
+    assert(u == NULL);
+    return;
+  }
+
+  assert(u != NULL);
+  assert(memcmp(u, expect, 2 * si.units + 2) == 0);
+
+  boolean_t is_gsm = utf16be_segment_info(expect, &expect_seg);
+
+  assert(is_gsm == (seg.non_gsm_offset < 0));
+  assert(seg.units == expect_seg.units);
+  assert(seg.septets == expect_seg.septets);
+  assert(seg.gsm_parts == expect_seg.gsm_parts);
+  assert(seg.ucs2_parts == expect_seg.ucs2_parts);
+  assert(seg.non_gsm_offset == expect_seg.non_gsm_offset);
+
+  free(expect);
+  free(u);
+}
+
+/**
+ * @name test_preflight:
+ *   Compare `utf8_preflight` against the multi-pass equivalent for
+ *   pseudo-random strings around the single and multipart boundaries,
+ *   with extension table, non-GSM, supplementary, and invalid input.
+ */
+void test_preflight() {
+
+  static const char *const samples[] = {
+    "a", "Z", " ", "\xc3\xa9", "{", "\xe2\x82\xac", "`",
+    "\xe0\xa4\xb9", "\xf0\x9f\x98\x80", "\n", "\xc3", "\xed\xa0\x80"
+  };
+
+  char s[2048];
+  uint32_t seed = 0x5eed;
+
+  preflight_differential_assert("");
+
+  for (unsigned int noise = 0; noise <= 12; noise += 1) {
+    for (size_t symbols = 0; symbols < 400; symbols += 7) {
+
+      size_t len = 0;
+
+      for (size_t i = 0; i < symbols; ++i) {
+
+        seed = seed * 1103515245 + 12345;
+
+        /* Rarely more than one unusual character per string */
+        const char *sample = (
+          (seed >> 16) % 400 < noise ?
+            samples[(seed >> 8) % (sizeof(samples) / sizeof(*samples))]
+            : samples[(seed >> 8) % 3]
+        );
+
+        memcpy(s + len, sample, strlen(sample));
+        len += strlen(sample);
+      }
+
+      s[len] = '\0';
+      preflight_differential_assert(s);
+    }
+  }
+}
+
+/**
+ * @name test_slices:
+ *   Check that the slice-based functions honour the slice length:
+ *   they must agree with their null-terminated counterparts, report
+ *   sequences cut short by the end of a slice as truncated, and never
+ *   read beyond the end of a slice -- even at the end of a page.
+ */
+void test_slices() {
+
+  string_info_t si;
+  sms_segment_info_t seg;
+
+  /* Sequences cut short by the end of the slice */
+  const char *s = "ab\xe2\x82\xac" "cd";
+  string_slice_t slice = { s, 4 };
+
+  assert(!utf8_string_info_slice(slice, &si));
+  assert(si.error == D_ERR_TRUNCATED && si.error_offset == 2);
+  assert(si.bytes == 4 && si.units == 2 && si.invalid_bytes == 2);
+  assert(utf8_encode_utf16be_slice(slice, &si) == NULL);
+  assert(utf8_preflight_slice(slice, &si, &seg) == NULL);
+  assert(si.error == D_ERR_TRUNCATED);
+
+  /* A complete prefix */
+  slice.length = 5;
+  char *u = utf8_preflight_slice(slice, &si, &seg);
+
+  assert(u != NULL && si.units == 3 && si.bytes == 5);
+  assert(memcmp(u, "\0a\0b\x20\xac\0\0", 8) == 0);
+  assert(seg.non_gsm_offset < 0 && seg.septets == 4);
+  free(u);
+
+  /* An empty slice */
+  slice.length = 0;
+  u = utf8_encode_utf16be_slice(slice, &si);
+  assert(u != NULL && si.units == 0 && u[0] == '\0' && u[1] == '\0');
+  free(u);
+
+  /* A null character ends a slice early */
+  slice.data = "ab\0cd";
+  slice.length = 5;
+  assert(utf8_string_info_slice(slice, &si) && si.bytes == 2);
+
+  /* UTF-16BE slices */
+  const char *w = "\0a\0\"\0b\0c\0\0";
+  char *j = utf16be_encode_json_utf8_slice(utf16be_slice_units(w, 3));
+  assert(strcmp(j, "a\\\"b") == 0);
+  free(j);
+
+  assert(utf16be_slice(w).length == 8);
+  assert(utf8_slice("abc").length == 3);
+
+  char *r = convert_utf8_utf16be_slice(utf16be_slice_units(w, 2), TRUE);
+  assert(strcmp(r, "a\"") == 0);
+  free(r);
+
+  /* Unterminated slices against the end of a page */
+  unsigned int levels[] = { CPU_NONE, CPU_SSE2, CPU_ALL };
+
+  size_t page = 4096;
+  char *region = NULL;
+
+  assert(posix_memalign((void **) &region, page, 2 * page) == 0);
+  char *end = region + page;
+
+  for (unsigned int l = 0; l < sizeof(levels) / sizeof(*levels); ++l) {
+
+    cpu_features_restrict(levels[l]);
+
+    for (size_t length = 0; length < 100; ++length) {
+
+      char *b = end - length;
+      memset(b, 'x', length);
+
+      /* Place a multibyte sequence that the slice cuts in half */
+      if (length >= 2) {
+        b[length - 1] = '\xc3';
+      }
+
+      slice.data = b;
+      slice.length = length;
+
+      boolean_t expect = (length < 2);
+      assert(utf8_string_info_slice(slice, &si) == expect);
+      assert(si.bytes == length);
+
+      u = utf8_preflight_slice(slice, &si, &seg);
+      assert((u != NULL) == expect);
+      free(u);
+
+      /* Valid throughout */
+      if (length >= 2) {
+        b[length - 1] = 'y';
+      }
+
+      u = utf8_preflight_slice(slice, &si, &seg);
+      assert(u != NULL && si.units == length);
+      assert(length == 0 || u[2 * length - 1] == (length >= 2 ? 'y' : 'x'));
+      free(u);
+
+      u = utf8_encode_utf16be_slice(slice, &si);
+      assert(u != NULL && si.units == length);
+      free(u);
+    }
+  }
+
+  cpu_features_restrict(CPU_ALL);
+  free(region);
+}
+
+/**
+ * @name test_into:
+ *   Check the caller-supplied buffer variants: they must report the
+ *   exact size required, write nothing if the buffer is too small,
+ *   and otherwise agree with the allocating functions.
+ */
+void test_into() {
+
+  char b[1024], s[512];
+  uint32_t seed = 0x5eed;
+
+  for (unsigned int noise = 0; noise <= 30; noise += 3) {
+    for (size_t units = 0; units < 80; ++units) {
+
+      random_utf16be_string(s, units, noise, &seed);
+
+      /* JSON encoding: exact size, with every smaller buffer */
+      char *expect = utf16be_encode_json_utf8(s);
+      size_t required = strlen(expect) + 1;
+
+      assert(utf16be_encode_json_utf8_into(s, b, sizeof(b)) == required);
+      assert(strcmp(b, expect) == 0);
+
+      for (size_t size = 0; size < required; ++size) {
+        memset(b, 'z', sizeof(b));
+        assert(utf16be_encode_json_utf8_into(s, b, size) == required);
+        assert(b[0] == 'z');
+      }
+
+      assert(utf16be_encode_json_utf8_into(s, b, required) == required);
+      assert(strcmp(b, expect) == 0);
+      free(expect);
+
+      /* UTF-16BE to UTF-8 */
+      expect = convert_utf8_utf16be(s, TRUE);
+      required = convert_utf8_utf16be_into(s, TRUE, b, sizeof(b));
+
+      if (!expect) {
+        assert(required == 0);
+        continue;
+      }
+
+      assert(required == strlen(expect) + 1);
+      assert(strcmp(b, expect) == 0);
+      assert(convert_utf8_utf16be_into(s, TRUE, b, required - 1) == required);
+
+      /* And back again */
+      char *utf8 = expect;
+      char *u = convert_utf8_utf16be(utf8, FALSE);
+
+      required = convert_utf8_utf16be_into(utf8, FALSE, b, sizeof(b));
+      assert(required == 2 * units + 2);
+      assert(memcmp(b, u, required) == 0);
+      assert(memcmp(b, s, required) == 0);
+
+      memset(b, 'z', sizeof(b));
+      assert(convert_utf8_utf16be_into(utf8, FALSE, b, required - 1) == required);
+      assert(b[0] == 'z');
+
+      free(utf8);
+      free(u);
+    }
+  }
+
+  /* Invalid input */
+  assert(convert_utf8_utf16be_into("a\xc3", FALSE, b, sizeof(b)) == 0);
+  assert(convert_utf8_utf16be_into("\xd8\x3d\0\0", TRUE, b, sizeof(b)) == 0);
+}
+
+/**
+ * @name test_payload_decoding:
+ */
+static void test_payload_decoding() {
+
+  uint8_t b[64];
+
+  /* Hexadecimal */
+  assert(hex_decode_octets(utf8_slice("00fF10"), b, sizeof(b)) == 3);
+  assert(memcmp(b, "\x00\xff\x10", 3) == 0);
+  assert(hex_decode_octets(utf8_slice(""), b, sizeof(b)) == 0);
+  assert(hex_decode_octets(utf8_slice("abc"), b, sizeof(b)) < 0);
+  assert(hex_decode_octets(utf8_slice("zz"), b, sizeof(b)) < 0);
+  assert(hex_decode_octets(utf8_slice("0011"), b, 1) < 0);
+
+  /* Base64, with and without padding */
+  assert(base64_decode_octets(utf8_slice("TWFu"), b, sizeof(b)) == 3);
+  assert(memcmp(b, "Man", 3) == 0);
+  assert(base64_decode_octets(utf8_slice("TWE="), b, sizeof(b)) == 2);
+  assert(memcmp(b, "Ma", 2) == 0);
+  assert(base64_decode_octets(utf8_slice("TWE"), b, sizeof(b)) == 2);
+  assert(base64_decode_octets(utf8_slice("TQ=="), b, sizeof(b)) == 1);
+  assert(base64_decode_octets(utf8_slice("TQ"), b, sizeof(b)) == 1);
+  assert(b[0] == 'M');
+  assert(base64_decode_octets(utf8_slice("+/8="), b, sizeof(b)) == 2);
+  assert(b[0] == 0xfb && b[1] == 0xff);
+
+  /* Base64, invalid */
+  assert(base64_decode_octets(utf8_slice("T"), b, sizeof(b)) < 0);
+  assert(base64_decode_octets(utf8_slice("TR=="), b, sizeof(b)) < 0);
+  assert(base64_decode_octets(utf8_slice("TW!u"), b, sizeof(b)) < 0);
+  assert(base64_decode_octets(utf8_slice("TQ==TQ=="), b, sizeof(b)) < 0);
+  assert(base64_decode_octets(utf8_slice("TWFu"), b, 2) < 0);
+
+  /* Round trip through the hexadecimal encoder */
+  char hex[2 * sizeof(b) + 1];
+
+  for (unsigned int i = 0; i < sizeof(b); ++i) {
+    b[i] = (uint8_t) (i * 37 + 11);
+  }
+
+  size_t n = octets_encode_hex(b, sizeof(b), hex);
+  hex[n] = '\0';
+
+  uint8_t d[sizeof(b)];
+  assert(hex_decode_octets(utf8_slice(hex), d, sizeof(d)) == sizeof(b));
+  assert(memcmp(b, d, sizeof(b)) == 0);
+}
+
+/**
+ * @name test_payload_encoding:
+ */
+static void test_payload_encoding() {
+
+  uint8_t p[256], d[256];
+  char hex[2 * sizeof(p) + 1], b64[base64_encoded_length(sizeof(p)) + 1];
+
+  const unsigned int levels[] = {
+    CPU_NONE, CPU_SSE2 | CPU_SSSE3, CPU_ALL
+  };
+
+  /* Known vectors, from RFC 4648 */
+  const char *vectors[][2] = {
+    { "", "" }, { "f", "Zg==" }, { "fo", "Zm8=" }, { "foo", "Zm9v" },
+    { "foob", "Zm9vYg==" }, { "fooba", "Zm9vYmE=" },
+    { "foobar", "Zm9vYmFy" }
+  };
+
+  for (unsigned int i = 0; i < sizeof(vectors) / sizeof(*vectors); ++i) {
+    size_t n = strlen(vectors[i][0]);
+    assert(octets_encode_base64(
+      (const uint8_t *) vectors[i][0], n, b64) == strlen(vectors[i][1]));
+    assert(strcmp(b64, vectors[i][1]) == 0);
+  }
+
+  assert(octets_encode_hex((const uint8_t *) "\x00\xab\x7f", 3, hex) == 6);
+  assert(strcmp(hex, "00AB7F") == 0);
+
+  for (unsigned int i = 0; i < sizeof(p); ++i) {
+    p[i] = (uint8_t) (i * 151 + 7);
+  }
+
+  /* Every length, at every dispatch level */
+  for (unsigned int l = 0; l < sizeof(levels) / sizeof(*levels); ++l) {
+
+    cpu_features_restrict(levels[l]);
+
+    for (size_t n = 0; n <= sizeof(p); ++n) {
+
+      memset(hex, 'z', sizeof(hex));
+      assert(octets_encode_hex(p, n, hex) == 2 * n);
+      assert(hex[2 * n] == '\0');
+
+      for (size_t i = 0; i < n; ++i) {
+        assert(hex[2 * i] == "0123456789ABCDEF"[p[i] >> 4]);
+        assert(hex[2 * i + 1] == "0123456789ABCDEF"[p[i] & 0x0f]);
+      }
+
+      memset(b64, 'z', sizeof(b64));
+      size_t m = octets_encode_base64(p, n, b64);
+
+      assert(m == base64_encoded_length(n));
+      assert(b64[m] == '\0');
+      assert(strlen(b64) == m);
+
+      memset(d, 0, sizeof(d));
+      assert(base64_decode_octets(utf8_slice(b64), d, sizeof(d)) == n);
+      assert(memcmp(p, d, n) == 0);
+    }
+  }
+
+  cpu_features_restrict(CPU_ALL);
+}
+
 int main(int argc, char *argv[]) {
 
   test_string_info();
+  test_string_info_vectorized();
+  test_utf8_string_info();
+  test_utf8_encode_utf16be();
+  test_preflight();
+  test_slices();
+  test_into();
+  test_gsm_classification();
+  test_segment_info();
+  test_national_info();
+  test_compose();
+  test_transliterate();
+  test_encode_json_utf8();
+  test_payload_decoding();
+  test_payload_encoding();
 }
 
 /* vim: set ts=4 sts=2 sw=2 expandtab: */
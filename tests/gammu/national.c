@@ -0,0 +1,151 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <assert.h>
+#include <string.h>
+#include <gammu.h>
+
+#include "allocate.h"
+#include "encoding.h"
+
+/**
+ * @name encode_default:
+ *   Encode the big-endian UTF-16 string `s` using libgammu's default
+ *   alphabet encoder, exactly as libgammu encodes the text of each
+ *   default-coded message it sends. Returns the number of septets.
+ */
+size_t encode_default(const char *s, uint8_t *septets) {
+
+  size_t length = utf16be_length(s);
+
+  EncodeDefault(septets, (unsigned char *) s, &length, TRUE, NULL);
+  return length;
+}
+
+/**
+ * @name test_stand_in_alphabet:
+ *   The stand-in character for every septet, including the escape
+ *   septet, must be encoded by libgammu as exactly that septet.
+ */
+void test_stand_in_alphabet() {
+
+  char text[2 * (1 + 1)];
+  uint8_t encoded[2 * sms_gsm_single_septets + 1];
+
+  for (unsigned int i = 0; i <= 0x7f; ++i) {
+
+    uint8_t septet = (uint8_t) i;
+    gsm_stand_in_utf16be(&septet, 1, text);
+
+    assert(encode_default(text, encoded) == 1);
+    assert(encoded[0] == septet);
+  }
+}
+
+/**
+ * @name test_single_shift:
+ *   A multipart message that needs the Turkish single shift table
+ *   must survive a round trip: septets, to stand-in text, through
+ *   libgammu's encoder, and back to the original text.
+ */
+void test_single_shift() {
+
+  string_info_t si;
+  gsm_national_info_t n;
+
+  const char *turkish = (
+    "I\xc5\x9f\xc4\xb1\xc4\x9f\xc4\xb1 a\xc3\xa7\xc4\xb1k, "
+    "\xc4\xb0zmir'deki da\xc4\x9f yolu kapal\xc4\xb1; "
+    "ya\xc4\x9fmur ya\xc4\x9f" "d\xc4\xb1\xc4\x9f\xc4\xb1 i\xc3\xa7in "
+    "\xc5\x9f" "afakta yola \xc3\xa7\xc4\xb1kmay\xc4\xb1n. "
+    "I\xc5\x9f\xc4\xb1\xc4\x9f\xc4\xb1 a\xc3\xa7\xc4\xb1k, "
+    "\xc4\xb0zmir'deki da\xc4\x9f yolu kapal\xc4\xb1; "
+    "ya\xc4\x9fmur ya\xc4\x9f" "d\xc4\xb1\xc4\x9f\xc4\xb1 i\xc3\xa7in "
+    "\xc5\x9f" "afakta yola \xc3\xa7\xc4\xb1kmay\xc4\xb1n."
+  );
+
+  char *u = utf8_encode_utf16be(turkish, &si);
+
+  assert(utf16be_national_info(u, &n));
+  assert(n.single != 0 && n.locking == 0);
+  assert(n.parts > 1);
+
+  size_t capacity = sms_gsm_septet_capacity(
+    gsm_national_shift_elements(&n), TRUE
+  );
+
+  const char *p = u;
+  unsigned int parts = 0;
+
+  while (p[0] || p[1]) {
+
+    const char *start = p;
+    uint8_t septets[sms_gsm_single_septets];
+    uint8_t encoded[2 * sms_gsm_single_septets + 1];
+    char text[2 * (sms_gsm_single_septets + 1)];
+    char decoded[2 * (sms_gsm_single_septets + 1)];
+
+    size_t length = utf16be_encode_gsm_part(&p, &n, capacity, septets);
+    assert(length > 0);
+
+    gsm_stand_in_utf16be(septets, length, text);
+
+    assert(encode_default(text, encoded) == length);
+    assert(memcmp(encoded, septets, length) == 0);
+
+    size_t units = gsm_decode_utf16be(
+      encoded, length, n.locking, n.single, decoded
+    );
+
+    assert(2 * units == (size_t) (p - start));
+    assert(memcmp(decoded, start, 2 * units) == 0);
+
+    parts++;
+  }
+
+  assert(parts == n.parts);
+  free(u);
+}
+
+/** --- **/
+
+int main(int argc, char *argv[]) {
+
+  test_stand_in_alphabet();
+  test_single_shift();
+
+  return 0;
+}
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
@@ -0,0 +1,331 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cpu.h"
+#include "json.h"
+#include "allocate.h"
+#include "json_index.h"
+
+/** --- **/
+
+/**
+ * @name levels:
+ *   Every classifier, from narrowest to widest.
+ */
+static const unsigned int levels[] = {
+  CPU_NONE, CPU_SSE2, CPU_ALL
+};
+
+/**
+ * @name compare:
+ *   Tokenize `json` with jsmn and via the index, and check that the
+ *   index either reproduces jsmn's tokens exactly or defers to jsmn.
+ *   Returns true if the index produced the tokens itself.
+ */
+static boolean_t compare(const char *json) {
+
+  jsmn_parser parser;
+  json_index_t x = { NULL, 0, 0, 0 };
+  size_t length = strlen(json);
+  unsigned int n = length + 1;
+
+  jsmn_compact_t *expect = allocate_array(sizeof(jsmn_compact_t), n, 0);
+  jsmn_compact_t *tokens = allocate_array(sizeof(jsmn_compact_t), n, 0);
+
+  jsmn_init(&parser);
+  jsmnerr_t r = jsmn_parse_compact(&parser, json, expect, n);
+  unsigned int expect_tokens = parser.toknext;
+
+  assert(json_index_build(&x, json, length));
+  int rv = json_index_tokenize(&x, &parser, json, tokens, n);
+
+  assert(rv == JSMN_SUCCESS || rv == json_index_fallback);
+
+  if (rv == JSMN_SUCCESS) {
+
+    assert(r == JSMN_SUCCESS);
+    assert(parser.toknext == expect_tokens);
+    assert(parser.pos == length);
+
+    for (unsigned int i = 0; i < expect_tokens; ++i) {
+      assert(tokens[i].start == expect[i].start);
+      assert(tokens[i].end == expect[i].end);
+      assert(tokens[i].skip == expect[i].skip);
+    }
+  }
+
+  json_index_release(&x);
+  free(expect);
+  free(tokens);
+
+  return (rv == JSMN_SUCCESS);
+}
+
+/**
+ * @name test_well_formed:
+ *   Well-formed inputs never fall back to jsmn. Padding moves each
+ *   input across every alignment within a sixty-four byte block, so
+ *   that quotes, escapes, and primitives straddle block boundaries.
+ */
+static void test_well_formed() {
+
+  const char *inputs[] = {
+    "{}", "[]", "[1]", "[[[[]]]]", "[true, false, null, -1.5e3]",
+    "{ \"command\": \"send\", \"arguments\": [\"+15035551234\", 12] }",
+    "{\"a\":\"\\\"\",\"b\":\"\\\\\",\"c\":\"\\\\\\\"\\\\\"}",
+    "[\"\\u00e9\\u20AC\", \"\\/\\b\\f\\n\\r\\t\", \"{[,:]}\"]",
+    "[\"\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\", \"\\\\\\\"\"]",
+    "{\"x\":{\"y\":[1,{\"z\":[]}]},\"w\":\"\\u0022\"}",
+    "[1,2,3]\t\r\n [4]"
+  };
+
+  char buffer[512];
+
+  for (unsigned int l = 0; l < sizeof(levels) / sizeof(*levels); ++l) {
+
+    cpu_features_restrict(levels[l]);
+
+    for (unsigned int i = 0; i < sizeof(inputs) / sizeof(*inputs); ++i) {
+      for (unsigned int pad = 0; pad < 130; ++pad) {
+
+        memset(buffer, ' ', pad);
+        strcpy(buffer + pad, inputs[i]);
+
+        assert(compare(buffer));
+      }
+    }
+  }
+
+  cpu_features_restrict(CPU_ALL);
+}
+
+/**
+ * @name test_random:
+ *   Random strings over an alphabet of structural characters. Most
+ *   are malformed; the index must defer to jsmn for every one that
+ *   it can't reproduce.
+ */
+static void test_random() {
+
+  const char alphabet[] = "{}[]\"\\:, \n1-tu0aé";
+  char buffer[300];
+
+  srand(1);
+
+  for (unsigned int l = 0; l < sizeof(levels) / sizeof(*levels); ++l) {
+
+    cpu_features_restrict(levels[l]);
+
+    for (unsigned int i = 0; i < 20000; ++i) {
+
+      unsigned int length = rand() % (sizeof(buffer) - 1);
+
+      for (unsigned int j = 0; j < length; ++j) {
+        buffer[j] = alphabet[rand() % (sizeof(alphabet) - 1)];
+      }
+
+      buffer[length] = '\0';
+      compare(buffer);
+    }
+  }
+
+  cpu_features_restrict(CPU_ALL);
+}
+
+/**
+ * @name random_value:
+ *   Append a random, well-formed JSON value to `*p`, nesting no
+ *   deeper than `depth`.
+ */
+static void random_value(char **p, unsigned int depth) {
+
+  const char *scalars[] = {
+    "1", "-20.5e3", "true", "null", "\"\"", "\"abc\"",
+    "\"\\\"\"", "\"\\\\\"", "\"\\u00e9\"", "\"{[:,]}\""
+  };
+
+  unsigned int kind = (depth ? rand() % 4 : 0);
+  unsigned int count = rand() % 4;
+
+  switch (kind) {
+    case 1:
+      *(*p)++ = '[';
+      for (unsigned int i = 0; i < count; ++i) {
+        *p += sprintf(*p, "%s", (i ? ", " : ""));
+        random_value(p, depth - 1);
+      }
+      *(*p)++ = ']';
+      break;
+    case 2:
+      *(*p)++ = '{';
+      for (unsigned int i = 0; i < count; ++i) {
+        *p += sprintf(*p, "%s\"k%u\":%s", (i ? "," : ""), i, " \n" + i % 3);
+        random_value(p, depth - 1);
+      }
+      *(*p)++ = '}';
+      break;
+    default:
+      *p += sprintf(*p, "%s", scalars[rand() % 10]);
+      break;
+  }
+}
+
+/**
+ * @name test_random_well_formed:
+ *   Random well-formed arrays never fall back to jsmn.
+ */
+static void test_random_well_formed() {
+
+  static char buffer[65536];
+
+  srand(2);
+
+  for (unsigned int l = 0; l < sizeof(levels) / sizeof(*levels); ++l) {
+
+    cpu_features_restrict(levels[l]);
+
+    for (unsigned int i = 0; i < 2000; ++i) {
+
+      /* jsmn requires a delimiter after every primitive */
+      char *p = buffer;
+      *p++ = '[';
+      random_value(&p, 5);
+      *p++ = ']';
+      *p = '\0';
+
+      assert(compare(buffer));
+    }
+  }
+
+  cpu_features_restrict(CPU_ALL);
+}
+
+/**
+ * @name build_command:
+ *   Build a `send` command of about `size` bytes, with escapes.
+ */
+static char *build_command(size_t size) {
+
+  size_t n = 0;
+  char *rv = allocate_array(sizeof(char), size + 128, 1);
+
+  n += sprintf(rv + n, "{ \"command\": \"send\", \"arguments\": [");
+
+  for (unsigned int i = 0; n < size; ++i) {
+    n += sprintf(
+      rv + n, "%s\"+1503555%04u\", \"line %u\\n\\\"quoted\\\" \\u00e9\"",
+        (i ? ", " : ""), i, i
+    );
+  }
+
+  sprintf(rv + n, "] }");
+  return rv;
+}
+
+/**
+ * @name convert:
+ *   Convert a copy of `json` to arguments, using the processor
+ *   features in `mask`. Returns the argument vector, and stores the
+ *   copy in `*copy`, since the arguments point in to it.
+ */
+static char **convert(const char *json, unsigned int mask,
+                      char **copy, int *argc) {
+  int err = 0;
+  char **rv = NULL;
+
+  cpu_features_restrict(mask);
+
+  *copy = allocate_array(sizeof(char), strlen(json), 1);
+  strcpy(*copy, json);
+
+  parsed_json_t *p = parse_json(*copy);
+
+  assert(p != NULL);
+  assert(parsed_json_to_arguments(p, argc, &rv, &err));
+
+  release_parsed_json(p);
+  cpu_features_restrict(CPU_ALL);
+
+  return rv;
+}
+
+/**
+ * @name test_arguments:
+ *   Argument vectors are identical whether or not `parse_json`
+ *   uses the index; without vector instructions, it never does.
+ */
+static void test_arguments() {
+
+  char *json = build_command(256 * 1024);
+
+  for (unsigned int l = 1; l < sizeof(levels) / sizeof(*levels); ++l) {
+
+    int argc_jsmn = 0, argc_index = 0;
+    char *copy_jsmn, *copy_index;
+
+    char **argv_jsmn = convert(json, CPU_NONE, &copy_jsmn, &argc_jsmn);
+    char **argv_index = convert(json, levels[l], &copy_index, &argc_index);
+
+    assert(argc_jsmn == argc_index && argc_jsmn > 1000);
+
+    for (int i = 0; i <= argc_jsmn; ++i) {
+      assert(!argv_jsmn[i] == !argv_index[i]);
+      assert(!argv_jsmn[i] || strcmp(argv_jsmn[i], argv_index[i]) == 0);
+    }
+
+    free(argv_jsmn);
+    free(argv_index);
+    free(copy_jsmn);
+    free(copy_index);
+  }
+
+  free(json);
+}
+
+int main(int argc, char *argv[]) {
+
+  test_well_formed();
+  test_random();
+  test_random_well_formed();
+  test_arguments();
+
+  return 0;
+}
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
@@ -0,0 +1,377 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "json.h"
+#include "allocate.h"
+
+/**
+ * @name build_command:
+ *   Build a `send` command with `pairs` phone number and message
+ *   pairs. Every third message is a numeric primitive, and every
+ *   fifth contains escape sequences, so that jsmn stops inside each
+ *   kind of token at some point.
+ */
+static char *build_command(unsigned int pairs) {
+
+  size_t n = 0;
+  char *rv = allocate_array(sizeof(char), 64 * (pairs + 1), 1);
+
+  n += sprintf(rv + n, "{ \"command\": \"send\", \"arguments\": [");
+
+  for (unsigned int i = 0; i < pairs; ++i) {
+
+    n += sprintf(rv + n, "%s\"+1%u\", ", (i ? ", " : ""), i);
+
+    if (i % 3 == 0) {
+      n += sprintf(rv + n, "%u", i * 7);
+    } else if (i % 5 == 0) {
+      n += sprintf(rv + n, "\"say \\\"hi\\\" \\u00e9 %u\"", i);
+    } else {
+      n += sprintf(rv + n, "\"message %u\"", i);
+    }
+  }
+
+  sprintf(rv + n, "] }");
+  return rv;
+}
+
+/**
+ * @name test_single_pass:
+ *   Tokens produced while the token array grows must be exactly
+ *   those produced by a single parse in to an array that is large
+ *   enough from the start.
+ */
+static void test_single_pass() {
+
+  const unsigned int sizes[] = {
+    0, 1, 7, 8, 13, 14, 15, 16, 50, 127, 1000, 5000, 16000
+  };
+
+  for (unsigned int k = 0; k < sizeof(sizes) / sizeof(*sizes); ++k) {
+
+    char *json = build_command(sizes[k]);
+    unsigned int expect_tokens = 2 * sizes[k] + 5;
+
+    /* Reference parse */
+    jsmn_parser parser;
+    jsmntok_t *expect = allocate_array(sizeof(jsmntok_t), expect_tokens, 0);
+
+    jsmn_init(&parser);
+    assert(jsmn_parse(&parser, json, expect, expect_tokens) == JSMN_SUCCESS);
+    assert(parser.toknext == expect_tokens);
+
+    /* Growing parse */
+    parsed_json_t *p = parse_json(json);
+
+    assert(p != NULL);
+    assert(p->parser.toknext == expect_tokens);
+    assert(p->nr_tokens == expect_tokens);
+
+    for (unsigned int i = 0; i < expect_tokens; ++i) {
+
+      jsmn_compact_t *t = &p->tokens[i];
+
+      assert(jsmn_compact_type(t) == expect[i].type);
+      assert((int) jsmn_compact_start(t) == expect[i].start);
+      assert((int) t->end == expect[i].end);
+
+      /* Subtree size counts every token that starts inside */
+      unsigned int descendants = 0;
+
+      for (unsigned int j = i + 1; j < expect_tokens; ++j) {
+        if (expect[j].start < expect[i].end) {
+          descendants++;
+        }
+      }
+
+      assert(t->skip == descendants);
+    }
+
+    /* Arguments */
+    int argc = 0, err = 0;
+    char **argv = NULL;
+
+    assert(parsed_json_to_arguments(p, &argc, &argv, &err));
+    assert(argc == (int) (2 * sizes[k] + 1));
+    assert(strcmp(argv[0], "send") == 0);
+
+    if (sizes[k] > 5) {
+      assert(strcmp(argv[2 * 5 + 2], "say \\\"hi\\\" \\u00e9 5") == 0);
+      assert(strcmp(argv[2 * 6 + 1], "+16") == 0);
+      assert(strcmp(argv[2 * 6 + 2], "42") == 0);
+    }
+
+    free(argv);
+    free(expect);
+    release_parsed_json(p);
+    free(json);
+  }
+}
+
+/**
+ * @name test_errors:
+ */
+static void test_errors() {
+
+  char *json;
+
+  /* Over the token limit */
+  json = build_command(20000);
+  assert(parse_json(json) == NULL);
+  free(json);
+
+  /* Malformed, after the token array has grown */
+  json = build_command(1000);
+  json[strlen(json) - 1] = '\0';
+  assert(parse_json(json) == NULL);
+  free(json);
+
+  json = build_command(1000);
+  json[strlen(json) / 2] = '}';
+  assert(parse_json(json) == NULL);
+  free(json);
+}
+
+/**
+ * @name validate:
+ *   Parse and convert a copy of `json`. Returns the number of
+ *   arguments, or the negated validation error. The arguments are
+ *   valid until the next call.
+ */
+static int validate(const char *json, char ***argv) {
+
+  static char buffer[256];
+  int argc = 0, err = 0;
+
+  assert(strlen(json) < sizeof(buffer));
+  strcpy(buffer, json);
+
+  parsed_json_t *p = parse_json(buffer);
+  *argv = NULL;
+
+  if (!p) {
+    return -V_ERR_PARSE;
+  }
+
+  boolean_t rv = parsed_json_to_arguments(p, &argc, argv, &err);
+  release_parsed_json(p);
+
+  return (rv ? argc : -err);
+}
+
+/**
+ * @name test_validation:
+ *   Each validation error is reported for the first problem found,
+ *   and values of unrelated properties are skipped over whole.
+ */
+static void test_validation() {
+
+  char **argv;
+
+  assert(validate("[]", &argv) == -V_ERR_ROOT_TYPE);
+  assert(validate("{ \"command\" }", &argv) == -V_ERR_PROPS_ODD);
+  assert(validate("{ 1: 2 }", &argv) == -V_ERR_PROPS_TYPE);
+  assert(validate("{ \"command\": 1 }", &argv) == -V_ERR_CMD_TYPE);
+  assert(validate("{ \"arguments\": \"x\" }", &argv) == -V_ERR_ARGS_TYPE);
+  assert(validate("{ \"arguments\": [[]] }", &argv) == -V_ERR_ARG_TYPE);
+  assert(validate("{ \"arguments\": [true] }", &argv) == -V_ERR_ARGS_NUMERIC);
+  assert(validate("{ \"command\": \"x\" }", &argv) == -V_ERR_PROPS_MISSING);
+
+  assert(validate(
+    "{ \"x\": { \"command\": [1, { \"arguments\": 2 }] }, "
+      "\"command\": \"send\", \"y\": [[]], \"arguments\": [\"a\", 1] }",
+    &argv
+  ) == 3);
+
+  assert(strcmp(argv[0], "send") == 0);
+  assert(strcmp(argv[1], "a") == 0 && strcmp(argv[2], "1") == 0);
+  assert(argv[3] == NULL);
+
+  free(argv);
+}
+
+/**
+ * @name build_arguments:
+ *   Build a command with exactly `count` string arguments.
+ */
+static char *build_arguments(unsigned int count) {
+
+  size_t n = 0;
+  char *rv = allocate_array(sizeof(char), 16 * (count + 4), 1);
+
+  n += sprintf(rv + n, "{ \"command\": \"x\", \"arguments\": [");
+
+  for (unsigned int i = 0; i < count; ++i) {
+    n += sprintf(rv + n, "%s\"%u\"", (i ? ", " : ""), i);
+  }
+
+  sprintf(rv + n, "] }");
+  return rv;
+}
+
+/**
+ * @name test_boundaries:
+ *   Commands whose tokens or arguments exactly fill a buffer.
+ */
+static void test_boundaries() {
+
+  for (unsigned int k = 0; k <= 1100; ++k) {
+
+    int argc = 0, err = 0;
+    char **argv = NULL;
+    char *json = build_arguments(k);
+
+    parsed_json_t *p = parse_json(json);
+
+    assert(p != NULL);
+    assert(p->nr_tokens == k + 5);
+    assert(parsed_json_to_arguments(p, &argc, &argv, &err));
+    assert(argc == (int) k + 1);
+    assert(argv[argc] == NULL);
+
+    if (k > 0) {
+      char expect[16];
+      sprintf(expect, "%u", k - 1);
+      assert(strcmp(argv[k], expect) == 0);
+    }
+
+    free(argv);
+    release_parsed_json(p);
+    free(json);
+  }
+}
+
+/**
+ * @name context_command:
+ *   Copy `json` in to the line buffer of `c`, as `read_line_into`
+ *   would, then parse it. Returns the number of arguments, or -1.
+ */
+static int context_command(json_context_t *c, const char *json) {
+
+  int argc = 0, err = 0;
+  char **argv = NULL;
+  size_t length = strlen(json);
+
+  if (length > c->line_size) {
+    c->line = reallocate_array(c->line, sizeof(char), length, 1);
+    c->line_size = length;
+  }
+
+  strcpy(c->line, json);
+
+  if (!json_context_parse(c, c->line)) {
+    json_context_finish(c);
+    return -1;
+  }
+
+  boolean_t rv = json_context_arguments(c, &argc, &argv, &err);
+
+  assert(!rv || argv == c->argv);
+  assert(!rv || argv[argc] == NULL);
+
+  json_context_finish(c);
+  return (rv ? argc : -1);
+}
+
+/**
+ * @name test_context:
+ */
+static void test_context() {
+
+  char *large = build_command(5000);
+  char *small = build_arguments(3);
+
+  /* Without a shrink policy, buffers stay at their peak */
+  json_context_t *c = json_context_create(0);
+
+  assert(context_command(c, small) == 4);
+  assert(context_command(c, large) == 10001);
+
+  jsmn_compact_t *tokens = c->parsed.tokens;
+  char **argv = c->argv;
+  size_t tokens_size = c->tokens_size, argv_size = c->argv_size;
+
+  for (unsigned int i = 0; i < 100; ++i) {
+    assert(context_command(c, small) == 4);
+    assert(context_command(c, "{ \"command\": 1") == -1);
+    assert(context_command(c, "[]") == -1);
+  }
+
+  /* No reallocation happened */
+  assert(context_command(c, large) == 10001);
+  assert(c->parsed.tokens == tokens && c->tokens_size == tokens_size);
+  assert(c->argv == argv && c->argv_size == argv_size);
+
+  json_context_destroy(c);
+
+  /* With a shrink policy, a burst is released afterwards */
+  c = json_context_create(8);
+
+  assert(context_command(c, large) == 10001);
+  assert(c->tokens_size >= 10005 && c->argv_size >= 10002);
+
+  for (unsigned int i = 0; i < 16; ++i) {
+    assert(context_command(c, small) == 4);
+  }
+
+  assert(c->tokens_size == 32);
+  assert(c->argv_size == 128);
+  assert(c->line_size == 1024);
+
+  /* Still usable afterwards */
+  assert(context_command(c, large) == 10001);
+  assert(context_command(c, small) == 4);
+
+  json_context_destroy(c);
+
+  free(large);
+  free(small);
+}
+
+int main(int argc, char *argv[]) {
+
+  test_single_pass();
+  test_errors();
+  test_validation();
+  test_boundaries();
+  test_context();
+
+  return 0;
+}
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */
@@ -0,0 +1,352 @@
+/**
+ * gammu-json
+ *
+ * Copyright (c) 2013-2014 David Brown <hello at scri.pt>.
+ * Copyright (c) 2013-2014 Medic Mobile, Inc. <david at medicmobile.org>
+ *
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License, version three,
+ * as published by the Free Software Foundation.
+ *
+ * You should have received a copy of version three of the GNU General
+ * Public License along with this software. If you did not, see
+ * http://www.gnu.org/licenses/.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL DAVID BROWN OR
+ * MEDIC MOBILE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "json.h"
+#include "allocate.h"
+#include "json_stream.h"
+
+/** --- **/
+
+/**
+ * @name log_t:
+ *   Everything reported by a stream parser, as text.
+ */
+typedef struct log {
+  char text[4096];
+  size_t length;
+} log_t;
+
+static void _log(log_t *l, const char *kind, const char *s) {
+
+  l->length += snprintf(
+    l->text + l->length, sizeof(l->text) - l->length, "%s(%s) ", kind, s
+  );
+}
+
+static void _command(void *x, const char *s, size_t length) {
+  assert(strlen(s) == length);
+  _log((log_t *) x, "c", s);
+}
+
+static void _argument(void *x, const char *s, size_t length) {
+  assert(strlen(s) == length);
+  _log((log_t *) x, "a", s);
+}
+
+static void _end(void *x, json_validation_error_t err) {
+
+  char s[8];
+  sprintf(s, "%d", err);
+
+  _log((log_t *) x, "end", s);
+}
+
+/**
+ * @name check:
+ *   Parse `json`, split in to two pieces at every possible position,
+ *   and require that the events reported are always `expect`.
+ */
+static void check(const char *json, const char *expect) {
+
+  size_t length = strlen(json);
+
+  for (size_t split = 0; split <= length; ++split) {
+
+    log_t l = { "", 0 };
+    json_stream_handler_t h = { _command, _argument, _end, &l };
+    json_stream_t *j = json_stream_create(&h);
+
+    json_stream_feed(j, json, split);
+    json_stream_feed(j, json + split, length - split);
+    json_stream_finish(j);
+
+    if (strcmp(l.text, expect) != 0) {
+      fprintf(stderr, "Input: %s\nSplit: %zu\n", json, split);
+      fprintf(stderr, "Expected: %s\nReceived: %s\n", expect, l.text);
+      assert(FALSE);
+    }
+
+    json_stream_destroy(j);
+  }
+}
+
+/**
+ * @name test_commands:
+ *   Commands are reported argument by argument, need not be
+ *   separated by newlines, and may span several lines.
+ */
+static void test_commands() {
+
+  check(
+    "{ \"command\": \"send\", \"arguments\": [\"+1503\", \"hi\", 12, 3] }",
+    "c(send) a(+1503) a(hi) a(12) a(3) end(0) "
+  );
+
+  check(
+    "{\"command\":\"a\",\"arguments\":[]}{\"command\":\"b\",\"arguments\":[1]}",
+    "c(a) end(0) c(b) a(1) end(0) "
+  );
+
+  check(
+    "{\n  \"arguments\": [\n    \"x\\n\\\"y\\\" \\u00e9\"\n  ],\n"
+      "  \"z\": { \"q\": [1, [true, null], \"]}\"] },\n"
+      "  \"command\": \"send\"\n}\n",
+    "a(x\\n\\\"y\\\" \\u00e9) c(send) end(0) "
+  );
+
+  /* A string containing a raw newline isn't split */
+  check(
+    "{\"command\":\"send\",\"arguments\":[\"a\nb\"]}",
+    "c(send) a(a\nb) end(0) "
+  );
+}
+
+/**
+ * @name test_validation:
+ *   Validation errors are reported when the command ends, using the
+ *   same codes as `parsed_json_to_arguments`; parsing continues.
+ */
+static void test_validation() {
+
+  check("[1] {}", "end(5) end(12) ");
+  check("\"x\" 12 ", "end(5) end(5) ");
+  check("{\"command\": 1, \"arguments\": []}", "end(8) ");
+  check("{\"command\": {}, \"arguments\": []}", "end(8) ");
+  check("{\"arguments\": \"x\"}", "end(9) ");
+  check("{\"arguments\": {}}", "end(9) ");
+  check("{\"arguments\": [\"a\", [], \"b\"]}", "a(a) end(10) ");
+  check("{\"arguments\": [\"a\", true, \"b\"]}", "a(a) end(11) ");
+  check("{\"command\": \"x\"}", "c(x) end(12) ");
+}
+
+/**
+ * @name test_syntax:
+ *   After a syntax error, the rest of the line is discarded.
+ */
+static void test_syntax() {
+
+  check("{1: 2}\n{}", "end(6) end(12) ");
+  check("{\"command\"}\n{}", "end(7) end(12) ");
+  check("{\"a\": [}\n{}", "end(1) end(12) ");
+  check("{\"a\": \"\\x\"}\n{}", "end(1) end(12) ");
+  check("{\"a\": \"\\u12g4\"}\n{}", "end(1) end(12) ");
+  check("{\"a\": x}\n{}", "end(1) end(12) ");
+
+  /* Incomplete at the end of input */
+  check(
+    "{\"command\": \"send\", \"arguments\": [\"1\"",
+    "c(send) a(1) end(1) "
+  );
+  check("{\"command\": \"se", "end(1) ");
+}
+
+/**
+ * @name check_same_as_parse_json:
+ *   Require that `json` is accepted or rejected exactly as it is by
+ *   `parse_json` and `parsed_json_to_arguments`, with the same error
+ *   code, and on success the same command and arguments. In `json`,
+ *   `command` must precede `arguments`, and nothing may follow them.
+ */
+static void check_same_as_parse_json(const char *json) {
+
+  int argc = 0, err = 0;
+  char **argv, buffer[256], expect[4096];
+
+  assert(strlen(json) < sizeof(buffer));
+  strcpy(buffer, json);
+
+  parsed_json_t *p = parse_json(buffer);
+
+  if (!p) {
+    err = V_ERR_PARSE;
+  } else if (parsed_json_to_arguments(p, &argc, &argv, &err)) {
+
+    size_t n = sprintf(expect, "c(%s) ", argv[0]);
+
+    for (int i = 1; i < argc; ++i) {
+      n += sprintf(expect + n, "a(%s) ", argv[i]);
+    }
+
+    sprintf(expect + n, "end(0) ");
+
+    free(argv);
+    release_parsed_json(p);
+
+    check(json, expect);
+    return;
+  }
+
+  if (p) {
+    release_parsed_json(p);
+  }
+
+  /* Rejected: compare only the error reported at the end */
+  log_t l = { "", 0 };
+  json_stream_handler_t h = { _command, _argument, _end, &l };
+  json_stream_t *j = json_stream_create(&h);
+
+  json_stream_feed(j, json, strlen(json));
+  json_stream_finish(j);
+  json_stream_destroy(j);
+
+  sprintf(expect, "end(%d) ", err);
+  char *end = strstr(l.text, "end(");
+
+  if (!end || strcmp(end, expect) != 0) {
+    fprintf(stderr, "Input: %s\n", json);
+    fprintf(stderr, "Expected: %s\nReceived: %s\n", expect, l.text);
+    assert(FALSE);
+  }
+}
+
+/**
+ * @name test_same_as_parse_json:
+ *   Separators are treated as whitespace, as they are by jsmn, so
+ *   trailing, repeated, and missing commas and colons are accepted;
+ *   the root object's properties alternate by position alone.
+ */
+static void test_same_as_parse_json() {
+
+  check_same_as_parse_json(
+    "{\"command\": \"send\", \"arguments\": [\"1\", \"a\"]}"
+  );
+
+  /* Trailing, repeated, leading, and missing commas */
+  check_same_as_parse_json(
+    "{\"command\":\"send\",\"arguments\":[\"1\",\"a\",]}"
+  );
+  check_same_as_parse_json(
+    "{\"command\":\"send\",\"arguments\":[\"1\",,\"a\"]}"
+  );
+  check_same_as_parse_json(
+    "{\"command\":\"send\",\"arguments\":[,\"1\",\"a\"]}"
+  );
+  check_same_as_parse_json(
+    "{\"command\":\"send\",\"arguments\":[\"1\" \"a\" 2]}"
+  );
+  check_same_as_parse_json("{,\"command\":\"send\",,\"arguments\":[\"1\"],}");
+  check_same_as_parse_json("{\"command\":\"send\",\"arguments\":[\"1\"]},");
+
+  /* Missing and misplaced colons */
+  check_same_as_parse_json("{\"command\" \"send\" \"arguments\" [\"1\"]}");
+  check_same_as_parse_json(
+    "{\"command\"::\"send\":\"arguments\",[\"1\":\"a\"]}"
+  );
+
+  /* Unrelated values are skipped whole, however they're separated */
+  check_same_as_parse_json(
+    "{\"x\": {\"y\" [1,,], \"z\"}, \"command\": \"a\", \"arguments\": []}"
+  );
+
+  /* Rejected for the same reasons */
+  check_same_as_parse_json("{\"command\" \"send\" \"arguments\"}");
+  check_same_as_parse_json("{\"command\":\"send\",1,2,\"arguments\":[]}");
+  check_same_as_parse_json(
+    "{[\"x\"]: 1, \"command\": \"a\", \"arguments\": []}"
+  );
+  check_same_as_parse_json("{\"command\": \"a\", \"arguments\": [[\"x\",],]}");
+  check_same_as_parse_json("{\"command\": \"a\", \"arguments\": [1,}");
+  check_same_as_parse_json("{\"command\": \"a\", \"arguments\": [x]}");
+}
+
+/**
+ * @name counts:
+ */
+static unsigned int counts[2];
+
+static void _count_command(void *x, const char *s, size_t length) {
+  assert(strcmp(s, "send") == 0);
+}
+
+static void _count_argument(void *x, const char *s, size_t length) {
+  counts[0]++;
+}
+
+static void _count_end(void *x, json_validation_error_t err) {
+  assert(err == V_ERR_NONE);
+  counts[1]++;
+}
+
+/**
+ * @name test_large:
+ *   A command with more arguments than `parse_json` allows, fed in
+ *   small pieces, is reported in full, and the parser's buffers
+ *   never grow beyond what the longest value needs.
+ */
+static void test_large() {
+
+  char piece[64];
+  unsigned int total = 1000000;
+
+  json_stream_handler_t h = {
+    _count_command, _count_argument, _count_end, NULL
+  };
+
+  json_stream_t *j = json_stream_create(&h);
+
+  const char *start = "{ \"command\": \"send\", \"arguments\": [";
+  json_stream_feed(j, start, strlen(start));
+
+  for (unsigned int i = 0; i < total; ++i) {
+    int n = sprintf(piece, "%s\"+1503555%04u\"", (i ? ", " : ""), i % 10000);
+    json_stream_feed(j, piece, n);
+  }
+
+  json_stream_feed(j, "] }", 3);
+  json_stream_finish(j);
+
+  assert(counts[0] == total && counts[1] == 1);
+  assert(j->value_size == json_stream_buffer_start);
+  assert(j->stack_size == json_stream_stack_start);
+
+  json_stream_destroy(j);
+}
+
+int main(int argc, char *argv[]) {
+
+  test_commands();
+  test_validation();
+  test_syntax();
+  test_same_as_parse_json();
+  test_large();
+
+  return 0;
+}
+
+/* vim: set ts=4 sts=2 sw=2 expandtab: */